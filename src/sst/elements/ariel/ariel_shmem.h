@@ -42,6 +42,30 @@
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
 
+/* Bytes of encoded instructions carried by one ARIEL_PERFORM_BLOCK record.
+ * Sized so the block record does not grow the ArielCommand union past inst. */
+#define ARIEL_MAX_BLOCK_RECORD_SIZE 76
+
+/* Longest varint encodings of a 32-bit operand size and a 64-bit address delta */
+#define ARIEL_MAX_VARINT32_SIZE 5
+#define ARIEL_MAX_VARINT64_SIZE 10
+
+/* Largest encoding of one instruction in a block record: header, SIMD width,
+ * and a (size, address delta) varint pair for both a read and a write */
+#define ARIEL_MAX_BLOCK_INST_SIZE (2 + 2 * (ARIEL_MAX_VARINT32_SIZE + ARIEL_MAX_VARINT64_SIZE))
+
+/* Block record instruction header bits */
+#define ARIEL_BLOCK_OP_READ     0x01
+#define ARIEL_BLOCK_OP_WRITE    0x02
+#define ARIEL_BLOCK_CLASS_SHIFT 2
+#define ARIEL_BLOCK_CLASS_MASK  0x07
+#define ARIEL_BLOCK_HAS_SIMD    0x20
+
+/* Sampling phases announced by ARIEL_SAMPLE_PHASE */
+#define ARIEL_SAMPLE_FASTFORWARD 0
+#define ARIEL_SAMPLE_WARMUP      1
+#define ARIEL_SAMPLE_DETAILED    2
+
 namespace SST {
 namespace ArielComponent {
 
@@ -64,6 +88,8 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_CUDA = 144,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_PERFORM_BLOCK = 160,
+    ARIEL_SAMPLE_PHASE = 161,
 };
 
 #ifdef HAVE_CUDA
@@ -171,6 +197,23 @@ struct ArielCommand {
         struct {
             uint64_t vaddr;
         } flushline;
+        /* A run of instructions from one basic block. Each instruction is
+         * a header byte (ARIEL_BLOCK_* bits), an optional SIMD width byte, and
+         * then a (size, zigzag address delta) varint pair per read and write.
+         * Deltas are taken from the previous address in the record, starting
+         * at baseAddr. */
+        struct {
+            uint64_t baseAddr;
+            uint16_t instCount;
+            uint16_t length;
+            uint8_t  data[ARIEL_MAX_BLOCK_RECORD_SIZE];
+        } block;
+        /* Thread moved from prevPhase, in which it executed insts instructions, to phase */
+        struct {
+            uint32_t phase;
+            uint32_t prevPhase;
+            uint64_t insts;
+        } sample;
 #ifdef HAVE_CUDA
         struct {
             GpuApi_t name;
@@ -180,6 +223,39 @@ struct ArielCommand {
     };
 };
 
+/* Varint helpers shared by the block record writer (frontend) and reader (core) */
+static inline uint32_t arielEncodeVarint(uint8_t* out, uint64_t value) {
+    uint32_t len = 0;
+    while (value >= 0x80) {
+        out[len++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    out[len++] = (uint8_t) value;
+    return len;
+}
+
+static inline uint32_t arielDecodeVarint(const uint8_t* in, uint32_t avail, uint64_t* value) {
+    uint64_t result = 0;
+    uint32_t shift = 0;
+    for (uint32_t i = 0; i < avail && shift < 64; i++) {
+        result |= ((uint64_t) (in[i] & 0x7F)) << shift;
+        if (!(in[i] & 0x80)) {
+            *value = result;
+            return i + 1;
+        }
+        shift += 7;
+    }
+    return 0; /* Truncated or malformed */
+}
+
+static inline uint64_t arielZigZagEncode(uint64_t delta) {
+    return (delta << 1) ^ (uint64_t) (((int64_t) delta) >> 63);
+}
+
+static inline uint64_t arielZigZagDecode(uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
 struct ArielSharedData {
     size_t numCores;
     uint64_t simTime;
@@ -87,6 +87,9 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     statInstructionCount = registerStatistic<uint64_t>( "instruction_count", subID );
     statCycles = registerStatistic<uint64_t>( "cycles", subID );
     statActiveCycles = registerStatistic<uint64_t>( "active_cycles", subID );
+    statSampleCycles = registerStatistic<uint64_t>( "sample_detailed_cycles", subID );
+    statSampleInstructions = registerStatistic<uint64_t>( "sample_detailed_instructions", subID );
+    statExtrapolatedCycles = registerStatistic<uint64_t>( "extrapolated_cycles", subID );
 
     statFPSPIns = registerStatistic<uint64_t>("fp_sp_ins", subID);
     statFPDPIns = registerStatistic<uint64_t>("fp_dp_ins", subID);
@@ -121,6 +124,16 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     }
 
     currentCycles = 0;
+
+    // Unsampled runs never see a phase marker and stay detailed throughout
+    samplePhase = ARIEL_SAMPLE_DETAILED;
+    warmupIssuePerCycle = params.find<uint32_t>("sample_warmup_issue", 64);
+    sampleOpen = false;
+    sampleFastForwardInsts = 0;
+    sampleWarmupInsts = 0;
+    sampleStartInsts = 0;
+    frontendInsts = 0;
+    sampleStartCycles = 0;
 }
 
 ArielCore::~ArielCore() {
@@ -630,6 +643,13 @@ void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
+void ArielCore::createSamplePhaseEvent(uint32_t phase, uint32_t prevPhase, uint64_t insts) {
+    ArielSamplePhaseEvent* ev = new ArielSamplePhaseEvent(phase, prevPhase, insts);
+    coreQ->push(ev);
+
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a SAMPLE_PHASE event, phase=%" PRIu32 " after %" PRIu64 " instructions\n", phase, insts));
+}
+
 void ArielCore::createNoOpEvent() {
     ArielNoOpEvent* ev = new ArielNoOpEvent();
     coreQ->push(ev);
@@ -781,6 +801,97 @@ bool ArielCore::hasDrainCompleted() const {
         return false;
 }
 
+void ArielCore::recordInstructionClass(uint32_t instClass, uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+        statFPSPIns->addData(1);
+
+        if(simdElemCount > 1) {
+            statFPSPSIMDIns->addData(1);
+        } else {
+            statFPSPScalarIns->addData(1);
+        }
+
+        if(simdElemCount < 32)
+            statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+        statFPDPIns->addData(1);
+
+        if(simdElemCount > 1) {
+            statFPDPSIMDIns->addData(1);
+        } else {
+            statFPDPScalarIns->addData(1);
+        }
+
+        if(simdElemCount < 16)
+            statFPDPOps->addData(simdElemCount);
+    }
+}
+
+/* Expand a batched basic block record into the same events the per-instruction
+ * START/READ/WRITE/END and NOOP commands would have produced. The whole record is
+ * queued at once, so the queue may briefly exceed maxQLength by one block. */
+void ArielCore::processBlockRecord(const ArielCommand& ac) {
+    const uint8_t* data = &ac.block.data[0];
+    const uint32_t length = ac.block.length;
+    uint64_t lastAddr = ac.block.baseAddr;
+    uint32_t pos = 0;
+
+    if(length > ARIEL_MAX_BLOCK_RECORD_SIZE) {
+        output->fatal(CALL_INFO, -1, "Error: Ariel block record on core %" PRIu32 " has invalid length %" PRIu32 "\n", coreID, length);
+    }
+
+    for(uint32_t i = 0; i < ac.block.instCount; i++) {
+        if(pos >= length) {
+            output->fatal(CALL_INFO, -1, "Error: Ariel block record on core %" PRIu32 " ended after %" PRIu32 " of %" PRIu32 " instructions\n",
+                    coreID, i, (uint32_t) ac.block.instCount);
+        }
+
+        const uint8_t header = data[pos++];
+        const uint32_t ops = header & (ARIEL_BLOCK_OP_READ | ARIEL_BLOCK_OP_WRITE);
+        uint32_t simdElemCount = 1;
+
+        if(header & ARIEL_BLOCK_HAS_SIMD) {
+            if(pos >= length) {
+                output->fatal(CALL_INFO, -1, "Error: Ariel block record on core %" PRIu32 " is truncated at byte %" PRIu32 "\n", coreID, pos);
+            }
+            simdElemCount = data[pos++];
+        }
+
+        if(0 == ops) {
+            createNoOpEvent();
+            coreQ->back()->setEndsInstruction();
+            continue;
+        }
+
+        recordInstructionClass((header >> ARIEL_BLOCK_CLASS_SHIFT) & ARIEL_BLOCK_CLASS_MASK, simdElemCount);
+
+        for(uint32_t op = ARIEL_BLOCK_OP_READ; op <= ARIEL_BLOCK_OP_WRITE; op <<= 1) {
+            if(!(ops & op))
+                continue;
+
+            uint64_t size, delta;
+            uint32_t used = (pos < length) ? arielDecodeVarint(&data[pos], length - pos, &size) : 0;
+            pos += used;
+            uint32_t usedAddr = (used && pos < length) ? arielDecodeVarint(&data[pos], length - pos, &delta) : 0;
+            pos += usedAddr;
+
+            if(0 == used || 0 == usedAddr) {
+                output->fatal(CALL_INFO, -1, "Error: Ariel block record on core %" PRIu32 " is truncated at byte %" PRIu32 "\n", coreID, pos);
+            }
+
+            lastAddr += arielZigZagDecode(delta);
+
+            if(ARIEL_BLOCK_OP_READ == op) {
+                createReadEvent(lastAddr, (uint32_t) size);
+            } else {
+                createWriteEvent(lastAddr, (uint32_t) size, NULL);
+            }
+        }
+
+        coreQ->back()->setEndsInstruction();
+    }
+}
+
 bool ArielCore::refillQueue() {
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 "...\n", coreID));
 
@@ -806,29 +917,9 @@ bool ArielCore::refillQueue() {
                 break;
 
             case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+            {
+                const size_t queued = coreQ->size();
+                recordInstructionClass(ac.inst.instClass, ac.inst.simdElemCount);
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
                         ac = tunnel->readMessage(coreID);
@@ -854,11 +945,24 @@ bool ArielCore::refillQueue() {
 
                 // Add one to our instruction counts
                 //statInstructionCount->addData(1);
+                if(coreQ->size() > queued) {
+                    coreQ->back()->setEndsInstruction();
+                }
 
                 break;
+            }
+
+            case ARIEL_PERFORM_BLOCK:
+                processBlockRecord(ac);
+                break;
+
+            case ARIEL_SAMPLE_PHASE:
+                createSamplePhaseEvent(ac.sample.phase, ac.sample.prevPhase, ac.sample.insts);
+                break;
 
             case ARIEL_NOOP:
                 createNoOpEvent();
+                coreQ->back()->setEndsInstruction();
                 break;
 
             case ARIEL_FLUSHLINE_INSTRUCTION:
@@ -904,6 +1008,54 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
+void ArielCore::closeSample(uint64_t detailedInsts) {
+    ArielSample sample;
+    sample.fastForwardInsts = sampleFastForwardInsts;
+    sample.warmupInsts = sampleWarmupInsts;
+    sample.detailedInsts = detailedInsts;
+    sample.detailedCycles = currentCycles - sampleStartCycles;
+    samples.push_back(sample);
+
+    statSampleCycles->addData(sample.detailedCycles);
+    statSampleInstructions->addData(sample.detailedInsts);
+
+    sampleFastForwardInsts = 0;
+    sampleWarmupInsts = 0;
+    sampleOpen = false;
+}
+
+void ArielCore::handleSamplePhaseEvent(ArielSamplePhaseEvent* sEv) {
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " entering sample phase %" PRIu32 " after %" PRIu64 " instructions in phase %" PRIu32 "\n",
+                coreID, sEv->getPhase(), sEv->getPrevPhaseInstructions(), sEv->getPrevPhase()));
+
+    // Instruction counts come from the frontend so that they match the fast-forwarded
+    // counts; inst_count counts memory events rather than instructions
+    switch(sEv->getPrevPhase()) {
+        case ARIEL_SAMPLE_FASTFORWARD:
+            sampleFastForwardInsts += sEv->getPrevPhaseInstructions();
+            break;
+        case ARIEL_SAMPLE_WARMUP:
+            sampleWarmupInsts += sEv->getPrevPhaseInstructions();
+            break;
+        case ARIEL_SAMPLE_DETAILED:
+            if(sampleOpen) {
+                closeSample(sEv->getPrevPhaseInstructions());
+            }
+            break;
+        default:
+            output->fatal(CALL_INFO, -1, "Error: core %" PRIu32 " received unknown sample phase %" PRIu32 "\n", coreID, sEv->getPrevPhase());
+            break;
+    }
+
+    samplePhase = sEv->getPhase();
+
+    if(ARIEL_SAMPLE_DETAILED == samplePhase) {
+        sampleOpen = true;
+        sampleStartInsts = frontendInsts;
+        sampleStartCycles = currentCycles;
+    }
+}
+
 void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
 
@@ -1308,6 +1460,41 @@ void ArielCore::handleGpuAckEvent(SST::Event* e){
 #endif
 
 void ArielCore::printCoreStatistics() {
+    // A detailed window cut short by the end of simulation has no closing marker
+    if(sampleOpen) {
+        closeSample(frontendInsts - sampleStartInsts);
+    }
+
+    if(samples.empty()) {
+        return;
+    }
+
+    // Instructions after the last sample still belong to the run being extrapolated
+    uint64_t totalInsts = sampleFastForwardInsts + sampleWarmupInsts;
+    uint64_t detailedInsts = 0;
+    uint64_t detailedCycles = 0;
+
+    for(size_t i = 0; i < samples.size(); i++) {
+        const ArielSample& sample = samples[i];
+        totalInsts += sample.fastForwardInsts + sample.warmupInsts + sample.detailedInsts;
+        detailedInsts += sample.detailedInsts;
+        detailedCycles += sample.detailedCycles;
+
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " sample %" PRIu32 ": fast-forward=%" PRIu64 " warmup=%" PRIu64 " detailed=%" PRIu64 " instructions in %" PRIu64 " cycles (CPI %.3f)\n",
+                coreID, (uint32_t) i, sample.fastForwardInsts, sample.warmupInsts, sample.detailedInsts, sample.detailedCycles,
+                sample.detailedInsts ? ((double) sample.detailedCycles / (double) sample.detailedInsts) : 0.0);
+    }
+
+    if(0 == detailedInsts) {
+        return;
+    }
+
+    const double cpi = (double) detailedCycles / (double) detailedInsts;
+    const uint64_t extrapolated = (uint64_t) (cpi * (double) totalInsts);
+    statExtrapolatedCycles->addData(extrapolated);
+
+    output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " sampled %" PRIu64 " of %" PRIu64 " instructions over %" PRIu32 " samples, CPI %.3f, extrapolated cycles=%" PRIu64 "\n",
+            coreID, detailedInsts, totalInsts, (uint32_t) samples.size(), cpi, extrapolated);
 }
 
 bool ArielCore::processNextEvent() {
@@ -1428,6 +1615,12 @@ bool ArielCore::processNextEvent() {
                 }
                 break;
 
+        case SAMPLE_PHASE:
+                ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a SAMPLE_PHASE\n", coreID));
+                removeEvent = true;
+                handleSamplePhaseEvent(dynamic_cast<ArielSamplePhaseEvent*>(nextEvent));
+                break;
+
         case FENCE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FENCE\n", coreID));
                 if(!isCoreFenced()) {// If core is fenced, drop this fence - they can be merged
@@ -1455,6 +1648,10 @@ bool ArielCore::processNextEvent() {
                             (uint32_t) coreQ->size()));
         coreQ->pop();
 
+        if(nextEvent->endsInstruction()) {
+            frontendInsts++;
+        }
+
         delete nextEvent;
         return true;
     } else {
@@ -1475,7 +1672,9 @@ void ArielCore::tick() {
         updateCycle = false;
 
         if(!isStalled) {
-                for(uint32_t i = 0; i < maxIssuePerCycle; ++i) {
+                // Warmup only needs to touch cache and translation state, so let it
+                // run ahead of the modeled issue width
+                for(uint32_t i = 0; i < (ARIEL_SAMPLE_WARMUP == samplePhase ? warmupIssuePerCycle : maxIssuePerCycle); ++i) {
                     bool didProcess = processNextEvent();
 
                     // If we didnt process anything in the call or we have halted then
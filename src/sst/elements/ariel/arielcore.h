@@ -34,6 +34,7 @@
 
 #include <string>
 #include <queue>
+#include <vector>
 #include <unordered_map>
 
 #include "arielmemmgr.h"
@@ -47,6 +48,7 @@
 #include "arielflushev.h"
 #include "arielfenceev.h"
 #include "arielswitchpool.h"
+#include "arielsampleev.h"
 
 #include "ariel_shmem.h"
 #include "arieltracegen.h"
@@ -125,6 +127,7 @@ class ArielCore : public ComponentExtension {
         void createFlushEvent(uint64_t vAddr);
         void createFenceEvent();
         void createSwitchPoolEvent(uint32_t pool);
+        void createSamplePhaseEvent(uint32_t phase, uint32_t prevPhase, uint64_t insts);
 
         void setFilePath(std::string fp) {
           getcwd(file_path, sizeof(file_path));
@@ -152,6 +155,7 @@ class ArielCore : public ComponentExtension {
         void handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE);
         void handleFlushEvent(ArielFlushEvent *flEv);
         void handleFenceEvent(ArielFenceEvent *fEv);
+        void handleSamplePhaseEvent(ArielSamplePhaseEvent* sEv);
 
 #ifdef HAVE_CUDA
         void handleGpuEvent(ArielGpuEvent* gEv);
@@ -175,6 +179,9 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        void recordInstructionClass(uint32_t instClass, uint32_t simdElemCount);
+        void processBlockRecord(const ArielCommand& ac);
+        void closeSample(uint64_t detailedInsts);
 
         bool writePayloads;
         uint32_t coreID;
@@ -232,6 +239,26 @@ class ArielCore : public ComponentExtension {
         // This indicates the max number of instructions before halting the simulation
         uint64_t max_insts;
 
+        // Sampled execution: the frontend fast-forwards natively and announces warmup
+        // and detailed windows; only detailed windows are timed and extrapolated
+        struct ArielSample {
+            uint64_t fastForwardInsts;
+            uint64_t warmupInsts;
+            uint64_t detailedInsts;
+            uint64_t detailedCycles;
+        };
+
+        uint32_t samplePhase;
+        uint32_t warmupIssuePerCycle;
+        bool sampleOpen;
+        uint64_t sampleFastForwardInsts;
+        uint64_t sampleWarmupInsts;
+        uint64_t sampleStartInsts;
+        // Instructions retired in the frontend's units, for windows closed without a marker
+        uint64_t frontendInsts;
+        uint64_t sampleStartCycles;
+        std::vector<ArielSample> samples;
+
         ArielTraceGenerator* traceGen;
 
         Statistic<uint64_t>* statReadRequests;
@@ -246,6 +273,9 @@ class ArielCore : public ComponentExtension {
         Statistic<uint64_t>* statInstructionCount;
         Statistic<uint64_t>* statCycles;
         Statistic<uint64_t>* statActiveCycles;
+        Statistic<uint64_t>* statSampleCycles;
+        Statistic<uint64_t>* statSampleInstructions;
+        Statistic<uint64_t>* statExtrapolatedCycles;
 
         Statistic<uint64_t>* statFPDPIns;
         Statistic<uint64_t>* statFPDPSIMDIns;
@@ -74,6 +74,11 @@ class ArielCPU : public SST::Component {
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
+        {"batchblocks", "Pack the memory operations of each basic block into a single delta-encoded tunnel record (ignored when writepayloadtrace is set)", "0"},
+        {"sample_fastforward", "Sampled execution: instructions each thread runs natively between samples", "0"},
+        {"sample_warmup", "Sampled execution: instructions per sample that only warm caches and translation state ahead of the detailed window", "0"},
+        {"sample_detailed", "Sampled execution: instructions per sample simulated in detail, 0 disables sampling", "0"},
+        {"sample_warmup_issue", "Sampled execution: events a core may issue per cycle during warmup windows", "64"},
         {"gpu_enabled", "If enabled, gpu links will be set up", "0"})
 
     SST_ELI_DOCUMENT_PORTS( {"cache_link_%(corecount)d", "Each core's link to its cache", {}},
@@ -101,7 +106,10 @@ class ArielCPU : public SST::Component {
         { "fp_sp_scalar_ins",     "Statistic for counting SP-FP Non-SIMD instructons", "instructions", 1 },
         { "fp_sp_ops",            "Statistic for counting SP-FP operations (inst * SIMD width)", "instructions", 1 },
         { "cycles",               "Statistic for counting cycles of the Ariel core.", "cycles", 1 },
-        { "active_cycles",        "Statistic for counting active cycles (cycles not idle) of the Ariel core.", "cycles", 1 })
+        { "active_cycles",        "Statistic for counting active cycles (cycles not idle) of the Ariel core.", "cycles", 1 },
+        { "sample_detailed_cycles",       "Cycles spent in each detailed sampling window", "cycles", 1 },
+        { "sample_detailed_instructions", "Instructions executed in each detailed sampling window", "instructions", 1 },
+        { "extrapolated_cycles",          "Whole-run cycle estimate from the sampled CPI and the total instruction count", "cycles", 1 })
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
             {"memmgr", "Memory manager to translate virtual addresses to physical, handle malloc/free, etc.", "SST::ArielComponent::ArielMemoryManager"},
@@ -20,7 +20,7 @@
 using namespace SST;
 using namespace SST::ArielComponent;
 
-ArielEvent::ArielEvent() {
+ArielEvent::ArielEvent() : endsInst(false) {
 }
 
 ArielEvent::~ArielEvent() {
@@ -35,6 +35,7 @@ enum ArielEventType {
     SWITCH_POOL,
     FLUSH,
     FENCE,
+    SAMPLE_PHASE,
 #ifdef HAVE_CUDA
     GPU
 #endif
@@ -47,6 +48,14 @@ class ArielEvent {
         virtual ~ArielEvent();
         virtual ArielEventType getEventType() const = 0;
 
+        // Set on the last event generated for a frontend instruction so the core can
+        // count instructions the way the frontend does
+        void setEndsInstruction() { endsInst = true; }
+        bool endsInstruction() const { return endsInst; }
+
+    private:
+        bool endsInst;
+
 };
 
 }
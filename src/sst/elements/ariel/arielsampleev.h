@@ -0,0 +1,61 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_SAMPLE_PHASE_EVENT
+#define _H_SST_ARIEL_SAMPLE_PHASE_EVENT
+
+#include "arielevent.h"
+
+using namespace SST;
+
+namespace SST {
+namespace ArielComponent {
+
+class ArielSamplePhaseEvent : public ArielEvent {
+
+    public:
+        ArielSamplePhaseEvent(uint32_t newPhase, uint32_t oldPhase, uint64_t insts) :
+                phase(newPhase), prevPhase(oldPhase), prevPhaseInsts(insts) {
+        }
+
+        ~ArielSamplePhaseEvent() {}
+
+        ArielEventType getEventType() const {
+                return SAMPLE_PHASE;
+        }
+
+        uint32_t getPhase() const {
+                return phase;
+        }
+
+        uint32_t getPrevPhase() const {
+                return prevPhase;
+        }
+
+        uint64_t getPrevPhaseInstructions() const {
+                return prevPhaseInsts;
+        }
+
+    private:
+        const uint32_t phase;
+        const uint32_t prevPhase;
+        const uint64_t prevPhaseInsts;
+
+};
+
+}
+}
+
+#endif
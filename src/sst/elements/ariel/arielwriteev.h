@@ -17,6 +17,8 @@
 #ifndef _H_SST_ARIEL_WRITE_EVENT
 #define _H_SST_ARIEL_WRITE_EVENT
 
+#include <cstring>
+
 #include "arielevent.h"
 
 using namespace SST;
@@ -32,8 +34,12 @@ class ArielWriteEvent : public ArielEvent {
 
                 payload = new uint8_t[length];
 
-                for( int i = 0; i < length; ++i ) {
-                	payload[i] = payloadData[i];
+                if( NULL == payloadData ) {
+                	memset(payload, 0, length);
+                } else {
+                	for( int i = 0; i < length; ++i ) {
+                		payload[i] = payloadData[i];
+                	}
                 }
         }
 
@@ -47,6 +47,10 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     output = new SST::Output("Pin3Frontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
 
     int instrument_instructions = params.find<int>("instrument_instructions", 1);
+    int batch_blocks = params.find<int>("batchblocks", 0);
+    uint64_t sample_fastforward = params.find<uint64_t>("sample_fastforward", 0);
+    uint64_t sample_warmup = params.find<uint64_t>("sample_warmup", 0);
+    uint64_t sample_detailed = params.find<uint64_t>("sample_detailed", 0);
     core_count = cores;
 
     /////////////////////////////////////////////////////////////////////////////////////
@@ -119,7 +123,7 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     appLauncher = params.find<std::string>("launcher", PINTOOL_EXECUTABLE);
 
     const uint32_t launch_param_count = (uint32_t) params.find<uint32_t>("launchparamcount", 0);
-    const uint32_t pin_arg_count = 37 + launch_param_count;
+    const uint32_t pin_arg_count = 45 + launch_param_count;
 
     execute_args = (char**) malloc(sizeof(char*) * (pin_arg_count + app_argc));
 
@@ -176,6 +180,18 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     execute_args[arg++] = const_cast<char*>("-E");
     execute_args[arg++] = (char*) malloc(sizeof(char) * 8);
     sprintf(execute_args[arg-1], "%d", instrument_instructions);
+    execute_args[arg++] = const_cast<char*>("-b");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 8);
+    sprintf(execute_args[arg-1], "%d", batch_blocks);
+    execute_args[arg++] = const_cast<char*>("-F");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 24);
+    sprintf(execute_args[arg-1], "%" PRIu64, sample_fastforward);
+    execute_args[arg++] = const_cast<char*>("-W");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 24);
+    sprintf(execute_args[arg-1], "%" PRIu64, sample_warmup);
+    execute_args[arg++] = const_cast<char*>("-D");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 24);
+    sprintf(execute_args[arg-1], "%" PRIu64, sample_detailed);
     execute_args[arg++] = const_cast<char*>("-p");
     execute_args[arg++] = (char*) malloc(sizeof(char) * (shmem_region_name.length() + 1));
     strcpy(execute_args[arg-1], shmem_region_name.c_str());
@@ -0,0 +1,87 @@
+# Stream under the built PIN frontend with the optional tunnel features
+# turned on, used by testsuite_default_Ariel.py
+#   sst arielStreamFeatures.py --model-options="--app=./stream --batchblocks=1"
+#   sst arielStreamFeatures.py --model-options="--app=./stream --sample=20000,5000,10000"
+#
+# Options:
+#   --app=PATH              stream executable
+#   --batchblocks=N         pack each basic block into one tunnel record (default 0)
+#   --sample=FF,WARM,DET    sampled execution window sizes in instructions (default off)
+import sst
+import sys
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--app", required=True, help="stream executable")
+parser.add_argument("--batchblocks", type=int, default=0, help="ariel batchblocks")
+parser.add_argument("--sample", default="", help="fast-forward,warmup,detailed instructions per sample")
+args = parser.parse_args(sys.argv[1:])
+
+sst.setProgramOption("timebase", "1ps")
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams({
+        "verbose" : "1",
+        "maxcorequeue" : "256",
+        "maxissuepercycle" : "2",
+        "pipetimeout" : "0",
+        "executable" : args.app,
+        "arielmode" : "1",
+        "corecount" : 1,
+        "envparamcount" : 1,
+        "envparamname0" : "OMP_NUM_THREADS",
+        "envparamval0" : "1",
+        "batchblocks" : args.batchblocks,
+        })
+
+if args.sample:
+    fastforward, warmup, detailed = args.sample.split(",")
+    ariel.addParams({
+        "sample_fastforward" : fastforward,
+        "sample_warmup" : warmup,
+        "sample_detailed" : detailed,
+        })
+
+memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+        "cache_frequency" : "2 Ghz",
+        "cache_size" : "64 KB",
+        "coherence_protocol" : "MSI",
+        "replacement_policy" : "lru",
+        "associativity" : "8",
+        "access_latency_cycles" : "1",
+        "cache_line_size" : "64",
+        "L1" : "1",
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+        "clock" : "1GHz",
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+        "access_time" : "10ns",
+        "mem_size" : "2048MiB",
+})
+
+cpu_cache_link = sst.Link("cpu_cache_link")
+cpu_cache_link.connect( (ariel, "cache_link_0", "50ps"), (l1cache, "high_network_0", "50ps") )
+
+memory_link = sst.Link("mem_bus_link")
+memory_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticLoadLevel(5)
+sst.setStatisticOutput("sst.statOutputConsole")
+
+ariel.enableStatistics([
+      "cycles",
+      "instruction_count",
+      "read_requests",
+      "write_requests",
+      "sample_detailed_cycles",
+      "sample_detailed_instructions",
+      "extrapolated_cycles"
+])
@@ -0,0 +1,133 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import re
+import shutil
+import subprocess
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, "{0}/../../../../../../memHierarchy/tests/".format(dirpath))
+from mhstats import *
+
+################################################################################
+# Code to support a single instance module initialize, must be called setUp method
+
+module_init = 0
+module_sema = threading.Semaphore()
+
+def initializeTestModule_SingleInstance(class_inst):
+    global module_init
+    global module_sema
+
+    module_sema.acquire()
+    if module_init != 1:
+        # Put your single instance Init Code Here
+        module_init = 1
+
+    module_sema.release()
+
+# Only one PIN frontend is built into ariel; PinCRT means the pin3 one
+pin_loaded = sst_elements_config_include_file_get_value_str("PINTOOL_EXECUTABLE", default="", disable_warning=True) != ""
+pin3_used = sst_elements_config_include_file_get_value_int("HAVE_PINCRT", default=0, disable_warning=True) == 1
+
+################################################################################
+################################################################################
+################################################################################
+
+class testcase_Ariel(SSTTestCase):
+
+    def initializeClass(self, testName):
+        super(type(self), self).initializeClass(testName)
+        # Put test based setup code here. it is called before testing starts
+        # NOTE: This method is called once for every test
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        initializeTestModule_SingleInstance(self)
+        # Put test based setup code here. it is called once before every test
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    @unittest.skipIf(not pin_loaded or pin3_used, "Ariel: test_Ariel_batchblocks_pin2 skipped, the pin2 frontend is not built")
+    def test_Ariel_batchblocks_pin2(self):
+        self.Ariel_batchblocks_template("test_Ariel_batchblocks_pin2")
+
+    @unittest.skipIf(not pin_loaded or not pin3_used, "Ariel: test_Ariel_batchblocks_pin3 skipped, the pin3 frontend is not built")
+    def test_Ariel_batchblocks_pin3(self):
+        self.Ariel_batchblocks_template("test_Ariel_batchblocks_pin3")
+
+    @unittest.skipIf(not pin_loaded or pin3_used, "Ariel: test_Ariel_sampling_pin2 skipped, the pin2 frontend is not built")
+    def test_Ariel_sampling_pin2(self):
+        self.Ariel_sampling_template("test_Ariel_sampling_pin2")
+
+    @unittest.skipIf(not pin_loaded or not pin3_used, "Ariel: test_Ariel_sampling_pin3 skipped, the pin3 frontend is not built")
+    def test_Ariel_sampling_pin3(self):
+        self.Ariel_sampling_template("test_Ariel_sampling_pin3")
+
+#####
+
+    # Batched block records must deliver the same instructions and memory
+    # operations as one record per instruction
+    def Ariel_batchblocks_template(self, testcase):
+        app = self._buildStream()
+
+        stats = {}
+        for batch in (0, 1):
+            outfile, stats[batch] = self._runStream("{0}_{1}".format(testcase, batch), "--batchblocks={0}".format(batch), app)
+
+        for name in ("instruction_count", "read_requests", "write_requests"):
+            unbatched = statistic_total(stats[0], name)
+            batched = statistic_total(stats[1], name)
+            self.assertTrue(unbatched > 0, "Ariel Test {0}: {1} is zero without batching".format(testcase, name))
+            self.assertEqual(batched, unbatched, "Ariel Test {0}: batched {1} {2} does not match unbatched {3}".format(testcase, name, batched, unbatched))
+
+    # A sampled run must report each sample it took and extrapolate cycles from the detailed ones
+    def Ariel_sampling_template(self, testcase):
+        app = self._buildStream()
+
+        outfile, stats = self._runStream(testcase, "--sample=20000,5000,10000", app)
+
+        summary = None
+        samples = 0
+        with open(outfile) as f:
+            for line in f:
+                if re.search(r"Core 0 sample \d+: fast-forward=", line):
+                    samples += 1
+                match = re.search(r"Core 0 sampled (\d+) of (\d+) instructions over (\d+) samples, CPI [0-9.]+, extrapolated cycles=(\d+)", line)
+                if match:
+                    summary = [int(value) for value in match.groups()]
+
+        self.assertTrue(samples > 0, "Ariel Test {0}: no sample markers in {1}".format(testcase, outfile))
+        self.assertTrue(summary is not None, "Ariel Test {0}: no extrapolation summary in {1}".format(testcase, outfile))
+        detailed, total, count, extrapolated = summary
+        self.assertEqual(count, samples, "Ariel Test {0}: summary counts {1} samples but {2} were reported".format(testcase, count, samples))
+        self.assertTrue(0 < detailed < total, "Ariel Test {0}: sampled {1} of {2} instructions".format(testcase, detailed, total))
+        self.assertTrue(statistic_total(stats, "sample_detailed_instructions") > 0, "Ariel Test {0}: sample_detailed_instructions is zero".format(testcase))
+        self.assertEqual(statistic_total(stats, "sample_detailed_instructions"), detailed, "Ariel Test {0}: sample_detailed_instructions does not match the summary".format(testcase))
+        self.assertTrue(statistic_total(stats, "extrapolated_cycles") > 0, "Ariel Test {0}: extrapolated_cycles is zero".format(testcase))
+        self.assertEqual(statistic_total(stats, "extrapolated_cycles"), extrapolated, "Ariel Test {0}: extrapolated_cycles does not match the summary".format(testcase))
+
+#####
+
+    def _buildStream(self):
+        test_path = self.get_testsuite_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        streamdir = "{0}/ariel_stream".format(tmpdir)
+        app = "{0}/stream".format(streamdir)
+        if not os.path.isfile(app):
+            shutil.rmtree(streamdir, ignore_errors=True)
+            shutil.copytree("{0}/..".format(test_path), streamdir, ignore=shutil.ignore_patterns("tests"))
+            rtn = subprocess.call(["make", "-C", streamdir, "stream"], stdout=subprocess.DEVNULL, stderr=subprocess.STDOUT)
+            self.assertEqual(rtn, 0, "Ariel: failed to build the stream test application in {0}".format(streamdir))
+        return app
+
+    def _runStream(self, testDataFileName, options, app):
+        sdlfile = "{0}/arielStreamFeatures.py".format(self.get_testsuite_dir())
+        return run_and_read_statistics(self, sdlfile, testDataFileName, "--app={0} {1}".format(app, options))
@@ -73,6 +73,10 @@ KNOB<UINT32> StartupMode(KNOB_MODE_WRITEONCE, "pintool", "s", "1", "Mode for con
 KNOB<UINT32> InstrumentInstructions(KNOB_MODE_WRITEONCE, "pintool", "E", "1", "Enable instruction instrumentation");
 KNOB<UINT32> PerformWriteTrace(KNOB_MODE_WRITEONCE, "pintool", "w", "0", "Perform write tracing (i.e copy values directly into SST memory operations) (0 = disabled, 1 = enabled)");
 KNOB<UINT32> TrapFunctionProfile(KNOB_MODE_WRITEONCE, "pintool", "t", "0", "Function profiling level (0 = disabled, 1 = enabled)");
+KNOB<UINT32> BatchBlocks(KNOB_MODE_WRITEONCE, "pintool", "b", "0", "Pack each basic block's memory operations into one tunnel record (0 = disabled, 1 = enabled)");
+KNOB<UINT64> SampleFastForward(KNOB_MODE_WRITEONCE, "pintool", "F", "0", "Sampling: instructions to run natively between samples");
+KNOB<UINT64> SampleWarmup(KNOB_MODE_WRITEONCE, "pintool", "W", "0", "Sampling: instructions per sample sent only to warm simulated caches");
+KNOB<UINT64> SampleDetailed(KNOB_MODE_WRITEONCE, "pintool", "D", "0", "Sampling: instructions per sample simulated in detail (0 = sampling disabled)");
 // Memory/malloc/etc. tracking
 KNOB<UINT32> InterceptMemAllocations(KNOB_MODE_WRITEONCE, "pintool", "m", "1", "Should intercept multi-level memory allocations, mallocs, and frees, 1 = start enabled, 0 = start disabled");
 KNOB<string> UseMallocMap(KNOB_MODE_WRITEONCE, "pintool", "u", "", "Should intercept ariel_malloc_flag() and interpret using a malloc map: specify filename or leave blank for disabled");
@@ -115,6 +119,28 @@ std::vector< std::set<ADDRINT> > instPtrsList;
 UINT32 overridePool;
 bool shouldOverride;
 bool writeTrace;
+bool batchBlocks;
+
+/* Per-thread block record being filled when batchBlocks is set */
+struct ArielBlockBuffer {
+    ArielCommand ac;
+    uint64_t lastAddr;
+    uint8_t __pad[64];  // Keep threads' records off each other's cache lines
+};
+ArielBlockBuffer* blockBuffers = NULL;
+
+/* Per-thread position in the fast-forward/warmup/detailed sampling cycle */
+struct ArielSampleState {
+    UINT64 remaining;
+    UINT64 executed;
+    UINT32 phase;
+    uint8_t __pad[64];
+};
+ArielSampleState* sampleStates = NULL;
+bool sampling;
+
+VOID WriteSampleMarker(THREADID thr, UINT32 phase, UINT32 prevPhase, UINT64 insts);
+VOID FlushBlockRecord(THREADID thr);
 
 // For gettimeofday/get_clocktime overrides:
 struct timeval offset_tv;
@@ -288,6 +314,20 @@ VOID Fini(INT32 code, VOID* v)
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    // Send any partially filled block records so no instructions are lost at exit
+    if(batchBlocks) {
+        for(UINT32 i = 0; i < core_count; i++) {
+            FlushBlockRecord(i);
+        }
+    }
+
+    // Report each thread's final window so the simulator can extrapolate over the whole run
+    if(sampling) {
+        for(UINT32 i = 0; i < core_count; i++) {
+            WriteSampleMarker(i, ARIEL_SAMPLE_FASTFORWARD, sampleStates[i].phase, sampleStates[i].executed);
+        }
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
@@ -332,6 +372,190 @@ VOID copy(void* dest, const void* input, UINT32 length)
     }
 }
 
+VOID FlushBlockRecord(THREADID thr)
+{
+    ArielCommand& ac = blockBuffers[thr].ac;
+
+    if(ac.block.instCount > 0) {
+        tunnel->writeMessage(thr, ac);
+        ac.block.instCount = 0;
+        ac.block.length = 0;
+    }
+}
+
+/* Any partially filled block record must go out first so the core sees commands in program order */
+VOID WriteMessage(THREADID thr, const ArielCommand& ac)
+{
+    if(batchBlocks && thr < core_count) {
+        FlushBlockRecord(thr);
+    }
+
+    tunnel->writeMessage(thr, ac);
+}
+
+UINT64 SampleWindow(UINT32 phase)
+{
+    switch(phase) {
+    case ARIEL_SAMPLE_FASTFORWARD:
+        return SampleFastForward.Value();
+    case ARIEL_SAMPLE_WARMUP:
+        return SampleWarmup.Value();
+    default:
+        return SampleDetailed.Value();
+    }
+}
+
+VOID WriteSampleMarker(THREADID thr, UINT32 phase, UINT32 prevPhase, UINT64 insts)
+{
+    ArielCommand ac;
+    ac.command = ARIEL_SAMPLE_PHASE;
+    ac.instPtr = (uint64_t) 0;
+    ac.sample.phase = phase;
+    ac.sample.prevPhase = prevPhase;
+    ac.sample.insts = insts;
+    WriteMessage(thr, ac);
+}
+
+/* Count one instruction against the thread's sampling window, moving to the next
+ * non-empty window when this one is used up. Returns whether the instruction should
+ * be sent to the simulator; fast-forwarded instructions are only counted. */
+bool AdvanceSample(THREADID thr)
+{
+    ArielSampleState& state = sampleStates[thr];
+
+    while(state.remaining == 0) {
+        UINT32 next = ARIEL_SAMPLE_DETAILED;
+        if(state.phase == ARIEL_SAMPLE_FASTFORWARD) {
+            next = (SampleWarmup.Value() > 0) ? ARIEL_SAMPLE_WARMUP : ARIEL_SAMPLE_DETAILED;
+        } else if(state.phase == ARIEL_SAMPLE_DETAILED) {
+            next = (SampleFastForward.Value() > 0) ? ARIEL_SAMPLE_FASTFORWARD :
+                (SampleWarmup.Value() > 0) ? ARIEL_SAMPLE_WARMUP : ARIEL_SAMPLE_DETAILED;
+        }
+
+        WriteSampleMarker(thr, next, state.phase, state.executed);
+        state.phase = next;
+        state.executed = 0;
+        state.remaining = SampleWindow(next);
+    }
+
+    state.remaining--;
+    state.executed++;
+    return state.phase != ARIEL_SAMPLE_FASTFORWARD;
+}
+
+inline bool SampleInstruction(THREADID thr)
+{
+    return !sampling || AdvanceSample(thr);
+}
+
+UINT32 EncodeBlockOp(uint8_t* out, uint64_t addr, UINT32 size, uint64_t* lastAddr)
+{
+    UINT32 len = arielEncodeVarint(out, size);
+    len += arielEncodeVarint(out + len, arielZigZagEncode(addr - *lastAddr));
+    *lastAddr = addr;
+    return len;
+}
+
+VOID AppendBlockInstruction(THREADID thr, ADDRINT ip, UINT32 ops,
+            uint64_t readAddr, UINT32 readSize, uint64_t writeAddr, UINT32 writeSize,
+            UINT32 instClass, UINT32 simdOpWidth)
+{
+    ArielBlockBuffer& buffer = blockBuffers[thr];
+    ArielCommand& ac = buffer.ac;
+
+    if(ac.block.length + ARIEL_MAX_BLOCK_INST_SIZE > ARIEL_MAX_BLOCK_RECORD_SIZE) {
+        FlushBlockRecord(thr);
+    }
+
+    if(ac.block.instCount == 0) {
+        ac.instPtr = (uint64_t) ip;
+        ac.block.baseAddr = (ops & ARIEL_BLOCK_OP_READ) ? readAddr : writeAddr;
+        buffer.lastAddr = ac.block.baseAddr;
+    }
+
+    uint8_t* out = &ac.block.data[ac.block.length];
+    UINT32 len = 1;
+
+    out[0] = (uint8_t) (ops | ((instClass & ARIEL_BLOCK_CLASS_MASK) << ARIEL_BLOCK_CLASS_SHIFT));
+    if(simdOpWidth != 1) {
+        out[0] |= ARIEL_BLOCK_HAS_SIMD;
+        out[len++] = (uint8_t) simdOpWidth;
+    }
+
+    if(ops & ARIEL_BLOCK_OP_READ) {
+        len += EncodeBlockOp(out + len, readAddr, readSize, &buffer.lastAddr);
+    }
+
+    if(ops & ARIEL_BLOCK_OP_WRITE) {
+        len += EncodeBlockOp(out + len, writeAddr, writeSize, &buffer.lastAddr);
+    }
+
+    ac.block.length += len;
+    ac.block.instCount++;
+}
+
+VOID BlockInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
+            ADDRINT* writeAddr, UINT32 writeSize, ADDRINT ip, UINT32 instClass,
+            UINT32 simdOpWidth )
+{
+    if(enable_output) {
+        if(thr < core_count && SampleInstruction(thr)) {
+            AppendBlockInstruction(thr, ip, ARIEL_BLOCK_OP_READ | ARIEL_BLOCK_OP_WRITE,
+                    (uint64_t) readAddr, readSize, (uint64_t) writeAddr, writeSize, instClass, simdOpWidth);
+        }
+    }
+}
+
+VOID BlockInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize, ADDRINT ip,
+            UINT32 instClass, UINT32 simdOpWidth)
+{
+    if(enable_output) {
+        if(thr < core_count && SampleInstruction(thr)) {
+            AppendBlockInstruction(thr, ip, ARIEL_BLOCK_OP_READ,
+                    (uint64_t) readAddr, readSize, 0, 0, instClass, simdOpWidth);
+        }
+    }
+}
+
+VOID BlockInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSize, ADDRINT ip,
+            UINT32 instClass, UINT32 simdOpWidth)
+{
+    if(enable_output) {
+        if(thr < core_count && SampleInstruction(thr)) {
+            AppendBlockInstruction(thr, ip, ARIEL_BLOCK_OP_WRITE,
+                    0, 0, (uint64_t) writeAddr, writeSize, instClass, simdOpWidth);
+        }
+    }
+}
+
+VOID BlockNoOp(THREADID thr, ADDRINT ip)
+{
+    if(enable_output) {
+        if(thr < core_count && SampleInstruction(thr)) {
+            AppendBlockInstruction(thr, ip, 0, 0, 0, 0, 0, ARIEL_INST_UNKNOWN, 1);
+        }
+    }
+}
+
+VOID BlockEnd(THREADID thr)
+{
+    if(thr < core_count) {
+        FlushBlockRecord(thr);
+    }
+}
+
+/* Send the block record at the end of each basic block; runs after the tail's own analysis call */
+VOID InstrumentBlockEnd(TRACE trace, VOID* args)
+{
+    for (BBL bbl = TRACE_BblHead(trace); BBL_Valid(bbl); bbl = BBL_Next(bbl)) {
+        INS_InsertCall(BBL_InsTail(bbl), IPOINT_BEFORE, (AFUNPTR)
+                BlockEnd,
+                IARG_CALL_ORDER, CALL_ORDER_LAST,
+                IARG_THREAD_ID,
+                IARG_END);
+    }
+}
+
 VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
 {
     ArielCommand ac;
@@ -339,7 +563,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -348,7 +572,7 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
@@ -366,7 +590,7 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
     ac.inst.instClass = instClass;
     ac.inst.simdElemCount = simdOpWidth;
 
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
@@ -398,7 +622,7 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     }
     printf("\n");
 */
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -406,7 +630,7 @@ VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
     ArielCommand ac;
     ac.command = ARIEL_START_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -414,7 +638,7 @@ VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
     ArielCommand ac;
     ac.command = ARIEL_END_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -423,7 +647,7 @@ VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 {
 
     if(enable_output) {
-        if(thr < core_count) {
+        if(thr < core_count && SampleInstruction(thr)) {
             WriteStartInstructionMarker( thr, ip );
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             WriteInstructionWrite( writeAddr, writeSize, thr, ip, instClass, simdOpWidth );
@@ -437,7 +661,7 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 {
 
     if(enable_output) {
-        if(thr < core_count) {
+        if(thr < core_count && SampleInstruction(thr)) {
             WriteStartInstructionMarker(thr, ip);
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             WriteEndInstructionMarker(thr, ip);
@@ -449,11 +673,11 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
-        if(thr < core_count) {
+        if(thr < core_count && SampleInstruction(thr)) {
             ArielCommand ac;
             ac.command = ARIEL_NOOP;
             ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            WriteMessage(thr, ac);
         }
     }
 }
@@ -463,7 +687,7 @@ VOID WriteInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSiz
 {
 
     if(enable_output) {
-        if(thr < core_count) {
+        if(thr < core_count && SampleInstruction(thr)) {
             WriteStartInstructionMarker(thr, ip);
             WriteInstructionWrite(writeAddr, writeSize,  thr, ip, instClass, simdOpWidth);
             WriteEndInstructionMarker(thr, ip);
@@ -545,7 +769,7 @@ VOID InstrumentInstruction(INS ins, VOID *v)
 
     if( INS_IsMemoryRead(ins) && INS_IsMemoryWrite(ins) ) {
         INS_InsertPredicatedCall(ins, IPOINT_BEFORE, (AFUNPTR)
-                WriteInstructionReadWrite,
+                (batchBlocks ? BlockInstructionReadWrite : WriteInstructionReadWrite),
                 IARG_THREAD_ID,
                 IARG_MEMORYREAD_EA, IARG_UINT32, INS_MemoryReadSize(ins),
                 IARG_MEMORYWRITE_EA, IARG_UINT32, INS_MemoryWriteSize(ins),
@@ -555,7 +779,7 @@ VOID InstrumentInstruction(INS ins, VOID *v)
                 IARG_END);
     } else if( INS_IsMemoryRead(ins) ) {
         INS_InsertPredicatedCall(ins, IPOINT_BEFORE, (AFUNPTR)
-                WriteInstructionReadOnly,
+                (batchBlocks ? BlockInstructionReadOnly : WriteInstructionReadOnly),
                 IARG_THREAD_ID,
                 IARG_MEMORYREAD_EA, IARG_UINT32, INS_MemoryReadSize(ins),
                 IARG_INST_PTR,
@@ -564,7 +788,7 @@ VOID InstrumentInstruction(INS ins, VOID *v)
                 IARG_END);
     } else if( INS_IsMemoryWrite(ins) ) {
         INS_InsertPredicatedCall(ins, IPOINT_BEFORE, (AFUNPTR)
-                WriteInstructionWriteOnly,
+                (batchBlocks ? BlockInstructionWriteOnly : WriteInstructionWriteOnly),
                 IARG_THREAD_ID,
                 IARG_MEMORYWRITE_EA, IARG_UINT32, INS_MemoryWriteSize(ins),
                 IARG_INST_PTR,
@@ -573,7 +797,7 @@ VOID InstrumentInstruction(INS ins, VOID *v)
                 IARG_END);
     } else {
         INS_InsertPredicatedCall(ins, IPOINT_BEFORE, (AFUNPTR)
-                WriteNoOp,
+                (batchBlocks ? BlockNoOp : WriteNoOp),
                 IARG_THREAD_ID,
                 IARG_INST_PTR,
                 IARG_END);
@@ -711,7 +935,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -721,7 +945,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -775,7 +999,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -803,7 +1027,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -858,7 +1082,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -916,7 +1140,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -961,7 +1185,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteMessage(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1013,14 +1237,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteMessage(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteMessage(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteMessage(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1047,7 +1271,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1077,7 +1301,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1118,7 +1342,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1183,7 +1407,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1312,7 +1536,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1360,7 +1584,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1385,7 +1609,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1409,7 +1633,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1432,7 +1656,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1471,7 +1695,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1507,7 +1731,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1535,7 +1759,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteMessage(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1818,6 +2042,34 @@ int main(int argc, char *argv[])
     core_count = MaxCoreCount.Value();
     instrument_instructions = InstrumentInstructions.Value();
 
+    batchBlocks = (BatchBlocks.Value() > 0);
+    if( batchBlocks && writeTrace ) {
+        fprintf(stderr, "ARIEL-SST: Block batching does not carry write payloads, disabling it for write tracing\n");
+        batchBlocks = false;
+    }
+
+    sampling = (SampleDetailed.Value() > 0);
+    if( sampling ) {
+        fprintf(stderr, "ARIEL-SST: Sampling with %" PRIu64 " fast-forward, %" PRIu64 " warmup and %" PRIu64 " detailed instructions per thread\n",
+                (uint64_t) SampleFastForward.Value(), (uint64_t) SampleWarmup.Value(), (uint64_t) SampleDetailed.Value());
+        sampleStates = new ArielSampleState[core_count];
+        for(unsigned int i = 0; i < core_count; i++) {
+            sampleStates[i].phase = ARIEL_SAMPLE_FASTFORWARD;
+            sampleStates[i].remaining = SampleFastForward.Value();
+            sampleStates[i].executed = 0;
+        }
+    }
+
+    if( batchBlocks ) {
+        blockBuffers = new ArielBlockBuffer[core_count];
+        for(unsigned int i = 0; i < core_count; i++) {
+            blockBuffers[i].ac.command = ARIEL_PERFORM_BLOCK;
+            blockBuffers[i].ac.block.instCount = 0;
+            blockBuffers[i].ac.block.length = 0;
+            blockBuffers[i].lastAddr = 0;
+        }
+    }
+
     tunnelmgr = new SST::Core::Interprocess::SHMChild<ArielTunnel>(SSTNamedPipe.Value());
     tunnel = tunnelmgr->getTunnel();
 #ifdef HAVE_CUDA
@@ -1891,6 +2143,9 @@ int main(int argc, char *argv[])
 
     if(instrument_instructions){
         INS_AddInstrumentFunction(InstrumentInstruction, 0);
+
+        if(batchBlocks)
+            TRACE_AddInstrumentFunction(InstrumentBlockEnd, 0);
     }
 
     RTN_AddInstrumentFunction(InstrumentRoutine, 0);
@@ -63,7 +63,11 @@ class Pin2Frontend : public ArielFrontend {
         {"mallocmapfile", "File with valid 'ariel_malloc_flag' ids", ""},
         {"tracePrefix", "Prefix when tracing is enable", ""},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
-        {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"})
+        {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
+        {"batchblocks", "Pack the memory operations of each basic block into a single delta-encoded tunnel record (ignored when writepayloadtrace is set)", "0"},
+        {"sample_fastforward", "Sampled execution: instructions each thread runs natively between samples", "0"},
+        {"sample_warmup", "Sampled execution: instructions per sample that only warm caches and translation state ahead of the detailed window", "0"},
+        {"sample_detailed", "Sampled execution: instructions per sample simulated in detail, 0 disables sampling", "0"})
 
         /* Ariel class */
         Pin2Frontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
@@ -26,7 +26,7 @@ using namespace SST::MemHierarchy;
 using namespace SST::Cassini;
 
 
-NextBlockPrefetcher::NextBlockPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+NextBlockPrefetcher::NextBlockPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params), throttle(params, 1, 1) {
     Simulation::getSimulation()->requireEvent("memHierarchy.MemEvent");
 
     blockSize = params.find<uint64_t>("cache_line_size", 64);
@@ -34,6 +34,13 @@ NextBlockPrefetcher::NextBlockPrefetcher(ComponentId_t id, Params& params) : Cac
     statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
     statMissEventsProcessed  = registerStatistic<uint64_t>("miss_events_processed");
     statHitEventsProcessed   = registerStatistic<uint64_t>("hit_events_processed");
+
+    if (throttle.isAdaptive()) {
+        throttle.setStatistics(registerStatistic<uint64_t>("prefetches_useful"), registerStatistic<uint64_t>("prefetches_late"),
+                registerStatistic<uint64_t>("prefetches_useless"), registerStatistic<uint64_t>("prefetches_redundant"),
+                registerStatistic<uint64_t>("prefetches_dropped"), registerStatistic<uint64_t>("prefetch_degree"),
+                registerStatistic<uint64_t>("prefetch_distance"));
+    }
 }
 
 NextBlockPrefetcher::~NextBlockPrefetcher() {}
@@ -47,18 +54,20 @@ void NextBlockPrefetcher::notifyAccess(const CacheListenerNotification& notify)
         if(notifyResType == MISS) {
             statMissEventsProcessed->addData(1);
 
-            Addr nextBlockAddr = (addr - (addr % blockSize)) + blockSize;
-            std::vector<Event::HandlerBase*>::iterator callbackItr;
-            statPrefetchEventsIssued->addData(1);
-
-            // Cycle over each registered call back and notify them that we want to issue a prefetch request
-            for(callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
-                // Create a new read request, we cannot issue a write because the data will get
-                // overwritten and corrupt memory (even if we really do want to do a write)
-                MemEvent* newEv = new MemEvent(getName(), nextBlockAddr, nextBlockAddr, Command::GetS);
-                newEv->setSize(blockSize);
-                newEv->setPrefetchFlag(true);
-                (*(*callbackItr))(newEv);
+            for (uint32_t i = 0; i < throttle.degree(); i++) {
+                Addr nextBlockAddr = (addr - (addr % blockSize)) + (throttle.distance() + i) * blockSize;
+                std::vector<Event::HandlerBase*>::iterator callbackItr;
+                statPrefetchEventsIssued->addData(1);
+
+                // Cycle over each registered call back and notify them that we want to issue a prefetch request
+                for(callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+                    // Create a new read request, we cannot issue a write because the data will get
+                    // overwritten and corrupt memory (even if we really do want to do a write)
+                    MemEvent* newEv = new MemEvent(getName(), nextBlockAddr, nextBlockAddr, Command::GetS);
+                    newEv->setSize(blockSize);
+                    newEv->setPrefetchFlag(true);
+                    (*(*callbackItr))(newEv);
+                }
             }
         } else {
             statHitEventsProcessed->addData(1);
@@ -66,6 +75,10 @@ void NextBlockPrefetcher::notifyAccess(const CacheListenerNotification& notify)
     }
 }
 
+void NextBlockPrefetcher::notifyPrefetchResult(Addr addr, PrefetchResult result) {
+    throttle.record(result);
+}
+
 void NextBlockPrefetcher::registerResponseCallback(Event::HandlerBase *handler) {
     registeredCallbacks.push_back(handler);
 }
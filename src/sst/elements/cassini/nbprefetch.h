@@ -27,6 +27,8 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 #include <sst/elements/memHierarchy/cacheListener.h>
 
+#include "prefetchThrottle.h"
+
 using namespace SST;
 using namespace SST::MemHierarchy;
 using namespace std;
@@ -40,6 +42,7 @@ public:
     ~NextBlockPrefetcher();
 
     void notifyAccess(const CacheListenerNotification& notify);
+    void notifyPrefetchResult(Addr addr, PrefetchResult result);
     void registerResponseCallback(Event::HandlerBase *handler);
     void printStats(Output& out);
 
@@ -53,18 +56,21 @@ public:
     )
 
     SST_ELI_DOCUMENT_PARAMS(
-        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" }
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        CASSINI_THROTTLE_ELI_PARAMS
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
         { "miss_events_processed", "Number of cache misses received", "misses", 2 },
-        { "hit_events_processed", "Number of cache hits received", "hits", 2 }
+        { "hit_events_processed", "Number of cache hits received", "hits", 2 },
+        CASSINI_THROTTLE_ELI_STATS
     )
 
 private:
     std::vector<Event::HandlerBase*> registeredCallbacks;
     uint64_t blockSize;
+    PrefetchThrottle throttle;  // Degree: blocks per miss, distance: blocks ahead of the miss
 
     Statistic<uint64_t>* statPrefetchEventsIssued;
     Statistic<uint64_t>* statMissEventsProcessed;
@@ -0,0 +1,189 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_CASSINI_PREFETCH_THROTTLE
+#define _H_SST_CASSINI_PREFETCH_THROTTLE
+
+#include <algorithm>
+
+#include <sst/core/params.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+namespace SST {
+namespace Cassini {
+
+#define CASSINI_THROTTLE_ELI_PARAMS \
+    { "max_degree", "Adaptive: maximum prefetches per trigger", "4" }, \
+    CASSINI_THROTTLE_ELI_PARAMS_NO_MAX_DEGREE
+
+/* For prefetchers with a different max_degree default, which document it themselves */
+#define CASSINI_THROTTLE_ELI_PARAMS_NO_MAX_DEGREE \
+    { "adaptive", "Adjust prefetch degree and distance using feedback from the cache (0 or 1)", "0" }, \
+    { "min_degree", "Adaptive: minimum prefetches per trigger", "1" }, \
+    { "max_distance", "Adaptive: maximum prefetch distance, in the prefetcher's distance units", "16" }, \
+    { "feedback_interval", "Adaptive: number of prefetch outcomes between adjustments", "256" }, \
+    { "accuracy_high", "Adaptive: accuracy above which the prefetcher becomes more aggressive", "0.75" }, \
+    { "accuracy_low", "Adaptive: accuracy below which the prefetcher becomes less aggressive", "0.40" }, \
+    { "lateness_threshold", "Adaptive: fraction of useful prefetches arriving late above which distance increases", "0.10" }
+
+/* Registered only if adaptive is set */
+#define CASSINI_THROTTLE_ELI_STATS \
+    { "prefetches_useful", "Prefetched lines hit by a demand access", "prefetches", 2 }, \
+    { "prefetches_late", "Prefetches a demand access had to wait for", "prefetches", 2 }, \
+    { "prefetches_useless", "Prefetched lines evicted or invalidated without use", "prefetches", 2 }, \
+    { "prefetches_redundant", "Prefetches for lines already in the cache", "prefetches", 2 }, \
+    { "prefetches_dropped", "Prefetches the cache could not issue", "prefetches", 2 }, \
+    { "prefetch_degree", "Prefetch degree, sampled at each adjustment", "prefetches", 3 }, \
+    { "prefetch_distance", "Prefetch distance, sampled at each adjustment", "distance", 3 }
+
+/*
+ * Feedback-directed throttling shared by the Cassini prefetchers.
+ *
+ * The cache reports each prefetch's outcome through
+ * CacheListener::notifyPrefetchResult. Every feedback_interval outcomes the
+ * throttle computes accuracy (useful / (useful + useless + redundant)) and
+ * lateness (late / useful) and steps the degree and distance by one:
+ *  - accurate and late: increase distance
+ *  - accurate and timely: increase degree
+ *  - inaccurate, or many prefetches dropped: decrease degree and distance
+ * Counts are halved after each adjustment so older intervals still count
+ * but fade. With adaptive off the prefetcher's configured degree and
+ * distance are used unchanged.
+ */
+class PrefetchThrottle {
+public:
+    PrefetchThrottle(Params& params, uint32_t degree, uint32_t distance, uint32_t defaultMaxDegree = 4) :
+        useful(0), late(0), useless(0), redundant(0), dropped(0), outcomes(0),
+        statUseful(nullptr), statLate(nullptr), statUseless(nullptr), statRedundant(nullptr),
+        statDropped(nullptr), statDegree(nullptr), statDistance(nullptr)
+    {
+        adaptive = params.find<uint32_t>("adaptive", 0) != 0;
+        minDegree = params.find<uint32_t>("min_degree", 1);
+        maxDegree = params.find<uint32_t>("max_degree", defaultMaxDegree);
+        minDistance = std::min<uint32_t>(1, distance);
+        maxDistance = params.find<uint32_t>("max_distance", 16);
+        interval = params.find<uint32_t>("feedback_interval", 256);
+        accuracyHigh = params.find<double>("accuracy_high", 0.75);
+        accuracyLow = params.find<double>("accuracy_low", 0.40);
+        latenessThreshold = params.find<double>("lateness_threshold", 0.10);
+
+        if (minDegree == 0) minDegree = 1;
+        if (maxDegree < minDegree) maxDegree = minDegree;
+        if (maxDistance < minDistance) maxDistance = minDistance;
+        if (interval == 0) interval = 1;
+
+        curDegree = adaptive ? std::max(minDegree, std::min(degree, maxDegree)) : degree;
+        curDistance = distance;
+    }
+
+    bool isAdaptive() const { return adaptive; }
+    uint32_t degree() const { return curDegree; }
+    uint32_t distance() const { return curDistance; }
+
+    void setStatistics(Statistic<uint64_t>* usefulS, Statistic<uint64_t>* lateS, Statistic<uint64_t>* uselessS,
+            Statistic<uint64_t>* redundantS, Statistic<uint64_t>* droppedS, Statistic<uint64_t>* degreeS, Statistic<uint64_t>* distanceS) {
+        statUseful = usefulS;
+        statLate = lateS;
+        statUseless = uselessS;
+        statRedundant = redundantS;
+        statDropped = droppedS;
+        statDegree = degreeS;
+        statDistance = distanceS;
+    }
+
+    void record(SST::MemHierarchy::PrefetchResult result) {
+        if (!adaptive)
+            return;
+
+        switch (result) {
+            case SST::MemHierarchy::PrefetchResult::Useful:
+                useful++;
+                statUseful->addData(1);
+                break;
+            case SST::MemHierarchy::PrefetchResult::Late:
+                late++;
+                statLate->addData(1);
+                break;
+            case SST::MemHierarchy::PrefetchResult::Useless:
+                useless++;
+                statUseless->addData(1);
+                break;
+            case SST::MemHierarchy::PrefetchResult::Redundant:
+                redundant++;
+                statRedundant->addData(1);
+                break;
+            case SST::MemHierarchy::PrefetchResult::Dropped:
+                dropped++;
+                statDropped->addData(1);
+                break;
+        }
+
+        if (++outcomes == interval)
+            adjust();
+    }
+
+private:
+    void adjust() {
+        uint64_t resolved = useful + useless + redundant;
+        double accuracy = resolved ? (double)useful / resolved : 1.0;
+        double lateness = useful ? (double)late / useful : 0.0;
+        bool congested = dropped * 2 > interval;
+
+        if (accuracy < accuracyLow || congested) {
+            if (curDegree > minDegree) curDegree--;
+            if (curDistance > minDistance) curDistance--;
+        } else if (accuracy >= accuracyHigh) {
+            if (lateness >= latenessThreshold && curDistance < maxDistance)
+                curDistance++;
+            else if (curDegree < maxDegree)
+                curDegree++;
+        } else if (lateness >= latenessThreshold && curDistance < maxDistance) {
+            curDistance++;
+        }
+
+        statDegree->addData(curDegree);
+        statDistance->addData(curDistance);
+
+        useful /= 2;
+        late /= 2;
+        useless /= 2;
+        redundant /= 2;
+        dropped /= 2;
+        outcomes = 0;
+    }
+
+    bool adaptive;
+    uint32_t curDegree, minDegree, maxDegree;
+    uint32_t curDistance, minDistance, maxDistance;
+    uint32_t interval;
+    double accuracyHigh, accuracyLow, latenessThreshold;
+
+    uint64_t useful, late, useless, redundant, dropped;
+    uint32_t outcomes;
+
+    Statistic<uint64_t>* statUseful;
+    Statistic<uint64_t>* statLate;
+    Statistic<uint64_t>* statUseless;
+    Statistic<uint64_t>* statRedundant;
+    Statistic<uint64_t>* statDropped;
+    Statistic<uint64_t>* statDegree;
+    Statistic<uint64_t>* statDistance;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -0,0 +1,236 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "smsprefetch.h"
+
+#include <stdint.h>
+#include <vector>
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+SMSPrefetcher::SMSPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    Simulation::getSimulation()->requireEvent("memHierarchy.MemEvent");
+
+    int verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    sprintf(new_prefix, "SMSPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    regionSize = params.find<uint64_t>("region_size", 2048);
+    uint32_t agtEntries = params.find<uint32_t>("agt_entries", 32);
+    uint32_t phtEntries = params.find<uint32_t>("pht_entries", 1024);
+    phtAssoc = params.find<uint32_t>("pht_associativity", 4);
+
+    if (blockSize == 0 || regionSize < blockSize || regionSize % blockSize != 0 || regionSize / blockSize > 64) {
+        output->fatal(CALL_INFO, -1, "%s, Error: region_size (%" PRIu64 ") must be a multiple of cache_line_size (%" PRIu64 ") covering 1 to 64 lines\n",
+                getName().c_str(), regionSize, blockSize);
+    }
+    if (agtEntries == 0) {
+        output->fatal(CALL_INFO, -1, "%s, Error: agt_entries must be at least 1\n", getName().c_str());
+    }
+    if (phtAssoc == 0 || phtEntries < phtAssoc || phtEntries % phtAssoc != 0) {
+        output->fatal(CALL_INFO, -1, "%s, Error: pht_entries (%" PRIu32 ") must be a non-zero multiple of pht_associativity (%" PRIu32 ")\n",
+                getName().c_str(), phtEntries, phtAssoc);
+    }
+
+    linesPerRegion = regionSize / blockSize;
+    phtSets = phtEntries / phtAssoc;
+    timestamp = 0;
+
+    AGTEntry agtInit = { false, 0, 0, 0, 0, 0 };
+    agt.assign(agtEntries, agtInit);
+    PHTEntry phtInit = { false, 0, 0, 0 };
+    pht.assign(phtEntries, phtInit);
+
+    // A footprint can cover the whole region, so the degree may grow back to it
+    throttle = new PrefetchThrottle(params, linesPerRegion, 0, linesPerRegion);
+
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statTriggerAccesses = registerStatistic<uint64_t>("trigger_accesses");
+    statPatternHits = registerStatistic<uint64_t>("pattern_hits");
+    statGenerationsRecorded = registerStatistic<uint64_t>("generations_recorded");
+
+    if (throttle->isAdaptive()) {
+        throttle->setStatistics(registerStatistic<uint64_t>("prefetches_useful"), registerStatistic<uint64_t>("prefetches_late"),
+                registerStatistic<uint64_t>("prefetches_useless"), registerStatistic<uint64_t>("prefetches_redundant"),
+                registerStatistic<uint64_t>("prefetches_dropped"), registerStatistic<uint64_t>("prefetch_degree"),
+                registerStatistic<uint64_t>("prefetch_distance"));
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "SMSPrefetcher created, cache line: %" PRIu64 ", region: %" PRIu64 ", AGT entries: %" PRIu32 ", PHT: %" PRIu32 " sets x %" PRIu32 " ways\n",
+        blockSize, regionSize, agtEntries, phtSets, phtAssoc);
+}
+
+SMSPrefetcher::~SMSPrefetcher() {
+    delete throttle;
+    delete output;
+}
+
+void SMSPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const Addr addr = notify.getPhysicalAddress();
+    const Addr region = addr / regionSize;
+    const uint32_t offset = (addr % regionSize) / blockSize;
+
+    AGTEntry* entry = findGeneration(region);
+
+    if (notifyType == EVICT) {
+        // Losing any line of the region ends its generation
+        if (entry) {
+            commitGeneration(entry);
+            entry->valid = false;
+        }
+        return;
+    }
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    timestamp++;
+
+    if (entry) {
+        entry->pattern |= (uint64_t)1 << offset;
+        entry->lastUse = timestamp;
+        return;
+    }
+
+    // Trigger access: predict this region's footprint from the PHT
+    statTriggerAccesses->addData(1);
+    const Addr pc = notify.getInstructionPointer();
+    uint64_t pattern;
+
+    if (lookupPattern(patternKey(pc, offset), pattern)) {
+        statPatternHits->addData(1);
+
+        // Issue in order of distance past the trigger, wrapping to the lines before it
+        uint32_t issued = 0;
+        const Addr regionBase = region * regionSize;
+        for (uint32_t i = 1; i < linesPerRegion && issued < throttle->degree(); i++) {
+            uint32_t line = (offset + i) % linesPerRegion;
+            if (pattern & ((uint64_t)1 << line)) {
+                issuePrefetch(regionBase + line * blockSize);
+                issued++;
+            }
+        }
+    }
+
+    // Start a new generation, displacing the least recently used one
+    AGTEntry* victim = &agt[0];
+    for (std::vector<AGTEntry>::iterator it = agt.begin(); it != agt.end(); it++) {
+        if (!it->valid) {
+            victim = &(*it);
+            break;
+        }
+        if (it->lastUse < victim->lastUse)
+            victim = &(*it);
+    }
+    if (victim->valid)
+        commitGeneration(victim);
+
+    victim->valid = true;
+    victim->region = region;
+    victim->pc = pc;
+    victim->triggerOffset = offset;
+    victim->pattern = (uint64_t)1 << offset;
+    victim->lastUse = timestamp;
+}
+
+SMSPrefetcher::AGTEntry* SMSPrefetcher::findGeneration(Addr region) {
+    for (std::vector<AGTEntry>::iterator it = agt.begin(); it != agt.end(); it++) {
+        if (it->valid && it->region == region)
+            return &(*it);
+    }
+    return nullptr;
+}
+
+/* Record a generation's footprint; a region touched only by its trigger predicts nothing */
+void SMSPrefetcher::commitGeneration(AGTEntry* entry) {
+    if (__builtin_popcountll(entry->pattern) < 2)
+        return;
+
+    const uint64_t key = patternKey(entry->pc, entry->triggerOffset);
+    PHTEntry* set = &pht[(key % phtSets) * phtAssoc];
+    PHTEntry* victim = nullptr;
+
+    // Overwrite an older footprint for the same key, else fill an empty way, else replace the LRU way
+    for (uint32_t way = 0; way < phtAssoc; way++) {
+        if (set[way].valid && set[way].key == key) {
+            victim = &set[way];
+            break;
+        }
+        if (!victim || (victim->valid && (!set[way].valid || set[way].lastUse < victim->lastUse)))
+            victim = &set[way];
+    }
+
+    victim->valid = true;
+    victim->key = key;
+    victim->pattern = entry->pattern;
+    victim->lastUse = timestamp;
+    statGenerationsRecorded->addData(1);
+}
+
+uint64_t SMSPrefetcher::patternKey(Addr pc, uint32_t offset) const {
+    uint64_t key = (pc * linesPerRegion + offset) * 0x9E3779B97F4A7C15ULL;
+    return key ^ (key >> 29);
+}
+
+bool SMSPrefetcher::lookupPattern(uint64_t key, uint64_t& pattern) {
+    PHTEntry* set = &pht[(key % phtSets) * phtAssoc];
+    for (uint32_t way = 0; way < phtAssoc; way++) {
+        if (set[way].valid && set[way].key == key) {
+            set[way].lastUse = timestamp;
+            pattern = set[way].pattern;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SMSPrefetcher::issuePrefetch(Addr addr) {
+    std::vector<Event::HandlerBase*>::iterator callbackItr;
+    statPrefetchEventsIssued->addData(1);
+
+    output->verbose(CALL_INFO, 2, 0, "Issue prefetch, address: %" PRIx64 "\n", addr);
+
+    // Cycle over each registered call back and notify them that we want to issue a prefetch request
+    for(callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+        // Create a new read request, we cannot issue a write because the data will get
+        // overwritten and corrupt memory (even if we really do want to do a write)
+        MemEvent* newEv = new MemEvent(getName(), addr, addr, Command::GetS);
+        newEv->setSize(blockSize);
+        newEv->setPrefetchFlag(true);
+        (*(*callbackItr))(newEv);
+    }
+}
+
+void SMSPrefetcher::notifyPrefetchResult(Addr addr, PrefetchResult result) {
+    throttle->record(result);
+}
+
+void SMSPrefetcher::registerResponseCallback(Event::HandlerBase *handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void SMSPrefetcher::printStats(Output &out) {
+
+}
@@ -0,0 +1,137 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_SMS_PREFETCH
+#define _H_SST_SMS_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include "prefetchThrottle.h"
+
+#include <sst/core/output.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Spatial memory streaming prefetcher.
+ *
+ * Memory is divided into fixed size regions. The first access to an inactive
+ * region (the trigger) starts a generation in the active generation table,
+ * which records a bit for each line of the region touched until one of the
+ * region's lines is evicted or the entry is displaced. The footprint is then
+ * stored in the pattern history table, indexed by the trigger's PC and offset
+ * within the region. A later trigger with the same PC and offset prefetches
+ * the stored footprint in the new region.
+ */
+class SMSPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    SMSPrefetcher(ComponentId_t id, Params& params);
+    ~SMSPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void notifyPrefetchResult(Addr addr, PrefetchResult result);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        SMSPrefetcher,
+        "cassini",
+        "SMSPrefetcher",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Spatial Memory Streaming Prefetcher",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "region_size", "Size of a spatial region in bytes, at most 64 cache lines", "2048" },
+        { "agt_entries", "Number of regions tracked concurrently by the active generation table", "32" },
+        { "pht_entries", "Number of footprints held by the pattern history table", "1024" },
+        { "pht_associativity", "Associativity of the pattern history table", "4" },
+        { "max_degree", "Adaptive: maximum lines prefetched per trigger", "lines per region" },
+        CASSINI_THROTTLE_ELI_PARAMS_NO_MAX_DEGREE
+    )
+
+    /* Only the degree (lines prefetched per trigger) is throttled; without adaptive the whole footprint is prefetched */
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
+        { "trigger_accesses", "Accesses that started a new region generation", "accesses", 2 },
+        { "pattern_hits", "Trigger accesses that found a footprint in the pattern history table", "accesses", 2 },
+        { "generations_recorded", "Footprints written to the pattern history table", "generations", 2 },
+        CASSINI_THROTTLE_ELI_STATS
+    )
+
+private:
+    struct AGTEntry {
+        bool valid;
+        Addr region;
+        Addr pc;
+        uint32_t triggerOffset;
+        uint64_t pattern;
+        uint64_t lastUse;
+    };
+
+    struct PHTEntry {
+        bool valid;
+        uint64_t key;
+        uint64_t pattern;
+        uint64_t lastUse;
+    };
+
+    AGTEntry* findGeneration(Addr region);
+    void commitGeneration(AGTEntry* entry);
+    uint64_t patternKey(Addr pc, uint32_t offset) const;
+    bool lookupPattern(uint64_t key, uint64_t& pattern);
+    void issuePrefetch(Addr addr);
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+    uint64_t blockSize;
+    uint64_t regionSize;
+    uint32_t linesPerRegion;
+
+    std::vector<AGTEntry> agt;
+    std::vector<PHTEntry> pht;
+    uint32_t phtSets;
+    uint32_t phtAssoc;
+    uint64_t timestamp;
+
+    PrefetchThrottle* throttle;
+
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statTriggerAccesses;
+    Statistic<uint64_t>* statPatternHits;
+    Statistic<uint64_t>* statGenerationsRecorded;
+};
+
+}
+}
+
+#endif
@@ -58,6 +58,7 @@ void StridePrefetcher::DetectStride() {
     bool foundStride = true;
     Addr targetAddress = 0;
     uint32_t strideIndex;
+    const uint32_t reach = throttle->distance();
 
     for(uint32_t i = 0; i < recentAddrListCount - 1; ++i) {
         for(uint32_t j = i + 1; j < recentAddrListCount; ++j) {
@@ -75,21 +76,21 @@ void StridePrefetcher::DetectStride() {
             }
 
             if(foundStride) {
-                Addr targetPrefetchAddress = targetAddress + (strideReach * stride);
+                Addr targetPrefetchAddress = targetAddress + (reach * stride);
                 targetPrefetchAddress = targetPrefetchAddress - (targetPrefetchAddress % blockSize);
 
                 if(overrunPageBoundary) {
                         output->verbose(CALL_INFO, 2, 0,
                             "Issue prefetch, target address: %" PRIx64 ", prefetch address: %" PRIx64 " (reach out: %" PRIu32 ", stride=%" PRIu32 "), prefetchAddress=%" PRIu64 "\n",
-                            targetAddress, targetAddress + (strideReach * stride),
-                            (strideReach * stride), stride, targetPrefetchAddress);
+                            targetAddress, targetAddress + (reach * stride),
+                            (reach * stride), stride, targetPrefetchAddress);
 
                         statPrefetchOpportunities->addData(1);
 
                         // Check next address is aligned to a cache line boundary
-                        assert((targetAddress + (strideReach * stride)) % blockSize == 0);
+                        assert((targetAddress + (reach * stride)) % blockSize == 0);
 
-                        ev = new MemEvent(getName(), targetAddress + (strideReach * stride), targetAddress + (strideReach * stride), Command::GetS);
+                        ev = new MemEvent(getName(), targetAddress + (reach * stride), targetAddress + (reach * stride), Command::GetS);
                 } else {
                         const Addr targetAddressPhysPage = targetAddress / pageSize;
                         const Addr targetPrefetchAddressPage = targetPrefetchAddress / pageSize;
@@ -102,7 +103,7 @@ void StridePrefetcher::DetectStride() {
                         // choose to not prefetch the address
                         if(targetAddressPhysPage == targetPrefetchAddressPage) {
                             output->verbose(CALL_INFO, 2, 0, "Issue prefetch, target address: %" PRIx64 ", prefetch address: %" PRIx64 " (reach out: %" PRIu32 ", stride=%" PRIu32 ")\n",
-                                    targetAddress, targetPrefetchAddress, (strideReach * stride), stride);
+                                    targetAddress, targetPrefetchAddress, (reach * stride), stride);
                             ev = new MemEvent(getName(), targetPrefetchAddress, targetPrefetchAddress, Command::GetS);
                             statPrefetchOpportunities->addData(1);
                         } else {
@@ -124,52 +125,67 @@ void StridePrefetcher::DetectStride() {
     }
 
     if(ev != NULL) {
-        std::vector<Event::HandlerBase*>::iterator callbackItr;
+        issuePrefetch(ev->getAddr());
+        delete ev;
 
-        Addr prefetchCacheLineBase = ev->getAddr() - (ev->getAddr() % blockSize);
-        bool inHistory = false;
-        const uint32_t currentHistCount = prefetchHistory->size();
+        // When the throttle raises the degree, continue along the stride past the first prefetch
+        for(uint32_t d = 1; d < throttle->degree(); ++d) {
+            Addr nextAddress = targetAddress + ((reach + d) * stride);
+            nextAddress = nextAddress - (nextAddress % blockSize);
 
-        output->verbose(CALL_INFO, 2, 0, "Checking prefetch history for cache line at base %" PRIx64 ", valid prefetch history entries=%" PRIu32 "\n", prefetchCacheLineBase,
-            currentHistCount);
-
-        for(uint32_t i = 0; i < currentHistCount; ++i) {
-            if(prefetchHistory->at(i) == prefetchCacheLineBase) {
-                    inHistory = true;
-                    break;
+            if(!overrunPageBoundary && (nextAddress / pageSize) != (targetAddress / pageSize)) {
+                statPrefetchIssueCanceledByPageBoundary->addData(1);
+                break;
             }
+
+            issuePrefetch(nextAddress);
         }
+    }
+}
 
-        if(! inHistory) {
-            statPrefetchEventsIssued->addData(1);
+void StridePrefetcher::issuePrefetch(Addr addr) {
+    std::vector<Event::HandlerBase*>::iterator callbackItr;
 
-            // Remove the oldest cache line
-            if(currentHistCount == prefetchHistoryCount) {
-                    prefetchHistory->pop_front();
-            }
+    Addr prefetchCacheLineBase = addr - (addr % blockSize);
+    bool inHistory = false;
+    const uint32_t currentHistCount = prefetchHistory.size();
 
-            // Put the cache line at the back of the queue
-            prefetchHistory->push_back(prefetchCacheLineBase);
+    output->verbose(CALL_INFO, 2, 0, "Checking prefetch history for cache line at base %" PRIx64 ", valid prefetch history entries=%" PRIu32 "\n", prefetchCacheLineBase,
+        currentHistCount);
 
-            assert((ev->getAddr() % blockSize) == 0);
+    for(uint32_t i = 0; i < currentHistCount; ++i) {
+        if(prefetchHistory[i] == prefetchCacheLineBase) {
+                inHistory = true;
+                break;
+        }
+    }
 
-                // Cycle over each registered call back and notify them that we want to issue a prefet$
-                for(callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
-                    // Create a new read request, we cannot issue a write because the data will get
-                    // overwritten and corrupt memory (even if we really do want to do a write)
-                    MemEvent* newEv = new MemEvent(getName(), ev->getAddr(), ev->getAddr(), Command::GetS);
-                        newEv->setSize(blockSize);
-                        newEv->setPrefetchFlag(true);
+    if(! inHistory) {
+        statPrefetchEventsIssued->addData(1);
 
-                (*(*callbackItr))(newEv);
-                }
-
-            delete ev;
-        } else {
-            statPrefetchIssueCanceledByHistory->addData(1);
-            output->verbose(CALL_INFO, 2, 0, "Prefetch canceled - same cache line is found in the recent prefetch history.\n");
-                delete ev;
+        // Replace the oldest cache line once the history is full
+        if(currentHistCount < prefetchHistoryCount) {
+                prefetchHistory.push_back(prefetchCacheLineBase);
+        } else if(prefetchHistoryCount != 0) {
+                prefetchHistory[prefetchHistoryNext] = prefetchCacheLineBase;
+                prefetchHistoryNext = (prefetchHistoryNext + 1) % prefetchHistoryCount;
         }
+
+        assert((addr % blockSize) == 0);
+
+            // Cycle over each registered call back and notify them that we want to issue a prefetch
+            for(callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+                // Create a new read request, we cannot issue a write because the data will get
+                // overwritten and corrupt memory (even if we really do want to do a write)
+                MemEvent* newEv = new MemEvent(getName(), addr, addr, Command::GetS);
+                    newEv->setSize(blockSize);
+                    newEv->setPrefetchFlag(true);
+
+            (*(*callbackItr))(newEv);
+            }
+    } else {
+        statPrefetchIssueCanceledByHistory->addData(1);
+        output->verbose(CALL_INFO, 2, 0, "Prefetch canceled - same cache line is found in the recent prefetch history.\n");
     }
 }
 
@@ -188,9 +204,11 @@ StridePrefetcher::StridePrefetcher(ComponentId_t id, Params& params) : CacheList
     blockSize = params.find<uint64_t>("cache_line_size", 64);
 
     prefetchHistoryCount = params.find<uint32_t>("history", 16);
-    prefetchHistory = new std::deque<uint64_t>();
+    prefetchHistory.reserve(prefetchHistoryCount);
+    prefetchHistoryNext = 0;
 
     strideReach = params.find<uint32_t>("reach", 2);
+    throttle = new PrefetchThrottle(params, 1, strideReach);
     strideDetectionRange = params.find<uint64_t>("detect_range", 4);
     recentAddrListCount = params.find<uint32_t>("address_count", 64);
     pageSize = params.find<uint64_t>("page_size", 4096);
@@ -215,10 +233,22 @@ StridePrefetcher::StridePrefetcher(ComponentId_t id, Params& params) : CacheList
     statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
     statPrefetchIssueCanceledByPageBoundary = registerStatistic<uint64_t>("prefetches_canceled_by_page_boundary");
     statPrefetchIssueCanceledByHistory = registerStatistic<uint64_t>("prefetches_canceled_by_history");
+
+    if (throttle->isAdaptive()) {
+        throttle->setStatistics(registerStatistic<uint64_t>("prefetches_useful"), registerStatistic<uint64_t>("prefetches_late"),
+                registerStatistic<uint64_t>("prefetches_useless"), registerStatistic<uint64_t>("prefetches_redundant"),
+                registerStatistic<uint64_t>("prefetches_dropped"), registerStatistic<uint64_t>("prefetch_degree"),
+                registerStatistic<uint64_t>("prefetch_distance"));
+    }
 }
 
 StridePrefetcher::~StridePrefetcher() {
     free(recentAddrList);
+    delete throttle;
+}
+
+void StridePrefetcher::notifyPrefetchResult(Addr addr, PrefetchResult result) {
+    throttle->record(result);
 }
 
 void StridePrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
@@ -27,6 +27,8 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 #include <sst/elements/memHierarchy/cacheListener.h>
 
+#include "prefetchThrottle.h"
+
 #include <sst/core/output.h>
 
 using namespace SST;
@@ -42,6 +44,7 @@ public:
     ~StridePrefetcher();
 
     void notifyAccess(const CacheListenerNotification& notify);
+    void notifyPrefetchResult(Addr addr, PrefetchResult result);
     void registerResponseCallback(Event::HandlerBase *handler);
     void printStats(Output &out);
 
@@ -62,7 +65,8 @@ public:
         { "detect_range", "Range to detect addresses over in request counts", "4" },
         { "address_count", "Number of addresses to keep in prefetch table", "64" },
         { "page_size", "Page size for this controller", "4096" },
-        { "overrun_page_boundaries", "Allow prefetcher to run over page boundaries, 0 is no, 1 is yes", "0" }
+        { "overrun_page_boundaries", "Allow prefetcher to run over page boundaries, 0 is no, 1 is yes", "0" },
+        CASSINI_THROTTLE_ELI_PARAMS
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -71,14 +75,17 @@ public:
                 "Prefetches which would not be executed because they span over a page boundary.", "prefetches", 1 },
         { "prefetches_canceled_by_history",
                 "Prefetches which did not get issued because of a prefetch history in the table", "prefetches", 1 },
-        { "prefetch_opportunities", "Count of opportunities to prefetch", "prefetches", 1 }
+        { "prefetch_opportunities", "Count of opportunities to prefetch", "prefetches", 1 },
+        CASSINI_THROTTLE_ELI_STATS
     )
 
 private:
     Output* output;
     std::vector<Event::HandlerBase*> registeredCallbacks;
-    std::deque<uint64_t>* prefetchHistory;
+    std::vector<uint64_t> prefetchHistory;  // Recently prefetched lines, oldest overwritten first
+    uint32_t prefetchHistoryNext;
     uint32_t prefetchHistoryCount;
+    PrefetchThrottle* throttle;             // Degree: strides prefetched per detection, distance: reach
     uint64_t blockSize;
     bool overrunPageBoundary;
     uint64_t pageSize;
@@ -86,6 +93,7 @@ private:
     uint32_t recentAddrListCount;
     uint32_t nextRecentAddressIndex;
     void DetectStride();
+    void issuePrefetch(Addr addr);
     uint32_t strideDetectionRange;
     uint32_t strideReach;
     Addr getAddressByIndex(uint32_t index);
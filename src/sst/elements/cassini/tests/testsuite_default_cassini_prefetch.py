@@ -3,6 +3,10 @@
 from sst_unittest import *
 from sst_unittest_support import *
 
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, "{0}/../../memHierarchy/tests/".format(dirpath))
+from mhstats import *
+
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
 
@@ -48,6 +52,9 @@ class testcase_cassini_prefetch(SSTTestCase):
     def test_cassini_prefetch_nextblock(self):
         self.cassini_prefetch_test_template("nbp")
 
+    def test_cassini_prefetch_sms(self):
+        self.cassini_prefetch_sms_test_template("sms")
+
 #####
 
     def cassini_prefetch_test_template(self, testcase):
@@ -82,3 +89,22 @@ class testcase_cassini_prefetch(SSTTestCase):
         if not cmp_result:
             log_debug("{0} - DIFF DATA =\n{1}".format(self.get_testcase_name(), diff_data))
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+#####
+
+    # The adaptive SMS run has no reference file; it checks that the stream
+    # completes, that the prefetcher issues prefetches and gets feedback, and
+    # that the adaptive degree is allowed above the next-block default of 4
+    def cassini_prefetch_sms_test_template(self, testcase):
+        test_path = self.get_testsuite_dir()
+
+        testDataFileName="test_cassini_prefetch_{0}".format(testcase)
+        sdlfile = "{0}/streamcpu-{1}.py".format(test_path, testcase)
+
+        outfile, stats = run_and_read_statistics(self, sdlfile, testDataFileName, finished="streamCPU Finished after 100000 issued reads, 100000 returned")
+
+        for stat in ["prefetches_issued", "prefetches_useful", "prefetch_degree"]:
+            self.assertTrue(has_statistic(stats, stat), "cassini_prefetch test {0}: statistic {1} missing from {2}".format(testDataFileName, stat, outfile))
+        self.assertTrue(statistic_total(stats, "prefetches_issued") > 0, "cassini_prefetch test {0}: no prefetches issued".format(testDataFileName))
+        self.assertTrue(statistic_total(stats, "prefetches_useful") > 0, "cassini_prefetch test {0}: no useful prefetches reported".format(testDataFileName))
+        self.assertTrue(statistic_max(stats, "prefetch_degree") > 4, "cassini_prefetch test {0}: adaptive degree never exceeded 4".format(testDataFileName))
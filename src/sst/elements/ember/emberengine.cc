@@ -64,6 +64,8 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
     m_detailedCompute = m_os->getDetailedCompute();
     m_memHeapLink = m_os->getMemHeapLink();
 
+    m_inlineEvents = params.find<bool>("inlineEvents", false);
+
     std::string motifLogFile = params.find<std::string>("motifLog", "");
     if("" != motifLogFile) {
         // std::ostringstream logPrefix;
@@ -268,45 +270,68 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
 
     output.debug(CALL_INFO, 8, ENGINE_MASK, "Engine issuing next event with delay %" PRIu64 "\n", nanoDelay);
 
-    while ( evQueue.empty() ) {
+    while ( 1 ) {
 
-        if ( ! m_motifDone ) {
-            m_motifDone = refillQueue();
+        // the motif has to generate more events at the time the inlined
+        // events finish, so wake up then
+        if ( evQueue.empty() && nanoDelay ) {
+            selfEventLink->send(nanoDelay, nanoTimeConverter, NULL);
+            return;
         }
 
-        // if the event Queue is empty after a refill the motif is done
-        if (  evQueue.empty() ) {
-            if (NULL != m_motifLogger) {
-                m_motifLogger->logMotifEnd(m_generator->getMotifName(),currentMotif);
-            }
-            // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif finished: %s\n",m_generator->getMotifName().c_str());
-            m_generator->completed( &output, getCurrentSimTimeNano() );
-            if ( m_generator->primary() ) {
-	            primaryComponentOKToEndSim();
+        while ( evQueue.empty() ) {
+
+            if ( ! m_motifDone ) {
+                m_motifDone = refillQueue();
             }
-            delete m_generator;
-
-            if ( ++currentMotif == motifParams.size() ) {
-                return;
-            } else {
-                m_generator = initMotif( motifParams[currentMotif],
-								m_apiMap, m_jobId, currentMotif, m_nodePerf );
-                assert( m_generator );
+
+            // if the event Queue is empty after a refill the motif is done
+            if (  evQueue.empty() ) {
                 if (NULL != m_motifLogger) {
-                    m_motifLogger->logMotifStart(currentMotif);
+                    m_motifLogger->logMotifEnd(m_generator->getMotifName(),currentMotif);
+                }
+                // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif finished: %s\n",m_generator->getMotifName().c_str());
+                m_generator->completed( &output, getCurrentSimTimeNano() );
+                if ( m_generator->primary() ) {
+                    primaryComponentOKToEndSim();
+                }
+                delete m_generator;
+
+                if ( ++currentMotif == motifParams.size() ) {
+                    return;
+                } else {
+                    m_generator = initMotif( motifParams[currentMotif],
+                                    m_apiMap, m_jobId, currentMotif, m_nodePerf );
+                    assert( m_generator );
+                    if (NULL != m_motifLogger) {
+                        m_motifLogger->logMotifStart(currentMotif);
+                    }
+                    // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif starting: %s\n",m_generator->getMotifName().c_str());
+
+                    m_motifDone = refillQueue();
                 }
-                // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif starting: %s\n",m_generator->getMotifName().c_str());
-
-                m_motifDone = refillQueue();
             }
         }
-    }
 
-	EmberEvent* nextEv = evQueue.front();
-	evQueue.pop();
+        EmberEvent* nextEv = evQueue.front();
+        evQueue.pop();
+
+        // Events that need the OS go through the self link, everything
+        // else can be issued and completed here
+        if ( ! m_inlineEvents || nextEv->state() != EmberEvent::Issue ) {
+            // issue the next event to the engine for deliver later
+            selfEventLink->send(nanoDelay, nanoTimeConverter, nextEv);
+            return;
+        }
+
+        output.debug(CALL_INFO, 2, ENGINE_MASK, "inline %s Event\n", nextEv->getName().c_str());
 
-	// issue the next event to the engine for deliver later
-	selfEventLink->send(nanoDelay, nanoTimeConverter, nextEv);
+        nextEv->issue( getCurrentSimTimeNano() + nanoDelay );
+        nanoDelay += nextEv->completeDelayNS();
+        if ( nextEv->complete( getCurrentSimTimeNano() + nanoDelay ) ) {
+            nextEv->release();
+        }
+    }
 }
 
 bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
@@ -315,7 +340,7 @@ bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
               ev->stateName( ev->state() ).c_str(), ev->getName().c_str());
 
     if ( ev->complete( getCurrentSimTimeNano(), retval ) ) {
-        delete ev;
+        ev->release();
     }
 
 	issueNextEvent(0);
@@ -329,6 +354,12 @@ void EmberEngine::handleEvent(Event* ev) {
 	// handlers we have created
 	EmberEvent* eEv = static_cast<EmberEvent*>(ev);
 
+    // wake up after inlined events, see issueNextEvent()
+    if ( NULL == eEv ) {
+        issueNextEvent(0);
+        return;
+    }
+
     output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               eEv->stateName( eEv->state() ).c_str(), eEv->getName().c_str());
 
@@ -361,7 +392,7 @@ void EmberEngine::handleEvent(Event* ev) {
 
       case EmberEvent::Complete:
         if ( eEv->complete( getCurrentSimTimeNano() ) ) {
-            delete ev;
+            eEv->release();
         }
 	    issueNextEvent(0);
         break;
@@ -71,6 +71,8 @@ public:
         { "spyplotmode", "Sets the spyplot generation mode, 0 = none, 1 = spy on sends", "0" },
 
         { "motifLog", "Sets a file path to a file where motif execution details are written, empty = no log", "" },
+
+        { "inlineEvents", "Run compute and other events that complete without the OS in place, folding their delays into the self event for the next event, 0 = off", "0" },
 /*
         { "Send_bin_width", "Bin width of the send time histogram", "5" },
         { "Compute_bin_width", "Bin width of the compute time histogram", "5" },
@@ -135,6 +137,14 @@ public:
 		return m_memHeapLink;
 	}
 
+	EmberEventPool<EmberComputeEvent>* getComputeEventPool() {
+		return &m_computeEventPool;
+	}
+
+	EmberEventPool<EmberGetTimeEvent>* getGetTimeEventPool() {
+		return &m_getTimeEventPool;
+	}
+
     EmberLib* getLib( std::string name ) {
         if( m_apiMap.find( name ) == m_apiMap.end() ) {
             output.fatal(CALL_INFO, -1, "Error: could not find %s\n",name.c_str() );
@@ -182,6 +192,10 @@ private:
 	Output      output;
 
 	std::queue<EmberEvent*> evQueue;
+    bool        m_inlineEvents;
+
+    EmberEventPool<EmberComputeEvent> m_computeEventPool;
+    EmberEventPool<EmberGetTimeEvent> m_getTimeEventPool;
 
     Hermes::NodePerf*   m_nodePerf;
 	EmberGenerator*     m_generator;
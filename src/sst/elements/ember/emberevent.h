@@ -17,6 +17,10 @@
 #ifndef _H_EMBER_EVENT
 #define _H_EMBER_EVENT
 
+#include <new>
+#include <utility>
+#include <vector>
+
 #include <sst/core/event.h>
 #include <sst/core/statapi/statbase.h>
 #include <sst/elements/hermes/msgapi.h>
@@ -43,8 +47,12 @@ typedef Hermes::Callback Callback;
 
 typedef Statistic<uint32_t> EmberEventTimeStatistic;
 
+template< class T > class EmberEventPool;
+
 class EmberEvent : public SST::Event {
 
+    template< class T > friend class EmberEventPool;
+
 public:
 
     enum State {
@@ -52,15 +60,24 @@ public:
     } m_state;
 
 	EmberEvent( Output* output, EmberEventTimeStatistic* stat = NULL) :
-        m_state(Issue), m_output(output), m_evStat(stat), m_completeDelayNS(0), m_retvalPtr(NULL)
+        m_state(Issue), m_output(output), m_evStat(stat), m_completeDelayNS(0), m_retvalPtr(NULL), m_pool(NULL)
 	{}
 	EmberEvent( Output* output, int* retval) :
-        m_state(Issue), m_output(output), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(retval)
+        m_state(Issue), m_output(output), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(retval), m_pool(NULL)
 	{}
 	EmberEvent( ) :
-        m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL) {}
+        m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL), m_pool(NULL) {}
 	~EmberEvent() {}
 
+    // called by the engine once the event has completed
+    void release() {
+        if ( m_pool ) {
+            m_pool->push_back( this );
+        } else {
+            delete this;
+        }
+    }
+
 	virtual std::string getName() { return "?????"; };
 
     State state() { return m_state; }
@@ -121,9 +138,42 @@ public:
     uint64_t            m_issueTime;
     int*                m_retvalPtr;
 
+  private:
+    std::vector<EmberEvent*>* m_pool;
+
     NotSerializable(EmberEvent)
 };
 
+// Completed events of one type, kept to be constructed again in place
+// rather than freed and allocated for every event a motif queues
+template< class T >
+class EmberEventPool {
+  public:
+    ~EmberEventPool() {
+        for ( unsigned i = 0; i < m_free.size(); i++ ) {
+            delete static_cast<T*>( m_free[i] );
+        }
+    }
+
+    template< typename... Args >
+    T* alloc( Args&&... args ) {
+        T* ev;
+        if ( m_free.empty() ) {
+            ev = new T( std::forward<Args>(args)... );
+        } else {
+            ev = static_cast<T*>( m_free.back() );
+            m_free.pop_back();
+            ev->~T();
+            ::new (ev) T( std::forward<Args>(args)... );
+        }
+        ev->m_pool = &m_free;
+        return ev;
+    }
+
+  private:
+    std::vector<EmberEvent*> m_free;
+};
+
 }
 }
 
@@ -57,6 +57,8 @@ void EmberGenerator::setEngine( EmberEngine* ee ) {
     m_nodePerf = m_ee->getNodePerf();
     m_detailedCompute = m_ee->getDetailedCompute();
 	m_memHeapLink = m_ee->getMemHeapLink();
+    m_computeEventPool = m_ee->getComputeEventPool();
+    m_getTimeEventPool = m_ee->getGetTimeEventPool();
 }
 
 EmberLib* EmberGenerator::getLib(std::string name )
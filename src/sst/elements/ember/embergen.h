@@ -135,20 +135,24 @@ class EmberGenerator : public SubComponent {
     bool                    m_primary;
     EmberComputeDistribution*           m_computeDistrib;
     uint64_t m_curVirtAddr;
+
+    // owned by the engine
+    EmberEventPool<EmberComputeEvent>*  m_computeEventPool;
+    EmberEventPool<EmberGetTimeEvent>*  m_getTimeEventPool;
 };
 
 void EmberGenerator::enQ_getTime( Queue& q, uint64_t* time ) {
-	q.push( new EmberGetTimeEvent( &getOutput(), time ) );
+	q.push( m_getTimeEventPool->alloc( &getOutput(), time ) );
 }
 
 void EmberGenerator::enQ_compute( Queue& q, uint64_t delay )
 {
-    q.push( new EmberComputeEvent( &getOutput(), delay, m_computeDistrib ) );
+    q.push( m_computeEventPool->alloc( &getOutput(), delay, m_computeDistrib ) );
 }
 
 void EmberGenerator::enQ_compute( Queue& q, std::function<uint64_t()> func )
 {
-    q.push( new EmberComputeEvent( &getOutput(), func, m_computeDistrib ) );
+    q.push( m_computeEventPool->alloc( &getOutput(), func, m_computeDistrib ) );
 }
 
 void EmberGenerator::enQ_detailedCompute( Queue& q, std::string name,
@@ -170,7 +174,7 @@ void EmberGenerator::enQ_memAlloc( Queue& q, Hermes::MemAddr* addr, size_t lengt
         }
         *addr = Hermes::MemAddr( m_curVirtAddr, memAlloc( length ) );
         m_curVirtAddr += length;
-        q.push( new EmberComputeEvent( &getOutput(), 0, m_computeDistrib ) );
+        q.push( m_computeEventPool->alloc( &getOutput(), 0, m_computeDistrib ) );
     }
 }
 
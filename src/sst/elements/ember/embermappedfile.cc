@@ -0,0 +1,135 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <unordered_map>
+#include "embermappedfile.h"
+
+using namespace SST::Ember;
+
+static std::unordered_map<std::string, EmberMappedFileRecord*>* mappedFiles = NULL;
+
+#ifndef _SST_EMBER_DISABLE_PARALLEL
+static std::mutex mapLock;
+#endif
+
+EmberMappedFileRecord::EmberMappedFileRecord(const std::string& filePath) :
+	path(filePath),
+	data(NULL),
+	size(0),
+	valid(false),
+	readerCount(0)
+{
+	const int fd = open(filePath.c_str(), O_RDONLY);
+
+	if( fd < 0 ) {
+		return;
+	}
+
+	struct stat fileInfo;
+
+	if( 0 == fstat(fd, &fileInfo) ) {
+		size = (uint64_t) fileInfo.st_size;
+
+		if( 0 == size ) {
+			valid = true;
+		} else {
+			void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if( MAP_FAILED != mapping ) {
+				data = (const char*) mapping;
+				valid = true;
+			}
+		}
+	}
+
+	// The mapping holds its own reference to the file
+	close(fd);
+}
+
+EmberMappedFileRecord::~EmberMappedFileRecord() {
+	if( NULL != data ) {
+		munmap((void*) data, size);
+	}
+}
+
+std::shared_ptr<const void> EmberMappedFileRecord::getDerived(std::function<std::shared_ptr<const void>()> build) {
+#ifndef _SST_EMBER_DISABLE_PARALLEL
+	// Readers asking at the same time wait for the first to finish building
+	std::lock_guard<std::mutex> lock(derivedLock);
+#endif
+
+	if( ! derived ) {
+		derived = build();
+	}
+
+	return derived;
+}
+
+EmberMappedFile::EmberMappedFile(const std::string& filePath) :
+	windowStart(0),
+	windowLength(0),
+	position(0)
+{
+#ifndef _SST_EMBER_DISABLE_PARALLEL
+	std::lock_guard<std::mutex> lock(mapLock);
+#endif
+
+	if(NULL == mappedFiles) {
+		mappedFiles = new std::unordered_map<std::string, EmberMappedFileRecord*>();
+	}
+
+	auto mappedFind = mappedFiles->find(filePath);
+
+	if(mappedFind == mappedFiles->end()) {
+		record = new EmberMappedFileRecord(filePath);
+		mappedFiles->insert( std::pair<std::string, EmberMappedFileRecord*>(filePath, record) );
+	} else {
+		record = mappedFind->second;
+	}
+
+	record->increment();
+	windowLength = record->getSize();
+}
+
+EmberMappedFile::~EmberMappedFile() {
+#ifndef _SST_EMBER_DISABLE_PARALLEL
+	std::lock_guard<std::mutex> lock(mapLock);
+#endif
+
+	if(0 == record->decrement()) {
+		mappedFiles->erase(record->getPath());
+		delete record;
+	}
+}
+
+bool EmberMappedFile::setWindow(const uint64_t offset, const uint64_t length) {
+	if( offset > record->getSize() || length > (record->getSize() - offset) ) {
+		return false;
+	}
+
+	windowStart = offset;
+	windowLength = length;
+	position = 0;
+
+	return true;
+}
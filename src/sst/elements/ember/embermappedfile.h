@@ -0,0 +1,136 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_EMBER_MAPPED_FILE
+#define _H_SST_EMBER_MAPPED_FILE
+
+#include <stdint.h>
+#include <string.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#ifndef _SST_EMBER_DISABLE_PARALLEL
+#include <mutex>
+#endif
+
+namespace SST {
+namespace Ember {
+
+/*
+ * A read-only memory mapping of an input file (trace, mesh), shared by every
+ * rank in the process that opens the same path. The mapping is released when
+ * the last reader is destroyed.
+ */
+class EmberMappedFileRecord {
+	public:
+		EmberMappedFileRecord(const std::string& filePath);
+		~EmberMappedFileRecord();
+
+		bool isValid() const { return valid; }
+		const char* getData() const { return data; }
+		uint64_t getSize() const { return size; }
+
+		const std::string& getPath() const { return path; }
+
+		uint32_t increment() { return ++readerCount; }
+		uint32_t decrement() { return --readerCount; }
+
+		/* Data derived from the file, built once by the first reader to ask */
+		std::shared_ptr<const void> getDerived(std::function<std::shared_ptr<const void>()> build);
+
+	protected:
+		std::string path;
+		const char* data;
+		uint64_t size;
+		bool valid;
+		uint32_t readerCount;
+
+		std::shared_ptr<const void> derived;
+#ifndef _SST_EMBER_DISABLE_PARALLEL
+		std::mutex derivedLock;
+#endif
+};
+
+/*
+ * A rank's cursor over a shared mapped file. Reads are bounds checked against
+ * the window, which is the whole file unless restricted with setWindow (e.g.
+ * to one rank's section of a packed file); offsets are relative to the window.
+ */
+class EmberMappedFile {
+	public:
+		EmberMappedFile(const std::string& filePath);
+		~EmberMappedFile();
+
+		/* False if the file could not be opened or mapped */
+		bool isOpen() const { return record->isValid(); }
+		const std::string& getPath() const { return record->getPath(); }
+		uint64_t getFileSize() const { return record->getSize(); }
+
+		bool setWindow(const uint64_t offset, const uint64_t length);
+		uint64_t getSize() const { return windowLength; }
+
+		bool seek(const uint64_t offset) {
+			if( offset > windowLength ) {
+				return false;
+			}
+
+			position = offset;
+			return true;
+		}
+
+		uint64_t tell() const { return position; }
+		uint64_t remaining() const { return windowLength - position; }
+
+		template<typename T>
+		bool read(T* value) {
+			if( ! readAt(position, value) ) {
+				return false;
+			}
+
+			position += sizeof(T);
+			return true;
+		}
+
+		/* Does not move the cursor, so is safe to share between threads */
+		template<typename T>
+		bool readAt(const uint64_t offset, T* value) const {
+			if( offset > windowLength || sizeof(T) > (windowLength - offset) ) {
+				return false;
+			}
+
+			memcpy(value, record->getData() + windowStart + offset, sizeof(T));
+			return true;
+		}
+
+		template<typename T>
+		std::shared_ptr<const T> getDerived(std::function<T*()> build) {
+			return std::static_pointer_cast<const T>( record->getDerived(
+				[&build]() { return std::shared_ptr<const void>( std::shared_ptr<const T>( build() ) ); } ) );
+		}
+
+	private:
+		EmberMappedFileRecord* record;
+		uint64_t windowStart;
+		uint64_t windowLength;
+		uint64_t position;
+};
+
+}
+}
+
+#endif
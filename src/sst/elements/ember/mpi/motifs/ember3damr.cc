@@ -25,10 +25,9 @@
 using namespace SST::Ember;
 using namespace SST::Hermes::MP;
 
-static std::map<uint32_t, int32_t>  blockToNodeMap;
-
 Ember3DAMRGenerator::Ember3DAMRGenerator(SST::ComponentId_t id, Params& params) :
-	EmberMessagePassingGenerator(id, params, "3DAMR")
+	EmberMessagePassingGenerator(id, params, "3DAMR"),
+	amrFile(NULL)
 {
 	int verbose = params.find("arg.verbose", 0);
 	out = new Output("AMR3D [@p:@l]: ", verbose, 0, Output::STDOUT);
@@ -80,14 +79,11 @@ Ember3DAMRGenerator::Ember3DAMRGenerator(SST::ComponentId_t id, Params& params)
 void Ember3DAMRGenerator::loadBlocks() {
 	out->verbose(CALL_INFO, 2, 0, "Loading AMR block information from %s ...\n", blockFilePath);
 
-    EmberAMRBinaryFile* amrFile = NULL;
-
     if(2 == meshType) {
         amrFile = new EmberAMRBinaryFile(blockFilePath, out);
 
-	if(blockToNodeMap.empty()) {
-		amrFile->populateGlobalBlocks(&blockToNodeMap);
-	}
+	// Shared with the other ranks reading this mesh, built by the first one here
+	blockToNodeMap = amrFile->getGlobalBlocks();
     } else {
 //        amrFile = new EmberAMRTextFile(blockFilePath, out);
 	out->fatal(CALL_INFO, -1, "Binary mesh files are the only type currently supported, use sst-meshconvert\n");
@@ -162,7 +158,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 	amrFile->populateLocalBlocks(&localBlocks , rank());
 
 	out->verbose(CALL_INFO, 2, 0, "Rank %" PRIu32 ", loaded %" PRIu32 " blocks locally and %" PRIu32 " remotely, stopped at line: %" PRIu32 ".\n", (uint32_t) rank(),
-		(uint32_t) localBlocks.size(), (uint32_t) blockToNodeMap.size(), line);
+		(uint32_t) localBlocks.size(), (uint32_t) blockToNodeMap->size(), line);
 
 	out->verbose(CALL_INFO, 4, 0, "Performing AMR block wire up...\n");
 	uint32_t maxRequests = 0;
@@ -204,9 +200,9 @@ void Ember3DAMRGenerator::loadBlocks() {
 			const uint32_t commToBlock = calcBlockID((blockXPos / 2) + 1,
 				blockYPos / 2, blockZPos / 2, blockXUp);
 
-			std::map<uint32_t, int32_t>::iterator blockNode = blockToNodeMap.find(commToBlock);
+			std::map<uint32_t, int32_t>::const_iterator blockNode = blockToNodeMap->find(commToBlock);
 
-			if(blockNode == blockToNodeMap.end() && isBlockLocal(commToBlock)) {
+			if(blockNode == blockToNodeMap->end() && isBlockLocal(commToBlock)) {
 				if( ! isBlockLocal(commToBlock) ) {
 					out->fatal(CALL_INFO, -1, "Could not locate block %" PRIu32 ", during wire up phase.\n", commToBlock);
 				}
@@ -222,17 +218,17 @@ void Ember3DAMRGenerator::loadBlocks() {
 			const uint32_t x3 = calcBlockID(blockXPos * 2 + 2, blockYPos * 2,     blockZPos * 2 + 1, blockXUp);
 			const uint32_t x4 = calcBlockID(blockXPos * 2 + 2, blockYPos * 2 + 1, blockZPos * 2 + 1, blockXUp);
 
-			std::map<uint32_t, int32_t>::iterator blockNodeX1 = blockToNodeMap.find(x1);
-			std::map<uint32_t, int32_t>::iterator blockNodeX2 = blockToNodeMap.find(x2);
-			std::map<uint32_t, int32_t>::iterator blockNodeX3 = blockToNodeMap.find(x3);
-			std::map<uint32_t, int32_t>::iterator blockNodeX4 = blockToNodeMap.find(x4);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX1 = blockToNodeMap->find(x1);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX2 = blockToNodeMap->find(x2);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX3 = blockToNodeMap->find(x3);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX4 = blockToNodeMap->find(x4);
 
 			int32_t rankX1 = blockNodeX1->second;
 			int32_t rankX2 = blockNodeX2->second;
 			int32_t rankX3 = blockNodeX3->second;
 			int32_t rankX4 = blockNodeX4->second;
 
-			if( blockNodeX1 == blockToNodeMap.end() ) {
+			if( blockNodeX1 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x1) ) {
 					rankX1 = -1;
 				} else {
@@ -240,7 +236,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeX2 == blockToNodeMap.end() ) {
+			if( blockNodeX2 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x2) ) {
 					rankX2 = -1;
 				} else {
@@ -248,7 +244,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeX3 == blockToNodeMap.end() ) {
+			if( blockNodeX3 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x3) ) {
 					rankX3 = -1;
 				} else {
@@ -256,7 +252,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeX4 == blockToNodeMap.end() ) {
+			if( blockNodeX4 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x4) ) {
 					rankX4 = -1;
 				} else {
@@ -275,9 +271,9 @@ void Ember3DAMRGenerator::loadBlocks() {
 			const uint32_t blockNextToMe = calcBlockID(blockXPos + 1,
 				blockYPos, blockZPos, blockXUp);
 
-			std::map<uint32_t, int32_t>::iterator blockNextToMeNode = blockToNodeMap.find(blockNextToMe);
+			std::map<uint32_t, int32_t>::const_iterator blockNextToMeNode = blockToNodeMap->find(blockNextToMe);
 
-			if(blockNextToMeNode == blockToNodeMap.end()) {
+			if(blockNextToMeNode == blockToNodeMap->end()) {
 				if( ! isBlockLocal(blockNextToMe) ) {
 					out->fatal(CALL_INFO, -1, "X+ wireup for block failed to locate wire up on same refinement level (block=%" PRIu32 "\n",
 						blockNextToMe);
@@ -309,9 +305,9 @@ void Ember3DAMRGenerator::loadBlocks() {
 			const uint32_t commToBlock = calcBlockID((blockXPos / 2) - 1,
 				blockYPos / 2, blockZPos / 2, blockXDown);
 
-			std::map<uint32_t, int32_t>::iterator blockNode = blockToNodeMap.find(commToBlock);
+			std::map<uint32_t, int32_t>::const_iterator blockNode = blockToNodeMap->find(commToBlock);
 
-			if(blockNode == blockToNodeMap.end() && isBlockLocal(commToBlock)) {
+			if(blockNode == blockToNodeMap->end() && isBlockLocal(commToBlock)) {
 				if( ! isBlockLocal(commToBlock) ) {
 					out->fatal(CALL_INFO, -1, "X- wireup for block failed to locate wire up partner (block: %" PRIu32 ")\n", commToBlock);
 				}
@@ -333,17 +329,17 @@ void Ember3DAMRGenerator::loadBlocks() {
 			const uint32_t x3 = calcBlockID(blockXPos * 2 - 1, blockYPos * 2,     blockZPos * 2 + 1, blockXDown);
 			const uint32_t x4 = calcBlockID(blockXPos * 2 - 1, blockYPos * 2 + 1, blockZPos * 2 + 1, blockXDown);
 
-			std::map<uint32_t, int32_t>::iterator blockNodeX1 = blockToNodeMap.find(x1);
-			std::map<uint32_t, int32_t>::iterator blockNodeX2 = blockToNodeMap.find(x2);
-			std::map<uint32_t, int32_t>::iterator blockNodeX3 = blockToNodeMap.find(x3);
-			std::map<uint32_t, int32_t>::iterator blockNodeX4 = blockToNodeMap.find(x4);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX1 = blockToNodeMap->find(x1);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX2 = blockToNodeMap->find(x2);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX3 = blockToNodeMap->find(x3);
+			std::map<uint32_t, int32_t>::const_iterator blockNodeX4 = blockToNodeMap->find(x4);
 
 			int32_t rankX1 = blockNodeX1->second;
 			int32_t rankX2 = blockNodeX2->second;
 			int32_t rankX3 = blockNodeX3->second;
 			int32_t rankX4 = blockNodeX4->second;
 
-			if( blockNodeX1 == blockToNodeMap.end() ) {
+			if( blockNodeX1 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x1) ) {
 					rankX1 = -1;
 				} else {
@@ -351,7 +347,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeX2 == blockToNodeMap.end() ) {
+			if( blockNodeX2 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x2) ) {
 					rankX2 = -1;
 				} else {
@@ -359,7 +355,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeX3 == blockToNodeMap.end() ) {
+			if( blockNodeX3 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x3) ) {
 					rankX3 = -1;
 				} else {
@@ -367,7 +363,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeX4 == blockToNodeMap.end() ) {
+			if( blockNodeX4 == blockToNodeMap->end() ) {
 				if( isBlockLocal(x4) ) {
 					rankX4 = -1;
 				} else {
@@ -386,9 +382,9 @@ void Ember3DAMRGenerator::loadBlocks() {
 			const uint32_t blockNextToMe = calcBlockID(blockXPos - 1,
 				blockYPos, blockZPos, blockXDown);
 
-			std::map<uint32_t, int32_t>::iterator blockNextToMeNode = blockToNodeMap.find(blockNextToMe);
+			std::map<uint32_t, int32_t>::const_iterator blockNextToMeNode = blockToNodeMap->find(blockNextToMe);
 
-			if(blockNextToMeNode == blockToNodeMap.end()) {
+			if(blockNextToMeNode == blockToNodeMap->end()) {
 				if( ! isBlockLocal(blockNextToMe) ) {
 					out->fatal(CALL_INFO, -1, "X- wireup for block failed to locate wire up block on same refinment level (block: %" PRIu32 ")\n", blockNextToMe);
 				}
@@ -410,9 +406,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t commToBlock = calcBlockID((blockXPos / 2),
                                                      (blockYPos / 2) + 1, blockZPos / 2, blockYUp);
 
-            std::map<uint32_t, int32_t>::iterator blockNode = blockToNodeMap.find(commToBlock);
+            std::map<uint32_t, int32_t>::const_iterator blockNode = blockToNodeMap->find(commToBlock);
 
-            if(blockNode == blockToNodeMap.end() && isBlockLocal(commToBlock)) {
+            if(blockNode == blockToNodeMap->end() && isBlockLocal(commToBlock)) {
                 if( ! isBlockLocal(commToBlock) ) {
                     printf("Y+ Did not locate block: %" PRIu32 "\n", commToBlock);
                     exit(-1);
@@ -429,17 +425,17 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t y3 = calcBlockID(blockXPos * 2,     blockYPos * 2 + 2, blockZPos * 2 + 1, blockYUp);
             const uint32_t y4 = calcBlockID(blockXPos * 2 + 1, blockYPos * 2 + 2, blockZPos * 2 + 1, blockYUp);
 
-            std::map<uint32_t, int32_t>::iterator blockNodeY1 = blockToNodeMap.find(y1);
-            std::map<uint32_t, int32_t>::iterator blockNodeY2 = blockToNodeMap.find(y2);
-            std::map<uint32_t, int32_t>::iterator blockNodeY3 = blockToNodeMap.find(y3);
-            std::map<uint32_t, int32_t>::iterator blockNodeY4 = blockToNodeMap.find(y4);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY1 = blockToNodeMap->find(y1);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY2 = blockToNodeMap->find(y2);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY3 = blockToNodeMap->find(y3);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY4 = blockToNodeMap->find(y4);
 
 			int32_t rankY1 = blockNodeY1->second;
 			int32_t rankY2 = blockNodeY2->second;
 			int32_t rankY3 = blockNodeY3->second;
 			int32_t rankY4 = blockNodeY4->second;
 
-			if( blockNodeY1 == blockToNodeMap.end() ) {
+			if( blockNodeY1 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y1) ) {
 					rankY1 = -1;
 				} else {
@@ -447,7 +443,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeY2 == blockToNodeMap.end() ) {
+			if( blockNodeY2 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y2) ) {
 					rankY2 = -1;
 				} else {
@@ -455,7 +451,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeY3 == blockToNodeMap.end() ) {
+			if( blockNodeY3 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y3) ) {
 					rankY3 = -1;
 				} else {
@@ -463,7 +459,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeY4 == blockToNodeMap.end() ) {
+			if( blockNodeY4 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y4) ) {
 					rankY4 = -1;
 				} else {
@@ -481,9 +477,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             // Same level
             const uint32_t blockNextToMe = calcBlockID(blockXPos,
                                                        blockYPos + 1, blockZPos, blockYUp);
-            std::map<uint32_t, int32_t>::iterator blockNextToMeNode = blockToNodeMap.find(blockNextToMe);
+            std::map<uint32_t, int32_t>::const_iterator blockNextToMeNode = blockToNodeMap->find(blockNextToMe);
 
-            if(blockNextToMeNode == blockToNodeMap.end()) {
+            if(blockNextToMeNode == blockToNodeMap->end()) {
                 if( ! isBlockLocal(blockNextToMe) ) {
 		    out->output("Dumping block map for rank: %" PRIu32 "\n", rank());
 		    out->fatal(CALL_INFO, -1, "Y+ wireup for block failed to locate wire up partner (block: %" PRIu32 ")\n", blockNextToMe);
@@ -507,9 +503,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t commToBlock = calcBlockID((blockXPos / 2),
                                                      (blockYPos / 2) - 1, blockZPos / 2, blockYDown);
 
-            std::map<uint32_t, int32_t>::iterator blockNode = blockToNodeMap.find(commToBlock);
+            std::map<uint32_t, int32_t>::const_iterator blockNode = blockToNodeMap->find(commToBlock);
 
-            if(blockNode == blockToNodeMap.end() && isBlockLocal(commToBlock)) {
+            if(blockNode == blockToNodeMap->end() && isBlockLocal(commToBlock)) {
                 if( ! isBlockLocal(commToBlock) ) {
                     printf("Y- Did not locate block: %" PRIu32 "\n", commToBlock);
                     exit(-1);
@@ -526,17 +522,17 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t y3 = calcBlockID(blockXPos * 2,     blockYPos * 2 - 1, blockZPos * 2 + 1, blockYDown);
             const uint32_t y4 = calcBlockID(blockXPos * 2 + 1, blockYPos * 2 - 1, blockZPos * 2 + 1, blockYDown);
 
-            std::map<uint32_t, int32_t>::iterator blockNodeY1 = blockToNodeMap.find(y1);
-            std::map<uint32_t, int32_t>::iterator blockNodeY2 = blockToNodeMap.find(y2);
-            std::map<uint32_t, int32_t>::iterator blockNodeY3 = blockToNodeMap.find(y3);
-            std::map<uint32_t, int32_t>::iterator blockNodeY4 = blockToNodeMap.find(y4);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY1 = blockToNodeMap->find(y1);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY2 = blockToNodeMap->find(y2);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY3 = blockToNodeMap->find(y3);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeY4 = blockToNodeMap->find(y4);
 
 			int32_t rankY1 = blockNodeY1->second;
 			int32_t rankY2 = blockNodeY2->second;
 			int32_t rankY3 = blockNodeY3->second;
 			int32_t rankY4 = blockNodeY4->second;
 
-			if( blockNodeY1 == blockToNodeMap.end() ) {
+			if( blockNodeY1 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y1) ) {
 					rankY1 = -1;
 				} else {
@@ -544,7 +540,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeY2 == blockToNodeMap.end() ) {
+			if( blockNodeY2 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y2) ) {
 					rankY2 = -1;
 				} else {
@@ -552,7 +548,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeY3 == blockToNodeMap.end() ) {
+			if( blockNodeY3 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y3) ) {
 					rankY3 = -1;
 				} else {
@@ -560,7 +556,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeY4 == blockToNodeMap.end() ) {
+			if( blockNodeY4 == blockToNodeMap->end() ) {
 				if( isBlockLocal(y4) ) {
 					rankY4 = -1;
 				} else {
@@ -578,9 +574,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t blockNextToMe = calcBlockID(blockXPos,
                                                        blockYPos - 1, blockZPos, blockYDown);
 
-            std::map<uint32_t, int32_t>::iterator blockNextToMeNode = blockToNodeMap.find(blockNextToMe);
+            std::map<uint32_t, int32_t>::const_iterator blockNextToMeNode = blockToNodeMap->find(blockNextToMe);
 
-            if(blockNextToMeNode == blockToNodeMap.end()) {
+            if(blockNextToMeNode == blockToNodeMap->end()) {
                 if( ! isBlockLocal(blockNextToMe) ) {
                 	out->fatal(CALL_INFO, -1, "Y- wireup for block failed to locate wire up partner (block: %" PRIu32 ")\n", blockNextToMe);
                 }
@@ -603,9 +599,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t commToBlock = calcBlockID((blockXPos / 2),
                                                      (blockYPos / 2), (blockZPos / 2) + 1, blockZUp);
 
-            std::map<uint32_t, int32_t>::iterator blockNode = blockToNodeMap.find(commToBlock);
+            std::map<uint32_t, int32_t>::const_iterator blockNode = blockToNodeMap->find(commToBlock);
 
-            if(blockNode == blockToNodeMap.end() && isBlockLocal(commToBlock)) {
+            if(blockNode == blockToNodeMap->end() && isBlockLocal(commToBlock)) {
                 if( ! isBlockLocal(commToBlock) ) {
                     printf("Y+ Did not locate block: %" PRIu32 "\n", commToBlock);
                     exit(-1);
@@ -622,17 +618,17 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t z3 = calcBlockID(blockXPos * 2,     blockYPos * 2 + 1, blockZPos * 2 + 2, blockZUp);
             const uint32_t z4 = calcBlockID(blockXPos * 2 + 1, blockYPos * 2 + 1, blockZPos * 2 + 2, blockZUp);
 
-            std::map<uint32_t, int32_t>::iterator blockNodeZ1 = blockToNodeMap.find(z1);
-            std::map<uint32_t, int32_t>::iterator blockNodeZ2 = blockToNodeMap.find(z2);
-            std::map<uint32_t, int32_t>::iterator blockNodeZ3 = blockToNodeMap.find(z3);
-            std::map<uint32_t, int32_t>::iterator blockNodeZ4 = blockToNodeMap.find(z4);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ1 = blockToNodeMap->find(z1);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ2 = blockToNodeMap->find(z2);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ3 = blockToNodeMap->find(z3);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ4 = blockToNodeMap->find(z4);
 
 			int32_t rankZ1 = blockNodeZ1->second;
 			int32_t rankZ2 = blockNodeZ2->second;
 			int32_t rankZ3 = blockNodeZ3->second;
 			int32_t rankZ4 = blockNodeZ4->second;
 
-			if( blockNodeZ1 == blockToNodeMap.end() ) {
+			if( blockNodeZ1 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z1) ) {
 					rankZ1 = -1;
 				} else {
@@ -640,7 +636,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeZ2 == blockToNodeMap.end() ) {
+			if( blockNodeZ2 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z2) ) {
 					rankZ2 = -1;
 				} else {
@@ -648,7 +644,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeZ3 == blockToNodeMap.end() ) {
+			if( blockNodeZ3 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z3) ) {
 					rankZ3 = -1;
 				} else {
@@ -656,7 +652,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeZ4 == blockToNodeMap.end() ) {
+			if( blockNodeZ4 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z4) ) {
 					rankZ4 = -1;
 				} else {
@@ -673,9 +669,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             // Same level
             const uint32_t blockNextToMe = calcBlockID(blockXPos,
                                                        blockYPos, blockZPos + 1, blockZUp);
-            std::map<uint32_t, int32_t>::iterator blockNextToMeNode = blockToNodeMap.find(blockNextToMe);
+            std::map<uint32_t, int32_t>::const_iterator blockNextToMeNode = blockToNodeMap->find(blockNextToMe);
 
-            if(blockNextToMeNode == blockToNodeMap.end()) {
+            if(blockNextToMeNode == blockToNodeMap->end()) {
                 if( ! isBlockLocal(blockNextToMe) ) {
                     out->fatal(CALL_INFO, -1, "Z+ wireup for block failed to locate wire up partner (block: %" PRIu32 ")\n", blockNextToMe);
                 }
@@ -697,9 +693,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t commToBlock = calcBlockID((blockXPos / 2),
                                                      (blockYPos / 2), (blockZPos / 2) - 1, blockZDown);
 
-            std::map<uint32_t, int32_t>::iterator blockNode = blockToNodeMap.find(commToBlock);
+            std::map<uint32_t, int32_t>::const_iterator blockNode = blockToNodeMap->find(commToBlock);
 
-            if(blockNode == blockToNodeMap.end() && isBlockLocal(commToBlock)) {
+            if(blockNode == blockToNodeMap->end() && isBlockLocal(commToBlock)) {
                 if( ! isBlockLocal(commToBlock) ) {
 	                out->fatal(CALL_INFO, -1, "Z- wireup for block failed to locate wire up partner (block: %" PRIu32 ")\n", commToBlock);
                 }
@@ -715,17 +711,17 @@ void Ember3DAMRGenerator::loadBlocks() {
             const uint32_t z3 = calcBlockID(blockXPos * 2,     blockYPos * 2 + 1, blockZPos * 2 - 1, blockZDown);
             const uint32_t z4 = calcBlockID(blockXPos * 2 + 1, blockYPos * 2 + 1, blockZPos * 2 - 1, blockZDown);
 
-            std::map<uint32_t, int32_t>::iterator blockNodeZ1 = blockToNodeMap.find(z1);
-            std::map<uint32_t, int32_t>::iterator blockNodeZ2 = blockToNodeMap.find(z2);
-            std::map<uint32_t, int32_t>::iterator blockNodeZ3 = blockToNodeMap.find(z3);
-            std::map<uint32_t, int32_t>::iterator blockNodeZ4 = blockToNodeMap.find(z4);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ1 = blockToNodeMap->find(z1);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ2 = blockToNodeMap->find(z2);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ3 = blockToNodeMap->find(z3);
+            std::map<uint32_t, int32_t>::const_iterator blockNodeZ4 = blockToNodeMap->find(z4);
 
 			int32_t rankZ1 = blockNodeZ1->second;
 			int32_t rankZ2 = blockNodeZ2->second;
 			int32_t rankZ3 = blockNodeZ3->second;
 			int32_t rankZ4 = blockNodeZ4->second;
 
-			if( blockNodeZ1 == blockToNodeMap.end() ) {
+			if( blockNodeZ1 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z1) ) {
 					rankZ1 = -1;
 				} else {
@@ -733,7 +729,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeZ2 == blockToNodeMap.end() ) {
+			if( blockNodeZ2 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z2) ) {
 					rankZ2 = -1;
 				} else {
@@ -741,7 +737,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeZ3 == blockToNodeMap.end() ) {
+			if( blockNodeZ3 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z3) ) {
 					rankZ3 = -1;
 				} else {
@@ -749,7 +745,7 @@ void Ember3DAMRGenerator::loadBlocks() {
 				}
 			}
 
-			if( blockNodeZ4 == blockToNodeMap.end() ) {
+			if( blockNodeZ4 == blockToNodeMap->end() ) {
 				if( isBlockLocal(z4) ) {
 					rankZ4 = -1;
 				} else {
@@ -766,9 +762,9 @@ void Ember3DAMRGenerator::loadBlocks() {
             // Same level
             const uint32_t blockNextToMe = calcBlockID(blockXPos,
                                                        blockYPos, blockZPos - 1, blockZDown);
-            std::map<uint32_t, int32_t>::iterator blockNextToMeNode = blockToNodeMap.find(blockNextToMe);
+            std::map<uint32_t, int32_t>::const_iterator blockNextToMeNode = blockToNodeMap->find(blockNextToMe);
 
-            if(blockNextToMeNode == blockToNodeMap.end()) {
+            if(blockNextToMeNode == blockToNodeMap->end()) {
                 if( ! isBlockLocal(blockNextToMe) ) {
                     out->fatal(CALL_INFO, -1, "Z- wireup for block failed to locate wire up partner (block: %" PRIu32 ")\n", blockNextToMe);
                 }
@@ -1095,14 +1091,14 @@ bool Ember3DAMRGenerator::isBlockLocal(const uint32_t bID) const {
 }
 
 void Ember3DAMRGenerator::printBlockMap() {
-	std::map<uint32_t, int32_t>::iterator block_itr;
+	std::map<uint32_t, int32_t>::const_iterator block_itr;
 
 	char* map_output = (char*) malloc(sizeof(char) * PATH_MAX);
 	sprintf(map_output, "blocks-%" PRIu32 ".map", rank());
 
 	FILE* map_output_file = fopen(map_output, "wt");
 
-	for(block_itr = blockToNodeMap.begin(); block_itr != blockToNodeMap.end(); block_itr++) {
+	for(block_itr = blockToNodeMap->begin(); block_itr != blockToNodeMap->end(); block_itr++) {
 		fprintf(map_output_file, "Block %" PRIu32 " maps to node: %" PRId32 "\n",
 			block_itr->first, block_itr->second);
 	}
@@ -1123,6 +1119,7 @@ void Ember3DAMRGenerator::printBlockMap() {
 }
 
 Ember3DAMRGenerator::~Ember3DAMRGenerator() {
+	delete amrFile;
 	delete out;
 	memFree(blockMessageBuffer);
 }
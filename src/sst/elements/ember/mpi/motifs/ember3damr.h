@@ -21,6 +21,9 @@
 #include <sst/core/params.h>
 #include <sst/core/output.h>
 
+#include <map>
+#include <memory>
+
 #include "mpi/embermpigen.h"
 #include "ember3damrblock.h"
 
@@ -29,6 +32,8 @@ using namespace SST;
 namespace SST {
 namespace Ember {
 
+class EmberAMRBinaryFile;
+
 class Ember3DAMRGenerator : public EmberMessagePassingGenerator {
 
 public:
@@ -105,7 +110,9 @@ private:
 
 	void* blockMessageBuffer;
 
-//        static std::map<uint32_t, int32_t>  blockToNodeMap;
+        // Held for the lifetime of the motif so ranks keep sharing the mapped mesh
+        EmberAMRBinaryFile* amrFile;
+        std::shared_ptr<const std::map<uint32_t, int32_t> >  blockToNodeMap;
         char* blockFilePath;
 
 	Output* out;
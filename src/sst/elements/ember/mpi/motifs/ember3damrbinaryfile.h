@@ -22,45 +22,49 @@
 #include <string.h>
 #include "ember3damrfile.h"
 #include "ember3damrblock.h"
+#include "embermappedfile.h"
 
-// To clean up warnings on not using return results on freads() below
-#if ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-result"
-#endif
+#include <map>
+#include <vector>
 
 namespace SST {
     namespace Ember {
 
+        /*
+         * Binary meshes written by sst-meshconvert. The file is mapped once per
+         * process and shared by every rank reading it; each rank finds its own
+         * blocks through the per-rank offset index after the header.
+         */
         class EmberAMRBinaryFile : public EmberAMRFile {
 
         public:
             EmberAMRBinaryFile(char* amrPath, Output* out) :
-                EmberAMRFile(amrPath, out) {
+                EmberAMRFile(amrPath, out),
+                mesh(amrPath) {
 
-                amrFile = fopen(amrFilePath, "rb");
+                amrFile = NULL;
 
-                if(NULL == amrFile) {
+                if(! mesh.isOpen()) {
                     output->fatal(CALL_INFO, -1, "Unable to open file: %s\n", amrPath);
                 }
 
                 rankCount = 0;
-                fread(&rankCount, sizeof(rankCount), 1, amrFile);
+                read(&rankCount);
 
                     uint32_t meshBlockCount = 0;
-                    fread(&meshBlockCount, sizeof(meshBlockCount), 1, amrFile);
+                    read(&meshBlockCount);
 
                     uint8_t meshMaxRefineLevel = 0;
-                    fread(&meshMaxRefineLevel, sizeof(meshMaxRefineLevel), 1, amrFile);
+                    read(&meshMaxRefineLevel);
 
                     uint32_t meshBlocksX = 0;
-                    fread(&meshBlocksX, sizeof(meshBlocksX), 1, amrFile);
+                    read(&meshBlocksX);
 
                     uint32_t meshBlocksY = 0;
-                    fread(&meshBlocksY, sizeof(meshBlocksY), 1, amrFile);
+                    read(&meshBlocksY);
 
                     uint32_t meshBlocksZ = 0;
-                    fread(&meshBlocksZ, sizeof(meshBlocksZ), 1, amrFile);
+                    read(&meshBlocksZ);
 
                     blocksX = (int) meshBlocksX;
                     blocksY = (int) meshBlocksY;
@@ -72,48 +76,52 @@ namespace SST {
                     out->verbose(CALL_INFO, 8, 0, "Read mesh header info: blocks=%" PRIu32 ", max-lev: %" PRIu32 " bkX=%" PRIu32 ", blkY=%" PRIu32 ", blkZ=%" PRIu32 "\n",
                              totalBlockCount, maxRefinementLevel, blocksX, blocksY, blocksZ);
 
-		    rankIndexOffset = ftell(amrFile);
+		    rankIndexOffset = mesh.tell();
 
 		    const uint64_t meshStartIndex = rankIndexOffset + (rankCount * sizeof(uint64_t));
 
 		    out->verbose(CALL_INFO, 8, 0, "Set mesh file seek to: %" PRIu64 "\n", meshStartIndex);
-		    fseek(amrFile, (long)(meshStartIndex), SEEK_SET);
+		    seek(meshStartIndex);
 
             }
 
             ~EmberAMRBinaryFile() {
-        	fclose(amrFile);
             }
 
-	    void populateGlobalBlocks(std::map<uint32_t, int32_t>* globalBlockMap) {
-		fseek(amrFile, rankIndexOffset + (rankCount * sizeof(uint64_t)), SEEK_SET);
+	    /*
+	     * Block to rank table for the whole mesh. It is built by the first rank
+	     * to ask and shared, read-only, by every rank using this file.
+	     */
+	    std::shared_ptr<const std::map<uint32_t, int32_t> > getGlobalBlocks() {
+		return mesh.getDerived<std::map<uint32_t, int32_t> >( [this]() {
+			std::map<uint32_t, int32_t>* globalBlockMap = new std::map<uint32_t, int32_t>();
 
-		for(uint32_t i = 0; i < rankCount; ++i) {
-			uint32_t blocksOnNode = 0;
-			uint32_t blockID;
-			uint32_t refineLevel;
-			int32_t  xDown;
-			int32_t  xUp;
-			int32_t  yDown;
-			int32_t  yUp;
-			int32_t  zDown;
-			int32_t  zUp;
+			for(uint32_t i = 0; i < rankCount; ++i) {
+				uint64_t rankBlocksIndex = 0;
+				readAt(rankIndexOffset + (i * sizeof(uint64_t)), &rankBlocksIndex);
 
-			readNodeMeshLine(&blocksOnNode);
+				uint32_t blocksOnNode = 0;
+				readAt(rankBlocksIndex, &blocksOnNode);
 
-			for(uint32_t j = 0; j < blocksOnNode; j++) {
-				readNextMeshLine(&blockID, &refineLevel,
-					&xDown, &xUp, &yDown, &yUp, &zDown, &zUp);
+				uint64_t nextBlockIndex = rankBlocksIndex + sizeof(blocksOnNode);
 
-				auto block_present = globalBlockMap->find(blockID);
+				for(uint32_t j = 0; j < blocksOnNode; j++) {
+					uint32_t blockID = 0;
+					readAt(nextBlockIndex, &blockID);
+					nextBlockIndex += BlockRecordSize;
 
-				if(block_present != globalBlockMap->end()) {
-					output->fatal(CALL_INFO, -1, "Block ID: %" PRIu32 " already in map.\n", blockID);
-				}
+					auto block_present = globalBlockMap->find(blockID);
 
-				globalBlockMap->insert(std::pair<uint32_t, int32_t>(blockID, (int32_t) i));
+					if(block_present != globalBlockMap->end()) {
+						output->fatal(CALL_INFO, -1, "Block ID: %" PRIu32 " already in map.\n", blockID);
+					}
+
+					globalBlockMap->insert(std::pair<uint32_t, int32_t>(blockID, (int32_t) i));
+				}
 			}
-		}
+
+			return globalBlockMap;
+		} );
             }
 
 	    void populateLocalBlocks(std::vector<Ember3DAMRBlock*>* localBlocks, uint32_t rank) {
@@ -122,14 +130,12 @@ namespace SST {
 		output->verbose(CALL_INFO, 16, 0, "Seek file offet: Base=%" PRIu64 ", Rank=%" PRIu32 ", Offset=%" PRIu64 ", File Seek=%" PRIu64 "\n",
 			rankIndexOffset, rank, (uint64_t)(rank * sizeof(uint64_t)), seekOffset);
 
-		fseek(amrFile, seekOffset, SEEK_SET);
-
 		uint64_t rankBlocksIndex = 0;
-		fread(&rankBlocksIndex, sizeof(rankBlocksIndex), 1, amrFile);
+		readAt(seekOffset, &rankBlocksIndex);
 
 		output->verbose(CALL_INFO, 16, 0, "Rank Offset: %" PRIu64 ", seeking in file...\n", rankBlocksIndex);
 
-		fseek(amrFile, rankBlocksIndex, SEEK_SET);
+		seek(rankBlocksIndex);
 
 		uint32_t blocksOnNode = 0;
 		readNodeMeshLine(&blocksOnNode);
@@ -160,46 +166,32 @@ namespace SST {
 	    }
 
             void readNodeMeshLine(uint32_t* blockCount) {
-                fread(blockCount, sizeof(uint32_t), 1, amrFile);
+                read(blockCount);
             }
 
 	    void locateRankEntries(uint32_t rank) {
-		fseek(amrFile, (long) (rankIndexOffset + (rank * sizeof(uint64_t))), SEEK_SET);
-
 		uint64_t rankStart = 0;
-		fread(&rankStart, sizeof(rankStart), 1, amrFile);
+		readAt(rankIndexOffset + (rank * sizeof(uint64_t)), &rankStart);
 
-		fseek(amrFile, (long) (rankStart), SEEK_SET);
+		seek(rankStart);
 	    }
 
             void readNextMeshLine(uint32_t* blockID, uint32_t* refineLev,
                                   int32_t* xDown, int32_t* xUp,
                                   int32_t* yDown, int32_t* yUp,
                                   int32_t* zDown, int32_t* zUp) {
-                int8_t temp = 0;
-
-                fread(blockID, sizeof(uint32_t), 1, amrFile);
-
-		fread(&temp, sizeof(temp), 1, amrFile);
-		*refineLev = (uint32_t) temp;
-
-                fread(&temp, sizeof(temp), 1, amrFile);
-                *xDown = (int32_t) temp;
-
-                fread(&temp, sizeof(temp), 1, amrFile);
-                *xUp = (int32_t) temp;
-
-                fread(&temp, sizeof(temp), 1, amrFile);
-                *yDown = (int32_t) temp;
-
-                fread(&temp, sizeof(temp), 1, amrFile);
-                *yUp = (int32_t) temp;
-
-                fread(&temp, sizeof(temp), 1, amrFile);
-                *zDown = (int32_t) temp;
-
-                fread(&temp, sizeof(temp), 1, amrFile);
-                *zUp = (int32_t) temp;
+                int8_t temp[7];
+
+                read(blockID);
+                read(&temp);
+
+                *refineLev = (uint32_t) temp[0];
+                *xDown     = (int32_t) temp[1];
+                *xUp       = (int32_t) temp[2];
+                *yDown     = (int32_t) temp[3];
+                *yUp       = (int32_t) temp[4];
+                *zDown     = (int32_t) temp[5];
+                *zUp       = (int32_t) temp[6];
             }
 
 	    virtual bool isBinary() {
@@ -207,16 +199,35 @@ namespace SST {
 	    }
 
         private:
+            // Block ID followed by the refinement level and six neighbor entries
+            static const uint64_t BlockRecordSize = sizeof(uint32_t) + (7 * sizeof(int8_t));
+
+            template<typename T>
+            void read(T* value) {
+                if(! mesh.read(value)) {
+                    output->fatal(CALL_INFO, -1, "Mesh file is truncated: %s\n", amrFilePath);
+                }
+            }
+
+            template<typename T>
+            void readAt(const uint64_t offset, T* value) const {
+                if(! mesh.readAt(offset, value)) {
+                    output->fatal(CALL_INFO, -1, "Mesh file is truncated: %s\n", amrFilePath);
+                }
+            }
+
+            void seek(const uint64_t offset) {
+                if(! mesh.seek(offset)) {
+                    output->fatal(CALL_INFO, -1, "Mesh file offset %" PRIu64 " is beyond the end of %s\n", offset, amrFilePath);
+                }
+            }
+
+            EmberMappedFile mesh;
             uint32_t rankCount;
 	    uint64_t rankIndexOffset;
-            FILE* amrFile;
         };
 
     }
 }
 
-#if ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
-#pragma GCC diagnostic pop
-#endif
-
 #endif
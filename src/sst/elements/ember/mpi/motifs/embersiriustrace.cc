@@ -20,27 +20,32 @@
 
 #include <cstdint>
 #include <climits>
+#include <sstream>
 
 using namespace SST::Ember;
 
 EmberSIRIUSTraceGenerator::EmberSIRIUSTraceGenerator(SST::ComponentId_t id,
                                             Params& params) :
-	EmberMessagePassingGenerator(id, params, "SIRIUSTrace")
+	EmberMessagePassingGenerator(id, params, "SIRIUSTrace"),
+	trace_file(NULL)
 {
+	std::string trace_path = params.find<std::string>("arg.tracefile", "");
 	std::string trace_prefix = params.find<std::string>("arg.traceprefix", "");
 
-	if( "" == trace_prefix ) {
+	if( "" != trace_path ) {
+		openPackedTrace(trace_path);
+	} else if( "" == trace_prefix ) {
 		fatal(CALL_INFO, -1, "Error: trace prefix is empty, no way to load a trace!\n");
 	} else {
-		char* full_trace = (char*) malloc( sizeof(char) * PATH_MAX );
-		sprintf(full_trace, "%s.%d", trace_prefix.c_str(), rank());
+		std::ostringstream full_trace;
+		full_trace << trace_prefix << "." << rank();
 
-		trace_file = fopen(full_trace, "rb");
+		trace_file = new EmberMappedFile(full_trace.str());
 
-		if( NULL == trace_file ) {
-			fatal(CALL_INFO, -1, "Error: unable to open SIRIUS trace: %s\n", full_trace);
+		if( ! trace_file->isOpen() ) {
+			fatal(CALL_INFO, -1, "Error: unable to open SIRIUS trace: %s\n", full_trace.str().c_str());
 		} else {
-			verbose(CALL_INFO, 1, 0, "Successfully opened SIRIUS trace: %s\n", full_trace);
+			verbose(CALL_INFO, 1, 0, "Successfully opened SIRIUS trace: %s\n", full_trace.str().c_str());
 		}
 	}
 
@@ -57,9 +62,46 @@ EmberSIRIUSTraceGenerator::EmberSIRIUSTraceGenerator(SST::ComponentId_t id,
 }
 
 EmberSIRIUSTraceGenerator::~EmberSIRIUSTraceGenerator() {
-	if( NULL != trace_file ) {
-		fclose(trace_file);
+	delete trace_file;
+}
+
+void EmberSIRIUSTraceGenerator::openPackedTrace(const std::string& trace_path) {
+	trace_file = new EmberMappedFile(trace_path);
+
+	if( ! trace_file->isOpen() ) {
+		fatal(CALL_INFO, -1, "Error: unable to open packed SIRIUS trace: %s\n", trace_path.c_str());
 	}
+
+	char magic[SIRIUS_PACK_MAGIC_LEN];
+	uint32_t version = 0;
+	uint32_t rankCount = 0;
+
+	if( ! trace_file->read(&magic) || memcmp(magic, SIRIUS_PACK_MAGIC, SIRIUS_PACK_MAGIC_LEN) != 0 ||
+		! trace_file->read(&version) || SIRIUS_PACK_VERSION != version ||
+		! trace_file->read(&rankCount) ) {
+
+		fatal(CALL_INFO, -1, "Error: %s is not a packed SIRIUS trace, use sst-siriuspack\n", trace_path.c_str());
+	}
+
+	if( (uint32_t) rank() >= rankCount ) {
+		fatal(CALL_INFO, -1, "Error: packed SIRIUS trace %s holds %" PRIu32 " ranks, no trace for rank %" PRIu32 "\n",
+			trace_path.c_str(), rankCount, (uint32_t) rank());
+	}
+
+	// The index entry for this rank locates its trace in the file
+	uint64_t offset = 0;
+	uint64_t length = 0;
+
+	if( ! trace_file->seek(trace_file->tell() + (rank() * 2 * sizeof(uint64_t))) ||
+		! trace_file->read(&offset) || ! trace_file->read(&length) ||
+		! trace_file->setWindow(offset, length) ) {
+
+		fatal(CALL_INFO, -1, "Error: packed SIRIUS trace %s has a corrupt index entry for rank %" PRIu32 "\n",
+			trace_path.c_str(), (uint32_t) rank());
+	}
+
+	verbose(CALL_INFO, 1, 0, "Successfully opened packed SIRIUS trace: %s, rank trace at %" PRIu64 " (%" PRIu64 " bytes)\n",
+		trace_path.c_str(), offset, length);
 }
 
 void EmberSIRIUSTraceGenerator::enqueueCompute( std::queue<EmberEvent*>& evQ,
@@ -448,11 +490,9 @@ void EmberSIRIUSTraceGenerator::readMPIFinalize( std::queue<EmberEvent*>& evQ )
 
 double EmberSIRIUSTraceGenerator::readTime() const {
 	double tmp = 0;
-	size_t readLen = fread(&tmp, sizeof(tmp), 1, trace_file);
-
-	if( 1 != readLen ) {
-		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size read %" PRIu64 " != %" PRIu64 "\n",
-			(uint64_t) readLen, (uint64_t) sizeof(tmp));
+	if( ! trace_file->read(&tmp) ) {
+		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size left %" PRIu64 " < %" PRIu64 "\n",
+			trace_file->remaining(), (uint64_t) sizeof(tmp));
 	}
 
 	return tmp;
@@ -460,11 +500,9 @@ double EmberSIRIUSTraceGenerator::readTime() const {
 
 uint32_t EmberSIRIUSTraceGenerator::readUINT32() const {
 	uint32_t tmp = 0;
-	size_t readLen = fread(&tmp, sizeof(tmp), 1, trace_file);
-
-	if( 1 != readLen ) {
-		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size read %" PRIu64 " != %" PRIu64 "\n",
-			(uint64_t) readLen, (uint64_t) sizeof(tmp));
+	if( ! trace_file->read(&tmp) ) {
+		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size left %" PRIu64 " < %" PRIu64 "\n",
+			trace_file->remaining(), (uint64_t) sizeof(tmp));
 	}
 
 	return tmp;
@@ -472,11 +510,9 @@ uint32_t EmberSIRIUSTraceGenerator::readUINT32() const {
 
 uint64_t EmberSIRIUSTraceGenerator::readUINT64() const {
 	uint64_t tmp = 0;
-	size_t readLen = fread(&tmp, sizeof(tmp), 1, trace_file);
-
-	if( 1 != readLen ) {
-		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size read %" PRIu64 " != %" PRIu64 "\n",
-			(uint64_t) readLen, (uint64_t) sizeof(tmp));
+	if( ! trace_file->read(&tmp) ) {
+		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size left %" PRIu64 " < %" PRIu64 "\n",
+			trace_file->remaining(), (uint64_t) sizeof(tmp));
 	}
 
 	return tmp;
@@ -484,11 +520,9 @@ uint64_t EmberSIRIUSTraceGenerator::readUINT64() const {
 
 int32_t EmberSIRIUSTraceGenerator::readINT32() const {
 	int32_t tmp = 0;
-	size_t readLen = fread(&tmp, sizeof(tmp), 1, trace_file);
-
-	if( 1 != readLen ) {
-		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size read %" PRIu64 " != %" PRIu64 "\n",
-			(uint64_t) readLen, (uint64_t) sizeof(tmp));
+	if( ! trace_file->read(&tmp) ) {
+		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace, size left %" PRIu64 " < %" PRIu64 "\n",
+			trace_file->remaining(), (uint64_t) sizeof(tmp));
 	}
 
 	return tmp;
@@ -497,9 +531,7 @@ int32_t EmberSIRIUSTraceGenerator::readINT32() const {
 const Communicator* EmberSIRIUSTraceGenerator::readCommunicator() const {
 	uint32_t comm;
 
-	size_t readLen = fread(&comm, sizeof(comm), 1, trace_file);
-
-        if( 1 != readLen ) {
+	if( ! trace_file->read(&comm) ) {
                 fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace.\n");
         }
 
@@ -521,9 +553,7 @@ const Communicator* EmberSIRIUSTraceGenerator::readCommunicator() const {
 PayloadDataType EmberSIRIUSTraceGenerator::readDataType() const {
 	uint32_t dType;
 
-	size_t readLen = fread(&dType, sizeof(dType), 1, trace_file);
-
-	if( 1 != readLen ) {
+	if( ! trace_file->read(&dType) ) {
 		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace.\n");
 	}
 
@@ -572,9 +602,7 @@ size_t EmberSIRIUSTraceGenerator::getTypeElementSize(const PayloadDataType dType
 ReductionOperation EmberSIRIUSTraceGenerator::readReductionOp() const {
 	uint32_t opType;
 
-	size_t readLen = fread(&opType, sizeof(opType), 1, trace_file);
-
-	if( 1 != readLen ) {
+	if( ! trace_file->read(&opType) ) {
 		fatal(CALL_INFO, -1, "I/O Error reading from SIRIUS trace.\n");
 	}
 
@@ -18,6 +18,7 @@
 #define _H_EMBER_SIRIUS_TRACE_MOTIF
 
 #include "mpi/embermpigen.h"
+#include "embermappedfile.h"
 #include <unordered_map>
 
 #include "sirius/siriusglobals.h"
@@ -39,6 +40,7 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS(
         {       "arg.traceprefix",              "Sets the trace prefix for loading SIRIUS files", "" },
+        {       "arg.tracefile",                "Packed SIRIUS trace written by sst-siriuspack, used instead of the per-rank files under arg.traceprefix", "" },
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -80,11 +82,12 @@ public:
 	}
 
 private:
-	FILE* trace_file;
+	EmberMappedFile* trace_file;
 	std::unordered_map<uint32_t, Communicator*> communicatorMap;
 	std::unordered_map<uint64_t, MessageRequest*> liveRequests;
 	double currentTraceTime;
 
+	void openPackedTrace(const std::string& trace_path);
 	double readTime() const;
 	uint32_t readUINT32() const;
 	uint64_t readUINT64() const;
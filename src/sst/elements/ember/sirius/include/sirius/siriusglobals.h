@@ -57,3 +57,10 @@
 #define SIRIUS_MPI_MIN 17
 
 #define SIRIUS_MPI_REQUEST_NULL UINT64_MAX
+
+// Packed traces written by sst-siriuspack: the per-rank traces of a job in
+// one file, "SIRIUSPK", uint32 version, uint32 rank count, then a uint64
+// offset and uint64 length per rank, followed by the traces themselves
+#define SIRIUS_PACK_MAGIC "SIRIUSPK"
+#define SIRIUS_PACK_MAGIC_LEN 8
+#define SIRIUS_PACK_VERSION 1
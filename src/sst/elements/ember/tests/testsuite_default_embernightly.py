@@ -4,6 +4,8 @@ from sst_unittest import *
 from sst_unittest_support import *
 
 import os
+import struct
+import subprocess
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -46,14 +48,22 @@ class testcase_EmberNightly(SSTTestCase):
     def test_Ember_Nightly(self):
         self.Ember_test_template("test_embernightly", otherargs = "", testoutput = True)
 
+    # Inlined events must not change the timing, so this shares the default run's reference file
+    def test_Ember_Nightly_Inline(self):
+        otherargs = '--model-options \"--simConfig=defaultSim --param=ember:inlineEvents=1\"'
+        self.Ember_test_template("test_embernightly_inline", otherargs = otherargs, testoutput = True, reftestcase = "test_embernightly")
+
     def test_Ember_Params(self):
         otherargs = '--verbose --model-options \"--topo=torus --shape=4x4x4 --cmdLine=\"Init\" --cmdLine=\"Allreduce\" --cmdLine=\"Fini\" \"'
         self.Ember_test_template("test_emberparams", otherargs = otherargs, testoutput = False)
 
+    def test_Ember_SIRIUS_Packed(self):
+        self.Ember_SIRIUS_test_template("test_embersiriuspacked", ranks = 4)
+
 
 #####
 
-    def Ember_test_template(self, testcase, otherargs, testoutput):
+    def Ember_test_template(self, testcase, otherargs, testoutput, reftestcase = None):
 
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -66,7 +76,9 @@ class testcase_EmberNightly(SSTTestCase):
         # Set the various file paths
         testDataFileName="{0}".format(testcase)
 
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        if reftestcase is None:
+            reftestcase = testcase
+        reffile = "{0}/refFiles/{1}.out".format(test_path, reftestcase)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
@@ -77,6 +89,13 @@ class testcase_EmberNightly(SSTTestCase):
 
 #        testing_remove_component_warning_from_file(outfile)
 
+        # emberLoad.py echoes each --param override, which the reference output does not have
+        if "--param=" in otherargs:
+            with open(outfile, 'r') as fp:
+                lines = [line for line in fp if not line.startswith("set emberParams ")]
+            with open(outfile, 'w') as fp:
+                fp.writelines(lines)
+
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
         #       DEVELOPER AGAINST THE LATEST VERSION OF SST TO SEE IF THE
@@ -89,6 +108,74 @@ class testcase_EmberNightly(SSTTestCase):
         self.assertFalse(os_test_file(errfile, "-s"), "Ember Nightly Test {0} has Non-empty Error File {1}".format(testDataFileName, errfile))
 
 
+    # Runs a small generated SIRIUS trace from its per-rank files and again
+    # after packing it with sst-siriuspack; the per-rank run is the reference
+    # output for the packed run
+    def Ember_SIRIUS_test_template(self, testcase, ranks):
+
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        self.emberSweep_Folder = "{0}/embernightly_folder".format(tmpdir)
+
+        siriuspack = shutil.which("sst-siriuspack")
+        if siriuspack is None:
+            self.skipTest("Ember SIRIUS Test {0} skipped, sst-siriuspack is not in the path".format(testcase))
+
+        traceprefix = "{0}/{1}".format(self.emberSweep_Folder, testcase)
+        tracefile = "{0}.pack".format(traceprefix)
+        self._writeSIRIUSTrace(traceprefix, ranks)
+
+        packlog = "{0}/{1}_pack.out".format(outdir, testcase)
+        with open(packlog, "w") as f:
+            rtn = subprocess.call([siriuspack, traceprefix, str(ranks), tracefile], stdout=f, stderr=subprocess.STDOUT)
+        self.assertEqual(rtn, 0, "Ember SIRIUS Test {0} failed to pack the trace, see {1}".format(testcase, packlog))
+
+        results = {}
+        for variant, motifarg in (("unpacked", "traceprefix=" + traceprefix),
+                                  ("packed", "tracefile=" + tracefile)):
+            outfile = "{0}/{1}_{2}.out".format(outdir, testcase, variant)
+            errfile = "{0}/{1}_{2}.err".format(outdir, testcase, variant)
+            mpioutfiles = "{0}/{1}_{2}.testfile".format(outdir, testcase, variant)
+            sdlfile = "{0}/../test/emberLoad.py".format(test_path)
+            otherargs = '--model-options \"--topo=torus --shape={0} --cmdLine=\"Init\" --cmdLine=\"SIRIUSTrace {1}\" --cmdLine=\"Fini\" \"'.format(ranks, motifarg)
+
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, set_cwd=self.emberSweep_Folder, mpi_out_files=mpioutfiles)
+
+            self.assertFalse(os_test_file(errfile, "-s"), "Ember SIRIUS Test {0} has Non-empty Error File {1}".format(testcase, errfile))
+
+            # The motif line names the trace, which is all that differs between the runs
+            with open(outfile) as f:
+                results[variant] = [line for line in f if not line.startswith("EMBER: Motif=")]
+
+        completed = [line for line in results["unpacked"] if line.startswith("Simulation is complete")]
+        self.assertEqual(len(completed), 1, "Ember SIRIUS Test {0} did not complete".format(testcase))
+        self.assertEqual(results["packed"], results["unpacked"], "Ember SIRIUS Test {0} packed trace output does not match the per-rank trace output".format(testcase))
+
+    # Each rank computes, exchanges 64 doubles with its neighbour (even ranks
+    # send first), then joins a barrier
+    def _writeSIRIUSTrace(self, traceprefix, ranks):
+        SIRIUS_MPI_INIT = 1
+        SIRIUS_MPI_FINALIZE = 2
+        SIRIUS_MPI_SEND = 4
+        SIRIUS_MPI_RECV = 16
+        SIRIUS_MPI_BARRIER = 64
+        SIRIUS_MPI_DOUBLE = 2
+        SIRIUS_MPI_COMM_WORLD = 0
+
+        for rank in range(ranks):
+            peer = rank ^ 1
+            now = 1.0e-6 * (rank + 1)
+            with open("{0}.{1}".format(traceprefix, rank), "wb") as f:
+                f.write(struct.pack("=Iddi", SIRIUS_MPI_INIT, 0.0, 0.0, 0))
+                for op in ((SIRIUS_MPI_SEND, SIRIUS_MPI_RECV) if rank % 2 == 0 else (SIRIUS_MPI_RECV, SIRIUS_MPI_SEND)):
+                    f.write(struct.pack("=IdQIIiiIdi", op, now, 0, 64, SIRIUS_MPI_DOUBLE, peer, 7, SIRIUS_MPI_COMM_WORLD, now + 2.0e-6, 0))
+                    now += 5.0e-6
+                f.write(struct.pack("=IdIdi", SIRIUS_MPI_BARRIER, now, SIRIUS_MPI_COMM_WORLD, now + 1.0e-6, 0))
+                now += 3.0e-6
+                f.write(struct.pack("=Iddi", SIRIUS_MPI_FINALIZE, now, now, 0))
+
 ###############################################
 
     def _setupEmberTestFiles(self):
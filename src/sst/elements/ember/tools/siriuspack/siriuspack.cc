@@ -0,0 +1,125 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <string>
+
+#include "sirius/siriusglobals.h"
+
+void usage() {
+	printf("Usage: siriuspack <trace prefix> <number ranks> <file out>\n");
+	printf("<trace prefix>   Is the prefix of the per-rank SIRIUS traces (<prefix>.<rank>)\n");
+	printf("<no ranks>       Is the number of ranks traced\n");
+	printf("<file out>       Is the packed, indexed trace to be written\n");
+	exit(-1);
+}
+
+int main(int argc, char* argv[]) {
+	printf("SST SIRIUS Trace Packer\n");
+
+	if(argc < 4) {
+		usage();
+	}
+
+	const std::string tracePrefix(argv[1]);
+	const uint32_t rankCount = (uint32_t) atoi(argv[2]);
+	const uint32_t version = SIRIUS_PACK_VERSION;
+
+	FILE* outTrace = fopen(argv[3], "wb");
+	if(NULL == outTrace) {
+		fprintf(stderr, "Unable to open output trace: %s\n", argv[3]);
+		exit(-1);
+	}
+
+	fwrite(SIRIUS_PACK_MAGIC, 1, SIRIUS_PACK_MAGIC_LEN, outTrace);
+	fwrite(&version, sizeof(version), 1, outTrace);
+	fwrite(&rankCount, sizeof(rankCount), 1, outTrace);
+
+	const uint64_t rankIndexOffset = SIRIUS_PACK_MAGIC_LEN + sizeof(version) + sizeof(rankCount);
+	uint64_t nextFileIndex = rankIndexOffset + (rankCount * 2 * sizeof(uint64_t));
+
+	// Reserve the index, filled in as each rank's trace is copied
+	const uint64_t emptyEntry = 0;
+	for(uint32_t i = 0; i < (rankCount * 2); i++) {
+		fwrite(&emptyEntry, sizeof(emptyEntry), 1, outTrace);
+	}
+
+	char* copyBuffer = (char*) malloc(sizeof(char) * 1048576);
+
+	for(uint32_t i = 0; i < rankCount; i++) {
+		char rankSuffix[16];
+		snprintf(rankSuffix, sizeof(rankSuffix), ".%" PRIu32, i);
+		const std::string tracePath = tracePrefix + rankSuffix;
+
+		FILE* inTrace = fopen(tracePath.c_str(), "rb");
+		if(NULL == inTrace) {
+			fprintf(stderr, "Unable to open input trace: %s\n", tracePath.c_str());
+			exit(-1);
+		}
+
+		uint32_t firstEvent = 0;
+		if(1 != fread(&firstEvent, sizeof(firstEvent), 1, inTrace) ||
+			SIRIUS_MPI_INIT != firstEvent) {
+
+			fprintf(stderr, "Trace does not start with an MPI init event: %s\n", tracePath.c_str());
+			exit(-1);
+		}
+
+		rewind(inTrace);
+
+		printf("Packing rank %" PRIu32 " at index: %" PRIu64 "...\n", i, nextFileIndex);
+
+		uint64_t traceLength = 0;
+		size_t readLen = 0;
+
+		fseek(outTrace, nextFileIndex, SEEK_SET);
+
+		while( (readLen = fread(copyBuffer, 1, 1048576, inTrace)) > 0 ) {
+			if(readLen != fwrite(copyBuffer, 1, readLen, outTrace)) {
+				fprintf(stderr, "Error writing output trace: %s\n", argv[3]);
+				exit(-1);
+			}
+
+			traceLength += readLen;
+		}
+
+		if(ferror(inTrace)) {
+			fprintf(stderr, "Error reading input trace: %s\n", tracePath.c_str());
+			exit(-1);
+		}
+
+		fclose(inTrace);
+
+		// Update the rank index
+		fseek(outTrace, rankIndexOffset + (i * 2 * sizeof(uint64_t)), SEEK_SET);
+		fwrite(&nextFileIndex, sizeof(nextFileIndex), 1, outTrace);
+		fwrite(&traceLength, sizeof(traceLength), 1, outTrace);
+
+		nextFileIndex += traceLength;
+	}
+
+	free(copyBuffer);
+
+	if(0 != fclose(outTrace)) {
+		fprintf(stderr, "Error writing output trace: %s\n", argv[3]);
+		exit(-1);
+	}
+
+	return 0;
+}
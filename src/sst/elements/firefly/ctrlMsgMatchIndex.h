@@ -0,0 +1,250 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_CTRL_MSG_MATCH_INDEX_H
+#define COMPONENTS_FIREFLY_CTRL_MSG_MATCH_INDEX_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Firefly {
+namespace CtrlMsg {
+
+/*
+ * Posted receive queue indexed by (communicator, source, tag).
+ *
+ * Receives are bucketed by how they match: fully specified, any source,
+ * any tag (AnyTag or a non-zero ignore mask) and any source with any tag.
+ * Each bucket keeps its receives in posting order and every receive carries
+ * a posting sequence number, so a message is matched against the head of at
+ * most four buckets and the earliest posted candidate wins, which is the
+ * MPI ordering rule including wildcards. The full header check (count,
+ * dtypeSize, masked tag) is still applied by the caller's predicate.
+ *
+ * The modeled matching cost is the number of entries a linear scan of the
+ * posting-ordered queue would have examined. A Fenwick tree over sequence
+ * numbers gives that position in O(log n) independent of how the match was
+ * actually found.
+ */
+template< class Req, uint64_t AnyTagV, uint32_t AnySrcV >
+class MatchIndex {
+
+    struct Entry {
+        Entry( Req* _req, uint64_t _seq ) : req(_req), seq(_seq) {}
+        Req*     req;
+        uint64_t seq;
+    };
+
+    enum Kind { Exact, AnySrcKind, AnyTagKind, AnyBoth, NumKinds };
+
+    struct Key {
+        uint64_t tag;
+        uint32_t rank;
+        uint32_t group;
+        bool operator==( const Key& o ) const {
+            return tag == o.tag && rank == o.rank && group == o.group;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()( const Key& k ) const {
+            uint64_t h = k.tag * 0x9E3779B97F4A7C15ULL;
+            h ^= ( (uint64_t) k.rank << 32 | k.group ) + 0x7F4A7C15 + (h << 6) + (h >> 2);
+            return (size_t) h;
+        }
+    };
+
+    typedef std::deque< Entry > Bucket;
+    typedef std::unordered_map< Key, Bucket, KeyHash > BucketMap;
+
+  public:
+    MatchIndex() : m_size(0), m_nextSeq(0) {
+        m_tree.assign( 64 + 1, 0 );
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return 0 == m_size; }
+
+    void push_back( Req* req ) {
+        if ( m_nextSeq + 1 >= m_tree.size() ) {
+            compact();
+        }
+        uint64_t seq = m_nextSeq++;
+        m_buckets[ kind( req->hdr(), req->ignore() ) ][ wantKey( req ) ].push_back( Entry( req, seq ) );
+        add( seq, 1 );
+        ++m_size;
+    }
+
+    /*
+     * Removes and returns the earliest posted receive for which
+     * match( hdr, req->hdr(), req->ignore() ) holds, or NULL. count is
+     * advanced by the number of entries a linear scan would have examined.
+     */
+    template< class Pred >
+    Req* match( MatchHdr& hdr, int& count, Pred pred ) {
+        BucketMap* map = NULL;
+        typename BucketMap::iterator bucket;
+        typename Bucket::iterator best;
+        bool found = false;
+
+        for ( int k = 0; k < NumKinds; k++ ) {
+            typename BucketMap::iterator b = m_buckets[k].find( msgKey( (Kind) k, hdr ) );
+            if ( b == m_buckets[k].end() ) {
+                continue;
+            }
+            typename Bucket::iterator e = b->second.begin();
+            for ( ; e != b->second.end(); ++e ) {
+                if ( found && e->seq > best->seq ) {
+                    break;
+                }
+                if ( pred( hdr, e->req->hdr(), e->req->ignore() ) ) {
+                    map = &m_buckets[k];
+                    bucket = b;
+                    best = e;
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        if ( ! found ) {
+            count += m_size;
+            return NULL;
+        }
+
+        Req* req = best->req;
+        count += position( best->seq );
+        remove( *map, bucket, best );
+        return req;
+    }
+
+    bool erase( Req* req ) {
+        BucketMap& map = m_buckets[ kind( req->hdr(), req->ignore() ) ];
+        typename BucketMap::iterator b = map.find( wantKey( req ) );
+        if ( b == map.end() ) {
+            return false;
+        }
+        typename Bucket::iterator e = b->second.begin();
+        for ( ; e != b->second.end(); ++e ) {
+            if ( e->req == req ) {
+                remove( map, b, e );
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+
+    static Kind kind( MatchHdr& want, uint64_t ignore ) {
+        bool anyTag = ( AnyTagV == want.tag ) || ( 0 != ignore );
+        bool anySrc = ( AnySrcV == want.rank );
+        if ( anyTag ) {
+            return anySrc ? AnyBoth : AnyTagKind;
+        }
+        return anySrc ? AnySrcKind : Exact;
+    }
+
+    static Key makeKey( Kind k, uint32_t group, uint32_t rank, uint64_t tag ) {
+        Key key;
+        key.group = group;
+        key.rank = ( k == Exact || k == AnyTagKind ) ? rank : 0;
+        key.tag = ( k == Exact || k == AnySrcKind ) ? tag : 0;
+        return key;
+    }
+
+    static Key wantKey( Req* req ) {
+        MatchHdr& want = req->hdr();
+        return makeKey( kind( want, req->ignore() ), want.group, want.rank, want.tag );
+    }
+
+    static Key msgKey( Kind k, MatchHdr& hdr ) {
+        return makeKey( k, hdr.group, hdr.rank, hdr.tag );
+    }
+
+    void remove( BucketMap& map, typename BucketMap::iterator b,
+                                typename Bucket::iterator e ) {
+        add( e->seq, -1 );
+        --m_size;
+        b->second.erase( e );
+        if ( b->second.empty() ) {
+            map.erase( b );
+        }
+    }
+
+    // 1-based position of seq among the live entries in posting order
+    int position( uint64_t seq ) const {
+        int sum = 0;
+        for ( size_t i = seq + 1; i > 0; i -= i & -i ) {
+            sum += m_tree[i];
+        }
+        return sum;
+    }
+
+    void add( uint64_t seq, int delta ) {
+        for ( size_t i = seq + 1; i < m_tree.size(); i += i & -i ) {
+            m_tree[i] += delta;
+        }
+    }
+
+    // Renumber live entries 0..size-1 in posting order and size the tree so
+    // at least half of it is free for new postings
+    void compact() {
+        std::vector< Entry* > live;
+        live.reserve( m_size );
+        for ( int k = 0; k < NumKinds; k++ ) {
+            typename BucketMap::iterator b = m_buckets[k].begin();
+            for ( ; b != m_buckets[k].end(); ++b ) {
+                typename Bucket::iterator e = b->second.begin();
+                for ( ; e != b->second.end(); ++e ) {
+                    live.push_back( &(*e) );
+                }
+            }
+        }
+        std::sort( live.begin(), live.end(), seqLess );
+
+        size_t cap = m_tree.size() - 1;
+        while ( cap < 2 * ( live.size() + 1 ) ) {
+            cap *= 2;
+        }
+        m_tree.assign( cap + 1, 0 );
+
+        for ( size_t i = 0; i < live.size(); i++ ) {
+            live[i]->seq = i;
+            add( i, 1 );
+        }
+        m_nextSeq = live.size();
+    }
+
+    static bool seqLess( const Entry* a, const Entry* b ) {
+        return a->seq < b->seq;
+    }
+
+    BucketMap           m_buckets[NumKinds];
+    size_t              m_size;
+    uint64_t            m_nextSeq;
+    std::vector<int>    m_tree;
+};
+
+}
+}
+}
+
+#endif
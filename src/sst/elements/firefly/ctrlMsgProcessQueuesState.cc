@@ -407,15 +407,10 @@ void ProcessQueuesState::processMakeProgress( Stack* stack )
 
 void ProcessQueuesState::enterCancel( MP::MessageRequest req, uint64_t exitDelay ) {
 
-    std::deque< _CommReq* >:: iterator iter = m_pstdRcvQ.begin();
-    for ( ; iter != m_pstdRcvQ.end(); ++iter ) {
-
-		if ( *iter == req ) {
-    		dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",*iter);
-			delete( *iter );
-        	m_pstdRcvQ.erase(iter);
-			break;
-		}
+    _CommReq* commReq = static_cast<_CommReq*>(req);
+    if ( m_pstdRcvQ.erase( commReq ) ) {
+        dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",commReq);
+        delete commReq;
     }
     enterMakeProgress(m_exitDelay);
 }
@@ -986,6 +981,20 @@ _CommReq* ProcessQueuesState::searchPostedRecv( std::deque< _CommReq* >& pstd, M
     return req;
 }
 
+_CommReq* ProcessQueuesState::searchPostedRecv( PostedRecvIndex& pstd, MatchHdr& hdr, int& count )
+{
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"posted size %lu\n",pstd.size());
+
+    _CommReq* req = pstd.match( hdr, count,
+        [this]( MatchHdr& hdr, MatchHdr& wantHdr, uint64_t ignore ) {
+            return checkMatchHdr( hdr, wantHdr, ignore );
+        }
+    );
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"req=%p count=%d\n",req,count);
+
+    return req;
+}
+
 bool ProcessQueuesState::checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr,
                                     uint64_t ignore )
 {
@@ -27,6 +27,7 @@
 #include "loopBack.h"
 
 #include "ctrlMsgCommReq.h"
+#include "ctrlMsgMatchIndex.h"
 #include "ctrlMsgWaitReq.h"
 
 #define DBG_MSK_PQS_APP_SIDE 1 << 0
@@ -265,6 +266,7 @@ class ProcessQueuesState : public SubComponent
     };
 
     typedef std::deque<FuncCtxBase*> Stack;
+    typedef MatchIndex< _CommReq, AnyTag, MP::AnySrc > PostedRecvIndex;
 
     class ProcessQueuesCtx : public FuncCtxBase {
 	  public:
@@ -380,6 +382,7 @@ class ProcessQueuesState : public SubComponent
 
     bool        checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr, uint64_t ignore );
     _CommReq*	searchPostedRecv( std::deque< _CommReq* >& pstd, MatchHdr& hdr, int& delay );
+    _CommReq*	searchPostedRecv( PostedRecvIndex& pstd, MatchHdr& hdr, int& delay );
 
     void exit( int delay = 0 ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"exit ProcessQueuesState\n");
@@ -480,7 +483,7 @@ class ProcessQueuesState : public SubComponent
     int     m_numRecvLooped;
     bool    m_missedInt;
 
-    std::deque< _CommReq* >         m_pstdRcvQ;
+    PostedRecvIndex                 m_pstdRcvQ;
     std::deque< _CommReq* >         m_pstdRcvPreQ;
     std::vector<std::deque< Msg* >> m_recvdMsgQ;
 	int m_recvdMsgQpos;
@@ -170,7 +170,7 @@ void Sieve::processEvent(SST::Event* ev) {
     // Currently, Ariel does not care about the payload.  Therefore,
     // there is no need to construct the payload.
 
-    responseEvent->setDst(event->getSrc());
+    responseEvent->setDstId(event->getSrcId());
     SST::Link * link = event->getDeliveryLink();
     link->send(responseEvent);
 
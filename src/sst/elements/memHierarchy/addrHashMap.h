@@ -0,0 +1,394 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_ADDRHASHMAP_H
+#define MEMHIERARCHY_ADDRHASHMAP_H
+
+#include <vector>
+#include <utility>
+#include <stdint.h>
+#include <cstddef>
+
+#include "sst/elements/memHierarchy/util.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Open-addressing hash map keyed by (line) address, used for MSHR lookups.
+ *
+ * Linear probing over a power-of-two table with backward-shift deletion so
+ * no tombstones accumulate. Exposes the subset of the std::map interface the
+ * MSHRs use (find/end/insert/erase/operator[]/iteration) so it is a drop-in
+ * replacement. Unlike std::map, insert and erase may move other entries,
+ * so iterators and references into the map are invalidated by either.
+ * Iteration order is unspecified.
+ */
+template <typename V>
+class AddrHashMap {
+public:
+    typedef std::pair<Addr, V> value_type;
+
+    template <typename MapT, typename ValT>
+    class iter_base {
+    public:
+        iter_base() : map_(nullptr), idx_(0) { }
+        iter_base(MapT* map, size_t idx) : map_(map), idx_(idx) { }
+        ValT& operator*() const { return map_->slots_[idx_]; }
+        ValT* operator->() const { return &(map_->slots_[idx_]); }
+        iter_base& operator++() { idx_ = map_->nextUsed(idx_ + 1); return *this; }
+        iter_base operator++(int) { iter_base tmp = *this; ++(*this); return tmp; }
+        bool operator==(const iter_base& o) const { return idx_ == o.idx_; }
+        bool operator!=(const iter_base& o) const { return idx_ != o.idx_; }
+    private:
+        friend class AddrHashMap;
+        MapT* map_;
+        size_t idx_;
+    };
+    typedef iter_base<AddrHashMap, value_type> iterator;
+    typedef iter_base<const AddrHashMap, const value_type> const_iterator;
+
+    AddrHashMap(size_t initCapacity = 16) : size_(0), lastProbe_(0), lookups_(0), probes_(0), maxProbe_(0) {
+        size_t cap = 8;
+        while (cap < initCapacity) cap <<= 1;
+        resize(cap);
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return slots_.size(); }
+
+    iterator begin() { return iterator(this, nextUsed(0)); }
+    iterator end() { return iterator(this, slots_.size()); }
+    const_iterator begin() const { return const_iterator(this, nextUsed(0)); }
+    const_iterator end() const { return const_iterator(this, slots_.size()); }
+
+    iterator find(Addr key) {
+        return iterator(this, locate(key));
+    }
+
+    const_iterator find(Addr key) const {
+        return const_iterator(this, const_cast<AddrHashMap*>(this)->locate(key));
+    }
+
+    size_t count(Addr key) const { return find(key) != end() ? 1 : 0; }
+
+    std::pair<iterator,bool> insert(const value_type& val) {
+        size_t idx = locate(val.first);
+        if (idx != slots_.size())
+            return std::make_pair(iterator(this, idx), false);
+        idx = place(val.first);
+        slots_[idx].second = val.second;
+        return std::make_pair(iterator(this, idx), true);
+    }
+
+    V& operator[](Addr key) {
+        size_t idx = locate(key);
+        if (idx == slots_.size())
+            idx = place(key);
+        return slots_[idx].second;
+    }
+
+    size_t erase(Addr key) {
+        size_t idx = locate(key);
+        if (idx == slots_.size())
+            return 0;
+        eraseSlot(idx);
+        return 1;
+    }
+
+    void erase(iterator it) { eraseSlot(it.idx_); }
+
+    void clear() {
+        for (size_t i = 0; i < slots_.size(); i++) {
+            if (used_[i]) {
+                slots_[i].second = V();
+                used_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    /* Probe statistics: slots examined by the most recent lookup and totals since construction */
+    uint64_t getLastProbeLength() const { return lastProbe_; }
+    uint64_t getLookupCount() const { return lookups_; }
+    uint64_t getProbeCount() const { return probes_; }
+    uint64_t getMaxProbeLength() const { return maxProbe_; }
+
+private:
+    /* Fibonacci hashing; line addresses have zero low bits so take the high bits of the product */
+    size_t home(Addr key) const {
+        return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+    size_t nextUsed(size_t idx) const {
+        while (idx < used_.size() && !used_[idx]) idx++;
+        return idx;
+    }
+
+    /* Returns slot index of key or slots_.size() if not present */
+    size_t locate(Addr key) {
+        size_t idx = home(key);
+        uint64_t probe = 1;
+        while (used_[idx]) {
+            if (slots_[idx].first == key) {
+                recordProbe(probe);
+                return idx;
+            }
+            idx = (idx + 1) & mask_;
+            probe++;
+        }
+        recordProbe(probe);
+        return slots_.size();
+    }
+
+    void recordProbe(uint64_t probe) {
+        lastProbe_ = probe;
+        lookups_++;
+        probes_ += probe;
+        if (probe > maxProbe_) maxProbe_ = probe;
+    }
+
+    /* Claim a slot for a key known not to be present. Keeps load factor <= 3/4 */
+    size_t place(Addr key) {
+        if ((size_ + 1) * 4 > slots_.size() * 3)
+            resize(slots_.size() * 2);
+        size_t idx = home(key);
+        while (used_[idx])
+            idx = (idx + 1) & mask_;
+        used_[idx] = 1;
+        slots_[idx].first = key;
+        size_++;
+        return idx;
+    }
+
+    void eraseSlot(size_t idx) {
+        size_t hole = idx;
+        size_t next = (hole + 1) & mask_;
+        while (used_[next]) {
+            size_t h = home(slots_[next].first);
+            /* Shift back any entry whose home is not cyclically in (hole, next] */
+            bool inRange = (hole <= next) ? (hole < h && h <= next) : (hole < h || h <= next);
+            if (!inRange) {
+                slots_[hole] = std::move(slots_[next]);
+                hole = next;
+            }
+            next = (next + 1) & mask_;
+        }
+        slots_[hole].second = V();
+        used_[hole] = 0;
+        size_--;
+    }
+
+    void resize(size_t cap) {
+        std::vector<value_type> oldSlots;
+        std::vector<uint8_t> oldUsed;
+        oldSlots.swap(slots_);
+        oldUsed.swap(used_);
+
+        slots_.resize(cap);
+        used_.assign(cap, 0);
+        mask_ = cap - 1;
+        shift_ = 64;
+        for (size_t c = cap; c > 1; c >>= 1) shift_--;
+
+        for (size_t i = 0; i < oldSlots.size(); i++) {
+            if (!oldUsed[i]) continue;
+            size_t idx = home(oldSlots[i].first);
+            while (used_[idx])
+                idx = (idx + 1) & mask_;
+            used_[idx] = 1;
+            slots_[idx] = std::move(oldSlots[i]);
+        }
+    }
+
+    std::vector<value_type> slots_;
+    std::vector<uint8_t> used_;
+    size_t size_;
+    size_t mask_;
+    unsigned int shift_;
+
+    uint64_t lastProbe_;
+    uint64_t lookups_;
+    uint64_t probes_;
+    uint64_t maxProbe_;
+};
+
+/*
+ * Per-address FIFO queues whose entries come from a slab pool, for MSHRs
+ * that hold a queue of entries per line (e.g., Scratchpad and
+ * CoherentMemController). The queues mirror the std::list calls those
+ * MSHRs make. Entries are linked by pool index and slabs never move, so
+ * pointers to a queued entry stay valid until it is removed. Removed
+ * entries are reset to T() and reused instead of freed.
+ */
+template <typename T>
+class AddrQueueMap {
+    static const uint32_t NoSlot = 0xFFFFFFFF;
+    static const uint32_t SlabShift = 6;
+    static const uint32_t SlabMask = (1 << SlabShift) - 1;
+
+    struct Slot {
+        T entry;
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    class Pool {
+    public:
+        Pool() : free_(NoSlot) { }
+        ~Pool() {
+            for (size_t i = 0; i < slabs_.size(); i++)
+                delete [] slabs_[i];
+        }
+
+        Slot& slot(uint32_t idx) { return slabs_[idx >> SlabShift][idx & SlabMask]; }
+
+        uint32_t alloc(const T& entry) {
+            if (free_ == NoSlot) {
+                uint32_t base = slabs_.size() << SlabShift;
+                Slot* slab = new Slot[SlabMask + 1];
+                slabs_.push_back(slab);
+                for (uint32_t i = SlabMask + 1; i > 0; i--) {
+                    slab[i-1].next = free_;
+                    free_ = base + i - 1;
+                }
+            }
+            uint32_t idx = free_;
+            Slot& s = slot(idx);
+            free_ = s.next;
+            s.entry = entry;
+            return idx;
+        }
+
+        void release(uint32_t idx) {
+            Slot& s = slot(idx);
+            s.entry = T();
+            s.next = free_;
+            free_ = idx;
+        }
+
+    private:
+        std::vector<Slot*> slabs_;
+        uint32_t free_;
+    };
+
+public:
+    /* Handle to one address's queue; copies refer to the same entries */
+    class Queue {
+    public:
+        class iterator {
+        public:
+            iterator() : pool_(nullptr), idx_(NoSlot) { }
+            iterator(Pool* pool, uint32_t idx) : pool_(pool), idx_(idx) { }
+            T& operator*() const { return pool_->slot(idx_).entry; }
+            T* operator->() const { return &(pool_->slot(idx_).entry); }
+            iterator& operator++() { idx_ = pool_->slot(idx_).next; return *this; }
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+            bool operator==(const iterator& o) const { return idx_ == o.idx_; }
+            bool operator!=(const iterator& o) const { return idx_ != o.idx_; }
+        private:
+            friend class Queue;
+            Pool* pool_;
+            uint32_t idx_;
+        };
+
+        Queue() : pool_(nullptr), head_(NoSlot), tail_(NoSlot), size_(0) { }
+        explicit Queue(Pool* pool) : pool_(pool), head_(NoSlot), tail_(NoSlot), size_(0) { }
+
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+        T& front() { return pool_->slot(head_).entry; }
+        T& back() { return pool_->slot(tail_).entry; }
+        iterator begin() { return iterator(pool_, head_); }
+        iterator end() { return iterator(pool_, NoSlot); }
+
+        void push_back(const T& entry) { insert(end(), entry); }
+
+        /* Insert ahead of pos and return an iterator to the new entry */
+        iterator insert(iterator pos, const T& entry) {
+            uint32_t idx = pool_->alloc(entry);
+            Slot& s = pool_->slot(idx);
+            s.next = pos.idx_;
+            s.prev = (pos.idx_ == NoSlot) ? tail_ : pool_->slot(pos.idx_).prev;
+            if (s.prev == NoSlot) head_ = idx;
+            else pool_->slot(s.prev).next = idx;
+            if (s.next == NoSlot) tail_ = idx;
+            else pool_->slot(s.next).prev = idx;
+            size_++;
+            return iterator(pool_, idx);
+        }
+
+        void pop_front() {
+            uint32_t idx = head_;
+            head_ = pool_->slot(idx).next;
+            if (head_ == NoSlot) tail_ = NoSlot;
+            else pool_->slot(head_).prev = NoSlot;
+            pool_->release(idx);
+            size_--;
+        }
+
+        void clear() {
+            while (!empty())
+                pop_front();
+        }
+
+    private:
+        Pool* pool_;
+        uint32_t head_;
+        uint32_t tail_;
+        size_t size_;
+    };
+
+    typedef typename AddrHashMap<Queue>::iterator iterator;
+
+    AddrQueueMap() { }
+    /* Queues point at this map's pool */
+    AddrQueueMap(const AddrQueueMap&) = delete;
+    AddrQueueMap& operator=(const AddrQueueMap&) = delete;
+
+    iterator begin() { return map_.begin(); }
+    iterator end() { return map_.end(); }
+    iterator find(Addr key) { return map_.find(key); }
+    size_t size() const { return map_.size(); }
+
+    /* Queue for key, created empty if the key is not present. The bool is true if it was created */
+    std::pair<iterator,bool> insert(Addr key) {
+        return map_.insert(std::make_pair(key, Queue(&pool_)));
+    }
+
+    Queue& operator[](Addr key) { return insert(key).first->second; }
+
+    /* Returns any entries still queued for key to the pool */
+    size_t erase(Addr key) {
+        iterator it = map_.find(key);
+        if (it == map_.end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    void erase(iterator it) {
+        it->second.clear();
+        map_.erase(it);
+    }
+
+private:
+    Pool pool_;
+    AddrHashMap<Queue> map_;
+};
+
+}}
+
+#endif
@@ -25,6 +25,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/lineTypes.h"
+#include "sst/elements/memHierarchy/snapshot.h"
 
 using namespace std;
 
@@ -51,7 +52,12 @@ class CacheArray {
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        bool            flatTags_;  // If true, lookups scan tags_ instead of dereferencing each line
+        vector<Addr>    tags_;      // Mirror of each line's address, grouped by set; state and replacement data stay in the lines
+
+        /** Compute the set an address maps to */
+        unsigned int getSet(Addr addr) { return hash_->hash(0, toLineAddr(addr)) % numSets_; }
     public:
 
         CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
@@ -88,14 +94,22 @@ class CacheArray {
     /**** Configuration and output */
         void setSliceAware(Addr size, Addr step);
         void setBanked(unsigned int numBanks);
+        void setLayout(std::string layout);
         void printCacheArray(Output &out);
+
+    /**** Snapshots */
+        /** Write lines in stable states to a snapshot. Returns the number of valid lines skipped because they were in transition */
+        uint64_t saveSnapshot(SnapshotWriter& out);
+
+        /** Install the lines written by saveSnapshot. If restored is given, the installed lines are appended to it */
+        void loadSnapshot(SnapshotReader& in, vector<T*>* restored = nullptr);
 };
 
 /************* Function definitions *****************/
 
 template <class T>
 CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
-    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
+    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash), flatTags_(false) {
 
     // Error check parameters
     if (numLines_ == 0)
@@ -126,13 +140,13 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
     }
 
     // Construct rInfo
+    rInfo.resize(numSets_);
     for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
+        rInfo[i].reserve(associativity_);
         for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
+            rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
     }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+    ReplacementInfo * info = rInfo[0].front();
     if (!replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
 
@@ -158,12 +172,24 @@ Addr CacheArray<T>::toLineAddr(Addr addr) {
 
 template <class T>
 T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
-    Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % numSets_;
-    int setBegin = set * associativity_;
-    int setEnd = setBegin + associativity_;
+    unsigned int setBegin = getSet(addr) * associativity_;
+
+    if (flatTags_) {
+        /* Scan the set's tags without touching the line objects */
+        const Addr* tags = &tags_[setBegin];
+        for (unsigned int way = 0; way < associativity_; way++) {
+            if (tags[way] == addr) {
+                unsigned int i = setBegin + way;
+                if (updateReplacement)
+                    replacementMgr_->update(i, lines_[i]->getReplacementInfo());
+                return lines_[i];
+            }
+        }
+        return nullptr; // Not found
+    }
 
-    for (int i = setBegin; i < setEnd; i++) {
+    unsigned int setEnd = setBegin + associativity_;
+    for (unsigned int i = setBegin; i < setEnd; i++) {
         if (lines_[i]->getAddr() == addr) {
             if (updateReplacement)
                 replacementMgr_->update(i, lines_[i]->getReplacementInfo());
@@ -175,8 +201,7 @@ T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
 
 template <class T>
 T * CacheArray<T>::findReplacementCandidate(Addr addr) {
-    Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % numSets_;
+    unsigned int set = getSet(addr);
 
     unsigned int id = replacementMgr_->findBestCandidate(rInfo[set]);
 
@@ -189,7 +214,9 @@ void CacheArray<T>::replace(Addr addr, T* candidate) {
     replacementMgr_->replaced(index);
     candidate->reset();
     candidate->setAddr(addr);
-    replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+    if (flatTags_)
+        tags_[index] = addr;
+    replacementMgr_->installed(index, addr, lines_[index]->getReplacementInfo());
 }
 
 template <class T>
@@ -212,6 +239,86 @@ void CacheArray<T>::setBanked(unsigned int numBanks) {
     banks_ = numBanks;
 }
 
+/* Select how lookups find a line's address
+ * line: each lookup reads the address from the line objects in the set
+ * flat: a tag mirror. Addresses are also kept in a per-set array that lookups scan, stopping at the
+ *       first match, so only the matching line object is dereferenced. Replacement and installs
+ *       still go through the line objects, and the mirror is updated wherever a line's address changes.
+ */
+template <class T>
+void CacheArray<T>::setLayout(std::string layout) {
+    if (layout == "line") {
+        flatTags_ = false;
+        tags_.clear();
+    } else if (layout == "flat") {
+        flatTags_ = true;
+        tags_.resize(numLines_);
+        for (unsigned int i = 0; i < numLines_; i++)
+            tags_[i] = lines_[i]->getAddr();
+    } else {
+        dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: Invalid array layout '%s'. Options are 'line' or 'flat'.\n", layout.c_str());
+    }
+}
+
+/* Snapshot body:
+ *   uint32 lines, uint32 associativity, uint32 line size, uint64 line count
+ *   lines: uint32 index, uint64 address, line contents (see the line type's save())
+ * Lines are restored to the same index, so the loading cache must have the same geometry and address hash.
+ */
+template <class T>
+uint64_t CacheArray<T>::saveSnapshot(SnapshotWriter& out) {
+    uint64_t count = 0;
+    uint64_t skipped = 0;
+    for (unsigned int i = 0; i < numLines_; i++) {
+        State state = lines_[i]->getState();
+        if (isSnapshotState(state))
+            count++;
+        else if (state != I)
+            skipped++;
+    }
+
+    out.put((uint32_t)numLines_);
+    out.put((uint32_t)associativity_);
+    out.put((uint32_t)lineSize_);
+    out.put(count);
+    for (unsigned int i = 0; i < numLines_; i++) {
+        if (!isSnapshotState(lines_[i]->getState()))
+            continue;
+        out.put((uint32_t)i);
+        out.put((uint64_t)lines_[i]->getAddr());
+        lines_[i]->save(out);
+    }
+    return skipped;
+}
+
+template <class T>
+void CacheArray<T>::loadSnapshot(SnapshotReader& in, vector<T*>* restored) {
+    uint32_t lines = in.get<uint32_t>();
+    uint32_t assoc = in.get<uint32_t>();
+    uint32_t lineSize = in.get<uint32_t>();
+    if (lines != numLines_ || assoc != associativity_ || lineSize != lineSize_)
+        in.mismatch("cache array size, associativity, or line size differs");
+
+    uint64_t count = in.get<uint64_t>();
+    for (uint64_t n = 0; n < count; n++) {
+        uint32_t index = in.get<uint32_t>();
+        Addr addr = in.get<uint64_t>();
+        if (index >= numLines_ || getSet(addr) != index / associativity_)
+            in.mismatch("line does not map to the same set, check the hash function and slice parameters");
+
+        // Restored lines bypass the replacement policy's replaced/installed hooks, which would
+        // count them as misses; the policy starts from its reset state for these lines
+        T* line = lines_[index];
+        line->reset();
+        line->setAddr(addr);
+        if (flatTags_)
+            tags_[index] = addr;
+        line->load(in);
+        if (restored)
+            restored->push_back(line);
+    }
+}
+
 template <class T>
 void CacheArray<T>::printCacheArray(Output &out) {
     for (unsigned int i = 0; i < numLines_; i++) {
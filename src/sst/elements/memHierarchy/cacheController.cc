@@ -69,8 +69,8 @@ void Cache::handlePrefetchEvent(SST::Event * ev) {
 void Cache::processPrefetchEvent(SST::Event * ev) {
     MemEvent * event = static_cast<MemEvent*>(ev);
     event->setBaseAddr(toBaseAddr(event->getAddr()));
-    event->setRqstr(getName());
-    event->setSrc(getName());
+    event->setRqstrId(cacheId_);
+    event->setSrcId(cacheId_);
 
     if (!clockIsOn_) {
         turnClockOn();
@@ -143,6 +143,13 @@ bool Cache::clockTick(Cycle_t time) {
     while (it != eventBuffer_.end()) {
         if (accepted == maxRequestsPerCycle_)
             break;
+        if (eventDriven_ && parkedEvents_.find(*it) != parkedEvents_.end()) {
+            // Nothing has changed since it was rejected so the coherence manager would reject it again.
+            // Arbitrate anyway so that bank conflicts are counted as they would be with a clocked retry.
+            arbitrateAccess(static_cast<MemEvent*>(*it)->getBaseAddr());
+            it++;
+            continue;
+        }
         Command cmd = (*it)->getCmd();
         if (is_debug_event((*it))) {
             dbg_->debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:New     (%s)\n",
@@ -154,6 +161,8 @@ bool Cache::clockTick(Cycle_t time) {
             statRecvEvents->addData(1);
             it = eventBuffer_.erase(it);
         } else {
+            if (eventDriven_)
+                parkedEvents_.insert(*it);
             it++;
         }
     }
@@ -163,7 +172,12 @@ bool Cache::clockTick(Cycle_t time) {
                     Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), prefetchBuffer_.front()->getVerboseString().c_str());
             fflush(stdout);
         }
-        if (accepted != maxRequestsPerCycle_ && processEvent(prefetchBuffer_.front(), false)) {
+        if (accepted == maxRequestsPerCycle_) {
+            // Out of request slots this cycle; prefetches rejected by the coherence manager are reported there
+            for (int i = 0; i < listeners_.size(); i++)
+                listeners_[i]->notifyPrefetchResult(static_cast<MemEvent*>(prefetchBuffer_.front())->getBaseAddr(), PrefetchResult::Dropped);
+            statPrefetchDrop->addData(1);
+        } else if (processEvent(prefetchBuffer_.front(), false)) {
             accepted++;
             // Accepted prefetches are profiled in the coherence manager
         } else {
@@ -179,8 +193,14 @@ bool Cache::clockTick(Cycle_t time) {
 
     idle &= coherenceMgr_->checkIdle();
 
+    // Parked events can only make progress once something has changed
+    if (eventDriven_ && (accepted != 0 || mshr_->getSize() != parkedMSHRSize_))
+        parkedEvents_.clear();
+    parkedMSHRSize_ = mshr_->getSize();
+
     // Disable lower-level cache clocks if they're idle
-    if (eventBuffer_.empty() && retryBuffer_.empty() && idle) {
+    // In event-driven mode, waiting events that are all parked cannot make progress until another event arrives
+    if (eventBuffer_.size() == parkedEvents_.size() && retryBuffer_.empty() && idle) {
         turnClockOff();
         return true;
     }
@@ -194,9 +214,8 @@ void Cache::turnClockOn() {
     timestamp_ = time - 1;
     coherenceMgr_->updateTimestamp(timestamp_);
     int64_t cyclesOff = timestamp_ - lastActiveClockCycle_;
-    for (int64_t i = 0; i < cyclesOff; i++) {           // TODO more efficient way to do this? Don't want to add in one-shot or we get weird averages/sum sq.
-        statMSHROccupancy->addData(mshr_->getSize());
-    }
+    if (cyclesOff > 0)  // Occupancy was constant while the clock was off
+        statMSHROccupancy->addDataNTimes(cyclesOff, mshr_->getSize());
     //d_->debug(_L3_, "%s turning clock ON at cycle %" PRIu64 ", timestamp %" PRIu64 ", ns %" PRIu64 "\n", this->getName().c_str(), time, timestamp_, getCurrentSimTimeNano());
     clockIsOn_ = true;
 }
@@ -465,7 +484,7 @@ void Cache::init(unsigned int phase) {
                     getName().c_str(), memEvent->getVerboseString().c_str());
             MemEventInit * mEv = memEvent->clone();
             mEv->setSrc(getName());
-            mEv->setDst(linkDown_->findTargetDestination(mEv->getRoutingAddress()));
+            mEv->setDstId(linkDown_->findTargetDestinationId(mEv->getRoutingAddress()));
             linkDown_->sendInitData(mEv);
         }
         delete memEvent;
@@ -496,6 +515,12 @@ void Cache::setup() {
     linkUp_->setup();
     if (linkUp_ != linkDown_) linkDown_->setup();
 
+    // Load warmed state; endpoint names are known by now
+    if (!snapshotInFile_.empty()) {
+        SnapshotReader in(snapshotInFile_, "cache");
+        coherenceMgr_->loadSnapshot(in);
+    }
+
     // Enqueue the first wakeup event to check for deadlock
     if (timeout_ != 0)
         timeoutSelfLink_->send(1, nullptr);
@@ -508,6 +533,16 @@ void Cache::finish() {
     }
     for (int i = 0; i < listeners_.size(); i++)
         listeners_[i]->printStats(*out_);
+    if (!snapshotOutFile_.empty()) {
+        uint64_t skipped;
+        {
+            SnapshotWriter out(snapshotOutFile_, "cache");
+            skipped = coherenceMgr_->saveSnapshot(out);
+        }
+        if (skipped != 0)
+            out_->output("%s, Warning: %" PRIu64 " lines in transient states were not saved to snapshot %s\n",
+                    getName().c_str(), skipped, snapshotOutFile_.c_str());
+    }
     linkDown_->finish();
     if (linkUp_ != linkDown_) linkUp_->finish();
 }
@@ -517,6 +552,8 @@ void Cache::printStatus(Output &out) {
     out.output("MemHierarchy::Cache %s\n", getName().c_str());
     out.output("  Clock is %s. Last active cycle: %" PRIu64 "\n", clockIsOn_ ? "on" : "off", timestamp_);
     out.output("  Events in queues: Retry = %zu, Event = %zu, Prefetch = %zu\n", retryBuffer_.size(), eventBuffer_.size(), prefetchBuffer_.size());
+    if (eventDriven_)
+        out.output("  Parked events (waiting for a change before retry) = %zu\n", parkedEvents_.size());
     if (mshr_) {
         out.output("  MSHR Status:\n");
         mshr_->printStatus(out);
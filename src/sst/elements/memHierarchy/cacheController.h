@@ -64,6 +64,7 @@ public:
             {"coherence_protocol",      "(string) Coherence protocol. Options: MESI, MSI, NONE", "MESI"},
             {"cache_type",              "(string) - Cache type. Options: inclusive cache ('inclusive', required for L1s), non-inclusive cache ('noninclusive') or non-inclusive cache with a directory ('noninclusive_with_directory', required for non-inclusive caches with multiple upper level caches directly above them),", "inclusive"},
             {"max_requests_per_cycle",  "(int) Maximum number of requests to accept per cycle. 0 or negative is unlimited.", "-1"},
+            {"event_driven",            "(bool) Event-driven scheduling. Events that are rejected (e.g., MSHR full) are not retried until another event is accepted or the MSHR changes, so the clock can stop while all waiting events are blocked. Events are handled in the same order and cycle as without it.", "false"},
             {"request_link_width",      "(string) Limits number of request bytes sent per cycle. Use 'B' units. '0B' is unlimited.", "0B"},
             {"response_link_width",     "(string) Limits number of response bytes sent per cycle. Use 'B' units. '0B' is unlimited.", "0B"},
             {"noninclusive_directory_entries", "(uint) Number of entries in the directory. Must be at least 1 if the non-inclusive directory exists.", "0"},
@@ -89,6 +90,9 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"array_layout",            "(string) How cache array lookups find tags. Options: line[tags are read from each line], flat[line addresses are mirrored in a per-set array that lookups scan; state and replacement data stay with each line]", "line"},
+            {"snapshot_in_file",        "(string) Load warmed cache contents from this snapshot during setup. The snapshot must come from a cache with the same geometry, protocol and hash.", ""},
+            {"snapshot_out_file",       "(string) Write the cache's stable lines to this snapshot at the end of simulation, for use as another run's snapshot_in_file.", ""},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
             {"network_bw",                  "MOVED - Now a member of the MemNIC subcomponent.", "80GiB/s"}, // Remove 9.0
@@ -116,6 +120,7 @@ public:
             {"TotalEventsReceived",     "Total number of events received by this cache", "events", 1},
             {"TotalEventsReplayed",     "Total number of events that were initially blocked and then were replayed", "events", 1},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle", "events", 1},
+            {"MSHR_probe_length",       "Number of MSHR table slots examined per address lookup", "count", 5},
             {"Bank_conflicts",          "Total number of bank conflicts detected", "count", 1},
             {"Prefetch_requests",       "Number of prefetches received from prefetcher at this cache", "events", 1},
             {"Prefetch_drops",          "Number of prefetches that were cancelled. Reasons: too many prefetches outstanding, cache can't handle prefetch this cycle, currently handling another event for the address.", "events", 1},
@@ -264,10 +269,14 @@ private:
     uint64_t            lineSize_;
     bool                allNoncacheableRequests_;
     int                 maxRequestsPerCycle_;
+    bool                eventDriven_;
     MemRegion           region_; // Memory region handled by this cache
     SimTime_t           timeout_;
+    std::string         snapshotInFile_;    // Warmed state to load in setup(), if any
+    std::string         snapshotOutFile_;   // Where to save state in finish(), if any
     uint64_t            maxOutstandingPrefetch_;
     bool                banked_;
+    EndpointId          cacheId_;           // This cache, used as source/requestor of prefetches
 
     /** Clocks *****************************************************************/
     Clock::Handler<Cache>*  clockHandler_;
@@ -285,6 +294,8 @@ private:
     std::list<MemEventBase*>    retryBuffer_;
     std::list<MemEventBase*>    eventBuffer_;
     std::queue<MemEventBase*>   prefetchBuffer_;
+    std::set<MemEventBase*>     parkedEvents_;          // Event-driven mode: events in eventBuffer_ rejected since the last change
+    int                         parkedMSHRSize_;        // Event-driven mode: MSHR size when events were last attempted
     std::map<SST::Event::id_type, std::string> noncacheableResponseDst_;
 
 
@@ -295,6 +306,7 @@ private:
 
     /** Statistics *************************************************************/
     Statistic<uint64_t>* statMSHROccupancy;
+    Statistic<uint64_t>* statMSHRProbeLength;
     Statistic<uint64_t>* statBankConflicts;
 
     // Prefetch statistics
@@ -38,6 +38,8 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
     dbg_ = new Output();
     dbg_->init("", params.find<int>("debug_level", 1), 0,(Output::output_location_t)params.find<int>("debug", 0));
 
+    cacheId_ = EndpointRegistry::intern(getName());
+
     /* Debug filtering */
     std::vector<Addr> addrArr;
     params.find_array<Addr>("debug_addr", addrArr);
@@ -60,6 +62,14 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
     bankStatus_.resize(banks, false);
     banked_ = banks;
 
+    /* Event-driven scheduling */
+    eventDriven_ = params.find<bool>("event_driven", false);
+    parkedMSHRSize_ = 0;
+
+    /* Warmed-state snapshots */
+    snapshotInFile_ = params.find<std::string>("snapshot_in_file", "");
+    snapshotOutFile_ = params.find<std::string>("snapshot_out_file", "");
+
     /* Create clock, deadlock timeout, etc. */
     createClock(params);
 
@@ -648,6 +658,7 @@ uint64_t Cache::createMSHR(Params &params, uint64_t accessLatency, bool L1) {
         out_->fatal(CALL_INFO, -1, "Invalid param: mshr_num_entries - MSHR requires at least 2 entries to avoid deadlock. You specified %d\n", mshrSize);
 
     mshr_ = new MSHR(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    mshr_->setProbeLengthStatistic(statMSHRProbeLength);
 
     if (mshrLatency > 0 && found)
         return mshrLatency;
@@ -800,5 +811,6 @@ void Cache::registerStatistics() {
     }
 
     statMSHROccupancy               = registerStatistic<uint64_t>("MSHR_occupancy");
+    statMSHRProbeLength             = registerStatistic<uint64_t>("MSHR_probe_length");
     statBankConflicts               = registerStatistic<uint64_t>("Bank_conflicts");
 }
@@ -39,6 +39,15 @@ namespace MemHierarchy {
     enum NotifyAccessType{ READ, WRITE, EVICT, PREFETCH };
     enum NotifyResultType{ HIT, MISS, NA };
 
+    /* Outcome of a prefetch, reported once per prefetched line
+     *  Useful:     a demand access hit the line
+     *  Late:       a demand access arrived while the prefetch was in flight (also reported Useful on the hit)
+     *  Useless:    the line was evicted or invalidated without being used
+     *  Redundant:  the line was already present
+     *  Dropped:    the cache did not have the resources to issue the prefetch
+     */
+    enum class PrefetchResult { Useful, Late, Useless, Redundant, Dropped };
+
 class CacheListenerNotification {
 public:
     CacheListenerNotification(const Addr tAddr, const Addr pAddr, const Addr vAddr,
@@ -81,6 +90,8 @@ public:
 
     virtual void printStats(Output &UNUSED(out)) {}
     virtual void notifyAccess(const CacheListenerNotification& UNUSED(notify)) {}
+    /* Feedback on prefetches issued by the cache's prefetcher(s). addr is the line address. */
+    virtual void notifyPrefetchResult(Addr UNUSED(addr), PrefetchResult UNUSED(result)) {}
     virtual void registerResponseCallback(Event::HandlerBase *handler) { delete handler; }
 };
 
@@ -35,7 +35,7 @@ using namespace SST::MemHierarchy;
 bool Incoherent::handleGetS(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
     PrivateCacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrId() == cacheId_);
     State state = line ? line->getState() : I;
     uint64_t sendTime = 0;
     MemEventStatus status = MemEventStatus::OK;
@@ -78,6 +78,7 @@ bool Incoherent::handleGetS(MemEvent * event, bool inMSHR) {
             }
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1);
+                notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Redundant);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 return DONE;
             }
@@ -392,6 +393,7 @@ bool Incoherent::handleGetSResp(MemEvent * event, bool inMSHR) {
         line->setData(event->getPayload(), 0);
         // Has to be a local prefetch
         line->setPrefetch(true);
+        recordPrefetchFill(line->getAddr());
         recordPrefetchLatency(req->getID(), LatType::MISS);
     }
 
@@ -658,7 +660,7 @@ void Incoherent::retry(Addr addr) {
         } else { // Pointer -> another request is waiting to evict this address
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                 retryBuffer_.push_back(ev);
             }
         }
@@ -683,7 +685,7 @@ void Incoherent::doEvict(MemEvent * event, PrivateCacheLine * line) {
  * Event creation and send
  ***********************************************************************************************************/
 
-SimTime_t Incoherent::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
+SimTime_t Incoherent::sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -709,8 +711,8 @@ SimTime_t Incoherent::sendResponseUp(MemEvent * event, vector<uint8_t> * data, b
 
 
 void Incoherent::sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty) {
-    MemEvent * writeback = new MemEvent(cachename_, line->getAddr(), line->getAddr(), cmd);
-    writeback->setDst(getDestination(line->getAddr()));
+    MemEvent * writeback = new MemEvent(cacheId_, line->getAddr(), line->getAddr(), cmd);
+    writeback->setDstId(getDestination(line->getAddr()));
     writeback->setSize(lineSize_);
 
     uint64_t latency = tagLatency_;
@@ -722,7 +724,7 @@ void Incoherent::sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty)
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrId(cacheId_);
 
     uint64_t time = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     time += latency;
@@ -732,10 +734,10 @@ void Incoherent::sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty)
 }
 
 
-void Incoherent::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+void Incoherent::forwardFlush(MemEvent * event, bool evict, Payload* data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
-    flush->setSrc(cachename_);
-    flush->setDst(getDestination(event->getBaseAddr()));
+    flush->setSrcId(cacheId_);
+    flush->setDstId(getDestination(event->getBaseAddr()));
 
     uint64_t latency = tagLatency_;
     if (evict) {
@@ -758,8 +760,8 @@ void Incoherent::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>
 
 void Incoherent::sendWritebackAck(MemEvent * event) {
     MemEvent * ack = event->makeResponse();
-    ack->setDst(event->getSrc());
-    ack->setRqstr(event->getSrc());
+    ack->setDstId(event->getSrcId());
+    ack->setRqstrId(event->getSrcId());
     ack->setSize(event->getSize());
 
     uint64_t time = timestamp_ + tagLatency_;
@@ -797,6 +799,7 @@ void Incoherent::recordPrefetchResult(PrivateCacheLine * line, Statistic<uint64_
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetch(line->getAddr(), stat);
     }
 }
 
@@ -147,6 +147,7 @@ public:
 
         cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "line"));
 
         stat_eventState[(int)Command::GetS][I] = registerStatistic<uint64_t>("stateEvent_GetS_I");
         stat_eventState[(int)Command::GetS][E] = registerStatistic<uint64_t>("stateEvent_GetS_E");
@@ -257,6 +258,9 @@ public:
     Addr getBank(Addr addr) { return cacheArray_->getBank(addr); }
     void setSliceAware(uint64_t interleaveSize, uint64_t interleaveStep) { cacheArray_->setSliceAware(interleaveSize, interleaveStep); }
 
+    uint64_t saveSnapshot(SnapshotWriter& out) { return cacheArray_->saveSnapshot(out); }
+    void loadSnapshot(SnapshotReader& in) { cacheArray_->loadSnapshot(in); }
+
     MemEventInitCoherence * getInitCoherenceEvent();
 
     void recordLatency(Command cmd, int type, uint64_t latency);
@@ -293,11 +297,11 @@ private:
 
     void doEvict(MemEvent * event, PrivateCacheLine * line);
 
-    SimTime_t sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = false);
+    SimTime_t sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = false);
 
     void sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty);
 
-    void forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t> * data, bool dirty, uint64_t time);
+    void forwardFlush(MemEvent * event, bool evict, Payload* data, bool dirty, uint64_t time);
 
     void sendWritebackAck(MemEvent * event);
 
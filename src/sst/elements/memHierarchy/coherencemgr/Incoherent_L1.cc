@@ -38,11 +38,11 @@ using namespace SST::MemHierarchy;
 bool IncoherentL1::handleGetS(MemEvent* event, bool inMSHR){
     Addr addr = event->getBaseAddr();
     L1CacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrId() == cacheId_);
     State state = line ? line->getState() : I;
     uint64_t sendTime = 0;
     MemEventStatus status = MemEventStatus::OK;
-    vector<uint8_t> data;
+    Payload data;
 
     printLine(addr);
 
@@ -75,7 +75,7 @@ bool IncoherentL1::handleGetS(MemEvent* event, bool inMSHR){
             if (event->isLoadLink())
                 line->atomicStart();
 
-            data.assign(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr() + event->getSize()));
+            data = line->getData()->slice(event->getAddr() - event->getBaseAddr(), event->getSize());
             sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterRequest(event, inMSHR);
@@ -172,7 +172,7 @@ bool IncoherentL1::handleGetSX(MemEvent* event, bool inMSHR) {
 
     MemEventStatus status = MemEventStatus::OK;
     uint64_t sendTime = 0;
-    std::vector<uint8_t> data;
+    Payload data;
 
     printLine(addr);
 
@@ -200,7 +200,7 @@ bool IncoherentL1::handleGetSX(MemEvent* event, bool inMSHR) {
             recordLatencyType(event->getID(), LatType::HIT);
             // Handle
             line->incLock();
-            std::copy(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr())  + event->getSize(), data.begin());
+            data = line->getData()->slice(event->getAddr() - event->getBaseAddr(), event->getSize());
             sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterRequest(event, inMSHR);
@@ -317,7 +317,7 @@ bool IncoherentL1::handleGetSResp(MemEvent * event, bool inMSHR) {
     stat_eventState[(int)(event->getCmd())][state]->addData(1);
 
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrId() == cacheId_);
 
     // Update line
     line->setData(event->getPayload(), 0);
@@ -330,10 +330,11 @@ bool IncoherentL1::handleGetSResp(MemEvent * event, bool inMSHR) {
     // Notify processor or set prefetch so we can track prefetch results
     if (localPrefetch) {
         line->setPrefetch(true);
+        recordPrefetchFill(line->getAddr());
     } else {
         req->setMemFlags(event->getMemFlags());
         Addr offset = req->getAddr() - req->getBaseAddr();
-        vector<uint8_t> data(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+        Payload data = line->getData()->slice(offset, req->getSize());
         uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
     }
@@ -370,7 +371,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
 
     /* Execute write */
     Addr offset = req->getAddr() - req->getBaseAddr();
-    std::vector<uint8_t> data;
+    Payload data;
     if (req->getCmd() == Command::GetX) {
         if (!req->isStoreConditional() || line->isAtomic()) {
             line->setData(req->getPayload(), offset);
@@ -388,7 +389,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     }
 
     // Return response
-    data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+    data = line->getData()->slice(offset, req->getSize());
     uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp(), false);
     line->setTimestamp(sendTime-1);
 
@@ -591,7 +592,7 @@ void IncoherentL1::cleanUpAfterRequest(MemEvent* event, bool inMSHR) {
                     debug->debug(_L5_, "    CleanUpAfterRequest: Waiting Evict in MSHR, retrying eviction(s)\n");
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
                     retryBuffer_.push_back(ev);
                 }
             } else {
@@ -632,7 +633,7 @@ void IncoherentL1::cleanUpAfterResponse(MemEvent* event, bool inMSHR) {
                 debug->debug(_L5_, "    CleanUpAfterResponse: Waiting Evict in MSHR, retrying eviction\n");
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
                 retryBuffer_.push_back(ev);
             }
         }
@@ -649,7 +650,7 @@ void IncoherentL1::retry(Addr addr) {
         } else if (!(mshr_->pendingWriteback(addr))) {
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
                 retryBuffer_.push_back(ev);
             }
         }
@@ -661,7 +662,7 @@ void IncoherentL1::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t IncoherentL1::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, bool success) {
+uint64_t IncoherentL1::sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t time, bool success) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
 
@@ -718,8 +719,8 @@ void IncoherentL1::sendResponseDown(MemEvent * event, L1CacheLine * line, bool d
 void IncoherentL1::forwardFlush(MemEvent * event, L1CacheLine * line, bool evict) {
     MemEvent * flush = new MemEvent(*event);
 
-    flush->setSrc(cachename_);
-    flush->setDst(getDestination(event->getBaseAddr()));
+    flush->setSrcId(cacheId_);
+    flush->setDstId(getDestination(event->getBaseAddr()));
 
     uint64_t latency = tagLatency_;
     if (evict) {
@@ -759,8 +760,8 @@ void IncoherentL1::forwardFlush(MemEvent * event, L1CacheLine * line, bool evict
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
 void IncoherentL1::sendWriteback(Command cmd, L1CacheLine* line, bool dirty) {
-    MemEvent* writeback = new MemEvent(cachename_, line->getAddr(), line->getAddr(), cmd, getCurrentSimTimeNano());
-    writeback->setDst(getDestination(line->getAddr()));
+    MemEvent* writeback = new MemEvent(cacheId_, line->getAddr(), line->getAddr(), cmd, getCurrentSimTimeNano());
+    writeback->setDstId(getDestination(line->getAddr()));
     writeback->setSize(lineSize_);
 
     uint64_t latency = tagLatency_;
@@ -777,7 +778,7 @@ void IncoherentL1::sendWriteback(Command cmd, L1CacheLine* line, bool dirty) {
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrId(cacheId_);
 
     uint64_t baseTime = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -818,7 +819,7 @@ void IncoherentL1::printLine(Addr addr) {
     debug->debug(_L8_, "  Line 0x%" PRIx64 ": %s\n", addr, state.c_str());
 }
 
-void IncoherentL1::printData(vector<uint8_t> * data, bool set) {
+void IncoherentL1::printData(Payload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
 
@@ -833,6 +834,7 @@ void IncoherentL1::recordPrefetchResult(L1CacheLine * line, Statistic<uint64_t>
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetch(line->getAddr(), stat);
     }
 }
 
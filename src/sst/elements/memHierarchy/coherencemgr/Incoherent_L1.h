@@ -138,6 +138,7 @@ public:
 
         cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "line"));
 
         stat_eventState[(int)Command::GetS][I] = registerStatistic<uint64_t>("stateEvent_GetS_I");
         stat_eventState[(int)Command::GetS][E] = registerStatistic<uint64_t>("stateEvent_GetS_E");
@@ -235,6 +236,9 @@ public:
     virtual Addr getBank(Addr addr) { return cacheArray_->getBank(addr); }
     virtual void setSliceAware(uint64_t size, uint64_t step) { cacheArray_->setSliceAware(size, step); }
 
+    uint64_t saveSnapshot(SnapshotWriter& out) { return cacheArray_->saveSnapshot(out); }
+    void loadSnapshot(SnapshotReader& in) { cacheArray_->loadSnapshot(in); }
+
     MemEventInitCoherence * getInitCoherenceEvent();
 
     std::set<Command> getValidReceiveEvents() {
@@ -265,7 +269,7 @@ private:
     void forwardFlush(MemEvent * event, L1CacheLine * line, bool data);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, bool success = false);
+    uint64_t sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t baseTime, bool success = false);
 
     /** Send response down (towards memory) */
     void sendResponseDown(MemEvent * event, L1CacheLine * line, bool data);
@@ -285,7 +289,7 @@ private:
     void eventProfileAndNotify(MemEvent * event, State state, NotifyAccessType type, NotifyResultType result, bool inMSHR, bool stalled);
 
     /* Debug output */
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(Payload* data, bool set);
     void printLine(Addr addr);
 
     CacheArray<L1CacheLine>* cacheArray_;
@@ -1117,8 +1117,8 @@ void MESIDirectory::handleFlushLineResponse(MemEvent * ev) {
     reqEv->setMemFlags(ev->getMemFlags()); // Copy anything back up that needs to be
 
     MemEvent * me = reqEv->makeResponse();
-    me->setDst(reqEv->getSrc());
-    me->setRqstr(reqEv->getRqstr());
+    me->setDstId(reqEv->getSrcId());
+    me->setRqstrId(reqEv->getRqstrId());
     me->setSuccess(ev->queryFlag(MemEvent::F_SUCCESS));
     me->setMemFlags(reqEv->getMemFlags());
 
@@ -1294,7 +1294,7 @@ MESIDirectory::DirEntry* MESIDirectory::getDirEntry(Addr baseAddr){
 void MESIDirectory::sendInvalidate(int target, MemEvent * reqEv, DirEntry* entry, Command cmd){
     MemEvent *me = new MemEvent(getName(), entry->getBaseAddr(), entry->getBaseAddr(), cmd, cacheLineSize);
     me->setDst(nodeid_to_name[target]);
-    me->setRqstr(reqEv->getRqstr());
+    me->setRqstrId(reqEv->getRqstrId());
 
     if (is_debug_event(reqEv)) dbg.debug(_L4_, "Sending Invalidate.  Dst: %s\n", nodeid_to_name[target].c_str());
     profileRequestSent(me);
@@ -1305,8 +1305,8 @@ void MESIDirectory::sendInvalidate(int target, MemEvent * reqEv, DirEntry* entry
 
 void MESIDirectory::sendAckPut(MemEvent * event) {
     MemEvent * me = event->makeResponse(Command::AckPut);
-    me->setDst(event->getSrc());
-    me->setRqstr(event->getRqstr());
+    me->setDstId(event->getSrcId());
+    me->setRqstrId(event->getRqstrId());
     me->setPayload(0, nullptr);
     me->setSize(cacheLineSize);
 
@@ -1320,7 +1320,7 @@ void MESIDirectory::sendAckPut(MemEvent * event) {
 
 void MESIDirectory::forwardFlushRequest(MemEvent * event) {
     MemEvent *reqEv     = new MemEvent(getName(), event->getAddr(), event->getBaseAddr(), Command::FlushLine, cacheLineSize);
-    reqEv->setRqstr(event->getRqstr());
+    reqEv->setRqstrId(event->getRqstrId());
     reqEv->setVirtualAddress(event->getVirtualAddress());
     reqEv->setInstructionPointer(event->getInstructionPointer());
     reqEv->setMemFlags(event->getMemFlags());
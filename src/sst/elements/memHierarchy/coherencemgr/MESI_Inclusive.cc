@@ -37,12 +37,12 @@ using namespace SST::MemHierarchy;
 bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
     SharedCacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrId() == cacheId_);
     State state = line ? line->getState() : I;
 
     MemEventStatus status = MemEventStatus::OK;
     uint64_t sendTime = 0;
-    vector<uint8_t>* data;
+    Payload* data;
     Command respcmd;
 
     if (is_debug_addr(addr))
@@ -82,6 +82,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                 notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
                 if (localPrefetch) {
                     statPrefetchRedundant->addData(1);
+                    notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Redundant);
                     recordPrefetchLatency(event->getID(), LatType::HIT);
                 } else {
                     recordLatencyType(event->getID(), LatType::HIT);
@@ -99,7 +100,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
             }
 
             recordPrefetchResult(line, statPrefetchHit);
-            line->addSharer(event->getSrc());
+            line->addSharer(event->getSrcId());
 
             sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime - 1);
@@ -119,6 +120,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                     stat_hits->addData(1);
                     notifyListenerOfAccess(event, NotifyAccessType::PREFETCH, NotifyResultType::HIT);
                     statPrefetchRedundant->addData(1);
+                    notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Redundant);
                     recordPrefetchLatency(event->getID(), LatType::HIT);
                 }
                 if (is_debug_event(event))
@@ -160,10 +162,10 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                     if (inMSHR) mshr_->setProfiled(addr);
                 }
                 if (!line->hasSharers() && protocol_) {
-                    line->setOwner(event->getSrc());
+                    line->setOwner(event->getSrcId());
                     respcmd = Command::GetXResp;
                 } else {
-                    line->addSharer(event->getSrc());
+                    line->addSharer(event->getSrcId());
                     respcmd = Command::GetSResp;
                 }
             }
@@ -273,7 +275,7 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
 
             recordPrefetchResult(line, statPrefetchHit);
 
-            if (line->hasOtherSharers(event->getSrc())) {
+            if (line->hasOtherSharers(event->getSrcId())) {
                 if (!inMSHR)
                     status = allocateMSHR(event, false);
                 if (status == MemEventStatus::OK) {
@@ -297,9 +299,9 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
                 break;
             }
 
-            line->setOwner(event->getSrc());
-            if (line->isSharer(event->getSrc()))
-                line->removeSharer(event->getSrc());
+            line->setOwner(event->getSrcId());
+            if (line->isSharer(event->getSrcId()))
+                line->removeSharer(event->getSrcId());
             sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
 
@@ -361,7 +363,7 @@ bool MESIInclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
 
     if (event->getEvict()) {
         state = doEviction(event, line, state);
-        line->addSharer(event->getSrc());
+        line->addSharer(event->getSrcId());
         ack = true;
     }
 
@@ -386,7 +388,7 @@ bool MESIInclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
             if (mshr_->getFrontType(addr) == MSHREntryType::Event) {
                 MemEvent * headEvent = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                 if (headEvent->getCmd() == Command::FetchInvX && !line->hasOwner()) { // Resolve race between downgrade request & this flush
-                    responses.find(addr)->second.erase(event->getSrc());
+                    responses.find(addr)->second.erase(event->getSrcId());
                     if (responses.find(addr)->second.empty()) responses.erase(addr);
                     retry(addr);
                 }
@@ -397,7 +399,7 @@ bool MESIInclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
         case E_InvX:
         case M_InvX:
             if (ack) {
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 mshr_->decrementAcksNeeded(addr);
                 state == E_InvX ? line->setState(E) : line->setState(M);
@@ -458,8 +460,8 @@ bool MESIInclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
     bool done = (mshr_->getAcksNeeded(addr) == 0);
     if (event->getEvict()) {
         state = doEviction(event, line, state);
-        if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
-            responses.find(addr)->second.erase(event->getSrc());
+        if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrcId()) != responses.find(addr)->second.end()) {
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
         }
         if (!done) {
@@ -580,8 +582,8 @@ bool MESIInclusive::handlePutS(MemEvent * event, bool inMSHR) {
     state = doEviction(event, line, state);
     stat_eventState[(int)Command::PutS][state]->addData(1);
 
-    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
-        responses.find(addr)->second.erase(event->getSrc());
+    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrcId()) != responses.find(addr)->second.end()) {
+        responses.find(addr)->second.erase(event->getSrcId());
         if (responses.find(addr)->second.empty()) responses.erase(addr);
     }
 
@@ -663,8 +665,8 @@ bool MESIInclusive::handlePutE(MemEvent * event, bool inMSHR) {
     stat_eventState[(int)Command::PutE][state]->addData(1);
 
     state = doEviction(event, line, state);
-    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
-        responses.find(addr)->second.erase(event->getSrc());
+    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrcId()) != responses.find(addr)->second.end()) {
+        responses.find(addr)->second.erase(event->getSrcId());
         if (responses.find(addr)->second.empty()) responses.erase(addr);
     }
 
@@ -727,8 +729,8 @@ bool MESIInclusive::handlePutM(MemEvent * event, bool inMSHR) {
     stat_eventState[(int)Command::PutM][state]->addData(1);
 
     state = doEviction(event, line, state);
-    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
-        responses.find(addr)->second.erase(event->getSrc());
+    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrcId()) != responses.find(addr)->second.end()) {
+        responses.find(addr)->second.erase(event->getSrcId());
         if (responses.find(addr)->second.empty()) responses.erase(addr);
     }
 
@@ -787,7 +789,7 @@ bool MESIInclusive::handlePutX(MemEvent * event, bool inMSHR) {
     stat_eventState[(int)Command::PutX][state]->addData(1);
 
     state = doEviction(event, line, state);
-    line->addSharer(event->getSrc());
+    line->addSharer(event->getSrcId());
 
     if (sendWritebackAck_)
        sendAckPut(event);
@@ -799,13 +801,13 @@ bool MESIInclusive::handlePutX(MemEvent * event, bool inMSHR) {
         case E_Inv:
         case M_Inv:
             if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::FetchInvX) {
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 retry(addr);
             }
             break;
         case E_InvX:
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             if (mshr_->getAcksNeeded(addr) && mshr_->decrementAcksNeeded(addr)) {
                 line->setState(E);
@@ -813,7 +815,7 @@ bool MESIInclusive::handlePutX(MemEvent * event, bool inMSHR) {
             }
             break;
         case M_InvX:
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             if (mshr_->getAcksNeeded(addr) && mshr_->decrementAcksNeeded(addr)) {
                 line->setState(M);
@@ -1030,7 +1032,7 @@ bool MESIInclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             cleanUpEvent(event, inMSHR); // No replay since state doesn't change
             break;
         case SM_Inv: { // ForceInv if there's an un-inv'd sharer, else in mshr & stall
-            std::string src = mshr_->getFrontEvent(addr)->getSrc();
+            EndpointId src = mshr_->getFrontEvent(addr)->getSrcId();
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
             if (status != MemEventStatus::Reject) {
                 profile = true;
@@ -1156,7 +1158,7 @@ bool MESIInclusive::handleFetchInv(MemEvent * event, bool inMSHR) {
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
             if (status != MemEventStatus::Reject) {
                 profile = true;
-                std::string shr = mshr_->getFrontEvent(addr)->getSrc();
+                EndpointId shr = mshr_->getFrontEvent(addr)->getSrcId();
                 if (line->isSharer(shr)) {
                     invalidateSharer(shr, event, line, inMSHR);
                 }
@@ -1295,7 +1297,7 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
     //if (is_debug_addr(addr))
         //debug->debug(_L5_, "    Request: %s\n", req->getBriefString().c_str());
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrId() == cacheId_);
     req->setFlags(event->getMemFlags());
 
     // Sanity check line state
@@ -1312,8 +1314,9 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     line->setState(S);
     if (localPrefetch) {
         line->setPrefetch(true);
+        recordPrefetchFill(line->getAddr());
     } else {
-        line->addSharer(req->getSrc());
+        line->addSharer(req->getSrcId());
         Addr offset = req->getAddr() - req->getBaseAddr();
         uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
@@ -1346,7 +1349,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
 
     // Get matching request
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrId() == cacheId_);
     req->setFlags(event->getMemFlags());
 
     std::vector<uint8_t> data;
@@ -1367,15 +1370,16 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
 
             if (localPrefetch) {
                 line->setPrefetch(true);
+                recordPrefetchFill(line->getAddr());
                 if (is_debug_event(event))
                     eventDI.action = "Done";
             } else {
                 if (protocol_ && line->getState() != S && mshr_->getSize(addr) == 1) {
-                    line->setOwner(req->getSrc());
+                    line->setOwner(req->getSrcId());
                     uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetXResp);
                     line->setTimestamp(sendTime - 1);
                 } else {
-                    line->addSharer(req->getSrc());
+                    line->addSharer(req->getSrcId());
                     uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetSResp);
                     line->setTimestamp(sendTime - 1);
                 }
@@ -1390,9 +1394,9 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
         case SM:
         {
             line->setState(M);
-            line->setOwner(req->getSrc());
-            if (line->isSharer(req->getSrc()))
-                line->removeSharer(req->getSrc());
+            line->setOwner(req->getSrcId());
+            if (line->isSharer(req->getSrcId()))
+                line->removeSharer(req->getSrcId());
 
             uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
             line->setTimestamp(sendTime-1);
@@ -1470,7 +1474,7 @@ bool MESIInclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
 
     // Do invalidation & update data
     state = doEviction(event, line, state);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     if (state == M_Inv) {
@@ -1510,9 +1514,9 @@ bool MESIInclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
     mshr_->decrementAcksNeeded(addr);
 
     state = doEviction(event, line, state);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
-    line->addSharer(event->getSrc());
+    line->addSharer(event->getSrcId());
 
     if (state == M_InvX)
         line->setState(M);
@@ -1544,12 +1548,12 @@ bool MESIInclusive::handleAckInv(MemEvent * event, bool inMSHR) {
 
     stat_eventState[(int)Command::AckInv][state]->addData(1);
 
-    if (line->isSharer(event->getSrc()))
-        line->removeSharer(event->getSrc());
+    if (line->isSharer(event->getSrcId()))
+        line->removeSharer(event->getSrcId());
     else
         line->removeOwner();
 
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     bool done = mshr_->decrementAcksNeeded(addr);
@@ -1700,8 +1704,8 @@ bool MESIInclusive::handleNACK(MemEvent * event, bool inMSHR) {
         case Command::Inv:
         case Command::ForceInv:
             if (responses.find(addr) != responses.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst()) != responses.find(addr)->second.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst())->second == nackedEvent->getID()) {
+                    && responses.find(addr)->second.find(nackedEvent->getDstId()) != responses.find(addr)->second.end()
+                    && responses.find(addr)->second.find(nackedEvent->getDstId())->second == nackedEvent->getID()) {
                 resendEvent(nackedEvent, true); // Resend towards CPU
             } else {
                 if (is_debug_event(nackedEvent))
@@ -1875,7 +1879,7 @@ void MESIInclusive::cleanUpAfterRequest(MemEvent* event, bool inMSHR) {
             if (mshr_->getFrontType(addr) == MSHREntryType::Evict && mshr_->getAcksNeeded(addr) == 0) {
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                     retryBuffer_.push_back(ev);
                 }
             }
@@ -1907,7 +1911,7 @@ void MESIInclusive::cleanUpAfterResponse(MemEvent* event, bool inMSHR) {
             if (mshr_->getAcksNeeded(addr) == 0) {
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                     retryBuffer_.push_back(ev);
                 }
             }
@@ -1928,7 +1932,7 @@ void MESIInclusive::retry(Addr addr) {
             //    debug->debug(_L5_, "    Retry: Waiting Evict in MSHR, retrying eviction\n");
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                 retryBuffer_.push_back(ev);
             }
         }
@@ -1956,10 +1960,10 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
                 break;
         }
     }
-    if (line->getOwner() == event->getSrc())
+    if (line->getOwnerId() == event->getSrcId())
         line->removeOwner();
-    else if (line->isSharer(event->getSrc()))
-        line->removeSharer(event->getSrc());
+    else if (line->isSharer(event->getSrcId()))
+        line->removeSharer(event->getSrcId());
 
     event->setEvict(false); // Avoid doing an eviction twice if the event gets replayed
     line->setState(nState);
@@ -1971,7 +1975,7 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
  * Event creation and send
  ***********************************************************************************************************/
 
-SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -2030,8 +2034,8 @@ void MESIInclusive::sendResponseDown(MemEvent * event, SharedCacheLine * line, b
 void MESIInclusive::forwardFlush(MemEvent * event, SharedCacheLine * line, bool evict) {
     MemEvent * flush = new MemEvent(*event);
 
-    flush->setSrc(cachename_);
-    flush->setDst(getDestination(event->getBaseAddr()));
+    flush->setSrcId(cacheId_);
+    flush->setDstId(getDestination(event->getBaseAddr()));
 
     uint64_t latency = tagLatency_;
     if (evict) {
@@ -2064,8 +2068,8 @@ void MESIInclusive::forwardFlush(MemEvent * event, SharedCacheLine * line, bool
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
 void MESIInclusive::sendWriteback(Command cmd, SharedCacheLine* line, bool dirty) {
-    MemEvent* writeback = new MemEvent(cachename_, line->getAddr(), line->getAddr(), cmd);
-    writeback->setDst(getDestination(line->getAddr()));
+    MemEvent* writeback = new MemEvent(cacheId_, line->getAddr(), line->getAddr(), cmd);
+    writeback->setDstId(getDestination(line->getAddr()));
     writeback->setSize(lineSize_);
 
     uint64_t latency = tagLatency_;
@@ -2082,7 +2086,7 @@ void MESIInclusive::sendWriteback(Command cmd, SharedCacheLine* line, bool dirty
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrId(cacheId_);
 
     uint64_t baseTime = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -2097,8 +2101,8 @@ void MESIInclusive::sendWriteback(Command cmd, SharedCacheLine* line, bool dirty
 
 void MESIInclusive::sendAckPut(MemEvent * event) {
     MemEvent * ack = event->makeResponse();
-    ack->setDst(event->getSrc());
-    ack->setRqstr(event->getSrc());
+    ack->setDstId(event->getSrcId());
+    ack->setRqstrId(event->getSrcId());
     ack->setSize(event->getSize());
 
     uint64_t deliveryTime = timestamp_ + tagLatency_;
@@ -2114,18 +2118,18 @@ void MESIInclusive::sendAckPut(MemEvent * event) {
 
 void MESIInclusive::downgradeOwner(MemEvent * event, SharedCacheLine* line, bool inMSHR) {
     Addr addr = event->getBaseAddr();
-    MemEvent * fetch = new MemEvent(cachename_, addr, addr, Command::FetchInvX);
+    MemEvent * fetch = new MemEvent(cacheId_, addr, addr, Command::FetchInvX);
     fetch->copyMetadata(event);
-    fetch->setDst(line->getOwner());
+    fetch->setDstId(line->getOwnerId());
     fetch->setSize(lineSize_);
 
     mshr_->incrementAcksNeeded(addr);
 
     if (responses.find(addr) != responses.end()) {
-        responses.find(addr)->second.insert(std::make_pair(line->getOwner(), fetch->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
+        responses.find(addr)->second.insert(std::make_pair(line->getOwnerId(), fetch->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
     } else {
-        std::map<std::string,MemEvent::id_type> respid;
-        respid.insert(std::make_pair(line->getOwner(), fetch->getID()));
+        std::map<EndpointId,MemEvent::id_type> respid;
+        respid.insert(std::make_pair(line->getOwnerId(), fetch->getID()));
         responses.insert(std::make_pair(addr, respid));
     }
 
@@ -2147,9 +2151,9 @@ void MESIInclusive::downgradeOwner(MemEvent * event, SharedCacheLine* line, bool
 
 bool MESIInclusive::invalidateExceptRequestor(MemEvent * event, SharedCacheLine * line, bool inMSHR) {
     uint64_t deliveryTime = 0;
-    std::string rqstr = event->getSrc();
+    EndpointId rqstr = event->getSrcId();
 
-    for (set<std::string>::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
+    for (EndpointSet::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
         if (*it == rqstr) continue;
 
         deliveryTime =  invalidateSharer(*it, event, line, inMSHR);
@@ -2168,7 +2172,7 @@ bool MESIInclusive::invalidateAll(MemEvent * event, SharedCacheLine * line, bool
     } else {
         if (cmd == Command::NULLCMD)
             cmd = Command::Inv;
-        for (std::set<std::string>::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
+        for (EndpointSet::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
             deliveryTime = invalidateSharer(*it, event, line, inMSHR, cmd);
         }
         if (deliveryTime != 0) {
@@ -2179,22 +2183,22 @@ bool MESIInclusive::invalidateAll(MemEvent * event, SharedCacheLine * line, bool
     return false;
 }
 
-uint64_t MESIInclusive::invalidateSharer(std::string shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd) {
+uint64_t MESIInclusive::invalidateSharer(EndpointId shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd) {
     if (line->isSharer(shr)) {
         Addr addr = line->getAddr();
-        MemEvent * inv = new MemEvent(cachename_, addr, addr, cmd);
+        MemEvent * inv = new MemEvent(cacheId_, addr, addr, cmd);
         if (event) {
             inv->copyMetadata(event);
-            inv->setRqstr(event->getRqstr());
+            inv->setRqstrId(event->getRqstrId());
         } else {
-            inv->setRqstr(cachename_);
+            inv->setRqstrId(cacheId_);
         }
-        inv->setDst(shr);
+        inv->setDstId(shr);
         inv->setSize(lineSize_);
         if (responses.find(addr) != responses.end()) {
             responses.find(addr)->second.insert(std::make_pair(shr, inv->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
         } else {
-            std::map<std::string,MemEvent::id_type> respid;
+            std::map<EndpointId,MemEvent::id_type> respid;
             respid.insert(std::make_pair(shr, inv->getID()));
             responses.insert(std::make_pair(addr, respid));
         }
@@ -2218,27 +2222,27 @@ uint64_t MESIInclusive::invalidateSharer(std::string shr, MemEvent * event, Shar
 
 bool MESIInclusive::invalidateOwner(MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd) {
     Addr addr = line->getAddr();
-    if (line->getOwner() == "")
+    if (!line->hasOwner())
         return false;
 
-    MemEvent * inv = new MemEvent(cachename_, addr, addr, cmd);
+    MemEvent * inv = new MemEvent(cacheId_, addr, addr, cmd);
     if (event) {
         inv->copyMetadata(event);
-        inv->setRqstr(event->getRqstr());
+        inv->setRqstrId(event->getRqstrId());
     } else {
-        inv->setRqstr(cachename_);
+        inv->setRqstrId(cacheId_);
     }
-    inv->setDst(line->getOwner());
+    inv->setDstId(line->getOwnerId());
     inv->setSize(lineSize_);
 
     mshr_->incrementAcksNeeded(addr);
 
     // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
     if (responses.find(addr) != responses.end()) {
-        responses.find(addr)->second.insert(std::make_pair(inv->getDst(), inv->getID()));
+        responses.find(addr)->second.insert(std::make_pair(inv->getDstId(), inv->getID()));
     } else {
-        std::map<std::string,MemEvent::id_type> respid;
-        respid.insert(std::make_pair(inv->getDst(), inv->getID()));
+        std::map<EndpointId,MemEvent::id_type> respid;
+        respid.insert(std::make_pair(inv->getDstId(), inv->getID()));
         responses.insert(std::make_pair(addr,respid));
     }
 
@@ -2280,6 +2284,7 @@ void MESIInclusive::recordPrefetchResult(SharedCacheLine * line, Statistic<uint6
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetch(line->getAddr(), stat);
     }
 }
 
@@ -2319,7 +2324,7 @@ MemEventInitCoherence * MESIInclusive::getInitCoherenceEvent() {
 }
 
 
-void MESIInclusive::printData(vector<uint8_t> * data, bool set) {
+void MESIInclusive::printData(Payload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
 
@@ -260,6 +260,7 @@ public:
         HashFunction * ht = createHashFunction(params);
         cacheArray_ = new CacheArray<SharedCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "line"));
 
         /* Statistics */
         stat_evict[I] =         registerStatistic<uint64_t>("evict_I");
@@ -499,6 +500,9 @@ public:
     virtual Addr getBank(Addr addr) { return cacheArray_->getBank(addr); }
     virtual void setSliceAware(uint64_t size, uint64_t step) { cacheArray_->setSliceAware(size, step); }
 
+    uint64_t saveSnapshot(SnapshotWriter& out) { return cacheArray_->saveSnapshot(out); }
+    void loadSnapshot(SnapshotReader& in) { cacheArray_->loadSnapshot(in); }
+
     /** Initialization **/
     MemEventInitCoherence * getInitCoherenceEvent();
 
@@ -544,14 +548,14 @@ private:
     /** Invalidation **/
     bool invalidateExceptRequestor(MemEvent * event, SharedCacheLine * line, bool inMSHR);
     bool invalidateAll(MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::NULLCMD);
-    uint64_t invalidateSharer(std::string shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::Inv);
+    uint64_t invalidateSharer(EndpointId shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::Inv);
     bool invalidateOwner(MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::FetchInv);
 
     /** Forward flush line request, with or without data */
     void forwardFlush(MemEvent * event, SharedCacheLine * line, bool data);
 
     /** Send response up (towards processor) */
-    SimTime_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd = Command::NULLCMD, bool success = false);
+    SimTime_t sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t time, Command cmd = Command::NULLCMD, bool success = false);
 
     /** Send response down (towards memory) */
     void sendResponseDown(MemEvent * event, SharedCacheLine * line, bool data, bool evict);
@@ -579,7 +583,7 @@ private:
     /* Record latency */
     void recordLatency(Command cmd, int type, uint64_t latency);
 
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(Payload* data, bool set);
     void printLine(Addr addr);
 
 /* Variables */
@@ -587,7 +591,7 @@ private:
     State protocolState_;       // State to transition to on exclusive response to read/shared request
     bool protocol_;             // True for MESI, false for MSI
 
-    std::map<Addr, std::map<std::string, MemEvent::id_type> > responses;
+    std::map<Addr, std::map<EndpointId, MemEvent::id_type> > responses;
 
     /* Statistics */
     Statistic<uint64_t>* stat_latencyGetS[3]; // HIT, MISS, INV
@@ -44,11 +44,11 @@ using namespace SST::MemHierarchy;
 bool MESIL1::handleGetS(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
     L1CacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrId() == cacheId_);
     State state = line ?  line->getState() : I;
     uint64_t sendTime = 0;
     MemEventStatus status = MemEventStatus::OK;
-    vector<uint8_t> data;
+    Payload data;
 
     if (inMSHR)
         mshr_->removePendingRetry(addr);
@@ -96,6 +96,7 @@ bool MESIL1::handleGetS(MemEvent * event, bool inMSHR) {
 
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1); // Unneccessary prefetch
+                notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Redundant);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
                 break;
@@ -105,7 +106,7 @@ bool MESIL1::handleGetS(MemEvent * event, bool inMSHR) {
 
             if (event->isLoadLink())
                 line->atomicStart();
-            data.assign(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr() + event->getSize()));
+            data = line->getData()->slice(event->getAddr() - event->getBaseAddr(), event->getSize());
             sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime - 1);
             cleanUpAfterRequest(event, inMSHR);
@@ -269,7 +270,7 @@ bool MESIL1::handleGetSX(MemEvent* event, bool inMSHR) {
     MemEventStatus status = MemEventStatus::OK;
     bool atomic = true;
     uint64_t sendTime = 0;
-    vector<uint8_t> data;
+    Payload data;
 
     switch (state) {
         case I:
@@ -328,7 +329,7 @@ bool MESIL1::handleGetSX(MemEvent* event, bool inMSHR) {
                 stat_hits->addData(1);
             }
             line->incLock();
-            std::copy(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr()) + event->getSize(), data.begin());
+            data = line->getData()->slice(event->getAddr() - event->getBaseAddr(), event->getSize());
             sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterRequest(event, inMSHR);
@@ -770,7 +771,7 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
     stat_eventState[(int)Command::GetSResp][state]->addData(1);
 
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrId() == cacheId_);
 
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::GetSResp, localPrefetch, addr, state);
@@ -789,13 +790,14 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
 
     if (localPrefetch) {
         line->setPrefetch(true);
+        recordPrefetchFill(line->getAddr());
         recordPrefetchLatency(req->getID(), LatType::MISS);
         if (is_debug_addr(addr))
             eventDI.action = "Done";
     } else {
         req->setMemFlags(event->getMemFlags());
         Addr offset = req->getAddr() - addr;
-        vector<uint8_t> data(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+        Payload data = line->getData()->slice(offset, req->getSize());
         uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
     }
@@ -818,14 +820,14 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
     stat_eventState[(int)Command::GetXResp][state]->addData(1);
 
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrId() == cacheId_);
 
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::GetXResp, localPrefetch, addr, state);
 
     req->setMemFlags(event->getMemFlags()); // Copy MemFlags through
 
-    std::vector<uint8_t> data;
+    Payload data;
     Addr offset = req->getAddr() - addr;
 
     switch (state) {
@@ -846,9 +848,10 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
 
                 if (localPrefetch) {
                     line->setPrefetch(true);
+                    recordPrefetchFill(line->getAddr());
                     recordPrefetchLatency(req->getID(), LatType::MISS);
                 } else {
-                    data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+                    data = line->getData()->slice(offset, req->getSize());
                     uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
                     line->setTimestamp(sendTime - 1);
                 }
@@ -878,7 +881,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
                 } else { // Read lock/GetSX
                     line->incLock();
                 }
-                data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+                data = line->getData()->slice(offset, req->getSize());
                 uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp(), false);
                 line->setTimestamp(sendTime-1);
                 break;
@@ -1186,7 +1189,7 @@ void MESIL1::cleanUpAfterRequest(MemEvent * event, bool inMSHR) {
             if (mshr_->getFrontType(addr) == MSHREntryType::Evict) {
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                     retryBuffer_.push_back(ev);
                 }
             }
@@ -1218,7 +1221,7 @@ void MESIL1::cleanUpAfterResponse(MemEvent* event, bool inMSHR) {
         } else { // Pointer to an eviction
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                 retryBuffer_.push_back(ev);
             }
         }
@@ -1235,7 +1238,7 @@ void MESIL1::retry(Addr addr) {
         } else if (!(mshr_->pendingWriteback(addr))) {
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                 retryBuffer_.push_back(ev);
             }
         }
@@ -1258,7 +1261,7 @@ void MESIL1::retry(Addr addr) {
  *
  *  Return: time that the requested cacheline can again be accessed
  */
-uint64_t MESIL1::sendResponseUp(MemEvent* event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success) {
+uint64_t MESIL1::sendResponseUp(MemEvent* event, Payload* data, bool inMSHR, uint64_t time, bool success) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
 
@@ -1320,8 +1323,8 @@ void MESIL1::sendResponseDown(MemEvent * event, L1CacheLine * line, bool data) {
 void MESIL1::forwardFlush(MemEvent* event, L1CacheLine* line, bool evict) {
     MemEvent* flush = new MemEvent(*event);
 
-    flush->setSrc(cachename_);
-    flush->setDst(getDestination(event->getBaseAddr()));
+    flush->setSrcId(cacheId_);
+    flush->setDstId(getDestination(event->getBaseAddr()));
 
     uint64_t latency = tagLatency_; // Check coherence state/hitVmiss
     if (evict) {
@@ -1352,8 +1355,8 @@ void MESIL1::forwardFlush(MemEvent* event, L1CacheLine* line, bool evict) {
  * Latency: cache access + tag to read data that is being written back and update coherence state
  */
 void MESIL1::sendWriteback(Command cmd, L1CacheLine * line, bool dirty) {
-    MemEvent* writeback = new MemEvent(cachename_, line->getAddr(), line->getAddr(), cmd);
-    writeback->setDst(getDestination(line->getAddr()));
+    MemEvent* writeback = new MemEvent(cacheId_, line->getAddr(), line->getAddr(), cmd);
+    writeback->setDstId(getDestination(line->getAddr()));
     writeback->setSize(lineSize_);
 
     uint64_t latency = tagLatency_;
@@ -1369,7 +1372,7 @@ void MESIL1::sendWriteback(Command cmd, L1CacheLine * line, bool dirty) {
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrId(cacheId_);
 
     uint64_t baseTime = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -1382,7 +1385,7 @@ void MESIL1::sendWriteback(Command cmd, L1CacheLine * line, bool dirty) {
 /* Send notification to the core that a line we have might have been lost */
 void MESIL1::snoopInvalidation(MemEvent * event, L1CacheLine * line) {
     if (snoopL1Invs_ && line) {
-        MemEvent * snoop = new MemEvent(cachename_, event->getAddr(), event->getBaseAddr(), Command::Inv);
+        MemEvent * snoop = new MemEvent(cacheId_, event->getAddr(), event->getBaseAddr(), Command::Inv);
         uint64_t baseTime = timestamp_ > line->getTimestamp() ? timestamp_ : line->getTimestamp();
         uint64_t deliveryTime = baseTime + tagLatency_;
         Response resp = {snoop, deliveryTime, packetHeaderBytes};
@@ -1414,6 +1417,7 @@ void MESIL1::recordPrefetchResult(L1CacheLine* line, Statistic<uint64_t>* stat)
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetch(line->getAddr(), stat);
     }
 }
 
@@ -1492,7 +1496,7 @@ Addr MESIL1::getBank(Addr addr) {
 
 void MESIL1::printLine(Addr addr) { }
 void MESIL1::printData(Addr addr) { }
-void MESIL1::printData(vector<uint8_t>* data, bool set) { }
+void MESIL1::printData(Payload* data, bool set) { }
 
 void MESIL1::printStatus(Output &out) {
     cacheArray_->printCacheArray(out);
@@ -200,6 +200,7 @@ public:
 
         cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "line"));
 
         // Register statistics
         stat_eventState[(int)Command::GetS][I] =      registerStatistic<uint64_t>("stateEvent_GetS_I");
@@ -375,6 +376,9 @@ public:
     virtual std::set<Command> getValidReceiveEvents();
     void setSliceAware(uint64_t interleaveSize, uint64_t interleaveStep);
 
+    uint64_t saveSnapshot(SnapshotWriter& out) { return cacheArray_->saveSnapshot(out); }
+    void loadSnapshot(SnapshotReader& in) { cacheArray_->loadSnapshot(in); }
+
     void printStatus(Output& out);
 
     Addr getBank(Addr addr);
@@ -390,7 +394,7 @@ private:
     void retry(Addr addr);
 
     /** Event send */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success = false);
+    uint64_t sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t time, bool success = false);
     void sendResponseDown(MemEvent * event, L1CacheLine * line, bool data);
     void forwardFlush(MemEvent * event, L1CacheLine * line, bool evict);
     void sendWriteback(Command cmd, L1CacheLine * line, bool dirty);
@@ -406,7 +410,7 @@ private:
     /** Miscellaneous */
     void printLine(Addr addr);
     void printData(Addr addr);
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(Payload* data, bool set);
 
     bool snoopL1Invs_;
     State protocolState_; // E for MESI, S for MSI
@@ -869,13 +869,13 @@ bool MESIPrivNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                     delete event;
                 } else { // Raced with GetX or FlushLine
                     status = allocateMSHR(event, true, 0);
-                    sendFwdRequest(event, Command::Fetch, upperCacheName_, event->getSize(), 0, inMSHR);
+                    sendFwdRequest(event, Command::Fetch, upperCacheId_, event->getSize(), 0, inMSHR);
                 }
             } else {
                 if (!inMSHR)
                     status = allocateMSHR(event, true, 0);
                 if (status == MemEventStatus::OK)
-                    sendFwdRequest(event, Command::Fetch, upperCacheName_, event->getSize(), 0, inMSHR);
+                    sendFwdRequest(event, Command::Fetch, upperCacheId_, event->getSize(), 0, inMSHR);
             }
             break;
         case S:
@@ -959,7 +959,7 @@ bool MESIPrivNoninclusive::handleInv(MemEvent * event, bool inMSHR) {
             } else {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
                 if (status == MemEventStatus::OK) {
-                    sendFwdRequest(event, Command::Inv, upperCacheName_, event->getSize(), 0, inMSHR);
+                    sendFwdRequest(event, Command::Inv, upperCacheId_, event->getSize(), 0, inMSHR);
                 }
             }
             break;
@@ -996,7 +996,7 @@ bool MESIPrivNoninclusive::handleInv(MemEvent * event, bool inMSHR) {
         if (line->getShared()) {
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
             if (status == MemEventStatus::OK) {
-                uint64_t sendTime = sendFwdRequest(event, Command::Inv, upperCacheName_, event->getSize(), line->getTimestamp(), inMSHR);
+                uint64_t sendTime = sendFwdRequest(event, Command::Inv, upperCacheId_, event->getSize(), line->getTimestamp(), inMSHR);
                 line->setState(state1);
                 line->setTimestamp(sendTime);
             }
@@ -1076,7 +1076,7 @@ bool MESIPrivNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
                 sendWritebackAck(put);
                 mshr_->setData(addr, put->getPayload(), put->getDirty());
                 delete put;
-                sendFwdRequest(event, Command::ForceInv, upperCacheName_, event->getSize(), 0, inMSHR);
+                sendFwdRequest(event, Command::ForceInv, upperCacheId_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
                 if (mshr_->hasData(addr)) mshr_->clearData(addr);
                 sendWritebackAck(static_cast<MemEvent*>(mshr_->getFrontEvent(addr)));
@@ -1086,7 +1086,7 @@ bool MESIPrivNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             } else {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
                 if (status == MemEventStatus::OK) {
-                    sendFwdRequest(event, Command::ForceInv, upperCacheName_, event->getSize(), 0, inMSHR);
+                    sendFwdRequest(event, Command::ForceInv, upperCacheId_, event->getSize(), 0, inMSHR);
                 }
             }
             break;
@@ -1124,7 +1124,7 @@ bool MESIPrivNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             cleanUpEvent(event, inMSHR); // No replay since state doesn't change
             break;
         case SM_Inv: { // ForceInv if there's an un-inv'd sharer, else in mshr & stall
-            std::string src = mshr_->getFrontEvent(addr)->getSrc();
+            EndpointId src = mshr_->getFrontEvent(addr)->getSrcId();
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
             if (status != MemEventStatus::Reject) {
                 if (line->getShared()) {
@@ -1145,7 +1145,7 @@ bool MESIPrivNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             if (!inMSHR)
                 status = allocateMSHR(event, true, 0);
             if (status == MemEventStatus::OK) {
-                uint64_t sendTime = sendFwdRequest(event, Command::ForceInv, upperCacheName_, event->getSize(), 0, inMSHR);
+                uint64_t sendTime = sendFwdRequest(event, Command::ForceInv, upperCacheId_, event->getSize(), 0, inMSHR);
                 line->setTimestamp(sendTime);
                 line->setState(state1);
                 status = MemEventStatus::Stall;
@@ -1239,7 +1239,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 sendWritebackAck(put);
                 mshr_->setData(addr, put->getPayload(), put->getDirty());
                 delete put;
-                sendFwdRequest(event, Command::FetchInv, upperCacheName_, event->getSize(), 0, inMSHR);
+                sendFwdRequest(event, Command::FetchInv, upperCacheId_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
                 MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                 sendWritebackAck(put);
@@ -1250,7 +1250,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
             } else {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
                 if (status == MemEventStatus::OK) {
-                    sendFwdRequest(event, Command::FetchInv, upperCacheName_, event->getSize(), 0, inMSHR);
+                    sendFwdRequest(event, Command::FetchInv, upperCacheId_, event->getSize(), 0, inMSHR);
                 }
             }
             break;
@@ -1296,7 +1296,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
         if (line->getShared() || line->getOwned()) {
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
             if (status == MemEventStatus::OK) {
-                uint64_t sendTime = sendFwdRequest(event, Command::FetchInv, upperCacheName_, event->getSize(), 0, inMSHR);
+                uint64_t sendTime = sendFwdRequest(event, Command::FetchInv, upperCacheId_, event->getSize(), 0, inMSHR);
                 line->setTimestamp(sendTime);
                 line->setState(state1);
             }
@@ -1376,7 +1376,7 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
             if (!inMSHR)
                 status = allocateMSHR(event, true, 0);
             if (status == MemEventStatus::OK) {
-                sendFwdRequest(event, Command::FetchInvX, upperCacheName_, event->getSize(), 0, inMSHR);
+                sendFwdRequest(event, Command::FetchInvX, upperCacheId_, event->getSize(), 0, inMSHR);
             }
             break;
         case E:
@@ -1384,7 +1384,7 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
             if (line->getOwned()) {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
                 if (status == MemEventStatus::OK) {
-                    uint64_t sendTime = sendFwdRequest(event, Command::FetchInvX, upperCacheName_, lineSize_, line->getTimestamp(), inMSHR);
+                    uint64_t sendTime = sendFwdRequest(event, Command::FetchInvX, upperCacheId_, lineSize_, line->getTimestamp(), inMSHR);
                     line->setTimestamp(sendTime);
                     mshr_->setInProgress(addr);
                     state == E ? line->setState(E_InvX) : line->setState(M_InvX);
@@ -2040,7 +2040,7 @@ void MESIPrivNoninclusive::cleanUpAfterRequest(MemEvent* event, bool inMSHR) {
             if (mshr_->getFrontType(addr) == MSHREntryType::Evict && mshr_->getAcksNeeded(addr) == 0) {
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                     retryBuffer_.push_back(ev);
                 }
             }
@@ -2074,7 +2074,7 @@ void MESIPrivNoninclusive::cleanUpAfterResponse(MemEvent* event, bool inMSHR) {
             if (mshr_->getAcksNeeded(addr) == 0) {
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                     retryBuffer_.push_back(ev);
                 }
             }
@@ -2091,7 +2091,7 @@ void MESIPrivNoninclusive::retry(Addr addr) {
         } else if (!(mshr_->pendingWriteback(addr))) {
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                 retryBuffer_.push_back(ev);
             }
         }
@@ -2103,7 +2103,7 @@ void MESIPrivNoninclusive::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool dirty) {
+uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, Payload* data, bool inMSHR, uint64_t time, bool dirty) {
     MemEvent * responseEvent = event->makeResponse();
     responseEvent->setCmd(Command::GetXResp);
 
@@ -2132,7 +2132,7 @@ uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<ui
     return deliveryTime;
 }
 
-uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -2165,7 +2165,7 @@ uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
     return deliveryTime;
 }
 
-void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vector<uint8_t>* data, bool dirty) {
+void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, Payload* data, bool dirty) {
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
@@ -2187,11 +2187,11 @@ void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vec
 }
 
 
-uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, Payload* data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
-    flush->setSrc(cachename_);
-    flush->setDst(getDestination(event->getBaseAddr()));
+    flush->setSrcId(cacheId_);
+    flush->setDstId(getDestination(event->getBaseAddr()));
 
     uint64_t latency = tagLatency_;
     if (evict) {
@@ -2230,9 +2230,9 @@ uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::v
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
 
-uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, std::vector<uint8_t>* data, bool dirty, uint64_t startTime) {
-    MemEvent* writeback = new MemEvent(cachename_, addr, addr, cmd);
-    writeback->setDst(getDestination(addr));
+uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, Payload* data, bool dirty, uint64_t startTime) {
+    MemEvent* writeback = new MemEvent(cacheId_, addr, addr, cmd);
+    writeback->setDstId(getDestination(addr));
     writeback->setSize(size);
 
     uint64_t latency = tagLatency_;
@@ -2249,7 +2249,7 @@ uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command c
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrId(cacheId_);
 
     uint64_t sendTime = timestamp_ > startTime ? timestamp_ : startTime;
     sendTime += latency;
@@ -2262,11 +2262,11 @@ uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command c
 }
 
 
-uint64_t MESIPrivNoninclusive::sendFwdRequest(MemEvent * event, Command cmd, std::string dst, uint32_t size, uint64_t startTime, bool inMSHR) {
+uint64_t MESIPrivNoninclusive::sendFwdRequest(MemEvent * event, Command cmd, EndpointId dst, uint32_t size, uint64_t startTime, bool inMSHR) {
     Addr addr = event->getBaseAddr();
-    MemEvent * req = new MemEvent(cachename_, addr, addr, cmd);
+    MemEvent * req = new MemEvent(cacheId_, addr, addr, cmd);
     req->copyMetadata(event);
-    req->setDst(dst);
+    req->setDstId(dst);
     req->setSize(size);
 
     mshr_->incrementAcksNeeded(addr);
@@ -2287,8 +2287,8 @@ uint64_t MESIPrivNoninclusive::sendFwdRequest(MemEvent * event, Command cmd, std
 
 void MESIPrivNoninclusive::sendWritebackAck(MemEvent * event) {
     MemEvent * ack = event->makeResponse();
-    ack->setDst(event->getSrc());
-    ack->setRqstr(event->getSrc());
+    ack->setDstId(event->getSrcId());
+    ack->setRqstrId(event->getSrcId());
     ack->setSize(event->getSize());
 
     uint64_t deliveryTime = timestamp_ + tagLatency_;
@@ -2324,7 +2324,7 @@ MemEventInitCoherence* MESIPrivNoninclusive::getInitCoherenceEvent() {
 }
 
 void MESIPrivNoninclusive::hasUpperLevelCacheName(std::string cachename) {
-    upperCacheName_ = cachename;
+    upperCacheId_ = EndpointRegistry::intern(cachename);
 }
 
 void MESIPrivNoninclusive::printLine(Addr addr) {
@@ -2334,7 +2334,7 @@ void MESIPrivNoninclusive::printLine(Addr addr) {
     debug->debug(_L8_, "  Line 0x%" PRIx64 ": %s\n", addr, state.c_str());
 }
 
-void MESIPrivNoninclusive::printData(vector<uint8_t> * data, bool set) {
+void MESIPrivNoninclusive::printData(Payload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
 
@@ -214,6 +214,8 @@ public:
         params.insert(ownerParams);
         debug->debug(_INFO_,"--------------------------- Initializing [MESI Controller] ... \n\n");
 
+        upperCacheId_ = EndpointRegistry::NoEndpoint;
+
         protocol_ = params.find<bool>("protocol", 1);
         if (protocol_) {
             protocolState_ = E;
@@ -229,6 +231,7 @@ public:
         HashFunction * ht = createHashFunction(params);
         cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "line"));
 
         stat_evict[I] =      registerStatistic<uint64_t>("evict_I");
         stat_evict[S] =      registerStatistic<uint64_t>("evict_S");
@@ -441,6 +444,9 @@ public:
     virtual Addr getBank(Addr addr) { return cacheArray_->getBank(addr); }
     virtual void setSliceAware(uint64_t size, uint64_t step) { cacheArray_->setSliceAware(size, step); }
 
+    uint64_t saveSnapshot(SnapshotWriter& out) { return cacheArray_->saveSnapshot(out); }
+    void loadSnapshot(SnapshotReader& in) { cacheArray_->loadSnapshot(in); }
+
     /* Initialization */
     virtual void hasUpperLevelCacheName(std::string cachename);
     MemEventInitCoherence* getInitCoherenceEvent();
@@ -484,20 +490,20 @@ private:
     void retry(Addr addr);
 
     /** Forward a flush line request, with or without data */
-    uint64_t forwardFlush(MemEvent* event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time);
+    uint64_t forwardFlush(MemEvent* event, bool evict, Payload* data, bool dirty, uint64_t time);
 
     /** Forward a request */
-    uint64_t sendFwdRequest(MemEvent * event, Command cmd, std::string dst, uint32_t size, uint64_t startTime, bool inMSHR);
+    uint64_t sendFwdRequest(MemEvent * event, Command cmd, EndpointId dst, uint32_t size, uint64_t startTime, bool inMSHR);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::GetSResp, bool success = false);
-    uint64_t sendExclusiveResponse(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, bool dirty);
+    uint64_t sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::GetSResp, bool success = false);
+    uint64_t sendExclusiveResponse(MemEvent * event, Payload* data, bool inMSHR, uint64_t baseTime, bool dirty);
 
     /** Send response down (towards memory) */
-    void sendResponseDown(MemEvent * event, uint32_t size, vector<uint8_t>* data, bool dirty);
+    void sendResponseDown(MemEvent * event, uint32_t size, Payload* data, bool dirty);
 
     /** Send writeback request to lower level caches */
-    uint64_t sendWriteback(Addr addr, uint32_t size, Command cmd, std::vector<uint8_t>* data, bool dirty, uint64_t time = 0);
+    uint64_t sendWriteback(Addr addr, uint32_t size, Command cmd, Payload* data, bool dirty, uint64_t time = 0);
 
     void sendWritebackAck(MemEvent * event);
 
@@ -510,7 +516,7 @@ private:
     void addToOutgoingQueueUp(Response& resp);
 
 /* Miscellaneous */
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(Payload* data, bool set);
     void printLine(Addr addr);
 
 /* Statistics */
@@ -521,7 +527,7 @@ private:
     bool protocol_;  // True for MESI, false for MSI
     State protocolState_;
 
-    std::string upperCacheName_; // Private so only one
+    EndpointId upperCacheId_; // Private so only one
 
     std::map<Addr, MemEvent::id_type> responses;
 
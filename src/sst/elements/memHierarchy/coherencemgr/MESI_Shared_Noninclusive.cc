@@ -38,7 +38,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
     DataLine * data = (tag) ? dataArray_->lookup(addr, true) : nullptr;
     if (data && data->getTag() != tag) data = nullptr;
 
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrId() == cacheId_);
     uint64_t sendTime = 0;
     MemEventStatus status = MemEventStatus::OK;
     Command respcmd;
@@ -96,6 +96,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
 
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1);
+                notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Redundant);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 if (is_debug_event(event))
                     eventDI.action = "Done";
@@ -106,7 +107,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
             recordPrefetchResult(tag, statPrefetchHit);
 
             if (data || mshr_->hasData(addr)) {
-                tag->addSharer(event->getSrc());
+                tag->addSharer(event->getSrcId());
                 if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp());
                 else
@@ -146,6 +147,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
 
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1);
+                notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Redundant);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
                 break;
@@ -160,7 +162,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                         mshr_->setProfiled(addr, event->getID());
                 }
                 if (status == MemEventStatus::OK) {
-                    sendTime = sendFetch(Command::FetchInvX, event, tag->getOwner(), inMSHR, tag->getTimestamp());
+                    sendTime = sendFetch(Command::FetchInvX, event, tag->getOwnerId(), inMSHR, tag->getTimestamp());
                     state == E ? tag->setState(E_InvX) : tag->setState(M_InvX);
                     tag->setTimestamp(sendTime - 1);
                     recordLatencyType(event->getID(), LatType::INV);
@@ -170,10 +172,10 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 recordLatencyType(event->getID(), LatType::HIT);
                 if (tag->hasSharers()) {
                     respcmd = Command::GetSResp;
-                    tag->addSharer(event->getSrc());
+                    tag->addSharer(event->getSrcId());
                 } else {
                     respcmd = Command::GetXResp;
-                    tag->setOwner(event->getSrc());
+                    tag->setOwner(event->getSrcId());
                 }
                 if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), respcmd);
@@ -294,7 +296,7 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
             }
         case E:
         case M:
-            if (!tag->hasOtherSharers(event->getSrc()) && !tag->hasOwner()) {
+            if (!tag->hasOtherSharers(event->getSrcId()) && !tag->hasOwner()) {
                 if (is_debug_event(event))
                     eventDI.reason = "hit";
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
@@ -303,9 +305,9 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
                     stat_hit[(event->getCmd() == Command::GetX ? 1 : 2)][inMSHR]->addData(1);
                     stat_hits->addData(1);
                 }
-                tag->setOwner(event->getSrc());
-                if (tag->isSharer(event->getSrc())) {
-                    tag->removeSharer(event->getSrc());
+                tag->setOwner(event->getSrcId());
+                if (tag->isSharer(event->getSrcId())) {
+                    tag->removeSharer(event->getSrcId());
                     sendTime = sendResponseUp(event, nullptr, inMSHR, tag->getTimestamp(), Command::GetXResp);
                 } else if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), Command::GetXResp);
@@ -327,8 +329,8 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
                     mshr_->setProfiled(addr);
                 }
                 recordLatencyType(event->getID(), LatType::INV);
-                if (tag->hasOtherSharers(event->getSrc())) {
-                    invalidateExceptRequestor(event, tag, inMSHR, !data && !tag->isSharer(event->getSrc()));
+                if (tag->hasOtherSharers(event->getSrcId())) {
+                    invalidateExceptRequestor(event, tag, inMSHR, !data && !tag->isSharer(event->getSrcId()));
                 } else {
                     invalidateOwner(event, tag, inMSHR, Command::FetchInv);
                 }
@@ -423,10 +425,10 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
                 }
                 if (event->getEvict()) {
                     removeOwnerViaInv(event, tag, data, false);
-                    tag->addSharer(event->getSrc());
+                    tag->addSharer(event->getSrcId());
                     event->setEvict(false); // Don't stall
                 } else if (tag->hasOwner()) {
-                    uint64_t sendTime = sendFetch(Command::FetchInvX, event, tag->getOwner(), inMSHR, tag->getTimestamp());
+                    uint64_t sendTime = sendFetch(Command::FetchInvX, event, tag->getOwnerId(), inMSHR, tag->getTimestamp());
                     tag->setTimestamp(sendTime - 1);
                     state == E ? tag->setState(E_InvX) : tag->setState(M_InvX);
                     break;
@@ -443,7 +445,7 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 removeOwnerViaInv(event, tag, data, true);
-                tag->addSharer(event->getSrc());
+                tag->addSharer(event->getSrcId());
 
                 mshr_->decrementAcksNeeded(addr);
                 tag->setState(NextState[tag->getState()]);
@@ -456,7 +458,7 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_Inv:
             if (event->getEvict()) {
                 removeOwnerViaInv(event, tag, data, false);
-                tag->addSharer(event->getSrc());
+                tag->addSharer(event->getSrcId());
                 event->setEvict(false);
             }
             break;
@@ -493,7 +495,7 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool inMSHR) {
     if (inMSHR)
         mshr_->removePendingRetry(addr);
 
-    vector<uint8_t>* datavec = nullptr;
+    Payload* datavec = nullptr;
     recordLatencyType(event->getID(), LatType::HIT);
 
     switch (state) {
@@ -587,7 +589,7 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case SM_D:
         case SB_D:
             if (event->getEvict()) {
-                if (*(tag->getSharers()->begin()) == event->getSrc()) {
+                if (*(tag->getSharers()->begin()) == event->getSrcId()) {
                     removeSharerViaInv(event, tag, data, true);
                     mshr_->decrementAcksNeeded(addr);
                     tag->setState(NextState[tag->getState()]);
@@ -658,7 +660,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
             if (!inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutS][I]->addData(1);
             }
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(event->getSrcId());
             sendWritebackAck(event);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -682,7 +684,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false, 1);   // Put just after the Flush, will handle next
                 break;
             }
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(event->getSrcId());
             sendWritebackAck(event);
             if (inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutS][state]->addData(1);
@@ -693,11 +695,11 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
         case E_D:
         case M_D:
         case SB_D:
-            if (event->getSrc() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
+            if (event->getSrcId() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
                 // Retry the pending fetch
                 mshr_->decrementAcksNeeded(addr);
                 mshr_->setData(addr, event->getPayload());
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty())
                     responses.erase(addr);
                 tag->setState(NextState[state]);
@@ -705,7 +707,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
 
                 // Handle PutS now if we can, later if not
                 if (tag->numSharers() > 1) {
-                    tag->removeSharer(event->getSrc());
+                    tag->removeSharer(event->getSrcId());
                     sendWritebackAck(event);
                     if (inMSHR || !mshr_->getProfiled(addr)) {
                         stat_eventState[(int)Command::PutS][state]->addData(1);
@@ -722,7 +724,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                 }
                 break;
             }
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(event->getSrcId());
             sendWritebackAck(event);
             if (inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutS][state]->addData(1);
@@ -795,7 +797,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
                 mshr_->setData(addr, event->getPayload());
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
             tag->setState(NextState[state]);
@@ -807,7 +809,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                     stat_eventState[(int)Command::PutE][state]->addData(1);
                 }
             } else {
-                tag->addSharer(event->getSrc());
+                tag->addSharer(event->getSrcId());
                 event->setCmd(Command::PutS);
                 if (inMSHR)
                     mshr_->removeFront(addr); // Need to reinsert after the conflicting request
@@ -825,7 +827,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
                 mshr_->setData(addr, event->getPayload());
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
             sendWritebackAck(event);
@@ -900,7 +902,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
         case M_InvX:
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
             tag->setState(M);
@@ -914,7 +916,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 sendWritebackAck(event);
                 cleanUpEvent(event, inMSHR);
             } else {
-                tag->addSharer(event->getSrc());
+                tag->addSharer(event->getSrcId());
                 event->setCmd(Command::PutS);
                 mshr_->setData(addr, event->getPayload());
                 if (inMSHR)
@@ -938,7 +940,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
                 mshr_->setData(addr, event->getPayload());
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
             sendWritebackAck(event);
@@ -976,7 +978,7 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
         mshr_->removePendingRetry(addr);
 
     tag->removeOwner();
-    tag->addSharer(event->getSrc());
+    tag->addSharer(event->getSrcId());
 
     sendWritebackAck(event);
 
@@ -1751,7 +1753,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
             }
             if (tag->hasOwner()) { // Get data from owner
                 if (!applyPendingReplacement(addr)) {
-                    sendTime = sendFetch(Command::FetchInvX, event, tag->getOwner(), inMSHR, tag->getTimestamp());
+                    sendTime = sendFetch(Command::FetchInvX, event, tag->getOwnerId(), inMSHR, tag->getTimestamp());
                     tag->setTimestamp(sendTime-1);
                 }
                 state == E ? tag->setState(E_InvX) : tag->setState(M_InvX);
@@ -1783,7 +1785,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
             // Clean up so that when we replay the replacement we get the right downgraded state
             req->setCmd(Command::PutS);
             tag->removeOwner();
-            tag->addSharer(req->getSrc());
+            tag->addSharer(req->getSrcId());
             tag->setState(SA);
             delete event;
             break;
@@ -1824,7 +1826,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     // Find matching request in MSHR
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
 
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrId() == cacheId_);
     req->setFlags(event->getMemFlags());
 
     if (is_debug_event(event))
@@ -1838,10 +1840,11 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
 
     if (localPrefetch) {
         tag->setPrefetch(true);
+        recordPrefetchFill(tag->getAddr());
         if (is_debug_event(event))
             eventDI.action = "Done";
     } else {
-        tag->addSharer(req->getSrc());
+        tag->addSharer(req->getSrcId());
         uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
         tag->setTimestamp(sendTime-1);
     }
@@ -1869,7 +1872,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     // Get matching request
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
 
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrId() == cacheId_);
     req->setFlags(event->getMemFlags());
 
     if (is_debug_event(event))
@@ -1891,15 +1894,16 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
 
             if (localPrefetch) {
                 tag->setPrefetch(true);
+                recordPrefetchFill(tag->getAddr());
                 if (is_debug_event(event))
                     eventDI.action = "Done";
             } else {
                 if (tag->getState() == S || !protocol_ || mshr_->getSize(addr) > 1) {
-                    tag->addSharer(req->getSrc());
+                    tag->addSharer(req->getSrcId());
                     uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
                     tag->setTimestamp(sendTime - 1);
                 } else {
-                    tag->setOwner(req->getSrc());
+                    tag->setOwner(req->getSrcId());
                     uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
                     tag->setTimestamp(sendTime - 1);
                 }
@@ -1912,10 +1916,10 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
         case SM:
         {
             tag->setState(M);
-            tag->setOwner(req->getSrc());
+            tag->setOwner(req->getSrcId());
             uint64_t sendTime = 0;
-            if (tag->isSharer(req->getSrc())) {
-                tag->removeSharer(req->getSrc());
+            if (tag->isSharer(req->getSrcId())) {
+                tag->removeSharer(req->getSrcId());
                 sendTime = sendResponseUp(req, nullptr, true, tag->getTimestamp(), Command::GetXResp);
             } else if (event->getPayloadSize() != 0) {
                 sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
@@ -2016,7 +2020,7 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
     bool done = mshr_->decrementAcksNeeded(addr);
 
     // Remove response from expected response list & extract payload
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty())
         responses.erase(addr);
 
@@ -2038,14 +2042,14 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
             break;
         case S_Inv:
         case SB_Inv:
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(event->getSrcId());
             if (done) {
                 tag->setState(S);
                 retry(addr);
             }
             break;
         case SM_Inv:
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(event->getSrcId());
             if (done) {
                 tag->setState(SM);
                 if (!mshr_->getInProgress(addr))
@@ -2055,7 +2059,7 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
         case E_InvX:
         case M_InvX:
             tag->removeOwner();
-            tag->addSharer(event->getSrc());
+            tag->addSharer(event->getSrcId());
             tag->setState(NextState[state]); // E or M
             retry(addr);
             break;
@@ -2064,7 +2068,7 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
             if (tag->hasOwner())
                 tag->removeOwner();
             else
-                tag->removeSharer(event->getSrc());
+                tag->removeSharer(event->getSrcId());
             if (done) {
                 tag->setState(NextState[state]);    // E or M
                 retry(addr);
@@ -2108,12 +2112,12 @@ bool MESISharNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
     mshr_->decrementAcksNeeded(addr);
 
     // Clear expected responses
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     // Update coherence state
     tag->removeOwner();
-    tag->addSharer(event->getSrc());
+    tag->addSharer(event->getSrcId());
 
     if (state == M_InvX || event->getDirty())
         tag->setState(M);
@@ -2151,12 +2155,12 @@ bool MESISharNoninclusive::handleAckInv(MemEvent * event, bool inMSHR) {
 
     stat_eventState[(int)Command::AckInv][state]->addData(1);
 
-    if (tag->isSharer(event->getSrc()))
-        tag->removeSharer(event->getSrc());
+    if (tag->isSharer(event->getSrcId()))
+        tag->removeSharer(event->getSrcId());
     else
         tag->removeOwner();
 
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     bool done = mshr_->decrementAcksNeeded(addr);
@@ -2348,8 +2352,8 @@ bool MESISharNoninclusive::handleNACK(MemEvent* event, bool inMSHR) {
             if (is_debug_addr(addr)) {
             }
             if (responses.find(addr) != responses.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst()) != responses.find(addr)->second.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst())->second == nackedEvent->getID()) {
+                    && responses.find(addr)->second.find(nackedEvent->getDstId()) != responses.find(addr)->second.end()
+                    && responses.find(addr)->second.find(nackedEvent->getDstId())->second == nackedEvent->getID()) {
 
                 resendEvent(nackedEvent, true); // Resend towards CPU
             } else {
@@ -2680,7 +2684,7 @@ void MESISharNoninclusive::cleanUpAfterRequest(MemEvent* event, bool inMSHR) {
             if (mshr_->getFrontType(addr) == MSHREntryType::Evict && mshr_->getAcksNeeded(addr) == 0) {
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                     retryBuffer_.push_back(ev);
                 }
             }
@@ -2714,7 +2718,7 @@ void MESISharNoninclusive::cleanUpAfterResponse(MemEvent* event, bool inMSHR) {
             if (mshr_->getAcksNeeded(addr) == 0) {
                 std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
                 for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                    MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                    MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                     retryBuffer_.push_back(ev);
                 }
             }
@@ -2737,7 +2741,7 @@ void MESISharNoninclusive::retry(Addr addr) {
         } else if (!(mshr_->pendingWriteback(addr))) {
             std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
             for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
-                MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
+                MemEvent * ev = new MemEvent(cacheId_, addr, *it, Command::NULLCMD);
                 retryBuffer_.push_back(ev);
             }
             if (is_debug_addr(addr)) {
@@ -2755,7 +2759,7 @@ void MESISharNoninclusive::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -2784,7 +2788,7 @@ uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
     return deliveryTime;
 }
 
-void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_t> * data, bool dirty, bool evict) {
+void MESISharNoninclusive::sendResponseDown(MemEvent * event, Payload* data, bool dirty, bool evict) {
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
@@ -2805,11 +2809,11 @@ void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_
 }
 
 
-uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, Payload* data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
-    flush->setSrc(cachename_);
-    flush->setDst(getDestination(event->getBaseAddr()));
+    flush->setSrcId(cacheId_);
+    flush->setDstId(getDestination(event->getBaseAddr()));
 
     uint64_t latency = tagLatency_;
     if (evict) {
@@ -2846,8 +2850,8 @@ uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, std::v
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
 void MESISharNoninclusive::sendWritebackFromCache(Command cmd, DirectoryLine* tag, DataLine* data, bool dirty) {
-    MemEvent* writeback = new MemEvent(cachename_, tag->getAddr(), tag->getAddr(), cmd);
-    writeback->setDst(getDestination(tag->getAddr()));
+    MemEvent* writeback = new MemEvent(cacheId_, tag->getAddr(), tag->getAddr(), cmd);
+    writeback->setDstId(getDestination(tag->getAddr()));
     writeback->setSize(lineSize_);
 
     uint64_t latency = tagLatency_;
@@ -2864,7 +2868,7 @@ void MESISharNoninclusive::sendWritebackFromCache(Command cmd, DirectoryLine* ta
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrId(cacheId_);
 
     uint64_t baseTime = (timestamp_ > tag->getTimestamp()) ? timestamp_ : tag->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -2875,8 +2879,8 @@ void MESISharNoninclusive::sendWritebackFromCache(Command cmd, DirectoryLine* ta
 }
 
 void MESISharNoninclusive::sendWritebackFromMSHR(Command cmd, DirectoryLine* tag, bool dirty) {
-    MemEvent* writeback = new MemEvent(cachename_, tag->getAddr(), tag->getAddr(), cmd);
-    writeback->setDst(getDestination(tag->getAddr()));
+    MemEvent* writeback = new MemEvent(cacheId_, tag->getAddr(), tag->getAddr(), cmd);
+    writeback->setDstId(getDestination(tag->getAddr()));
     writeback->setSize(lineSize_);
 
     uint64_t latency = tagLatency_;
@@ -2893,7 +2897,7 @@ void MESISharNoninclusive::sendWritebackFromMSHR(Command cmd, DirectoryLine* tag
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrId(cacheId_);
 
     uint64_t baseTime = (timestamp_ > tag->getTimestamp()) ? timestamp_ : tag->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -2906,8 +2910,8 @@ void MESISharNoninclusive::sendWritebackFromMSHR(Command cmd, DirectoryLine* tag
 
 void MESISharNoninclusive::sendWritebackAck(MemEvent * event) {
     MemEvent * ack = event->makeResponse();
-    ack->setDst(event->getSrc());
-    ack->setRqstr(event->getSrc());
+    ack->setDstId(event->getSrcId());
+    ack->setRqstrId(event->getSrcId());
     ack->setSize(event->getSize());
 
     uint64_t deliveryTime = timestamp_ + tagLatency_;
@@ -2919,11 +2923,11 @@ void MESISharNoninclusive::sendWritebackAck(MemEvent * event) {
         eventDI.action = "Ack";
 }
 
-uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, std::string dst, bool inMSHR, uint64_t ts) {
+uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, EndpointId dst, bool inMSHR, uint64_t ts) {
     Addr addr = event->getBaseAddr();
-    MemEvent * fetch = new MemEvent(cachename_, addr, addr, cmd);
+    MemEvent * fetch = new MemEvent(cacheId_, addr, addr, cmd);
     fetch->copyMetadata(event);
-    fetch->setDst(dst);
+    fetch->setDstId(dst);
     fetch->setSize(event->getSize());
 
     mshr_->incrementAcksNeeded(addr);
@@ -2931,7 +2935,7 @@ uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, std::str
     if (responses.find(addr) != responses.end()) {
         responses.find(addr)->second.insert(std::make_pair(dst, fetch->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
     } else {
-        std::map<std::string,MemEvent::id_type> respid;
+        std::map<EndpointId,MemEvent::id_type> respid;
         respid.insert(std::make_pair(dst, fetch->getID()));
         responses.insert(std::make_pair(addr, respid));
     }
@@ -2951,13 +2955,13 @@ uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, std::str
 
 bool MESISharNoninclusive::invalidateExceptRequestor(MemEvent * event, DirectoryLine * tag, bool inMSHR, bool needData) {
     uint64_t deliveryTime = 0;
-    std::string rqstr = event->getSrc();
+    EndpointId rqstr = event->getSrcId();
 
     bool getData = needData;
-    if (getData && tag->isSharer(event->getSrc()))
+    if (getData && tag->isSharer(event->getSrcId()))
         getData = false;
 
-    for (set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+    for (EndpointSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
         if (*it == rqstr) continue;
 
         if (getData) { // FetchInv
@@ -2981,7 +2985,7 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
     } else {
         if (cmd == Command::NULLCMD)
             cmd = Command::Inv;
-        for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+        for (EndpointSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
             deliveryTime = invalidateSharer(*it, event, tag, inMSHR, cmd);
         }
         if (deliveryTime != 0) {
@@ -2994,7 +2998,7 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
 
 void MESISharNoninclusive::invalidateSharers(MemEvent * event, DirectoryLine * tag, bool inMSHR, bool needData, Command cmd) {
     uint64_t deliveryTime = 0;
-    for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+    for (EndpointSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
         if (needData) {
             deliveryTime = invalidateSharer(*it, event, tag, inMSHR, Command::FetchInv);
             needData = false;
@@ -3006,22 +3010,22 @@ void MESISharNoninclusive::invalidateSharers(MemEvent * event, DirectoryLine * t
 
 }
 
-uint64_t MESISharNoninclusive::invalidateSharer(std::string shr, MemEvent * event, DirectoryLine * tag, bool inMSHR, Command cmd) {
+uint64_t MESISharNoninclusive::invalidateSharer(EndpointId shr, MemEvent * event, DirectoryLine * tag, bool inMSHR, Command cmd) {
     if (tag->isSharer(shr)) {
         Addr addr = tag->getAddr();
-        MemEvent * inv = new MemEvent(cachename_, addr, addr, cmd);
+        MemEvent * inv = new MemEvent(cacheId_, addr, addr, cmd);
         if (event) {
             inv->copyMetadata(event);
-            inv->setRqstr(event->getRqstr());
+            inv->setRqstrId(event->getRqstrId());
         } else {
-            inv->setRqstr(cachename_);
+            inv->setRqstrId(cacheId_);
         }
-        inv->setDst(shr);
+        inv->setDstId(shr);
         inv->setSize(lineSize_);
         if (responses.find(addr) != responses.end()) {
             responses.find(addr)->second.insert(std::make_pair(shr, inv->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
         } else {
-            std::map<std::string,MemEvent::id_type> respid;
+            std::map<EndpointId,MemEvent::id_type> respid;
             respid.insert(std::make_pair(shr, inv->getID()));
             responses.insert(std::make_pair(addr, respid));
         }
@@ -3046,7 +3050,7 @@ uint64_t MESISharNoninclusive::invalidateSharer(std::string shr, MemEvent * even
 
 bool MESISharNoninclusive::invalidateOwner(MemEvent * metaEvent, DirectoryLine * tag, bool inMSHR, Command cmd) {
     Addr addr = tag->getAddr();
-    if (tag->getOwner() == "")
+    if (!tag->hasOwner())
         return false;
 
     if (is_debug_addr(addr)) {
@@ -3054,24 +3058,24 @@ bool MESISharNoninclusive::invalidateOwner(MemEvent * metaEvent, DirectoryLine *
         eventDI.reason = "Inv owner";
     }
 
-    MemEvent * inv = new MemEvent(cachename_, addr, addr, cmd);
+    MemEvent * inv = new MemEvent(cacheId_, addr, addr, cmd);
     if (metaEvent) {
         inv->copyMetadata(metaEvent);
-        inv->setRqstr(metaEvent->getRqstr());
+        inv->setRqstrId(metaEvent->getRqstrId());
     } else {
-        inv->setRqstr(cachename_);
+        inv->setRqstrId(cacheId_);
     }
-    inv->setDst(tag->getOwner());
+    inv->setDstId(tag->getOwnerId());
     inv->setSize(lineSize_);
 
     mshr_->incrementAcksNeeded(addr);
 
     // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
     if (responses.find(addr) != responses.end()) {
-        responses.find(addr)->second.insert(std::make_pair(inv->getDst(), inv->getID()));
+        responses.find(addr)->second.insert(std::make_pair(inv->getDstId(), inv->getID()));
     } else {
-        std::map<std::string,MemEvent::id_type> respid;
-        respid.insert(std::make_pair(inv->getDst(), inv->getID()));
+        std::map<EndpointId,MemEvent::id_type> respid;
+        respid.insert(std::make_pair(inv->getDstId(), inv->getID()));
         responses.insert(std::make_pair(addr,respid));
     }
 
@@ -3094,10 +3098,10 @@ bool MESISharNoninclusive::applyPendingReplacement(Addr addr) {
             mshr_->incrementAcksNeeded(addr);
             mshr_->moveEntryToFront(addr, i);
             if (responses.find(addr) != responses.end()) {
-                responses.find(addr)->second.insert(std::make_pair(evb->getSrc(), evb->getID()));
+                responses.find(addr)->second.insert(std::make_pair(evb->getSrcId(), evb->getID()));
             } else {
-                std::map<std::string,MemEvent::id_type> respid;
-                respid.insert(std::make_pair(evb->getSrc(), evb->getID()));
+                std::map<EndpointId,MemEvent::id_type> respid;
+                respid.insert(std::make_pair(evb->getSrcId(), evb->getID()));
                 responses.insert(std::make_pair(addr,respid));
             }
             retry(addr);
@@ -3127,12 +3131,12 @@ void MESISharNoninclusive::addToOutgoingQueueUp(Response& resp) {
 
 void MESISharNoninclusive::removeSharerViaInv(MemEvent * event, DirectoryLine * tag, DataLine * data, bool remove) {
     Addr addr = event->getBaseAddr();
-    tag->removeSharer(event->getSrc());
+    tag->removeSharer(event->getSrcId());
     if (!data && !mshr_->hasData(addr))
         mshr_->setData(addr, event->getPayload());
 
     if (remove) {
-        responses.find(addr)->second.erase(event->getSrc());
+        responses.find(addr)->second.erase(event->getSrcId());
         if (responses.find(addr)->second.empty())
             responses.erase(addr);
     }
@@ -3156,7 +3160,7 @@ void MESISharNoninclusive::removeOwnerViaInv(MemEvent * event, DirectoryLine * t
     }
 
     if (remove) {
-        responses.find(addr)->second.erase(event->getSrc());
+        responses.find(addr)->second.erase(event->getSrcId());
         if (responses.find(addr)->second.empty())
             responses.erase(addr);
     }
@@ -3166,6 +3170,7 @@ void MESISharNoninclusive::recordPrefetchResult(DirectoryLine * tag, Statistic<u
     if (tag->getPrefetch()) {
         stat->addData(1);
         tag->setPrefetch(false);
+        notifyListenerOfPrefetch(tag->getAddr(), stat);
     }
 }
 
@@ -3189,7 +3194,7 @@ void MESISharNoninclusive::printLine(Addr addr) {
     }
 }
 
-void MESISharNoninclusive::printData(vector<uint8_t> * data, bool set) {
+void MESISharNoninclusive::printData(Payload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
 
@@ -277,6 +277,7 @@ public:
         HashFunction * ht = createHashFunction(params);
         dataArray_ = new CacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         dataArray_->setBanked(params.find<uint64_t>("banks", 0));
+        dataArray_->setLayout(params.find<std::string>("array_layout", "line"));
 
         uint64_t dLines = params.find<uint64_t>("dlines");
         uint64_t dAssoc = params.find<uint64_t>("dassoc");
@@ -284,6 +285,7 @@ public:
         ReplacementPolicy *drmgr = createReplacementPolicy(dLines, dAssoc, params, 1, false);
         dirArray_ = new CacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht);
         dirArray_->setBanked(params.find<uint64_t>("banks", 0));
+        dirArray_->setLayout(params.find<std::string>("array_layout", "line"));
 
         /* Statistics */
         stat_evict[I] =         registerStatistic<uint64_t>("evict_I");
@@ -543,6 +545,24 @@ public:
         dataArray_->setSliceAware(size, step);
     }
 
+    uint64_t saveSnapshot(SnapshotWriter& out) {
+        return dirArray_->saveSnapshot(out) + dataArray_->saveSnapshot(out);
+    }
+
+    /* Data lines are reattached to their restored directory lines */
+    void loadSnapshot(SnapshotReader& in) {
+        dirArray_->loadSnapshot(in);
+        std::vector<DataLine*> data;
+        dataArray_->loadSnapshot(in, &data);
+        for (std::vector<DataLine*>::iterator it = data.begin(); it != data.end(); it++) {
+            DirectoryLine* tag = dirArray_->lookup((*it)->getAddr(), false);
+            if (tag)
+                (*it)->setTag(tag);
+            else
+                dataArray_->deallocate(*it);
+        }
+    }
+
     std::set<Command> getValidReceiveEvents() {
         std::set<Command> cmds = { Command::GetS,
             Command::GetX,
@@ -585,25 +605,25 @@ private:
     /** Invalidate sharers and/or owner; returns either the new line timestamp (or 0 if no invalidation) or a bool indicating whether anything was invalidated */
     bool invalidateExceptRequestor(MemEvent * event, DirectoryLine * line, bool inMSHR, bool needData);
     bool invalidateAll(MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::NULLCMD);
-    uint64_t invalidateSharer(std::string shr, MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::Inv);
+    uint64_t invalidateSharer(EndpointId shr, MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::Inv);
     void invalidateSharers(MemEvent * event, DirectoryLine * line, bool inMSHR, bool needData, Command cmd);
     bool invalidateOwner(MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::FetchInv);
 
     /** Forward a flush line request, with or without data */
-    uint64_t forwardFlush(MemEvent* event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time);
+    uint64_t forwardFlush(MemEvent* event, bool evict, Payload* data, bool dirty, uint64_t time);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = false);
+    uint64_t sendResponseUp(MemEvent * event, Payload* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = false);
 
     /** Send response down (towards memory) */
-    void sendResponseDown(MemEvent* event, std::vector<uint8_t>* data, bool dirty, bool evict);
+    void sendResponseDown(MemEvent* event, Payload* data, bool dirty, bool evict);
 
     /** Send writeback request to lower level caches */
     void sendWritebackFromCache(Command cmd, DirectoryLine* tag, DataLine* data, bool dirty);
     void sendWritebackFromMSHR(Command cmd, DirectoryLine* tag, bool dirty);
     void sendWritebackAck(MemEvent* event);
 
-    uint64_t sendFetch(Command cmd, MemEvent * event, std::string dst, bool inMSHR, uint64_t ts);
+    uint64_t sendFetch(Command cmd, MemEvent * event, EndpointId dst, bool inMSHR, uint64_t ts);
 
     /** Call through to coherenceController with statistic recording */
     void addToOutgoingQueue(Response& resp);
@@ -617,7 +637,7 @@ private:
     bool applyPendingReplacement(Addr addr);
 
 /* Miscellaneous */
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(Payload* data, bool set);
     void printLine(Addr addr);
 
 /* Statistics */
@@ -631,7 +651,7 @@ private:
     bool protocol_;  // True for MESI, false for MSI
     State protocolState_;
 
-    std::map<Addr, std::map<std::string, MemEvent::id_type> > responses;
+    std::map<Addr, std::map<EndpointId, MemEvent::id_type> > responses;
 
     // Map an outstanding eviction (key = replaceAddr,newAddr) to whether it is a directory eviction (true) or data eviction (false)
     std::map<std::pair<Addr,Addr>, bool> evictionType_;
@@ -83,6 +83,7 @@ CoherenceController::CoherenceController(ComponentId_t id, Params &params, Param
     dropPrefetchLevel_ = ((size_t) - 1);
     maxOutstandingPrefetch_ = ((size_t) - 2);
     cachename_ = getName().c_str();
+    cacheId_ = EndpointRegistry::intern(cachename_);
 
 
     // Register statistics - only those that are common across all coherence managers
@@ -147,8 +148,12 @@ ReplacementPolicy* CoherenceController::createReplacementPolicy(uint64_t lines,
     }
     if (policy == "random") return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.random", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
     if (policy == "nmru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.nmru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "srrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.srrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "brrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.brrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "drrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.drrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "ship")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.ship", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
 
-    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', and 'nmru'. You specified '%s'.\n", getName().c_str(), policy.c_str());
+    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', 'nmru', 'srrip', 'brrip', 'drrip', and 'ship'. You specified '%s'.\n", getName().c_str(), policy.c_str());
     return nullptr;
 }
 
@@ -331,7 +336,7 @@ bool CoherenceController::sendOutgoingEvents() {
             }
         }
 
-        outgoingEvent->setDst(linkDown_->findTargetDestination(outgoingEvent->getRoutingAddress()));
+        outgoingEvent->setDstId(linkDown_->findTargetDestinationId(outgoingEvent->getRoutingAddress()));
 
         if (is_debug_event(outgoingEvent)) {
             debug->debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
@@ -383,8 +388,8 @@ bool CoherenceController::checkIdle() {
 
 /* Forward an events toward memory. Return expected send time. */
 uint64_t CoherenceController::forwardTowardsMem(MemEventBase * event) {
-    event->setSrc(cachename_);
-    event->setDst(linkDown_->findTargetDestination(event->getRoutingAddress()));
+    event->setSrcId(cacheId_);
+    event->setDstId(linkDown_->findTargetDestinationId(event->getRoutingAddress()));
 
     Response fwdReq = {event, timestamp_ + 1, packetHeaderBytes + event->getPayloadSize()};
     addToOutgoingQueue(fwdReq);
@@ -392,9 +397,9 @@ uint64_t CoherenceController::forwardTowardsMem(MemEventBase * event) {
 }
 
 /* Forward an event towards processor. Return expected send time. */
-uint64_t CoherenceController::forwardTowardsCPU(MemEventBase * event, std::string dst) {
-    event->setSrc(cachename_);
-    event->setDst(dst);
+uint64_t CoherenceController::forwardTowardsCPU(MemEventBase * event, EndpointId dst) {
+    event->setSrcId(cacheId_);
+    event->setDstId(dst);
 
     Response fwdReq = {event, timestamp_ + 1, packetHeaderBytes + event->getPayloadSize()};
     addToOutgoingQueueUp(fwdReq);
@@ -468,16 +473,40 @@ void CoherenceController::notifyListenerOfEvict(Addr addr, uint32_t size, Addr i
 }
 
 
+/* Feedback to prefetchers */
+void CoherenceController::notifyListenerOfPrefetch(Addr addr, PrefetchResult result) {
+    for (int i = 0; i < listeners_.size(); i++) {
+        listeners_[i]->notifyPrefetchResult(addr, result);
+    }
+}
+
+/* Feedback for a prefetched line whose outcome was just recorded in stat */
+void CoherenceController::notifyListenerOfPrefetch(Addr addr, Statistic<uint64_t>* stat) {
+    PrefetchResult result = PrefetchResult::Useless;
+    if (stat == statPrefetchHit || stat == statPrefetchUpgradeMiss)
+        result = PrefetchResult::Useful;
+    else if (stat == statPrefetchRedundant)
+        result = PrefetchResult::Redundant;
+    notifyListenerOfPrefetch(addr, result);
+}
+
+/* A local prefetch filled a line. It was late if a request is already waiting behind it. */
+void CoherenceController::recordPrefetchFill(Addr addr) {
+    if (mshr_->getSize(addr) > 1)
+        notifyListenerOfPrefetch(addr, PrefetchResult::Late);
+}
+
+
 /* Forward a message to a lower level (towards memory) in the hierarchy */
-uint64_t CoherenceController::forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data) {
+uint64_t CoherenceController::forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, Payload* data) {
     /* Create event to be forwarded */
     MemEvent* forwardEvent;
     forwardEvent = new MemEvent(*event);
 
     if (data == nullptr) forwardEvent->setPayload(0, nullptr);
 
-    forwardEvent->setSrc(cachename_);
-    forwardEvent->setDst(linkDown_->findTargetDestination(event->getRoutingAddress()));
+    forwardEvent->setSrcId(cacheId_);
+    forwardEvent->setDstId(linkDown_->findTargetDestinationId(event->getRoutingAddress()));
     forwardEvent->setSize(requestSize);
 
     if (data != nullptr) forwardEvent->setPayload(*data);
@@ -539,21 +568,21 @@ void CoherenceController::resendEvent(MemEvent * event, bool towardsCPU) {
 
 
 /* Send response up (towards CPU). L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Payload* data, bool replay, uint64_t baseTime, bool atomic) {
     return sendResponseUp(event, CommandResponse[(int)event->getCmd()], data, false, replay, baseTime, atomic);
 }
 
 
 /* Send response up (towards CPU). L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, Payload* data, bool replay, uint64_t baseTime, bool atomic) {
     return sendResponseUp(event, cmd, data, false, replay, baseTime, atomic);
 }
 
 
 /* Send response towards the CPU. L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool atomic) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, Payload* data, bool dirty, bool replay, uint64_t baseTime, bool atomic) {
     MemEvent * responseEvent = event->makeResponse(cmd);
-    responseEvent->setDst(event->getSrc());
+    responseEvent->setDstId(event->getSrcId());
     responseEvent->setSize(event->getSize());
     if (data != nullptr) responseEvent->setPayload(*data);
     responseEvent->setDirty(dirty);
@@ -576,15 +605,17 @@ MemEventStatus CoherenceController::allocateMSHR(MemEvent * event, bool fwdReq,
     // Screen prefetches first to ensure limits are not exceeeded:
     //      - Maximum number of outstanding prefetches
     //      - MSHR too full to accept prefetches
-    if (event->isPrefetch() && event->getRqstr() == cachename_) {
+    if (event->isPrefetch() && event->getRqstrId() == cacheId_) {
         if (dropPrefetchLevel_ <= mshr_->getSize()) {
             eventDI.action = "Reject";
             eventDI.reason = "Prefetch drop level";
+            notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Dropped);
             return MemEventStatus::Reject;
         }
         if (maxOutstandingPrefetch_ <= outstandingPrefetches_) {
             eventDI.action = "Reject";
             eventDI.reason = "Max outstanding prefetches";
+            notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Dropped);
             return MemEventStatus::Reject;
         }
     }
@@ -595,6 +626,8 @@ MemEventStatus CoherenceController::allocateMSHR(MemEvent * event, bool fwdReq,
             eventDI.action = "Reject";
             eventDI.reason = "MSHR full";
         }
+        if (event->isPrefetch() && event->getRqstrId() == cacheId_)
+            notifyListenerOfPrefetch(event->getBaseAddr(), PrefetchResult::Dropped);
         return MemEventStatus::Reject; // MSHR is full
     } else if (end_pos != 0) {
         if (is_debug_event(event)) {
@@ -32,6 +32,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/hash.h"
+#include "sst/elements/memHierarchy/snapshot.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -90,7 +91,7 @@ public:
     uint64_t forwardTowardsMem(MemEventBase * event);
 
     /* Forward an event towards processor. Return expected send time */
-    uint64_t forwardTowardsCPU(MemEventBase * event, std::string dst);
+    uint64_t forwardTowardsCPU(MemEventBase * event, EndpointId dst);
 
     /* Send a NACK event */
     void sendNACK(MemEvent * event);
@@ -149,11 +150,15 @@ public:
     virtual std::set<Command> getValidReceiveEvents() = 0;
 
     /* Memory components are identified by their names (e.g., source, destination, requestor) */
-    void setName(std::string name) { cachename_ = name; }
+    void setName(std::string name) { cachename_ = name; cacheId_ = EndpointRegistry::intern(name); }
 
     /* Call through to cache array to configure banking/slicing */
     virtual void setSliceAware(uint64_t interleaveSize, uint64_t interleaveStep) = 0;
 
+    /* Save/restore the cache array(s) for warm starts. saveSnapshot returns the number of lines not saved because they were in transition */
+    virtual uint64_t saveSnapshot(SnapshotWriter& out) = 0;
+    virtual void loadSnapshot(SnapshotReader& in) = 0;
+
     /* Setup debug info (cache-wide) */
     void setDebug(std::set<Addr> debugAddr) { DEBUG_ADDR = debugAddr; }
 
@@ -189,9 +194,12 @@ protected:
     /* Listener callbacks */
     virtual void notifyListenerOfAccess(MemEvent * event, NotifyAccessType accessT, NotifyResultType resultT);
     virtual void notifyListenerOfEvict(Addr addr, uint32_t size, uint64_t ip);
+    void notifyListenerOfPrefetch(Addr addr, PrefetchResult result);
+    void notifyListenerOfPrefetch(Addr addr, Statistic<uint64_t>* stat);
+    void recordPrefetchFill(Addr addr);
 
     /* Forward a message to a lower memory level (towards memory) */
-    uint64_t forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data);
+    uint64_t forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, Payload* data);
 
     /* Insert event into MSHR */
     MemEventStatus allocateMSHR(MemEvent * event, bool fwdReq, int pos = -1, bool stallEvict = false);
@@ -254,6 +262,7 @@ protected:
 
     /* Cache name - used for identifying where events came from/are going to */
     std::string cachename_;
+    EndpointId cacheId_;    // Interned cachename_, used on the event path
 
     /* Output & debug */
     Output* output; // Output stream for warnings, notices, fatal, etc.
@@ -306,11 +315,11 @@ protected:
     /* Add a new event to the outgoing command queue towards the CPU */
     virtual void addToOutgoingQueueUp(Response& resp);
 
-    virtual uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic = false);
-    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic = false);
-    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool atomic = false);
+    virtual uint64_t sendResponseUp(MemEvent * event, Payload* data, bool replay, uint64_t baseTime, bool atomic = false);
+    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, Payload* data, bool replay, uint64_t baseTime, bool atomic = false);
+    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, Payload* data, bool dirty, bool replay, uint64_t baseTime, bool atomic = false);
 
-    std::string getDestination(Addr addr) { return linkDown_->findTargetDestination(addr); }
+    EndpointId getDestination(Addr addr) { return linkDown_->findTargetDestinationId(addr); }
 
     std::string getSrc();
 
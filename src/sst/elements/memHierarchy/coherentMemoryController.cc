@@ -198,14 +198,13 @@ void CoherentMemController::handleRequest(MemEvent * ev) {
     outstandingEventList_.insert(std::make_pair(ev->getID(), OutstandingEvent(ev, ev->getBaseAddr())));
     notifyListeners(ev);
 
-    if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        mshr_.insert(std::make_pair(ev->getBaseAddr(), std::list<MSHREntry>(1, MSHREntry(ev->getID(), ev->getCmd()))));
+    std::pair<AddrQueueMap<MSHREntry>::iterator,bool> entry = mshr_.insert(ev->getBaseAddr());
+    entry.first->second.push_back(MSHREntry(ev->getID(), ev->getCmd()));
+    if (entry.second) {
         if (!ev->queryFlag(MemEventBase::F_NONCACHEABLE)) {
             cacheStatus_.at(ev->getBaseAddr()/lineSize_) = true;
         }
         memBackendConvertor_->handleMemEvent(ev);
-    } else {
-        mshr_.find(ev->getBaseAddr())->second.push_back(MSHREntry(ev->getID(), ev->getCmd()));
     }
 }
 
@@ -223,8 +222,9 @@ void CoherentMemController::handleReplacement(MemEvent * ev) {
     }
 
     /* Handle shootdown race where no further Ack is expected */
-    if (!directory_ && mshr_.find(ev->getBaseAddr()) != mshr_.end()) {
-        MSHREntry * entry = &(mshr_.find(ev->getBaseAddr())->second.front());
+    AddrQueueMap<MSHREntry>::iterator mshrIt = directory_ ? mshr_.end() : mshr_.find(ev->getBaseAddr());
+    if (mshrIt != mshr_.end()) {
+        MSHREntry * entry = &(mshrIt->second.front());
         if (entry->cmd == Command::CustomReq && entry->shootdown) {
             ev->getPayload().empty() ? handleAckInv(ev) : handleFetchResp(ev);
             return;
@@ -243,14 +243,15 @@ void CoherentMemController::handleReplacement(MemEvent * ev) {
     outstandingEventList_.insert(std::make_pair(ev->getID(), OutstandingEvent(ev, ev->getBaseAddr())));
     notifyListeners(ev);
 
-    if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        mshr_.insert(std::make_pair(ev->getBaseAddr(), std::list<MSHREntry>(1, MSHREntry(ev->getID(), ev->getCmd()))));
+    std::pair<AddrQueueMap<MSHREntry>::iterator,bool> mshrEntry = mshr_.insert(ev->getBaseAddr());
+    if (mshrEntry.second) {
+        mshrEntry.first->second.push_back(MSHREntry(ev->getID(), ev->getCmd()));
         cacheStatus_.at(ev->getBaseAddr()/lineSize_) = directory_;
         memBackendConvertor_->handleMemEvent(ev);
     } else {
         /* Search for race with a shootdown where we might receive an Ack but not data */
-        std::list<MSHREntry>* entryList = &(mshr_.find(ev->getBaseAddr())->second);
-        for (std::list<MSHREntry>::iterator it = entryList->begin(); it != entryList->end(); it++) {
+        AddrQueueMap<MSHREntry>::Queue* entryList = &(mshrEntry.first->second);
+        for (AddrQueueMap<MSHREntry>::Queue::iterator it = entryList->begin(); it != entryList->end(); it++) {
             if (it->cmd == Command::CustomReq && it->shootdown) {
                 if (it == entryList->begin()) { /* Shootdown in progress, we will receive an Ack but possibly no data with it */
                     it->writebacks.insert(ev->getID());
@@ -285,8 +286,9 @@ void CoherentMemController::handleFlush(MemEvent * ev) {
      * - Caches handle a FetchInv that raced with FlushLineInv by dropping the FetchInv
      * - Caches handle a FetchInv that raced with FlushLine by invalidating caches and eventually responding with AckInv
      */
-    if (mshr_.find(ev->getBaseAddr()) != mshr_.end()) {
-        MSHREntry * entry = &(mshr_.find(ev->getBaseAddr())->second.front());
+    AddrQueueMap<MSHREntry>::iterator mshrIt = mshr_.find(ev->getBaseAddr());
+    if (mshrIt != mshr_.end()) {
+        MSHREntry * entry = &(mshrIt->second.front());
         if (entry->cmd == Command::CustomReq && entry->shootdown) { // Race with shootdown
             if (!directory_) {
                 if (ev->getCmd() == Command::FlushLineInv) {
@@ -314,29 +316,28 @@ void CoherentMemController::handleFlush(MemEvent * ev) {
 
     MemEvent* put = NULL;
     if (ev->getPayloadSize() != 0) {
-        put = new MemEvent(getName(), ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload());
+        put = new MemEvent(memId_, ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload());
         put->setFlag(MemEvent::F_NORESPONSE);
         outstandingEventList_.insert(std::make_pair(put->getID(), OutstandingEvent(put, put->getBaseAddr())));
         notifyListeners(ev);
 
-        if (mshr_.find(put->getBaseAddr()) == mshr_.end()) {
-            mshr_.insert(std::make_pair(put->getBaseAddr(), std::list<MSHREntry>(1, MSHREntry(put->getID(), put->getCmd()))));
+        std::pair<AddrQueueMap<MSHREntry>::iterator,bool> putEntry = mshr_.insert(put->getBaseAddr());
+        putEntry.first->second.push_back(MSHREntry(put->getID(), put->getCmd()));
+        if (putEntry.second) {
             memBackendConvertor_->handleMemEvent(put);
-        } else {
-            mshr_.find(put->getBaseAddr())->second.push_back(MSHREntry(put->getID(), put->getCmd()));
         }
     }
 
     outstandingEventList_.insert(std::make_pair(ev->getID(), OutstandingEvent(ev, ev->getBaseAddr())));
-    if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        mshr_.insert(std::make_pair(ev->getBaseAddr(), std::list<MSHREntry>(1, MSHREntry(ev->getID(), ev->getCmd()))));
+    // TODO resolve potential race with a not-yet-started shootdown sitting in the MSHR?
+    std::pair<AddrQueueMap<MSHREntry>::iterator,bool> mshrEntry = mshr_.insert(ev->getBaseAddr());
+    mshrEntry.first->second.push_back(MSHREntry(ev->getID(), ev->getCmd()));
+    if (mshrEntry.second) {
         if (ev->getCmd() == Command::FlushLineInv) {
             cacheStatus_.at(ev->getBaseAddr()/lineSize_) = false;
             ev->setCmd(Command::FlushLine);
         }
         memBackendConvertor_->handleMemEvent(ev);
-    } else { // TODO resolve potential race with a not-yet-started shootdown sitting in the MSHR?
-        mshr_.find(ev->getBaseAddr())->second.push_back(MSHREntry(ev->getID(), ev->getCmd()));
     }
 }
 
@@ -389,8 +390,8 @@ void CoherentMemController::handleFetchResp(MemEvent * ev) {
 
     // Write dirty data if needed
     if (ev->getDirty()) {
-        MemEvent * write = new MemEvent(getName(), ev->getAddr(), baseAddr, Command::PutM, ev->getPayload());
-        write->setRqstr(ev->getRqstr());
+        MemEvent * write = new MemEvent(memId_, ev->getAddr(), baseAddr, Command::PutM, ev->getPayload());
+        write->setRqstrId(ev->getRqstrId());
         ev->setFlag(MemEvent::F_NORESPONSE);
 
         entry->writebacks.insert(write->getID());
@@ -417,13 +418,14 @@ void CoherentMemController::handleNack(MemEvent * ev) {
     Addr baseAddr = nackedEvent->isAddrGlobal() ? translateToLocal(nackedEvent->getBaseAddr()) : nackedEvent->getBaseAddr();
 
     /* NACKed event no longer needed due to race between replacement and Inv */
-    if (mshr_.find(baseAddr) == mshr_.end()) {
+    AddrQueueMap<MSHREntry>::iterator mshrIt = mshr_.find(baseAddr);
+    if (mshrIt == mshr_.end()) {
         delete nackedEvent;
         delete ev;
         return;
     }
 
-    MSHREntry * entry = &(mshr_.find(baseAddr)->second.front());
+    MSHREntry * entry = &(mshrIt->second.front());
     if (entry->shootdown) { // Still need the shootdown
         /* Compute backoff to avoid excessive NACKing */
         int retries = nackedEvent->getRetries();
@@ -452,18 +454,20 @@ void CoherentMemController::handleCustomCmd(MemEventBase * evb) {
 
     /* Custom commands may touch multiple (base) addresses */
     for (std::set<Addr>::iterator it = outEv->addrs.begin(); it != outEv->addrs.end(); it++) {
-        if (mshr_.find(*it) == mshr_.end()) {
+        std::pair<AddrQueueMap<MSHREntry>::iterator,bool> mshrEntry = mshr_.insert(*it);
+        AddrQueueMap<MSHREntry>::Queue* entryList = &(mshrEntry.first->second);
+        if (mshrEntry.second) {
             if (!evInfo.shootdown) {
-                mshr_.insert(std::make_pair(*it, std::list<MSHREntry>(1, MSHREntry(evb->getID(), evb->getCmd()))));
+                entryList->push_back(MSHREntry(evb->getID(), evb->getCmd()));
                 outEv->decrementCount();
             } else if (doShootdown(*it, evb)) {
-                mshr_.insert(std::make_pair(*it, std::list<MSHREntry>(1, MSHREntry(evb->getID(), evb->getCmd(), evInfo.shootdown))));
+                entryList->push_back(MSHREntry(evb->getID(), evb->getCmd(), evInfo.shootdown));
             } else {
-                mshr_.insert(std::make_pair(*it, std::list<MSHREntry>(1, MSHREntry(evb->getID(), evb->getCmd()))));
+                entryList->push_back(MSHREntry(evb->getID(), evb->getCmd()));
                 outEv->decrementCount();
             }
         } else {
-            mshr_.find(*it)->second.push_back(MSHREntry(evb->getID(), evb->getCmd(), evInfo.shootdown));
+            entryList->push_back(MSHREntry(evb->getID(), evb->getCmd(), evInfo.shootdown));
         }
     }
 
@@ -482,9 +486,9 @@ void CoherentMemController::handleCustomCmd(MemEventBase * evb) {
 bool CoherentMemController::doShootdown(Addr addr, MemEventBase * ev) {
     if (cacheStatus_.at(addr/lineSize_) == true) {
         Addr globalAddr = translateToGlobal(addr);
-        MemEvent * inv = new MemEvent(getName(), globalAddr, globalAddr, Command::FetchInv, lineSize_);
-        inv->setRqstr(ev->getRqstr());
-        inv->setDst(ev->getSrc());
+        MemEvent * inv = new MemEvent(memId_, globalAddr, globalAddr, Command::FetchInv, lineSize_);
+        inv->setRqstrId(ev->getRqstrId());
+        inv->setDstId(ev->getSrcId());
 
         msgQueue_.insert(std::make_pair(timestamp_, inv)); /* Send on next clock. TODO timing needed? */
         return true;
@@ -606,15 +610,16 @@ void CoherentMemController::finishCustomReq(SST::Event::id_type id, uint32_t fla
  */
 void CoherentMemController::updateMSHR(Addr baseAddr) {
     // Remove finished event
-    mshr_.find(baseAddr)->second.pop_front();
+    AddrQueueMap<MSHREntry>::iterator mshrIt = mshr_.find(baseAddr);
+    mshrIt->second.pop_front();
 
     /* Delete address if no more events */
-    if (mshr_.find(baseAddr)->second.empty()) {
-        mshr_.erase(baseAddr);
+    if (mshrIt->second.empty()) {
+        mshr_.erase(mshrIt);
 
     /* Start next event */
     } else {
-        MSHREntry * entry = &(mshr_.find(baseAddr)->second.front());
+        MSHREntry * entry = &(mshrIt->second.front());
         OutstandingEvent * outEv = &(outstandingEventList_.find(entry->id)->second);
 
         /* If custom request check whether it's ready to replay */
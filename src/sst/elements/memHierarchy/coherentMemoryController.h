@@ -29,6 +29,7 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
+#include "sst/elements/memHierarchy/addrHashMap.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/membackend/backing.h"
 
@@ -108,10 +109,12 @@ private:
             bool shootdown;                             // Whether event requires a shootdown before being processed
             std::set<SST::Event::id_type> writebacks;   // Writebacks this event is waiting for, due to shootdown
 
+            // Empty entry, used by the MSHR's entry pool
+            MSHREntry() : cmd(Command::NULLCMD), shootdown(false) { }
             MSHREntry(SST::Event::id_type id, Command cmd, bool sdown = false) : id(id), cmd(cmd), shootdown(sdown) { }
     };
 
-    std::map<Addr, std::list<MSHREntry> > mshr_;    // Keeps outstanding events coherent
+    AddrQueueMap<MSHREntry> mshr_;    // Keeps outstanding events coherent
 
     // Event tracking
     class OutstandingEvent {
@@ -37,6 +37,9 @@ public:
     CustomCmdEvent(std::string src, Addr addr, Addr baseAddr, Command cmd, uint32_t opc = 0, uint32_t size = 0) :
         MemEventBase(src, cmd), addr_(addr), baseAddr_(baseAddr), addrGlobal_(true), opCode_(opc), size_(size), instPtr_(0), vAddr_(0) { }
 
+    CustomCmdEvent(EndpointId src, Addr addr, Addr baseAddr, Command cmd, uint32_t opc = 0, uint32_t size = 0) :
+        MemEventBase(src, cmd), addr_(addr), baseAddr_(baseAddr), addrGlobal_(true), opCode_(opc), size_(size), instPtr_(0), vAddr_(0) { }
+
     /* Getters/setters */
     void setAddr(Addr addr) { addr_ = addr; }
     Addr getAddr() { return addr_; }
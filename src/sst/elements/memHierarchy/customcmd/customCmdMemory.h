@@ -17,6 +17,8 @@
 #define _MEMHIERARCHY_CUSTOMCMDMEMHANDLER_H_
 
 #include <string>
+#include <vector>
+#include <functional>
 
 #include <sst/core/event.h>
 #include <sst/core/output.h>
@@ -31,10 +33,10 @@ class CustomCmdInfo {
 public:
 
     /* Constructors */
-    CustomCmdInfo() { }
+    CustomCmdInfo() : usesAccesses_(false), maxOutstanding_(0) { }
 
     CustomCmdInfo(SST::Event::id_type id, std::string rqstr, uint32_t flags = 0 ) :
-      id_(id), flags_(flags), rqstr_(rqstr) { }
+      id_(id), flags_(flags), rqstr_(rqstr), usesAccesses_(false), maxOutstanding_(0) { }
 
     virtual ~CustomCmdInfo() = default;
 
@@ -64,10 +66,38 @@ public:
     std::string getRqstr() { return rqstr_; }
     void setRqstr(std::string rq) { rqstr_ = rq; }
 
+    /* Commands executed at the memory controller (e.g., near-memory compute) can be
+     * charged as the memory they touch instead of being sent to the backend.
+     * The convertor issues line-sized reads and writes covering each range, in order,
+     * and responds once they have all completed. Addresses are local to the memory.
+     * A range is count elements of bytes each, stride apart */
+    struct AccessRange {
+        Addr start;
+        uint64_t bytes;
+        uint64_t stride;
+        uint64_t count;
+        bool write;
+    };
+    void addAccessRange(Addr start, uint64_t bytes, bool write, uint64_t stride = 0, uint64_t count = 1) {
+        usesAccesses_ = true;
+        if (bytes != 0 && count != 0)
+            accesses_.push_back({start, bytes, stride, count, write});
+    }
+    /* A command that uses accesses but adds no ranges completes immediately */
+    void setUsesAccesses(bool uses) { usesAccesses_ = uses; }
+    bool usesAccesses() { return usesAccesses_; }
+    std::vector<AccessRange>& getAccessRanges() { return accesses_; }
+    /* Limit on this command's accesses in flight at once, 0 for no limit */
+    void setMaxOutstanding(uint32_t max) { maxOutstanding_ = max; }
+    uint32_t getMaxOutstanding() { return maxOutstanding_; }
+
 protected:
     SST::Event::id_type id_;    /* ID of matching MemEventBase */
     uint32_t flags_;            /* Flags to be sent */
     std::string rqstr_;         /* Requestor */
+    bool usesAccesses_;
+    uint32_t maxOutstanding_;
+    std::vector<AccessRange> accesses_;
 };
 
 /*
@@ -111,6 +141,7 @@ public:
         // Calls to read & write data
         readData = read;
         writeData = write;
+        translateToLocal = [](Addr addr) { return addr; };
     }
 
     /* Destructor */
@@ -143,6 +174,10 @@ public:
      */
     virtual MemEventBase* finish(MemEventBase *ev, uint32_t flags) =0;
 
+    /* Set by the memController so handlers can map global addresses in their operands
+     * to the local addresses used by readData(), writeData(), and access ranges */
+    void setAddrTranslator(std::function<Addr(Addr)> toLocal) { translateToLocal = toLocal; }
+
 protected:
 
     // Debug
@@ -151,6 +186,7 @@ protected:
 
     std::function<void(Addr,size_t,std::vector<uint8_t>&)> readData;
     std::function<void(Addr,std::vector<uint8_t>*)> writeData;
+    std::function<Addr(Addr)> translateToLocal;
 
 };
 
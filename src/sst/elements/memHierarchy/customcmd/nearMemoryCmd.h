@@ -0,0 +1,106 @@
+// Copyright 2013-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_NEARMEMORYCMD_H_
+#define _MEMHIERARCHY_NEARMEMORYCMD_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "sst/elements/memHierarchy/util.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Operands of a near-memory command.
+ *
+ * The command is a CustomCmdEvent whose opcode is one of the Opcodes below and
+ * whose address is the source operand (the target for Memset). The remaining
+ * operands are encoded in the event's payload with encode(). Without a payload,
+ * elements are packed 8-byte unsigned integers, count covers the event's size,
+ * and value is 0, so a zeroing Memset or a summing Reduce needs no payload.
+ *   Memset:  count bytes at addr are set to the low byte of value
+ *   Memcpy:  count bytes are copied from addr to dst (overlap is allowed)
+ *   Gather:  count elements, stride bytes apart from addr, are packed at dst
+ *   Scatter: count packed elements at addr are written stride bytes apart from dst
+ *   Reduce:  count elements, stride bytes apart from addr, are combined with op;
+ *            the response payload holds the result (elem_size bytes)
+ * A stride of 0 means elements are packed.
+ */
+class NearMemoryCmd {
+public:
+    enum Opcode : uint32_t { Memset = 0x4E00, Memcpy, Gather, Scatter, Reduce };
+    enum class DataType : uint8_t { UInt, Int, Float };
+    enum class ReduceOp : uint8_t { Sum, Min, Max, And, Or, Xor };
+
+    NearMemoryCmd() : dst(0), count(0), stride(0), elemSize(8), type(DataType::UInt), op(ReduceOp::Sum), value(0) { }
+
+    Addr        dst;
+    uint64_t    count;
+    uint64_t    stride;
+    uint32_t    elemSize;
+    DataType    type;
+    ReduceOp    op;
+    uint64_t    value;
+
+    /* Distance from the first element to the end of the last */
+    uint64_t span() const { return count == 0 ? 0 : (count - 1) * stride + elemSize; }
+
+    /* Payload encoding, host byte order */
+    static const size_t EncodedSize = 8 + 8 + 8 + 4 + 1 + 1 + 8;
+
+    std::vector<uint8_t> encode() const {
+        std::vector<uint8_t> buf(EncodedSize);
+        uint8_t* ptr = buf.data();
+        put(ptr, dst);
+        put(ptr, count);
+        put(ptr, stride);
+        put(ptr, elemSize);
+        put(ptr, (uint8_t)type);
+        put(ptr, (uint8_t)op);
+        put(ptr, value);
+        return buf;
+    }
+
+    bool decode(const std::vector<uint8_t>& buf) {
+        if (buf.size() < EncodedSize)
+            return false;
+        const uint8_t* ptr = buf.data();
+        uint8_t t, o;
+        get(ptr, dst);
+        get(ptr, count);
+        get(ptr, stride);
+        get(ptr, elemSize);
+        get(ptr, t);
+        get(ptr, o);
+        get(ptr, value);
+        type = (DataType)t;
+        op = (ReduceOp)o;
+        return true;
+    }
+
+private:
+    template <typename T>
+    static void put(uint8_t*& ptr, T val) { memcpy(ptr, &val, sizeof(T)); ptr += sizeof(T); }
+    template <typename T>
+    static void get(const uint8_t*& ptr, T& val) { memcpy(&val, ptr, sizeof(T)); ptr += sizeof(T); }
+};
+
+}     // namespace MemHierarchy
+}     // namespace SST
+
+#endif
@@ -0,0 +1,395 @@
+// Copyright 2013-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "customcmd/nearMemoryCustomCmdHandler.h"
+#include "customcmd/customOpCodeCmd.h"
+
+using namespace std;
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+NearMemoryCustomCmdMemHandler::NearMemoryCustomCmdMemHandler(ComponentId_t id, Params &params,
+        std::function<void(Addr,size_t,std::vector<uint8_t>&)> read, std::function<void(Addr,std::vector<uint8_t>*)> write)
+    : CustomCmdMemHandler(id, params, read, write) {
+    out.init("", 1, 0, Output::STDOUT);
+
+    maxOutstanding = params.find<uint32_t>("max_outstanding", 32);
+    shootdown = params.find<bool>("shootdown", true);
+    lineSize = params.find<uint64_t>("line_size", 64);
+    if (lineSize == 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: line_size - must be greater than 0\n", getName().c_str());
+
+    stat_memset         = registerStatistic<uint64_t>("memset_cmds");
+    stat_memcpy         = registerStatistic<uint64_t>("memcpy_cmds");
+    stat_gather         = registerStatistic<uint64_t>("gather_cmds");
+    stat_scatter        = registerStatistic<uint64_t>("scatter_cmds");
+    stat_reduce         = registerStatistic<uint64_t>("reduce_cmds");
+    stat_bytesRead      = registerStatistic<uint64_t>("bytes_read");
+    stat_bytesWritten   = registerStatistic<uint64_t>("bytes_written");
+}
+
+/* Every line the command reads or writes is shot down so that dirty data in
+ * the caches is written back first and no cache keeps a stale copy */
+CustomCmdMemHandler::MemEventInfo NearMemoryCustomCmdMemHandler::receive(MemEventBase* ev){
+    if (!shootdown) {
+        CustomCmdMemHandler::MemEventInfo MEI(ev->getRoutingAddress(), false);
+        return MEI;
+    }
+
+    CustomCmdEvent * cme = static_cast<CustomCmdEvent*>(ev);
+    NearMemoryCmd cmd;
+    Addr src;
+    getOperands(cme, cmd, src);
+
+    std::set<Addr> lines;
+    uint64_t packed = cmd.count * cmd.elemSize;
+    switch (cme->getOpCode()) {
+        case NearMemoryCmd::Memset:
+            addLines(lines, src, packed, packed, 1);
+            break;
+        case NearMemoryCmd::Memcpy:
+            addLines(lines, src, packed, packed, 1);
+            addLines(lines, cmd.dst, packed, packed, 1);
+            break;
+        case NearMemoryCmd::Gather:
+            addLines(lines, src, cmd.elemSize, cmd.stride, cmd.count);
+            addLines(lines, cmd.dst, packed, packed, 1);
+            break;
+        case NearMemoryCmd::Scatter:
+            addLines(lines, src, packed, packed, 1);
+            addLines(lines, cmd.dst, cmd.elemSize, cmd.stride, cmd.count);
+            break;
+        case NearMemoryCmd::Reduce:
+            addLines(lines, src, cmd.elemSize, cmd.stride, cmd.count);
+            break;
+    }
+    if (lines.empty())
+        lines.insert(ev->getRoutingAddress());
+
+    CustomCmdMemHandler::MemEventInfo MEI(lines, true);
+    return MEI;
+}
+
+void NearMemoryCustomCmdMemHandler::addLines(std::set<Addr>& lines, Addr start, uint64_t bytes, uint64_t stride, uint64_t count) {
+    if (bytes == 0)
+        return;
+    for (uint64_t i = 0; i < count; i++) {
+        Addr first = start + i * stride;
+        Addr last = first + bytes - 1;
+        for (Addr line = first - (first % lineSize); ; line += lineSize) {
+            lines.insert(line);
+            if (last - line < lineSize)
+                break;
+        }
+    }
+}
+
+/* Operands are translated to local addresses; each must be contiguous in this memory */
+Addr NearMemoryCustomCmdMemHandler::toLocal(CustomCmdEvent* ev, Addr addr, uint64_t span) {
+    if (span != 0 && addr > std::numeric_limits<Addr>::max() - (span - 1))
+        out.fatal(CALL_INFO, -1, "%s, Error: near-memory command operand at 0x%" PRIx64 " (%" PRIu64 " bytes) wraps the address space. Ev = %s\n",
+                getName().c_str(), addr, span, ev->getVerboseString().c_str());
+    if (!ev->isAddrGlobal() || span == 0)
+        return addr;
+    Addr local = translateToLocal(addr);
+    if (translateToLocal(addr + span - 1) - local != span - 1)
+        out.fatal(CALL_INFO, -1, "%s, Error: near-memory command operand at 0x%" PRIx64 " (%" PRIu64 " bytes) is not contiguous in this memory. Ev = %s\n",
+                getName().c_str(), addr, span, ev->getVerboseString().c_str());
+    return local;
+}
+
+void NearMemoryCustomCmdMemHandler::getOperands(CustomCmdEvent* ev, NearMemoryCmd& cmd, Addr& src) {
+    uint32_t opc = ev->getOpCode();
+    if (ev->getPayloadSize() != 0) {
+        if (!cmd.decode(ev->getPayload()))
+            out.fatal(CALL_INFO, -1, "%s, Error: near-memory command payload is too short. Ev = %s\n", getName().c_str(), ev->getVerboseString().c_str());
+    } else if (opc == NearMemoryCmd::Memset) {
+        cmd.count = ev->getSize();
+    } else if (opc == NearMemoryCmd::Reduce) {
+        cmd.count = ev->getSize() / cmd.elemSize;
+    } else {
+        out.fatal(CALL_INFO, -1, "%s, Error: near-memory command needs its operands in the payload. Ev = %s\n", getName().c_str(), ev->getVerboseString().c_str());
+    }
+
+    if ((uint8_t)cmd.type > (uint8_t)NearMemoryCmd::DataType::Float)
+        out.fatal(CALL_INFO, -1, "%s, Error: unknown near-memory data type %" PRIu32 ". Ev = %s\n", getName().c_str(), (uint32_t)cmd.type, ev->getVerboseString().c_str());
+    if ((uint8_t)cmd.op > (uint8_t)NearMemoryCmd::ReduceOp::Xor)
+        out.fatal(CALL_INFO, -1, "%s, Error: unknown near-memory reduction %" PRIu32 ". Ev = %s\n", getName().c_str(), (uint32_t)cmd.op, ev->getVerboseString().c_str());
+
+    switch (opc) {
+        case NearMemoryCmd::Memset:
+        case NearMemoryCmd::Memcpy:
+            cmd.elemSize = 1;
+            cmd.stride = 1;
+            break;
+        case NearMemoryCmd::Gather:
+        case NearMemoryCmd::Scatter:
+        case NearMemoryCmd::Reduce:
+            if (cmd.elemSize == 0 || (opc == NearMemoryCmd::Reduce && cmd.elemSize != 1 && cmd.elemSize != 2 && cmd.elemSize != 4 && cmd.elemSize != 8))
+                out.fatal(CALL_INFO, -1, "%s, Error: invalid element size %" PRIu32 " for near-memory command. Ev = %s\n", getName().c_str(), cmd.elemSize, ev->getVerboseString().c_str());
+            if (opc == NearMemoryCmd::Reduce && cmd.type == NearMemoryCmd::DataType::Float &&
+                    ((cmd.elemSize != 4 && cmd.elemSize != 8) || cmd.op == NearMemoryCmd::ReduceOp::And || cmd.op == NearMemoryCmd::ReduceOp::Or || cmd.op == NearMemoryCmd::ReduceOp::Xor))
+                out.fatal(CALL_INFO, -1, "%s, Error: invalid floating point reduction. Ev = %s\n", getName().c_str(), ev->getVerboseString().c_str());
+            if (cmd.stride == 0)
+                cmd.stride = cmd.elemSize;
+            break;
+        default:
+            out.fatal(CALL_INFO, -1, "%s, Error: unknown near-memory opcode 0x%" PRIx32 ". Ev = %s\n", getName().c_str(), opc, ev->getVerboseString().c_str());
+    }
+
+    /* Both the packed and the strided extents must fit in 64 bits */
+    const uint64_t maxBytes = std::numeric_limits<uint64_t>::max();
+    if (cmd.count != 0 && (cmd.count > maxBytes / cmd.elemSize || cmd.count - 1 > (maxBytes - cmd.elemSize) / cmd.stride))
+        out.fatal(CALL_INFO, -1, "%s, Error: near-memory command of %" PRIu64 " elements of %" PRIu32 " bytes, stride %" PRIu64 ", overflows. Ev = %s\n",
+                getName().c_str(), cmd.count, cmd.elemSize, cmd.stride, ev->getVerboseString().c_str());
+
+    /* Packed side of gather/scatter, and memcpy's destination */
+    uint64_t packed = cmd.count * cmd.elemSize;
+    switch (opc) {
+        case NearMemoryCmd::Memset:
+        case NearMemoryCmd::Reduce:
+            src = toLocal(ev, ev->getAddr(), cmd.span());
+            break;
+        case NearMemoryCmd::Memcpy:
+            src = toLocal(ev, ev->getAddr(), packed);
+            cmd.dst = toLocal(ev, cmd.dst, packed);
+            break;
+        case NearMemoryCmd::Gather:
+            src = toLocal(ev, ev->getAddr(), cmd.span());
+            cmd.dst = toLocal(ev, cmd.dst, packed);
+            break;
+        case NearMemoryCmd::Scatter:
+            src = toLocal(ev, ev->getAddr(), packed);
+            cmd.dst = toLocal(ev, cmd.dst, cmd.span());
+            break;
+    }
+}
+
+CustomCmdInfo* NearMemoryCustomCmdMemHandler::ready(MemEventBase* ev){
+    CustomCmdEvent * cme = static_cast<CustomCmdEvent*>(ev);
+    NearMemoryCmd cmd;
+    Addr src;
+    getOperands(cme, cmd, src);
+
+    CustomOpCodeCmdInfo *CI = new CustomOpCodeCmdInfo(cme->getID(),
+                                        cme->getRqstr(),
+                                        cme->getAddr(),
+                                        cme->getOpCode(),
+                                        MemEventBase::F_SUCCESS);
+    CI->setUsesAccesses(true);
+    CI->setMaxOutstanding(maxOutstanding);
+
+    uint64_t packed = cmd.count * cmd.elemSize;
+    switch (cme->getOpCode()) {
+        case NearMemoryCmd::Memset:
+            CI->addAccessRange(src, packed, true);
+            break;
+        case NearMemoryCmd::Memcpy:
+            CI->addAccessRange(src, packed, false);
+            CI->addAccessRange(cmd.dst, packed, true);
+            break;
+        case NearMemoryCmd::Gather:
+            CI->addAccessRange(src, cmd.elemSize, false, cmd.stride, cmd.count);
+            CI->addAccessRange(cmd.dst, packed, true);
+            break;
+        case NearMemoryCmd::Scatter:
+            CI->addAccessRange(src, packed, false);
+            CI->addAccessRange(cmd.dst, cmd.elemSize, true, cmd.stride, cmd.count);
+            break;
+        case NearMemoryCmd::Reduce:
+            CI->addAccessRange(src, cmd.elemSize, false, cmd.stride, cmd.count);
+            break;
+    }
+
+    if (is_debug_event(cme)) {
+        dbg.debug(_L5_, "NearMemory: %s ready, src 0x%" PRIx64 " dst 0x%" PRIx64 " count %" PRIu64 " stride %" PRIu64 " size %" PRIu32 "\n",
+                cme->getBriefString().c_str(), src, cmd.dst, cmd.count, cmd.stride, cmd.elemSize);
+    }
+    return CI;
+}
+
+/* All of the command's accesses have completed at the backend; do the work */
+MemEventBase* NearMemoryCustomCmdMemHandler::finish(MemEventBase *ev, uint32_t flags){
+    CustomCmdEvent * cme = static_cast<CustomCmdEvent*>(ev);
+    NearMemoryCmd cmd;
+    Addr src;
+    getOperands(cme, cmd, src);
+
+    uint64_t packed = cmd.count * cmd.elemSize;
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> result;
+    switch (cme->getOpCode()) {
+        case NearMemoryCmd::Memset:
+            data.assign(packed, (uint8_t)cmd.value);
+            writeData(src, &data);
+            stat_memset->addData(1);
+            stat_bytesWritten->addData(packed);
+            break;
+        case NearMemoryCmd::Memcpy:
+            readData(src, packed, data);
+            writeData(cmd.dst, &data);
+            stat_memcpy->addData(1);
+            stat_bytesRead->addData(packed);
+            stat_bytesWritten->addData(packed);
+            break;
+        case NearMemoryCmd::Gather:
+            if (cmd.stride == cmd.elemSize) {
+                readData(src, packed, data);
+            } else {
+                std::vector<uint8_t> elem;
+                data.reserve(packed);
+                for (uint64_t i = 0; i < cmd.count; i++) {
+                    readData(src + i * cmd.stride, cmd.elemSize, elem);
+                    data.insert(data.end(), elem.begin(), elem.end());
+                }
+            }
+            writeData(cmd.dst, &data);
+            stat_gather->addData(1);
+            stat_bytesRead->addData(packed);
+            stat_bytesWritten->addData(packed);
+            break;
+        case NearMemoryCmd::Scatter:
+            readData(src, packed, data);
+            if (cmd.stride == cmd.elemSize) {
+                writeData(cmd.dst, &data);
+            } else {
+                std::vector<uint8_t> elem(cmd.elemSize);
+                for (uint64_t i = 0; i < cmd.count; i++) {
+                    std::copy(data.begin() + i * cmd.elemSize, data.begin() + (i + 1) * cmd.elemSize, elem.begin());
+                    writeData(cmd.dst + i * cmd.stride, &elem);
+                }
+            }
+            stat_scatter->addData(1);
+            stat_bytesRead->addData(packed);
+            stat_bytesWritten->addData(packed);
+            break;
+        case NearMemoryCmd::Reduce:
+            if (cmd.stride == cmd.elemSize) {
+                readData(src, packed, data);
+            } else {
+                std::vector<uint8_t> elem;
+                data.reserve(packed);
+                for (uint64_t i = 0; i < cmd.count; i++) {
+                    readData(src + i * cmd.stride, cmd.elemSize, elem);
+                    data.insert(data.end(), elem.begin(), elem.end());
+                }
+            }
+            reduce(cme, cmd, data, result);
+            stat_reduce->addData(1);
+            stat_bytesRead->addData(packed);
+            break;
+    }
+
+    if(ev->queryFlag(MemEventBase::F_NORESPONSE)||
+         ((flags & MemEventBase::F_NORESPONSE)>0)){
+        // posted request
+        return nullptr;
+    }
+
+    CustomCmdEvent *resp = cme->makeResponse();
+    resp->setPayload(result);
+    resp->setFlags(flags);
+    return resp;
+}
+
+namespace {
+template <typename T>
+T reduceElements(const std::vector<uint8_t>& data, uint64_t count, NearMemoryCmd::ReduceOp op) {
+    T acc = T();
+    for (uint64_t i = 0; i < count; i++) {
+        T val;
+        memcpy(&val, data.data() + i * sizeof(T), sizeof(T));
+        if (i == 0) {
+            acc = val;
+            continue;
+        }
+        switch (op) {
+            case NearMemoryCmd::ReduceOp::Sum: acc = acc + val; break;
+            case NearMemoryCmd::ReduceOp::Min: acc = std::min(acc, val); break;
+            case NearMemoryCmd::ReduceOp::Max: acc = std::max(acc, val); break;
+            default: break;
+        }
+    }
+    return acc;
+}
+
+template <typename T>
+T reduceBits(const std::vector<uint8_t>& data, uint64_t count, NearMemoryCmd::ReduceOp op) {
+    T acc = T();
+    for (uint64_t i = 0; i < count; i++) {
+        T val;
+        memcpy(&val, data.data() + i * sizeof(T), sizeof(T));
+        if (i == 0) acc = val;
+        else if (op == NearMemoryCmd::ReduceOp::And) acc &= val;
+        else if (op == NearMemoryCmd::ReduceOp::Or) acc |= val;
+        else acc ^= val;
+    }
+    return acc;
+}
+
+template <typename T>
+void setResult(T acc, std::vector<uint8_t>& result) {
+    result.resize(sizeof(T));
+    memcpy(result.data(), &acc, sizeof(T));
+}
+
+/* Signed elements only differ from unsigned ones for min and max */
+template <typename U, typename S>
+void reduceInt(const std::vector<uint8_t>& data, uint64_t count, NearMemoryCmd::ReduceOp op, bool isSigned, std::vector<uint8_t>& result) {
+    switch (op) {
+        case NearMemoryCmd::ReduceOp::Min:
+        case NearMemoryCmd::ReduceOp::Max:
+            if (isSigned)
+                setResult(reduceElements<S>(data, count, op), result);
+            else
+                setResult(reduceElements<U>(data, count, op), result);
+            break;
+        case NearMemoryCmd::ReduceOp::Sum:
+            setResult(reduceElements<U>(data, count, op), result);
+            break;
+        default:
+            setResult(reduceBits<U>(data, count, op), result);
+            break;
+    }
+}
+}
+
+/* Integer sums wrap; an empty reduction returns zero */
+void NearMemoryCustomCmdMemHandler::reduce(CustomCmdEvent* ev, NearMemoryCmd& cmd, const std::vector<uint8_t>& data, std::vector<uint8_t>& result) {
+    bool isSigned = cmd.type == NearMemoryCmd::DataType::Int;
+    switch (cmd.type) {
+        case NearMemoryCmd::DataType::UInt:
+        case NearMemoryCmd::DataType::Int:
+            switch (cmd.elemSize) {
+                case 1: reduceInt<uint8_t, int8_t>(data, cmd.count, cmd.op, isSigned, result); return;
+                case 2: reduceInt<uint16_t, int16_t>(data, cmd.count, cmd.op, isSigned, result); return;
+                case 4: reduceInt<uint32_t, int32_t>(data, cmd.count, cmd.op, isSigned, result); return;
+                case 8: reduceInt<uint64_t, int64_t>(data, cmd.count, cmd.op, isSigned, result); return;
+            }
+            break;
+        case NearMemoryCmd::DataType::Float:
+            if (cmd.elemSize == 4) setResult(reduceElements<float>(data, cmd.count, cmd.op), result);
+            else setResult(reduceElements<double>(data, cmd.count, cmd.op), result);
+            return;
+    }
+    out.fatal(CALL_INFO, -1, "%s, Error: invalid near-memory reduction. Ev = %s\n", getName().c_str(), ev->getVerboseString().c_str());
+}
+
+// EOF
@@ -0,0 +1,113 @@
+// Copyright 2013-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_NEARMEMORYCUSTOMCMDHANDLER_H_
+#define _MEMHIERARCHY_NEARMEMORYCUSTOMCMDHANDLER_H_
+
+#include <string.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/output.h>
+#include <sst/core/subcomponent.h>
+
+#include "sst/elements/memHierarchy/memEventBase.h"
+#include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/customcmd/customCmdEvent.h"
+#include "sst/elements/memHierarchy/customcmd/nearMemoryCmd.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Near-memory compute
+ * Custom Command Handler
+ *
+ * Executes bulk commands (see NearMemoryCmd) against the memory's backing store.
+ * The command is charged as the line reads and writes it makes, which the
+ * backend convertor issues to the backend like any other request, so timing
+ * follows the configured memory model without the traffic crossing the network.
+ * Data is read and written when all of the command's accesses have completed.
+ * Operands must be in this memory; if memories are interleaved, each operand
+ * must be within one interleave chunk. The command asks for a shootdown of
+ * every line it touches, so under CoherentMemController cached copies are
+ * written back and invalidated before it runs. MemController does not do
+ * shootdowns, so there the caches must not hold the lines a command touches
+ * and shootdown should be set to 0.
+ */
+class NearMemoryCustomCmdMemHandler : public CustomCmdMemHandler {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(NearMemoryCustomCmdMemHandler, "memHierarchy", "nearMemoryCustomCmdHandler", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Custom command handler for near-memory bulk operations (memset, memcpy, gather, scatter, reduce)", SST::MemHierarchy::CustomCmdMemHandler)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"max_outstanding", "(uint) Maximum line accesses each command has in flight at the backend. 0 is unlimited", "32"},
+            {"shootdown",       "(bool) Shoot down the cache lines a command touches before it runs. Requires CoherentMemController", "1"},
+            {"line_size",       "(uint) Cache line size in bytes, used to find the lines a command shoots down", "64"},
+            {"debug",           "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
+            {"debug_level",     "(uint) Debug verbosity level. Between 0 and 10", "0"},
+            {"debug_addr",      "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"memset_cmds",     "Memset commands executed", "commands", 1},
+            {"memcpy_cmds",     "Memcpy commands executed", "commands", 1},
+            {"gather_cmds",     "Gather commands executed", "commands", 1},
+            {"scatter_cmds",    "Scatter commands executed", "commands", 1},
+            {"reduce_cmds",     "Reduce commands executed", "commands", 1},
+            {"bytes_read",      "Bytes read from memory by commands", "bytes", 1},
+            {"bytes_written",   "Bytes written to memory by commands", "bytes", 1} )
+
+/* Begin class defintion */
+
+    NearMemoryCustomCmdMemHandler(ComponentId_t id, Params &params, std::function<void(Addr,size_t,std::vector<uint8_t>&)> read, std::function<void(Addr,std::vector<uint8_t>*)> write);
+
+    ~NearMemoryCustomCmdMemHandler() {}
+
+    CustomCmdMemHandler::MemEventInfo receive(MemEventBase* ev) override;
+
+    CustomCmdInfo* ready(MemEventBase* ev) override;
+
+    MemEventBase* finish(MemEventBase *ev, uint32_t flags) override;
+
+private:
+    /* Decode the command and translate its addresses to local ones */
+    void getOperands(CustomCmdEvent* ev, NearMemoryCmd& cmd, Addr& src);
+    Addr toLocal(CustomCmdEvent* ev, Addr addr, uint64_t span);
+
+    /* Line addresses covered by count elements of bytes each, stride apart */
+    void addLines(std::set<Addr>& lines, Addr start, uint64_t bytes, uint64_t stride, uint64_t count);
+
+    void reduce(CustomCmdEvent* ev, NearMemoryCmd& cmd, const std::vector<uint8_t>& data, std::vector<uint8_t>& result);
+
+    Output out;
+    uint32_t maxOutstanding;
+    bool shootdown;
+    uint64_t lineSize;
+
+    Statistic<uint64_t>* stat_memset;
+    Statistic<uint64_t>* stat_memcpy;
+    Statistic<uint64_t>* stat_gather;
+    Statistic<uint64_t>* stat_scatter;
+    Statistic<uint64_t>* stat_reduce;
+    Statistic<uint64_t>* stat_bytesRead;
+    Statistic<uint64_t>* stat_bytesWritten;
+};    // class NearMemoryCustomCmdMemHandler
+}     // namespace MemHierarchy
+}     // namespace SST
+
+#endif
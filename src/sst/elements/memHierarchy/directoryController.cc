@@ -304,6 +304,8 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     stat_dirEntryReads              = registerStatistic<uint64_t>("eventSent_read_directory_entry");
     stat_dirEntryWrites             = registerStatistic<uint64_t>("eventSent_write_directory_entry");
     stat_MSHROccupancy              = registerStatistic<uint64_t>("MSHR_occupancy");
+    stat_MSHRProbeLength            = registerStatistic<uint64_t>("MSHR_probe_length");
+    stat_dirFootprint               = registerStatistic<uint64_t>("directory_footprint");
 
     // Coherence part
 
@@ -313,8 +315,14 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     // TODO implement the cache properly using the cacheArray
     entryCacheMaxSize = params.find<uint64_t>("entry_cache_size", 32768);
     entryCacheSize = 0;
+    entryCacheHead = nullptr;
+    entryCacheTail = nullptr;
+    freeEntries = nullptr;
     entrySize = 4; // Bytes, TODO parameterize
 
+    snapshotInFile = params.find<std::string>("snapshot_in_file", "");
+    snapshotOutFile = params.find<std::string>("snapshot_out_file", "");
+
     string protstr  = params.find<std::string>("coherence_protocol", "MESI");
     if (protstr == "mesi" || protstr == "MESI") protocol = CoherenceProtocol::MESI;
     else if (protstr == "msi" || protstr == "MSI") protocol = CoherenceProtocol::MSI;
@@ -323,19 +331,24 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     int mshrSize    = params.find<int>("mshr_num_entries",-1);
     if (mshrSize == 0) dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_num_entries - must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
     mshr                = new MSHR(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    mshr->setProbeLengthStatistic(stat_MSHRProbeLength);
 
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
     mshrLatency     = params.find<uint64_t>("mshr_latency_cycles", 0);
+
+    /* Resolve endpoint names once; events are built from the IDs */
+    dirId_ = EndpointRegistry::intern(getName());
+    memoryId_ = memoryName.empty() ? EndpointRegistry::NoEndpoint : EndpointRegistry::intern(memoryName);
 }
 
 
 
 DirectoryController::~DirectoryController(){
-    for(std::unordered_map<Addr, DirEntry*>::iterator i = directory.begin(); i != directory.end() ; ++i){
-        delete i->second;
-    }
     directory.clear();
+    for (std::vector<DirEntry*>::iterator it = entrySlabs.begin(); it != entrySlabs.end(); it++)
+        delete [] *it;
+    entrySlabs.clear();
 }
 
 
@@ -547,15 +560,15 @@ bool DirectoryController::arbitrateAccess(Addr addr) {
 
 void DirectoryController::handleNoncacheableRequest(MemEventBase * ev) {
     if (!(ev->queryFlag(MemEventBase::F_NORESPONSE))) {
-        noncacheMemReqs[ev->getID()] = ev->getSrc();
+        noncacheMemReqs[ev->getID()] = ev->getSrcId();
     }
     stat_noncacheRecv[(int)ev->getCmd()]->addData(1);
 
-    ev->setSrc(getName());
+    ev->setSrcId(dirId_);
     if (memoryName == "")
-        ev->setDst(memLink->findTargetDestination(ev->getRoutingAddress()));
+        ev->setDstId(memLink->findTargetDestinationId(ev->getRoutingAddress()));
     else
-        ev->setDst(memoryName);
+        ev->setDstId(memoryId_);
 
     forwardTowardsMem(ev);
 }
@@ -566,8 +579,8 @@ void DirectoryController::handleNoncacheableResponse(MemEventBase * ev) {
         dbg.fatal(CALL_INFO, -1, "%s, Error: Received a noncacheable response that does not match a pending request. Event: %s\n. Time: %" PRIu64 "ns\n",
                 getName().c_str(), ev->getVerboseString().c_str(), getCurrentSimTimeNano());
     }
-    ev->setDst(noncacheMemReqs[ev->getID()]);
-    ev->setSrc(getName());
+    ev->setDstId(noncacheMemReqs[ev->getID()]);
+    ev->setSrcId(dirId_);
 
     stat_noncacheRecv[(int)ev->getCmd()]->addData(1);
 
@@ -599,9 +612,14 @@ void DirectoryController::printStatus(Output &statusOut) {
         memLink->printStatus(statusOut);
     }
 
+    statusOut.output("  Directory footprint: %zu bytes\n", getFootprint());
     statusOut.output("  Directory entries:\n");
-    for (std::unordered_map<Addr, DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
-        statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString().c_str());
+    std::vector<Addr> addrs;
+    for (AddrHashMap<DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++)
+        addrs.push_back(it->first);
+    std::sort(addrs.begin(), addrs.end());
+    for (std::vector<Addr>::iterator it = addrs.begin(); it != addrs.end(); it++) {
+        statusOut.output("    0x%" PRIx64 " %s\n", *it, directory.find(*it)->second->getString().c_str());
     }
     statusOut.output("End MemHierarchy::DirectoryController\n\n");
 }
@@ -693,9 +711,9 @@ void DirectoryController::init(unsigned int phase) {
                 dbg.debug(_L10_, "I: %-20s   Event:SendInitData    %" PRIx64 "\n",
                         getName().c_str(), ev->getAddr());
                 if (memoryName == "")
-                    ev->setDst(memLink->findTargetDestination(ev->getRoutingAddress()));
+                    ev->setDstId(memLink->findTargetDestinationId(ev->getRoutingAddress()));
                 else
-                    ev->setDst(memoryName);
+                    ev->setDstId(memoryId_);
                     memLink->sendInitData(ev);
             } else
                 delete ev;
@@ -727,12 +745,40 @@ void DirectoryController::init(unsigned int phase) {
 
 void DirectoryController::finish(void){
     cpuLink->finish();
+    if (!snapshotOutFile.empty()) {
+        uint64_t skipped;
+        {
+            SnapshotWriter snap(snapshotOutFile, "directory");
+            skipped = saveSnapshot(snap);
+        }
+        if (skipped != 0)
+            out.output("%s, Warning: %" PRIu64 " entries in transient states were not saved to snapshot %s\n",
+                    getName().c_str(), skipped, snapshotOutFile.c_str());
+    }
+    sampleFootprint();
+    stat_dirFootprint->addData(sharerIndex.getPeakFootprint());
 }
 
 
 
 void DirectoryController::setup(void){
     cpuLink->setup();
+
+    /* Number the caches above us in name order so sharer sets iterate in name order without sorting */
+    std::vector<std::string> names;
+    std::set<MemLinkBase::EndpointInfo>* sources = cpuLink->getSources();
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = sources->begin(); it != sources->end(); it++)
+        names.push_back(it->name);
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); it++)
+        sharerIndex.local(EndpointRegistry::intern(*it));
+
+    /* Load warmed entries after numbering so restored sharer sets keep name order */
+    if (!snapshotInFile.empty()) {
+        SnapshotReader snap(snapshotInFile, "directory");
+        loadSnapshot(snap);
+    }
     //MemLinkBase * mem = memLink ? memLink : network;
     // dircc->configure(getName(), memoryName, sendWBAck, recvWBAck, network, mem);
 }
@@ -767,12 +813,12 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                 else {
                     if (protocol == CoherenceProtocol::MESI) {
                         entry->setState(M);
-                        entry->setOwner(event->getSrc());
+                        entry->setOwner(event->getSrcId());
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                         mshr->clearData(addr);
                     } else {
                         entry->setState(S);
-                        entry->addSharer(event->getSrc());
+                        entry->addSharer(event->getSrcId());
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                     }
                     if (is_debug_event(event)) {
@@ -794,7 +840,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
             break;
         case S:
             if (mshr->hasData(addr)) { // saved from earlier request
-                entry->addSharer(event->getSrc());
+                entry->addSharer(event->getSrcId());
                 sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                 if (is_debug_event(event)) {
                     eventDI.reason = "hit";
@@ -868,7 +914,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
                     out.output("ALERT (%s): mshr should NOT have data for 0x%" PRIx64 " but it does...\n", getName().c_str(), addr);
                 else {
                     entry->setState(M);
-                    entry->setOwner(event->getSrc());
+                    entry->setOwner(event->getSrcId());
                     sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                     mshr->clearData(addr);
                     if (is_debug_event(event)) {
@@ -892,13 +938,13 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
             // Upgrade request and no other sharers -> respond & M
             // Upgrade request and other sharers -> invalidate other sharers & S_Inv
             // Otherwise need data & invalidate sharers -> invalidate other sharers, request data from Memory, SM_Inv
-            if (entry->isSharer(event->getSrc())) { // Don't need data
+            if (entry->isSharer(event->getSrcId())) { // Don't need data
                 if (entry->getSharerCount() == 1) { // Also don't need to invalidate
                     if (mshr->hasData(addr))
                         mshr->clearData(addr);
                     entry->setState(M);
-                    entry->removeSharer(event->getSrc());
-                    entry->setOwner(event->getSrc());
+                    entry->removeSharer(event->getSrcId());
+                    entry->setOwner(event->getSrcId());
                     sendResponse(event);
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -994,7 +1040,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    entry->addSharer(event->getSrc());
+                    entry->addSharer(event->getSrcId());
                     mshr->setData(addr, event->getPayload(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
@@ -1009,7 +1055,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_Inv:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(event->getSrcId());
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
@@ -1018,11 +1064,11 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(event->getSrcId());
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
             }
@@ -1069,7 +1115,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case S:
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
-                    entry->removeSharer(event->getSrc());
+                    entry->removeSharer(event->getSrcId());
                     event->setEvict(false);
                 }
 
@@ -1101,7 +1147,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_D:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(event->getSrcId());
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(IS);
@@ -1109,7 +1155,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_B:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(event->getSrcId());
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(I);
@@ -1120,7 +1166,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
                 entry->removeOwner();
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
 
                 if (mshr->decrementAcksNeeded(addr)) {
@@ -1131,9 +1177,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SD_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(event->getSrcId());
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->hasSharers() ? entry->setState(S_D) : entry->setState(IS);
@@ -1143,9 +1189,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SM_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(event->getSrcId());
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->setState(IM);
@@ -1154,9 +1200,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(event->getSrcId());
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->hasSharers() ? entry->setState(S) : entry->setState(I);
@@ -1166,9 +1212,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case M_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(event->getSrcId());
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(event->getSrcId());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->setState(I);
@@ -1207,11 +1253,11 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
     if (!inMSHR)
         stat_cacheHits->addData(1);
 
-    entry->removeSharer(event->getSrc());
+    entry->removeSharer(event->getSrcId());
     sendAckPut(event);
 
-    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
-        responses.find(addr)->second.erase(event->getSrc());
+    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrcId()) != responses.find(addr)->second.end()) {
+        responses.find(addr)->second.erase(event->getSrcId());
         if (responses.find(addr)->second.empty()) responses.erase(addr);
     }
 
@@ -1282,7 +1328,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
         stat_cacheHits->addData(1);
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(event->getSrcId());
 
     sendAckPut(event);
 
@@ -1301,7 +1347,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
             break;
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             mshr->setData(addr, event->getPayload(), event->getDirty());
             entry->setState(S);
@@ -1350,7 +1396,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
         case M_Inv:
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             mshr->setData(addr, event->getPayload(), event->getDirty());
             entry->setState(I);
@@ -1400,7 +1446,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
         case M_Inv:
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(event->getSrcId());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             mshr->setData(addr, event->getPayload(), event->getDirty());
             entry->setState(I);
@@ -1648,7 +1694,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
 
     entry->setState(S);
-    entry->addSharer(reqEv->getSrc());
+    entry->addSharer(reqEv->getSrcId());
 
     sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
     mshr->setData(addr, event->getPayload(), false); // Save data for a subsequent GetS
@@ -1676,19 +1722,19 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         case IS:
             if (protocol == CoherenceProtocol::MESI) {
                 entry->setState(M);
-                entry->setOwner(reqEv->getSrc());
+                entry->setOwner(reqEv->getSrcId());
                 sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
                 break;
             }
         case S_D:
             entry->setState(S);
-            entry->addSharer(reqEv->getSrc());
+            entry->addSharer(reqEv->getSrcId());
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
             mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
             break;
         case IM:
             entry->setState(M);
-            entry->setOwner(reqEv->getSrc());
+            entry->setOwner(reqEv->getSrcId());
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
             break;
         case SM_Inv:
@@ -1775,13 +1821,13 @@ bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::AckInv, false, addr, state);
 
-    if (entry->isSharer(event->getSrc()))
-        entry->removeSharer(event->getSrc());
+    if (entry->isSharer(event->getSrcId()))
+        entry->removeSharer(event->getSrcId());
     else
         entry->removeOwner();
 
     bool done = mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     if (!done) {
@@ -1836,13 +1882,13 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
                 getName().c_str(), StateString[state], event->getVerboseString().c_str(), getCurrentSimTimeNano());
 
     mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(event->getSrcId());
     entry->setState(S);
     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
 
@@ -1871,7 +1917,7 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
     MemEvent * reqEv = static_cast<MemEvent*>(mshr->getFrontEvent(addr));
 
     mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(event->getSrcId());
     if (responses.find(addr)->second.empty())
         responses.erase(addr);
     mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
@@ -1943,16 +1989,136 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
  * Manage data structures
  ****************************/
 DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
-    std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
+    AddrHashMap<DirEntry*>::iterator i = directory.find(addr);
+    if (directory.end() != i)
+        return i->second;
+
+    DirEntry* entry = allocateEntry(addr);
+    entry->setCached(true);
+    directory[addr] = entry;
+    sampleFootprint();
+    return entry;
+}
 
-    if (directory.end() == i) {
-        directory[addr] = new DirEntry(addr);
-        i = directory.find(addr);
-        i->second->cacheIter = entryCache.end();
-        i->second->setCached(true);
+DirectoryController::DirEntry* DirectoryController::allocateEntry(Addr addr) {
+    if (freeEntries == nullptr) {
+        DirEntry* slab = new DirEntry[entrySlabSize];
+        entrySlabs.push_back(slab);
+        for (size_t i = 0; i < entrySlabSize; i++) {
+            slab[i].sharerIndex = &sharerIndex;
+            slab[i].lruNext = (i + 1 < entrySlabSize) ? &slab[i + 1] : nullptr;
+        }
+        freeEntries = slab;
+    }
+    DirEntry* entry = freeEntries;
+    freeEntries = entry->lruNext;
+    entry->reset(addr);
+    return entry;
+}
+
+void DirectoryController::freeEntry(DirEntry* entry) {
+    entry->clearSharers();
+    entry->lruPrev = nullptr;
+    entry->lruNext = freeEntries;
+    freeEntries = entry;
+}
+
+size_t DirectoryController::getFootprint() {
+    return entrySlabs.size() * entrySlabSize * sizeof(DirEntry)
+        + directory.capacity() * (sizeof(AddrHashMap<DirEntry*>::value_type) + 1)
+        + sharerIndex.getFootprint();
+}
 
+/* Entries and the index only grow, so they are passed on whenever an entry is added;
+ * the sharer index samples the peak whenever sharer storage grows */
+void DirectoryController::sampleFootprint() {
+    sharerIndex.setBaseFootprint(getFootprint() - sharerIndex.getFootprint());
+}
+
+void DirectoryController::entryCacheUnlink(DirEntry* entry) {
+    if (entry->lruPrev) entry->lruPrev->lruNext = entry->lruNext;
+    else entryCacheHead = entry->lruNext;
+    if (entry->lruNext) entry->lruNext->lruPrev = entry->lruPrev;
+    else entryCacheTail = entry->lruPrev;
+    entry->lruPrev = nullptr;
+    entry->lruNext = nullptr;
+    entry->inEntryCache = false;
+}
+
+void DirectoryController::entryCachePushFront(DirEntry* entry) {
+    entry->lruPrev = nullptr;
+    entry->lruNext = entryCacheHead;
+    if (entryCacheHead) entryCacheHead->lruPrev = entry;
+    else entryCacheTail = entry;
+    entryCacheHead = entry;
+    entry->inEntryCache = true;
+}
+
+/*
+ * Snapshot body: uint64 line size, uint64 count, then per entry
+ * addr, uint8 state, owner, sharers, uint8 cached.
+ * Entry cache contents are written least recently used first so
+ * pushing each to the front on load rebuilds the same LRU order.
+ */
+uint64_t DirectoryController::saveSnapshot(SnapshotWriter& out) {
+    uint64_t count = 0, skipped = 0;
+    for (AddrHashMap<DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
+        if (isSnapshotState(it->second->getState()))
+            count++;
+        else if (it->second->getState() != I)
+            skipped++;
+    }
+
+    out.put(lineSize);
+    out.put(count);
+    for (DirEntry* entry = entryCacheTail; entry != nullptr; entry = entry->lruPrev) {
+        if (isSnapshotState(entry->getState()))
+            saveEntry(out, entry);
+    }
+    for (AddrHashMap<DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
+        if (!it->second->inEntryCache && isSnapshotState(it->second->getState()))
+            saveEntry(out, it->second);
+    }
+    return skipped;
+}
+
+void DirectoryController::saveEntry(SnapshotWriter& out, DirEntry* entry) {
+    out.put(entry->getBaseAddr());
+    out.put((uint8_t)entry->getState());
+    out.putEndpoint(entry->getOwner());
+    entry->getSharers(sharerScratch);
+    out.putEndpoints(sharerScratch.begin(), sharerScratch.end(), sharerScratch.size());
+    out.put((uint8_t)entry->isCached());
+}
+
+void DirectoryController::loadSnapshot(SnapshotReader& in) {
+    if (in.get<uint64_t>() != lineSize)
+        in.mismatch("cache_line_size differs");
+
+    uint64_t count = in.get<uint64_t>();
+    for (uint64_t i = 0; i < count; i++) {
+        Addr addr = in.get<Addr>();
+        if (!region.contains(addr))
+            in.mismatch("entry outside this directory's address range");
+
+        DirEntry* entry = getDirEntry(addr);
+        entry->setState((State)in.get<uint8_t>());
+        entry->setOwner(in.getEndpoint());
+        in.getEndpoints(sharerScratch);
+        entry->clearSharers();
+        for (std::vector<EndpointId>::iterator it = sharerScratch.begin(); it != sharerScratch.end(); it++)
+            entry->addSharer(*it);
+
+        bool cached = in.get<uint8_t>();
+        if (entryCacheMaxSize == 0) {
+            entry->setCached(cached);
+        } else if (cached && entryCacheSize < entryCacheMaxSize) {
+            entryCachePushFront(entry);
+            ++entryCacheSize;
+        } else {
+            entry->setCached(false);
+        }
     }
-    return i->second;
 }
 
 bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR) {
@@ -1982,7 +2148,7 @@ bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, boo
                     getName().c_str(), StateString[state], entry->getBaseAddr(), getCurrentSimTimeNano());
     }
 
-    MemEvent* me = new MemEvent(getName(), 0, 0, Command::GetS, lineSize);
+    MemEvent* me = new MemEvent(dirId_, 0, 0, Command::GetS, lineSize);
     me->setAddrGlobal(false);
     me->setSize(entrySize);
 
@@ -2054,29 +2220,26 @@ void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a
     if (0 == entryCacheMaxSize) {
         sendEntryToMemory(entry);
     } else {
-        if (entry->cacheIter != entryCache.end()) {
-            entryCache.erase(entry->cacheIter);
+        if (entry->inEntryCache) {
+            entryCacheUnlink(entry);
             --entryCacheSize;
-            entry->cacheIter = entryCache.end();
         }
 
         if (entry->getState() == I) {
             directory.erase(entry->getBaseAddr());
-            delete entry;
+            freeEntry(entry);
             return;
         } else  {
-            entryCache.push_front(entry);
-            entry->cacheIter = entryCache.begin();
+            entryCachePushFront(entry);
             ++entryCacheSize;
 
             while (entryCacheSize > entryCacheMaxSize) {
-                DirEntry * oldEntry = entryCache.back();
+                DirEntry * oldEntry = entryCacheTail;
                 if (mshr->exists(oldEntry->getBaseAddr()))
                     break;
 
-                entryCache.pop_back();
+                entryCacheUnlink(oldEntry);
                 --entryCacheSize;
-                oldEntry->cacheIter = entryCache.end();
                 oldEntry->setCached(false);
                 sendEntryToMemory(oldEntry);
             }
@@ -2086,14 +2249,14 @@ void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a
 
 void DirectoryController::sendEntryToMemory(DirEntry *entry) {
     Addr entryAddr = 0;
-    MemEvent * me = new MemEvent(getName(), entryAddr, entryAddr, Command::PutE, lineSize);
+    MemEvent * me = new MemEvent(dirId_, entryAddr, entryAddr, Command::PutE, lineSize);
     me->setSize(entrySize);
 
     uint64_t deliveryTime = timestamp + accessLatency;
     if (memoryName == "")
-        me->setDst(memLink->findTargetDestination(0));
+        me->setDstId(memLink->findTargetDestinationId(0));
     else
-        me->setDst(memoryName);
+        me->setDstId(memoryId_);
     memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
 }
 
@@ -2103,11 +2266,11 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
 
 void DirectoryController::issueMemoryRequest(MemEvent* event, DirEntry* entry) {
     MemEvent* reqEvent = new MemEvent(*event);
-    reqEvent->setSrc(getName());
+    reqEvent->setSrcId(dirId_);
     if (memoryName == "")
-        reqEvent->setDst(memLink->findTargetDestination(reqEvent->getRoutingAddress()));
+        reqEvent->setDstId(memLink->findTargetDestinationId(reqEvent->getRoutingAddress()));
     else
-        reqEvent->setDst(memoryName);
+        reqEvent->setDstId(memoryId_);
     memReqs[reqEvent->getID()] = event->getBaseAddr();
     uint64_t deliveryTime = timestamp + accessLatency;
 
@@ -2119,11 +2282,11 @@ void DirectoryController::issueMemoryRequest(MemEvent* event, DirEntry* entry) {
 void DirectoryController::issueFlush(MemEvent* event) {
     Addr addr = event->getBaseAddr();
     MemEvent * flush = new MemEvent(*event);
-    flush->setSrc(getName());
+    flush->setSrcId(dirId_);
     if (memoryName == "")
-        flush->setDst(memLink->findTargetDestination(event->getRoutingAddress()));
+        flush->setDstId(memLink->findTargetDestinationId(event->getRoutingAddress()));
     else
-        flush->setDst(memoryName);
+        flush->setDstId(memoryId_);
     memReqs[flush->getID()] = addr;
 
     if (mshr->hasData(addr) && mshr->getDataDirty(addr)) { // also writeback dirty data
@@ -2143,11 +2306,11 @@ void DirectoryController::issueFlush(MemEvent* event) {
 
 void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = event->getBaseAddr();
-    MemEvent * fetch = new MemEvent(getName(), event->getAddr(), addr, cmd, lineSize);
-    fetch->setDst(entry->getOwner());
+    MemEvent * fetch = new MemEvent(dirId_, event->getAddr(), addr, cmd, lineSize);
+    fetch->setDstId(entry->getOwner());
 
     if (responses.find(addr) == responses.end()) {
-        std::map<std::string,MemEvent::id_type> resp;
+        std::map<EndpointId,MemEvent::id_type> resp;
         resp.insert(std::make_pair(entry->getOwner(), fetch->getID()));
         responses.insert(std::make_pair(addr, resp));
     } else {
@@ -2160,29 +2323,30 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
-    std::string rqstr = (event->getSrc());
+    EndpointId rqstr = event->getSrcId();
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
+    entry->getSharers(sharerScratch);
+    for (std::vector<EndpointId>::iterator it = sharerScratch.begin(); it != sharerScratch.end(); it++) {
         if (*it == rqstr) continue;
         issueInvalidation(*it, event, entry, cmd);
     }
 }
 
-void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd) {
+void DirectoryController::issueInvalidation(EndpointId dst, MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = entry->getBaseAddr();
-    MemEvent* inv = new MemEvent(getName(), addr, addr, cmd, lineSize);
+    MemEvent* inv = new MemEvent(dirId_, addr, addr, cmd, lineSize);
     if (event) {
         inv->copyMetadata(event);
-        inv->setRqstr(event->getRqstr());
+        inv->setRqstrId(event->getRqstrId());
     } else {
-        inv->setRqstr(getName());
+        inv->setRqstrId(dirId_);
     }
-    inv->setDst(dst);
+    inv->setDstId(dst);
 
     mshr->incrementAcksNeeded(addr);
 
     if (responses.find(addr) == responses.end()) {
-        std::map<std::string,MemEvent::id_type> resp;
+        std::map<EndpointId,MemEvent::id_type> resp;
         resp.insert(std::make_pair(entry->getOwner(), inv->getID()));
         responses.insert(std::make_pair(addr, resp));
     } else {
@@ -2193,7 +2357,7 @@ void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, Di
     cpuMsgQueue.insert(std::make_pair(deliveryTime, inv));
 }
 
-void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags) {
+void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, const Payload& data, Command cmd, uint32_t flags) {
     MemEvent * respEv = event->makeResponse(cmd);
     respEv->setSize(lineSize);
     respEv->setPayload(data);
@@ -2210,13 +2374,13 @@ void DirectoryController::sendResponse(MemEvent* event, uint32_t flags, uint32_t
 }
 
 void DirectoryController::writebackData(MemEvent* event) {
-    MemEvent * wb = new MemEvent(getName(), event->getBaseAddr(), event->getBaseAddr(), Command::PutM, lineSize);
+    MemEvent * wb = new MemEvent(dirId_, event->getBaseAddr(), event->getBaseAddr(), Command::PutM, lineSize);
     wb->copyMetadata(event);
-    wb->setRqstr(event->getRqstr());
+    wb->setRqstrId(event->getRqstrId());
     if (memoryName == "")
-        wb->setDst(memLink->findTargetDestination(wb->getRoutingAddress()));
+        wb->setDstId(memLink->findTargetDestinationId(wb->getRoutingAddress()));
     else
-        wb->setDst(memoryName);
+        wb->setDstId(memoryId_);
 
     if (waitWBAck)
         mshr->insertWriteback(event->getBaseAddr(), false);
@@ -2226,11 +2390,11 @@ void DirectoryController::writebackData(MemEvent* event) {
 }
 
 void DirectoryController::writebackDataFromMSHR(Addr addr) {
-    MemEvent * wb = new MemEvent(getName(), addr, addr, Command::PutM, lineSize);
+    MemEvent * wb = new MemEvent(dirId_, addr, addr, Command::PutM, lineSize);
     if (memoryName == "")
-        wb->setDst(memLink->findTargetDestination(wb->getRoutingAddress()));
+        wb->setDstId(memLink->findTargetDestinationId(wb->getRoutingAddress()));
     else
-        wb->setDst(memoryName);
+        wb->setDstId(memoryId_);
 
     mshr->setDataDirty(addr, false);
 
@@ -2245,9 +2409,9 @@ void DirectoryController::sendFetchResponse(MemEvent * event) {
     Addr addr = event->getBaseAddr();
     MemEvent * ack = event->makeResponse();
     if (memoryName == "")
-        ack->setDst(memLink->findTargetDestination(ack->getRoutingAddress()));
+        ack->setDstId(memLink->findTargetDestinationId(ack->getRoutingAddress()));
     else
-        ack->setDst(memoryName);
+        ack->setDstId(memoryId_);
 
     ack->setPayload(mshr->getData(addr));
     ack->setDirty(mshr->getDataDirty(addr));
@@ -2261,9 +2425,9 @@ void DirectoryController::sendAckInv(MemEvent * event) {
     Addr addr = event->getBaseAddr();
     MemEvent * ack = event->makeResponse(Command::AckInv);
     if (memoryName == "")
-        ack->setDst(memLink->findTargetDestination(ack->getRoutingAddress()));
+        ack->setDstId(memLink->findTargetDestinationId(ack->getRoutingAddress()));
     else
-        ack->setDst(memoryName);
+        ack->setDstId(memoryId_);
 
     if (mshr->hasData(addr))
         mshr->clearData(addr);
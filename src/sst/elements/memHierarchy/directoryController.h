@@ -37,6 +37,9 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/addrHashMap.h"
+#include "sst/elements/memHierarchy/directorySharers.h"
+#include "sst/elements/memHierarchy/snapshot.h"
 
 using namespace std;
 
@@ -68,6 +71,8 @@ public:
             {"interleave_size",         "Size of interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
             {"interleave_step",         "Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
             {"node",					"Node number in multinode environment"},
+            {"snapshot_in_file",        "(string) Load warmed directory entries from this snapshot during setup. The snapshot must come from a directory with the same line size and address range.", ""},
+            {"snapshot_out_file",       "(string) Write the directory's stable entries to this snapshot at the end of simulation, for use as another run's snapshot_in_file.", ""},
             /* Old parameters - deprecated or moved */
             {"network_num_vc",          "DEPRECATED. Number of virtual channels (VCs) on the on-chip network. memHierarchy only uses one VC.", "1"}, // Remove SST 9.0
             {"network_address",         "DEPRECATD - Now auto-detected by link control", ""},   // Remove SST 9.0
@@ -135,6 +140,8 @@ public:
             {"eventSent_FlushLineInv",  "Event sent: FlushLineInv", "count", 2},
             {"eventSent_FlushLineResp", "Event sent: FlushLineResp", "count", 2},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle",  "events",       1},
+            {"MSHR_probe_length",       "Number of MSHR table slots examined per address lookup", "count", 5},
+            {"directory_footprint",     "Peak simulator memory used by directory entries, sharer sets and the directory index", "bytes", 5},
             {"default_stat",            "Default statistic. If not 0 then a statistic is missing", "", 1})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -179,11 +186,13 @@ private:
     Statistic<uint64_t> * stat_dirEntryWrites;
 
     Statistic<uint64_t> * stat_MSHROccupancy;
+    Statistic<uint64_t> * stat_MSHRProbeLength;
+    Statistic<uint64_t> * stat_dirFootprint;
 
     /* Queue of packets to work on */
     std::list<MemEvent*> eventBuffer;
     std::list<MemEvent*> retryBuffer;
-    std::map<MemEvent::id_type, std::string> noncacheMemReqs;
+    std::map<MemEvent::id_type, EndpointId> noncacheMemReqs;
 
     std::set<Addr> addrsThisCycle;
 
@@ -191,6 +200,8 @@ private:
     MemLinkBase*    memLink;
     MemLinkBase*    cpuLink;
     string          memoryName; // if connected to mem via network, this should be the name of the memory we own - param is memory_name
+    EndpointId      memoryId_;  // memoryName, or NoEndpoint if not set
+    EndpointId      dirId_;     // This directory
     bool clockMemLink;
     bool clockCpuLink;
 
@@ -286,40 +297,52 @@ private:
         }
     } eventDI, evictDI;
 
+    /* Entries are pooled by the controller and linked into the entry cache (or the free list) through lruPrev/lruNext */
     struct DirEntry {
-	bool                cached;         // whether block is cached or not
-        Addr                addr;           // block address
+        bool                cached;         // whether block is cached or not
+        bool                inEntryCache;   // whether entry is in the entry cache LRU list
         State               state;          // state
-        std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
-        std::string         owner;          // Owner of block
+        EndpointId          owner;          // Owner of block
+        Addr                addr;           // block address
+        SharerSet           sharers;        // set of sharers for block
+        SharerIndex*        sharerIndex;    // Directory's numbering of sharers
+        DirEntry*           lruPrev;
+        DirEntry*           lruNext;
+
+        DirEntry() : cached(false), inEntryCache(false), state(I), owner(EndpointRegistry::NoEndpoint), addr(0),
+            sharerIndex(nullptr), lruPrev(nullptr), lruNext(nullptr) { }
 
-        DirEntry(Addr a) {
+        void reset(Addr a) {
             clearEntry();
             addr = a;
             state = I;
             cached = false;
+            inEntryCache = false;
+            lruPrev = nullptr;
+            lruNext = nullptr;
         }
 
         void clearEntry(){
             cached = true;
             addr = 0;
-            sharers.clear();
-            owner = "";
+            sharers.clear(*sharerIndex);
+            owner = EndpointRegistry::NoEndpoint;
         }
 
         std::string getString() {
             std::ostringstream str;
             str << "State: " << StateString[state];
             str << " Sharers: [";
+            std::vector<EndpointId> shr;
+            getSharers(shr);
             bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
+            for (std::vector<EndpointId>::iterator it = shr.begin(); it != shr.end(); it++) {
                 if (comma)
                     str << ",";
-                str << *it;
+                str << EndpointRegistry::name(*it);
                 comma = true;
             }
-            str << "] Owner: " << owner;
+            str << "] Owner: " << (hasOwner() ? EndpointRegistry::name(owner) : "");
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
         }
@@ -332,25 +355,41 @@ private:
 
         size_t getSharerCount() { return sharers.size(); }
 
-        void clearSharers() { sharers.clear(); }
+        void clearSharers() { sharers.clear(*sharerIndex); }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        void addSharer(EndpointId shr) { sharers.insert(sharerIndex->local(shr), *sharerIndex); }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(EndpointId shr) {
+            uint32_t idx = sharerIndex->find(shr);
+            return idx != SharerIndex::NoIndex && sharers.contains(idx);
+        }
 
         bool hasSharers() { return !(sharers.empty()); }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        /* Sharers in name order. Local indices are written into shr and translated in
+         * place (both are uint32_t) so callers can reuse one buffer such as sharerScratch */
+        void getSharers(std::vector<EndpointId>& shr) {
+            shr.clear();
+            sharers.appendTo(shr);
+            for (std::vector<EndpointId>::iterator it = shr.begin(); it != shr.end(); it++)
+                *it = sharerIndex->endpoint(*it);
+            if (!sharerIndex->inNameOrder())
+                std::sort(shr.begin(), shr.end(), EndpointRegistry::NameLess());
+        }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        void removeSharer(EndpointId shr) {
+            uint32_t idx = sharerIndex->find(shr);
+            if (idx != SharerIndex::NoIndex)
+                sharers.erase(idx, *sharerIndex);
+        }
 
-        std::string getOwner() { return owner; }
+        EndpointId getOwner() { return owner; }
 
-        bool hasOwner() { return owner != ""; }
+        bool hasOwner() { return owner != EndpointRegistry::NoEndpoint; }
 
-        void removeOwner() { owner = ""; }
+        void removeOwner() { owner = EndpointRegistry::NoEndpoint; }
 
-        void setOwner(std::string own) { owner = own; }
+        void setOwner(EndpointId own) { owner = own; }
 
         void setState(State nState) { state = nState; }
 
@@ -375,8 +414,8 @@ private:
     void issueFlush(MemEvent* event);
     void issueFetch(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd);
-    void issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd);
-    void sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags = 0);
+    void issueInvalidation(EndpointId dst, MemEvent* event, DirEntry* entry, Command cmd);
+    void sendDataResponse(MemEvent* event, DirEntry* entry, const Payload& data, Command cmd, uint32_t flags = 0);
     void sendResponse(MemEvent* event, uint32_t flags = 0, uint32_t memflags = 0);
     void writebackData(MemEvent* event);
     void writebackDataFromMSHR(Addr addr);
@@ -386,7 +425,20 @@ private:
     void sendNACK(MemEvent* event);
 
     MSHR * mshr;
-    std::unordered_map<Addr, DirEntry*> directory; // Master list of all directory entries, including noncached ones
+    AddrHashMap<DirEntry*> directory; // Master list of all directory entries, including noncached ones
+
+    /* Directory entry pool. Slabs are never moved so entry pointers stay valid */
+    static const size_t entrySlabSize = 1024;
+    std::vector<DirEntry*> entrySlabs;
+    DirEntry* freeEntries;
+    DirEntry* allocateEntry(Addr addr);
+    void freeEntry(DirEntry* entry);
+
+    SharerIndex sharerIndex;
+    std::vector<EndpointId> sharerScratch;
+
+    size_t getFootprint();
+    void sampleFootprint();
 
 
     struct MemMsg {
@@ -405,7 +457,17 @@ private:
     uint64_t    entryCacheMaxSize;
     uint64_t    entryCacheSize;
     uint32_t    entrySize;
-    std::list<DirEntry*> entryCache;
+    DirEntry*   entryCacheHead; // Most recently used
+    DirEntry*   entryCacheTail;
+    void entryCacheUnlink(DirEntry* entry);
+    void entryCachePushFront(DirEntry* entry);
+
+    /* Warmed-state snapshots */
+    std::string snapshotInFile;
+    std::string snapshotOutFile;
+    uint64_t saveSnapshot(SnapshotWriter& out);
+    void saveEntry(SnapshotWriter& out, DirEntry* entry);
+    void loadSnapshot(SnapshotReader& in);
 
     uint64_t lineSize;
 
@@ -413,7 +475,7 @@ private:
     uint64_t mshrLatency;
 
     std::map<MemEvent::id_type, Addr> memReqs;
-    std::map<Addr, std::map<std::string, MemEvent::id_type> > responses;
+    std::map<Addr, std::map<EndpointId, MemEvent::id_type> > responses;
 
     CoherenceProtocol protocol;
     bool waitWBAck;
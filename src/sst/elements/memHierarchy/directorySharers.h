@@ -0,0 +1,260 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_DIRECTORYSHARERS_H
+#define MEMHIERARCHY_DIRECTORYSHARERS_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Dense numbering of the endpoints that share lines through one directory.
+ *
+ * Sharer sets hold these local indices rather than EndpointIds so their size
+ * depends on the number of caches above the directory, not on the number of
+ * endpoints in the process. When the directory registers its sources up front
+ * in name order, index order is name order and sharers can be walked in the
+ * order the coherence protocol expects without sorting.
+ */
+class SharerIndex {
+public:
+    static const uint32_t NoIndex = 0xFFFFFFFF;
+
+    SharerIndex() : nameOrder_(true), heapBytes_(0), baseBytes_(0), peakBytes_(0) { }
+
+    /* Return the local index for an endpoint, assigning the next one if needed */
+    uint32_t local(EndpointId id) {
+        if (id < toLocal_.size() && toLocal_[id] != NoIndex)
+            return toLocal_[id];
+        if (id >= toLocal_.size())
+            toLocal_.resize(id + 1, (uint32_t)NoIndex);
+        if (!endpoints_.empty() && !(EndpointRegistry::name(endpoints_.back()) < EndpointRegistry::name(id)))
+            nameOrder_ = false;
+        toLocal_[id] = endpoints_.size();
+        endpoints_.push_back(id);
+        samplePeak();
+        return toLocal_[id];
+    }
+
+    /* Return the local index for an endpoint or NoIndex if it has never been a sharer */
+    uint32_t find(EndpointId id) const {
+        return id < toLocal_.size() ? toLocal_[id] : (uint32_t)NoIndex;
+    }
+
+    EndpointId endpoint(uint32_t idx) const { return endpoints_[idx]; }
+    uint32_t size() const { return endpoints_.size(); }
+
+    /* True if increasing local index is increasing endpoint name */
+    bool inNameOrder() const { return nameOrder_; }
+
+    /* Bytes used by the index and by sharer set storage outside of directory entries */
+    size_t getFootprint() const {
+        return heapBytes_ + toLocal_.capacity() * sizeof(uint32_t) + endpoints_.capacity() * sizeof(EndpointId);
+    }
+
+    /* The owner's bytes outside the index (e.g., directory entries), counted in the peak.
+     * The peak is sampled whenever the index or any sharer set grows, so it is exact
+     * as long as the owner updates its bytes whenever they grow. */
+    void setBaseFootprint(size_t bytes) {
+        baseBytes_ = bytes;
+        samplePeak();
+    }
+    size_t getPeakFootprint() const { return peakBytes_; }
+
+private:
+    friend class SharerSet;
+
+    void samplePeak() {
+        size_t bytes = baseBytes_ + getFootprint();
+        if (bytes > peakBytes_)
+            peakBytes_ = bytes;
+    }
+
+    std::vector<uint32_t> toLocal_;     // EndpointId -> local index
+    std::vector<EndpointId> endpoints_; // local index -> EndpointId
+    bool nameOrder_;
+    size_t heapBytes_;
+    size_t baseBytes_;
+    size_t peakBytes_;
+};
+
+/*
+ * Exact set of sharers for one directory entry, by SharerIndex local index.
+ *
+ * Up to InlineCount sharers are stored as pointers inside the set itself.
+ * Larger sets move to a sorted pointer array and, once that array would take
+ * more space than one bit per known sharer, to a bit vector. Lines with a few
+ * sharers stay small in very large systems while widely shared lines never
+ * cost more than the full vector. Iteration is always in local index order.
+ */
+class SharerSet {
+public:
+    static const uint32_t InlineCount = 4;
+
+    SharerSet() : count_(0), cap_(0), vector_(false) { }
+    ~SharerSet() { freeHeap(); }
+
+    uint32_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    bool contains(uint32_t s) const {
+        if (vector_)
+            return s < cap_ * 64 && (bits_[s >> 6] >> (s & 63)) & 1;
+        const uint32_t* list = cap_ ? ptrs_ : inline_;
+        const uint32_t* pos = std::lower_bound(list, list + count_, s);
+        return pos != list + count_ && *pos == s;
+    }
+
+    bool insert(uint32_t s, SharerIndex& index) {
+        if (!vector_) {
+            uint32_t* list = cap_ ? ptrs_ : inline_;
+            uint32_t* pos = std::lower_bound(list, list + count_, s);
+            if (pos != list + count_ && *pos == s)
+                return false;
+            if (count_ < (cap_ ? cap_ : InlineCount)) {
+                std::memmove(pos + 1, pos, (list + count_ - pos) * sizeof(uint32_t));
+                *pos = s;
+                count_++;
+                return true;
+            }
+            grow(s, index);
+            if (!vector_)
+                return insert(s, index);
+        }
+
+        if (s >= cap_ * 64)
+            growVector(s, index);
+        uint64_t bit = (uint64_t)1 << (s & 63);
+        if (bits_[s >> 6] & bit)
+            return false;
+        bits_[s >> 6] |= bit;
+        count_++;
+        return true;
+    }
+
+    bool erase(uint32_t s, SharerIndex& index) {
+        if (vector_) {
+            if (!contains(s))
+                return false;
+            bits_[s >> 6] &= ~((uint64_t)1 << (s & 63));
+        } else {
+            uint32_t* list = cap_ ? ptrs_ : inline_;
+            uint32_t* pos = std::lower_bound(list, list + count_, s);
+            if (pos == list + count_ || *pos != s)
+                return false;
+            std::memmove(pos, pos + 1, (list + count_ - pos - 1) * sizeof(uint32_t));
+        }
+        if (--count_ == 0)
+            clear(index);
+        return true;
+    }
+
+    void clear(SharerIndex& index) {
+        index.heapBytes_ -= heapBytes();
+        freeHeap();
+        count_ = 0;
+        cap_ = 0;
+        vector_ = false;
+    }
+
+    /* Append members in increasing order */
+    void appendTo(std::vector<uint32_t>& out) const {
+        if (!vector_) {
+            const uint32_t* list = cap_ ? ptrs_ : inline_;
+            out.insert(out.end(), list, list + count_);
+            return;
+        }
+        for (uint32_t w = 0; w < cap_; w++) {
+            for (uint64_t word = bits_[w]; word != 0; word &= word - 1)
+                out.push_back(w * 64 + __builtin_ctzll(word));
+        }
+    }
+
+private:
+    SharerSet(const SharerSet&);
+    SharerSet& operator=(const SharerSet&);
+
+    size_t heapBytes() const {
+        if (cap_ == 0) return 0;
+        return vector_ ? cap_ * sizeof(uint64_t) : cap_ * sizeof(uint32_t);
+    }
+
+    void freeHeap() {
+        if (cap_ == 0) return;
+        if (vector_) delete [] bits_;
+        else delete [] ptrs_;
+    }
+
+    /* Pointer list is full; double it or switch to a bit vector, whichever is smaller */
+    void grow(uint32_t s, SharerIndex& index) {
+        uint32_t listCap = 2 * (cap_ ? cap_ : InlineCount);
+        const uint32_t* list = cap_ ? ptrs_ : inline_;
+        uint32_t words = (std::max(index.size(), std::max(s, list[count_ - 1]) + 1) + 63) / 64;
+
+        if (listCap * sizeof(uint32_t) < words * sizeof(uint64_t)) {
+            uint32_t* ptrs = new uint32_t[listCap];
+            std::memcpy(ptrs, list, count_ * sizeof(uint32_t));
+            index.heapBytes_ += listCap * sizeof(uint32_t) - heapBytes();
+            index.samplePeak();
+            freeHeap();
+            ptrs_ = ptrs;
+            cap_ = listCap;
+            return;
+        }
+
+        uint64_t* bits = new uint64_t[words];
+        std::memset(bits, 0, words * sizeof(uint64_t));
+        for (uint32_t i = 0; i < count_; i++)
+            bits[list[i] >> 6] |= (uint64_t)1 << (list[i] & 63);
+        index.heapBytes_ += words * sizeof(uint64_t) - heapBytes();
+        index.samplePeak();
+        freeHeap();
+        bits_ = bits;
+        cap_ = words;
+        vector_ = true;
+    }
+
+    void growVector(uint32_t s, SharerIndex& index) {
+        uint32_t words = (std::max(index.size(), s + 1) + 63) / 64;
+        uint64_t* bits = new uint64_t[words];
+        std::memcpy(bits, bits_, cap_ * sizeof(uint64_t));
+        std::memset(bits + cap_, 0, (words - cap_) * sizeof(uint64_t));
+        index.heapBytes_ += (words - cap_) * sizeof(uint64_t);
+        index.samplePeak();
+        delete [] bits_;
+        bits_ = bits;
+        cap_ = words;
+    }
+
+    uint32_t count_;
+    uint32_t cap_;      // Heap pointer slots or vector words, 0 while inline
+    bool vector_;
+    union {
+        uint32_t inline_[InlineCount];
+        uint32_t* ptrs_;
+        uint64_t* bits_;
+    };
+};
+
+}}
+
+#endif // MEMHIERARCHY_DIRECTORYSHARERS_H
@@ -0,0 +1,220 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include <sst/core/simulation.h>
+
+#include "endpointRegistry.h"
+
+using namespace SST::MemHierarchy;
+
+/*
+ * The table is a fixed array of chunk pointers so that a chunk never moves once allocated.
+ * Lookups by ID read the table without locking; an ID is only handed out after its entry is written.
+ * Lookups by name or hash first read the published copy of the maps without locking and only take
+ * the lock on a miss, which after init means a name that was never interned. Published copies are
+ * never freed, so a reader holding an old copy stays valid when a newer one is published.
+ *
+ * A name is never changed in place. The only rename is of a placeholder (created by fromHash) when
+ * the real name is interned, which publishes a new string; the placeholder string stays allocated
+ * so references returned by name() remain valid. Placeholders are renamed as soon as the init event
+ * carrying the name is unpacked, before any coherence state holds the ID.
+ */
+namespace {
+
+const uint32_t chunkBits = 12;
+const uint32_t chunkSize = 1 << chunkBits;
+const uint32_t maxChunks = 1 << 12;         // 16M endpoints
+
+struct Entry {
+    std::atomic<const std::string*> name;
+    uint64_t hash;
+    bool placeholder;   // Name is not known yet, only its hash. Only read/written under the lock
+};
+
+struct Published {
+    std::unordered_map<std::string, EndpointId> byName;
+    std::unordered_map<uint64_t, EndpointId> byHash;
+};
+
+struct Table {
+    Entry* chunks[maxChunks];
+    uint32_t count;
+    std::unordered_map<std::string, EndpointId> byName;
+    std::unordered_map<uint64_t, EndpointId> byHash;
+    std::mutex lock;
+    std::atomic<const Published*> published;
+    bool dirty;     // Maps changed since the last publish. Only read/written under the lock
+
+    Table() : count(0), published(nullptr), dirty(true) {
+        for (uint32_t i = 0; i < maxChunks; i++)
+            chunks[i] = nullptr;
+        add("None", EndpointRegistry::hashName("None"), false); // Matches NONE in memTypes.h
+    }
+
+    Entry& entry(EndpointId id) { return chunks[id >> chunkBits][id & (chunkSize - 1)]; }
+
+    /* Caller must hold lock */
+    EndpointId add(const std::string& name, uint64_t hash, bool placeholder) {
+        EndpointId id = count;
+        if ((id >> chunkBits) >= maxChunks) {
+            fprintf(stderr, "EndpointRegistry, Error: too many endpoints (more than %u)\n", maxChunks * chunkSize);
+            abort();
+        }
+        if (chunks[id >> chunkBits] == nullptr)
+            chunks[id >> chunkBits] = new Entry[chunkSize];
+        Entry& e = entry(id);
+        e.hash = hash;
+        e.placeholder = placeholder;
+        e.name.store(new std::string(name), std::memory_order_release);
+        byName[name] = id;
+        byHash[hash] = id;
+        dirty = true;
+        count++;
+        return id;
+    }
+
+    /* Lock-free lookups in the published maps, NoEndpoint on a miss */
+    EndpointId publishedByName(const std::string& name) {
+        const Published* p = published.load(std::memory_order_acquire);
+        if (p == nullptr)
+            return EndpointRegistry::NoEndpoint;
+        std::unordered_map<std::string, EndpointId>::const_iterator it = p->byName.find(name);
+        return it == p->byName.end() ? EndpointRegistry::NoEndpoint : it->second;
+    }
+
+    EndpointId publishedByHash(uint64_t hash) {
+        const Published* p = published.load(std::memory_order_acquire);
+        if (p == nullptr)
+            return EndpointRegistry::NoEndpoint;
+        std::unordered_map<uint64_t, EndpointId>::const_iterator it = p->byHash.find(hash);
+        return it == p->byHash.end() ? EndpointRegistry::NoEndpoint : it->second;
+    }
+};
+
+Table& table() {
+    static Table t;
+    return t;
+}
+
+}
+
+uint64_t EndpointRegistry::hashName(const std::string& name) {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < name.size(); i++) {
+        h ^= (uint8_t)name[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+EndpointId EndpointRegistry::intern(const std::string& name) {
+    Table& t = table();
+    EndpointId id = t.publishedByName(name);
+    if (id != NoEndpoint)
+        return id;
+
+    std::lock_guard<std::mutex> guard(t.lock);
+
+    std::unordered_map<std::string, EndpointId>::iterator it = t.byName.find(name);
+    if (it != t.byName.end())
+        return it->second;
+
+    uint64_t h = hashName(name);
+    std::unordered_map<uint64_t, EndpointId>::iterator hit = t.byHash.find(h);
+    if (hit != t.byHash.end()) {
+        Entry& e = t.entry(hit->second);
+        if (!e.placeholder) {
+            SST::Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, -1,
+                    "EndpointRegistry, Error: endpoint names '%s' and '%s' have the same hash (0x%" PRIx64 "). Rename one of them.\n",
+                    name.c_str(), e.name.load(std::memory_order_acquire)->c_str(), h);
+        }
+        // Seen from another rank before the name was known, replace the placeholder
+        t.byName.erase(*e.name.load(std::memory_order_acquire));
+        e.name.store(new std::string(name), std::memory_order_release);
+        e.placeholder = false;
+        t.byName[name] = hit->second;
+        t.dirty = true;
+        return hit->second;
+    }
+    return t.add(name, h, false);
+}
+
+const std::string& EndpointRegistry::name(EndpointId id) {
+    return *table().entry(id).name.load(std::memory_order_acquire);
+}
+
+uint64_t EndpointRegistry::hash(EndpointId id) {
+    return table().entry(id).hash;
+}
+
+EndpointId EndpointRegistry::lookup(const std::string& name) {
+    Table& t = table();
+    EndpointId id = t.publishedByName(name);
+    if (id != NoEndpoint)
+        return id;
+
+    std::lock_guard<std::mutex> guard(t.lock);
+    std::unordered_map<std::string, EndpointId>::iterator it = t.byName.find(name);
+    return it == t.byName.end() ? NoEndpoint : it->second;
+}
+
+EndpointId EndpointRegistry::known(const std::string& name) {
+    EndpointId id = lookup(name);
+    if (id == NoEndpoint && name != "None") {
+        SST::Simulation::getSimulation()->getSimulationOutput().fatal(CALL_INFO, -1,
+                "EndpointRegistry, Error: '%s' is not a known endpoint.\n", name.c_str());
+    }
+    return id;
+}
+
+EndpointId EndpointRegistry::fromHash(uint64_t hash) {
+    Table& t = table();
+    EndpointId id = t.publishedByHash(hash);
+    if (id != NoEndpoint)
+        return id;
+
+    std::lock_guard<std::mutex> guard(t.lock);
+
+    std::unordered_map<uint64_t, EndpointId>::iterator it = t.byHash.find(hash);
+    if (it != t.byHash.end())
+        return it->second;
+
+    std::ostringstream placeholder;
+    placeholder << "endpoint-0x" << std::hex << hash;
+    return t.add(placeholder.str(), hash, true);
+}
+
+void EndpointRegistry::publish() {
+    Table& t = table();
+    std::lock_guard<std::mutex> guard(t.lock);
+    if (!t.dirty)
+        return;
+
+    Published* p = new Published();
+    p->byName = t.byName;
+    p->byHash = t.byHash;
+    t.published.store(p, std::memory_order_release);
+    t.dirty = false;
+}
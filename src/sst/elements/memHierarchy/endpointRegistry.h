@@ -0,0 +1,91 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_ENDPOINTREGISTRY_H
+#define MEMHIERARCHY_ENDPOINTREGISTRY_H
+
+#include <stdint.h>
+#include <set>
+#include <string>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Compact identifiers for memHierarchy endpoints (caches, directories, memories, etc.)
+ *
+ * Events and coherence state refer to endpoints by a small integer instead of by name.
+ * Names are interned once into a process-wide table and only resolved when a name
+ * is actually needed (debug output, routing tables keyed by name). After init the
+ * name and hash tables are published read-only so that lookups do not lock.
+ *
+ * IDs are local to a process. When an event crosses ranks, the 64-bit hash of
+ * the endpoint's name is sent instead and mapped back to a local ID on the other side.
+ * Init events additionally carry names so that each rank learns the real names of
+ * the endpoints it talks to before simulation starts.
+ */
+typedef uint32_t EndpointId;
+
+class EndpointRegistry {
+public:
+    /* ID of the NONE endpoint, always 0 */
+    static const EndpointId NoEndpoint = 0;
+
+    /** Return the ID for a name, adding it to the table if needed.
+     * Fatal if a different, already known name has the same hash.
+     * Components should intern their own and their peers' names during construction/init
+     * and build events from the IDs.
+     */
+    static EndpointId intern(const std::string& name);
+
+    /** Return the ID for a name, or NoEndpoint if the name has never been interned */
+    static EndpointId lookup(const std::string& name);
+
+    /** Return the ID for a name that must already be interned. Fatal if it is not */
+    static EndpointId known(const std::string& name);
+
+    /** Publish an immutable copy of the name and hash tables.
+     * Lookups that hit the published copy do not lock. Called once every component's init
+     * has run (MemLinkBase::setup); later calls only copy if names were added since.
+     */
+    static void publish();
+
+    /** Return the name for an ID. The reference remains valid for the life of the process */
+    static const std::string& name(EndpointId id);
+
+    /** Return the rank-independent hash for an ID, used for serialization */
+    static uint64_t hash(EndpointId id);
+
+    /** Return the local ID for a hash received from another rank.
+     * If the name is not yet known, a placeholder name is used until it is interned.
+     */
+    static EndpointId fromHash(uint64_t hash);
+
+    /** Hash a name. 64-bit FNV-1a. */
+    static uint64_t hashName(const std::string& name);
+
+    /* Comparator that orders IDs by name so that containers of IDs iterate in the same order as containers of names */
+    struct NameLess {
+        bool operator()(EndpointId lhs, EndpointId rhs) const {
+            return lhs != rhs && name(lhs) < name(rhs);
+        }
+    };
+};
+
+/* Set of endpoints, iterates in name order */
+typedef std::set<EndpointId, EndpointRegistry::NameLess> EndpointSet;
+
+}}
+
+#endif // MEMHIERARCHY_ENDPOINTREGISTRY_H
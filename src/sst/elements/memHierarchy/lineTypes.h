@@ -23,6 +23,9 @@
 #include "sst/elements/memHierarchy/memTypes.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+#include "sst/elements/memHierarchy/payload.h"
+#include "sst/elements/memHierarchy/snapshot.h"
 
 using namespace std;
 
@@ -35,6 +38,7 @@ namespace SST { namespace MemHierarchy {
  * - getString() for debug
  * - getAddr() for identifiying a line
  * - getReplacementInfo() for returning the information that a replacement policy might need
+ * - save()/load() for writing and restoring a valid line's contents in a snapshot (address is handled by the array)
  */
 
 
@@ -45,14 +49,14 @@ class DirectoryLine {
         const unsigned int index_;
         Addr addr_;
         State state_;
-        std::set<std::string> sharers_;
-        std::string owner_;
+        EndpointSet sharers_;
+        EndpointId owner_;
         uint64_t lastSendTimestamp_;
         CoherenceReplacementInfo * info_;
         bool wasPrefetch_;
 
     public:
-        DirectoryLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), lastSendTimestamp_(0), wasPrefetch_(false) {
+        DirectoryLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), owner_(EndpointRegistry::NoEndpoint), lastSendTimestamp_(0), wasPrefetch_(false) {
             info_ = new CoherenceReplacementInfo(index, I, false, false);
         }
         virtual ~DirectoryLine() { }
@@ -60,7 +64,7 @@ class DirectoryLine {
         void reset() {
             state_ = I;
             sharers_.clear();
-            owner_ = "";
+            owner_ = EndpointRegistry::NoEndpoint;
             lastSendTimestamp_ = 0;
             wasPrefetch_ = false;
         }
@@ -76,30 +80,39 @@ class DirectoryLine {
         State getState() { return state_; }
         void setState(State state) { state_ = state; }
 
-        // Sharers
-        set<std::string>* getSharers() { return &sharers_; }
-        bool isSharer(std::string shr) {   return sharers_.find(shr) != sharers_.end(); }
+        // Sharers. The name overloads only look names up and are fatal for an unknown endpoint
+        EndpointSet* getSharers() { return &sharers_; }
+        bool isSharer(EndpointId shr) { return sharers_.find(shr) != sharers_.end(); }
+        bool isSharer(const std::string& shr) { return isSharer(EndpointRegistry::known(shr)); }
         size_t numSharers() { return sharers_.size(); }
         bool hasSharers() { return !sharers_.empty(); }
-        bool hasOtherSharers(std::string shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
-        void addSharer(std::string shr) {
+        bool hasOtherSharers(EndpointId shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
+        bool hasOtherSharers(const std::string& shr) { return hasOtherSharers(EndpointRegistry::known(shr)); }
+        void addSharer(EndpointId shr) {
             sharers_.insert(shr);
             info_->setShared(true);
         }
-        void removeSharer(std::string shr) {
+        void addSharer(const std::string& shr) { addSharer(EndpointRegistry::known(shr)); }
+        void removeSharer(EndpointId shr) {
             sharers_.erase(shr);
             info_->setShared(!sharers_.empty());
         }
+        void removeSharer(const std::string& shr) { removeSharer(EndpointRegistry::known(shr)); }
 
         // Owner
-        std::string getOwner() { return owner_; }
-        bool hasOwner() { return !owner_.empty(); }
-        void setOwner(std::string owner) {
+        const std::string& getOwner() {
+            static const std::string noOwner;
+            return owner_ == EndpointRegistry::NoEndpoint ? noOwner : EndpointRegistry::name(owner_);
+        }
+        EndpointId getOwnerId() { return owner_; }
+        bool hasOwner() { return owner_ != EndpointRegistry::NoEndpoint; }
+        void setOwner(EndpointId owner) {
             owner_ = owner;
             info_->setOwned(true);
         }
+        void setOwner(const std::string& owner) { setOwner(EndpointRegistry::known(owner)); }
         void removeOwner() {
-            owner_.clear();
+            owner_ = EndpointRegistry::NoEndpoint;
             info_->setOwned(false);
         }
 
@@ -115,14 +128,34 @@ class DirectoryLine {
         // Replacement
         ReplacementInfo* getReplacementInfo() { return info_; }
 
+        // Snapshot
+        void save(SnapshotWriter& out) {
+            out.put((uint8_t)state_);
+            out.putEndpoint(owner_);
+            out.putEndpoints(sharers_.begin(), sharers_.end(), sharers_.size());
+        }
+        void load(SnapshotReader& in) {
+            setState((State)in.get<uint8_t>());
+            sharers_.clear();
+            info_->setShared(false);
+            removeOwner();
+            EndpointId owner = in.getEndpoint();
+            if (owner != EndpointRegistry::NoEndpoint)
+                setOwner(owner);
+            std::vector<EndpointId> sharers;
+            in.getEndpoints(sharers);
+            for (std::vector<EndpointId>::iterator it = sharers.begin(); it != sharers.end(); it++)
+                addSharer(*it);
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
-            str << "O: " << (owner_.empty() ? "-" : owner_);
+            str << "O: " << (hasOwner() ? getOwner() : "-");
             str << " S: [";
-            for (std::set<std::string>::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
+            for (EndpointSet::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
                 if (it != sharers_.begin()) str << ",";
-                str << *it;
+                str << EndpointRegistry::name(*it);
             }
             str << "]";
             return str.str();
@@ -134,7 +167,7 @@ class DataLine {
     private:
         const unsigned int index_;
         Addr addr_;
-        vector<uint8_t> data_;
+        Payload data_;
         DirectoryLine* tag_;
         CoherenceReplacementInfo* info_;
     public:
@@ -163,14 +196,25 @@ class DataLine {
         DirectoryLine* getTag() { return tag_; }
 
         // Data
-        vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> data, uint32_t offset) {
-            std::copy(data.begin(), data.end(), data_.begin() + offset);
+        Payload* getData() { return &data_; }
+        void setData(const Payload& data, uint32_t offset) {
+            if (offset == 0 && data.size() == data_.size())
+                data_ = data;   // Whole line, share with the event until either side writes
+            else
+                std::copy(data.begin(), data.end(), data_.begin() + offset);
         }
 
         // Replacement
         ReplacementInfo* getReplacementInfo() { return tag_ ? tag_->getReplacementInfo() : info_; }
 
+        // Snapshot - state is held by the tag, which the owner of the arrays reconnects after loading
+        void save(SnapshotWriter& out) { out.putBytes(data_.data(), data_.size()); }
+        void load(SnapshotReader& in) {
+            Payload data(data_.size());
+            in.getBytes(data.data(), data.size());
+            data_ = data;
+        }
+
         // String-ify for debugging
         std::string getString() {
             return (tag_ ? "Valid" : "Invalid");
@@ -183,7 +227,7 @@ class CacheLine {
         const unsigned int index_;
         Addr addr_;
         State state_;
-        vector<uint8_t> data_;
+        Payload data_;
 
         // Timing
         uint64_t lastSendTimestamp_;
@@ -216,9 +260,12 @@ class CacheLine {
         void setState(State state) { state_ = state; updateReplacement(); }
 
         // Data
-        vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> in, uint32_t offset) {
-            std::copy(in.begin(), in.end(), std::next(data_.begin(), offset));
+        Payload* getData() { return &data_; }
+        void setData(const Payload& in, uint32_t offset) {
+            if (offset == 0 && in.size() == data_.size())
+                data_ = in;     // Whole line, share with the event until either side writes
+            else
+                std::copy(in.begin(), in.end(), data_.begin() + offset);
         }
 
         // Timestamp
@@ -231,6 +278,18 @@ class CacheLine {
 
         virtual ReplacementInfo* getReplacementInfo() = 0;
 
+        // Snapshot
+        void save(SnapshotWriter& out) {
+            out.put((uint8_t)state_);
+            out.putBytes(data_.data(), data_.size());
+        }
+        void load(SnapshotReader& in) {
+            setState((State)in.get<uint8_t>());
+            Payload data(data_.size());
+            in.getBytes(data.data(), data.size());
+            data_ = data;
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
@@ -290,13 +349,13 @@ class L1CacheLine : public CacheLine {
 /* With owner/sharer state for shared caches */
 class SharedCacheLine : public CacheLine {
     private:
-        std::set<std::string> sharers_;
-        std::string owner_;
+        EndpointSet sharers_;
+        EndpointId owner_;
         CoherenceReplacementInfo * info;
     protected:
         virtual void updateReplacement() { info->setState(state_); }
     public:
-        SharedCacheLine(uint32_t size, unsigned int index) : owner_(""), CacheLine(size, index) {
+        SharedCacheLine(uint32_t size, unsigned int index) : owner_(EndpointRegistry::NoEndpoint), CacheLine(size, index) {
             info = new CoherenceReplacementInfo(index, I, false, false);
         }
 
@@ -305,47 +364,76 @@ class SharedCacheLine : public CacheLine {
         void reset() {
             CacheLine::reset();
             sharers_.clear();
-            owner_ = "";
+            owner_ = EndpointRegistry::NoEndpoint;
         }
 
-        // Sharers
-        set<std::string>* getSharers() { return &sharers_; }
-        bool isSharer(std::string name) {   return sharers_.find(name) != sharers_.end(); }
+        // Sharers. The name overloads only look names up and are fatal for an unknown endpoint
+        EndpointSet* getSharers() { return &sharers_; }
+        bool isSharer(EndpointId shr) { return sharers_.find(shr) != sharers_.end(); }
+        bool isSharer(const std::string& shr) { return isSharer(EndpointRegistry::known(shr)); }
         size_t numSharers() { return sharers_.size(); }
         bool hasSharers() { return !sharers_.empty(); }
-        bool hasOtherSharers(std::string shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
-        void addSharer(std::string s) {
-            sharers_.insert(s);
+        bool hasOtherSharers(EndpointId shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
+        bool hasOtherSharers(const std::string& shr) { return hasOtherSharers(EndpointRegistry::known(shr)); }
+        void addSharer(EndpointId shr) {
+            sharers_.insert(shr);
             info->setShared(true);
         }
-        void removeSharer(std::string s) {
-            sharers_.erase(s);
+        void addSharer(const std::string& shr) { addSharer(EndpointRegistry::known(shr)); }
+        void removeSharer(EndpointId shr) {
+            sharers_.erase(shr);
             info->setShared(!sharers_.empty());
         }
+        void removeSharer(const std::string& shr) { removeSharer(EndpointRegistry::known(shr)); }
 
         // Owner
-        std::string getOwner() { return owner_; }
-        bool hasOwner() { return !owner_.empty(); }
-        void setOwner(std::string owner) {
+        const std::string& getOwner() {
+            static const std::string noOwner;
+            return owner_ == EndpointRegistry::NoEndpoint ? noOwner : EndpointRegistry::name(owner_);
+        }
+        EndpointId getOwnerId() { return owner_; }
+        bool hasOwner() { return owner_ != EndpointRegistry::NoEndpoint; }
+        void setOwner(EndpointId owner) {
             owner_ = owner;
             info->setOwned(true);
         }
+        void setOwner(const std::string& owner) { setOwner(EndpointRegistry::known(owner)); }
         void removeOwner() {
-            owner_.clear();
+            owner_ = EndpointRegistry::NoEndpoint;
             info->setOwned(false);
         }
 
         // Replacement
         ReplacementInfo * getReplacementInfo() { return info; }
 
+        // Snapshot
+        void save(SnapshotWriter& out) {
+            CacheLine::save(out);
+            out.putEndpoint(owner_);
+            out.putEndpoints(sharers_.begin(), sharers_.end(), sharers_.size());
+        }
+        void load(SnapshotReader& in) {
+            CacheLine::load(in);
+            sharers_.clear();
+            info->setShared(false);
+            removeOwner();
+            EndpointId owner = in.getEndpoint();
+            if (owner != EndpointRegistry::NoEndpoint)
+                setOwner(owner);
+            std::vector<EndpointId> sharers;
+            in.getEndpoints(sharers);
+            for (std::vector<EndpointId>::iterator it = sharers.begin(); it != sharers.end(); it++)
+                addSharer(*it);
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
-            str << "O: " << (owner_.empty() ? "-" : owner_);
+            str << "O: " << (hasOwner() ? getOwner() : "-");
             str << " S: [";
-            for (std::set<std::string>::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
+            for (EndpointSet::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
                 if (it != sharers_.begin()) str << ",";
-                str << *it;
+                str << EndpointRegistry::name(*it);
             }
             str << "]";
             return str.str();
@@ -384,6 +472,18 @@ class PrivateCacheLine : public CacheLine {
         // Replacement
         ReplacementInfo * getReplacementInfo() { return info; }
 
+        // Snapshot
+        void save(SnapshotWriter& out) {
+            CacheLine::save(out);
+            out.put((uint8_t)((shared ? 1 : 0) | (owned ? 2 : 0)));
+        }
+        void load(SnapshotReader& in) {
+            CacheLine::load(in);
+            uint8_t flags = in.get<uint8_t>();
+            setShared(flags & 1);
+            setOwned(flags & 2);
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::string str = "O: ";
@@ -24,6 +24,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/payload.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -58,7 +59,7 @@ public:
     }
 
     /** MemEvent constructor - Writes */
-    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd, std::vector<uint8_t>& data) : MemEventBase(src->getName(), cmd) {
+    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd, const Payload& data) : MemEventBase(src->getName(), cmd) {
         initialize();
         addr_ = addr;
         baseAddr_ = baseAddr;
@@ -77,7 +78,25 @@ public:
         baseAddr_ = baseAddr;
         size_ = size;
     }
-    MemEvent(std::string src, Addr addr, Addr baseAddr, Command cmd, std::vector<uint8_t>& data) : MemEventBase(src, cmd) {
+    MemEvent(std::string src, Addr addr, Addr baseAddr, Command cmd, const Payload& data) : MemEventBase(src, cmd) {
+        initialize();
+        addr_ = addr;
+        baseAddr_ = baseAddr;
+        setPayload(data);
+    }
+    /* Same as above, from an ID resolved once by the sender instead of a name */
+    MemEvent(EndpointId src, Addr addr, Addr baseAddr, Command cmd) : MemEventBase(src, cmd) {
+        initialize();
+        addr_ = addr;
+        baseAddr_ = baseAddr;
+    }
+    MemEvent(EndpointId src, Addr addr, Addr baseAddr, Command cmd, uint32_t size) : MemEventBase(src, cmd) {
+        initialize();
+        addr_ = addr;
+        baseAddr_ = baseAddr;
+        size_ = size;
+    }
+    MemEvent(EndpointId src, Addr addr, Addr baseAddr, Command cmd, const Payload& data) : MemEventBase(src, cmd) {
         initialize();
         addr_ = addr;
         baseAddr_ = baseAddr;
@@ -202,7 +221,7 @@ public:
     bool fromLowNetNACK()   { return CommandCPUSide[(int)cmd_];}
 
     /** @return  the data payload. */
-    dataVec& getPayload(void) {
+    Payload& getPayload(void) {
         /* Lazily allocate space for payload */
         if ( payload_.size() < size_ )  payload_.resize(size_);
         return payload_;
@@ -210,9 +229,9 @@ public:
 
 
     /** Sets the data payload and payload size.
-     * @param[in] data  Vector from which to copy data
+     * @param[in] data  Payload to share; bytes are only copied if one side later writes them
      */
-    void setPayload(std::vector<uint8_t>& data) {
+    void setPayload(const Payload& data) {
         setSize(data.size());
         payload_ = data;
     }
@@ -221,12 +240,9 @@ public:
      * @param[in] size  How many bytes to copy from data
      * @param[in] data  Data array to set as payload
      */
-    void setPayload(uint32_t size, uint8_t* data) {
+    void setPayload(uint32_t size, const uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
-        }
+        payload_.assign(data, size);
     }
 
     void setZeroPayload(uint32_t size) {
@@ -305,7 +321,7 @@ private:
     bool            addrGlobal_;        // Whether address is a local or global address
     MemEvent*       NACKedEvent_;       // For a NACK, pointer to the NACKed event
     int             retries_;           // For NACKed events, how many times a retry has been sent
-    dataVec         payload_;           // Data
+    Payload         payload_;           // Data
     bool            prefetch_;          // Whether this request came from a prefetcher
     bool            blocked_;           // Whether this request blocked for another pending request (for profiling) TODO move to mshrs
     bool            dirty_;             // For a replacement, whether the data is dirty or not
@@ -325,7 +341,14 @@ public:
         ser & addrGlobal_;
         ser & NACKedEvent_;
         ser & retries_;
-        ser & payload_;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            std::vector<uint8_t> data;
+            ser & data;
+            payload_ = data;
+        } else {
+            std::vector<uint8_t> data = payload_.toVector();
+            ser & data;
+        }
         ser & prefetch_;
         ser & blocked_;
         ser & dirty_;
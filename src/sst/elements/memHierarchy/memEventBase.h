@@ -22,6 +22,7 @@
 
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/endpointRegistry.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -44,8 +45,15 @@ public:
     static const uint32_t F_NORESPONSE      = 0x00010000;
 
 
-    /** Creates a new MemEventBase */
+    /** Creates a new MemEventBase. Interns src, so components should resolve
+     * their ID once and use the EndpointId constructor for runtime events */
     MemEventBase(std::string src, Command cmd) : SST::Event() {
+        setDefaults();
+        cmd_ = cmd;
+        src_ = EndpointRegistry::intern(src);
+    }
+
+    MemEventBase(EndpointId src, Command cmd) : SST::Event() {
         setDefaults();
         cmd_ = cmd;
         src_ = src;
@@ -54,9 +62,9 @@ public:
     virtual void setDefaults() {
         eventID_        = generateUniqueId();  // Defined in SST::Event
         responseToID_   = NO_ID;
-        dst_            = NONE;
-        src_            = NONE;
-        rqstr_          = NONE;
+        dst_            = EndpointRegistry::NoEndpoint;
+        src_            = EndpointRegistry::NoEndpoint;
+        rqstr_          = EndpointRegistry::NoEndpoint;
         cmd_            = Command::NULLCMD;
         flags_          = 0;
         memFlags_       = 0;
@@ -96,19 +104,31 @@ public:
     void setCmd(Command newcmd) { cmd_ = newcmd; }
 
     /** @return the source string - who sent this MemEvent */
-    const std::string& getSrc(void) const { return src_; }
+    const std::string& getSrc(void) const { return EndpointRegistry::name(src_); }
     /** Sets the source string - who sent this MemEvent */
-    void setSrc(const std::string& src) { src_ = src; }
+    void setSrc(const std::string& src) { src_ = EndpointRegistry::intern(src); }
+    /** @return the source ID */
+    EndpointId getSrcId(void) const { return src_; }
+    /** Sets the source ID */
+    void setSrcId(EndpointId src) { src_ = src; }
 
     /** @return the destination string - who receives this MemEvent */
-    const std::string& getDst(void) const { return dst_; }
+    const std::string& getDst(void) const { return EndpointRegistry::name(dst_); }
     /** Sets the destination string - who received this MemEvent */
-    void setDst(const std::string& dst) { dst_ = dst; }
+    void setDst(const std::string& dst) { dst_ = EndpointRegistry::intern(dst); }
+    /** @return the destination ID */
+    EndpointId getDstId(void) const { return dst_; }
+    /** Sets the destination ID */
+    void setDstId(EndpointId dst) { dst_ = dst; }
 
     /** @return the requestor string - whose original request caused this MemEvent */
-    const std::string& getRqstr(void) const { return rqstr_; }
+    const std::string& getRqstr(void) const { return EndpointRegistry::name(rqstr_); }
     /** Sets the requestor string - whose original request caused this MemEvent */
-    void setRqstr(const std::string& rqstr) { rqstr_ = rqstr; }
+    void setRqstr(const std::string& rqstr) { rqstr_ = EndpointRegistry::intern(rqstr); }
+    /** @return the requestor ID */
+    EndpointId getRqstrId(void) const { return rqstr_; }
+    /** Sets the requestor ID */
+    void setRqstrId(EndpointId rqstr) { rqstr_ = rqstr; }
 
     /** @returns the state of all flags */
     uint32_t getFlags(void) const { return flags_; }
@@ -174,7 +194,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream str;
         str << " Flags: " << getFlagString();
-        return idstring.str() + cmdStr + " Src: " + src_ + " Dst: " + dst_ + " Rq: " + rqstr_ + str.str();
+        return idstring.str() + cmdStr + " Src: " + getSrc() + " Dst: " + getDst() + " Rq: " + getRqstr() + str.str();
     }
 
     /** Get brief print of the event */
@@ -182,7 +202,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream idstring;
         idstring << "<" << eventID_.first << "," << eventID_.second << "> ";
-        return idstring.str() + cmdStr + " Src: " + src_ + " Dst: " + dst_;
+        return idstring.str() + cmdStr + " Src: " + getSrc() + " Dst: " + getDst();
     }
 
     virtual bool doDebug(std::set<Addr> &UNUSED(addr)) {
@@ -204,9 +224,9 @@ public:
 protected:
     id_type         eventID_;           // Unique ID for this event
     id_type         responseToID_;      // For responses, holds the ID to which this event matches
-    string          src_;               // Source ID
-    string          dst_;               // Destination ID
-    string          rqstr_;             // Cache that originated this request
+    EndpointId      src_;               // Source ID
+    EndpointId      dst_;               // Destination ID
+    EndpointId      rqstr_;             // Cache that originated this request
     Command         cmd_;               // Command
     uint32_t        flags_;
     uint32_t        memFlags_;
@@ -218,9 +238,21 @@ public:
         Event::serialize_order(ser);
         ser & eventID_;
         ser & responseToID_;
-        ser & src_;
-        ser & dst_;
-        ser & rqstr_;
+        // Endpoint IDs are local to a rank, send the name hashes instead
+        uint64_t srcHash = 0, dstHash = 0, rqstrHash = 0;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) {
+            srcHash = EndpointRegistry::hash(src_);
+            dstHash = EndpointRegistry::hash(dst_);
+            rqstrHash = EndpointRegistry::hash(rqstr_);
+        }
+        ser & srcHash;
+        ser & dstHash;
+        ser & rqstrHash;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            src_ = EndpointRegistry::fromHash(srcHash);
+            dst_ = EndpointRegistry::fromHash(dstHash);
+            rqstr_ = EndpointRegistry::fromHash(rqstrHash);
+        }
         ser & cmd_;
         ser & flags_;
         ser & memFlags_;
@@ -295,6 +327,21 @@ protected:
 public:
     void serialize_order(SST::Core::Serialization::serializer &ser) override {
         MemEventBase::serialize_order(ser);
+        // Init events also carry endpoint names so that the receiving rank can resolve them
+        std::string src, dst, rqstr;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) {
+            src = getSrc();
+            dst = getDst();
+            rqstr = getRqstr();
+        }
+        ser & src;
+        ser & dst;
+        ser & rqstr;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            src_ = EndpointRegistry::intern(src);
+            dst_ = EndpointRegistry::intern(dst);
+            rqstr_ = EndpointRegistry::intern(rqstr);
+        }
         ser & initCmd_;
         ser & addr_;
         ser & payload_;
@@ -34,7 +34,8 @@ MemHierarchyInterface::MemHierarchyInterface(SST::ComponentId_t id, Params &para
     setDefaultTimeBase(time); // Required for link since we no longer inherit it from our parent
 
     output.init("", 1, 0, Output::STDOUT);
-    rqstr_ = "";
+    id_ = EndpointRegistry::intern(getName());
+    rqstr_ = EndpointRegistry::NoEndpoint;
     initDone_ = false;
 
     recvHandler_ = handler;
@@ -68,7 +69,7 @@ void MemHierarchyInterface::init(unsigned int phase) {
         MemEventInit * memEvent = dynamic_cast<MemEventInit*>(ev);
         if (memEvent) {
             if (memEvent->getCmd() == Command::NULLCMD) {
-                rqstr_ = memEvent->getSrc();
+                rqstr_ = memEvent->getSrcId();
                 if (memEvent->getInitCmd() == MemEventInit::InitCommand::Coherence) {
                     MemEventInitCoherence * memEventC = static_cast<MemEventInitCoherence*>(memEvent);
                     baseAddrMask_ = ~(memEventC->getLineSize() - 1);
@@ -138,10 +139,10 @@ MemEventBase* MemHierarchyInterface::createMemEvent(SimpleMem::Request *req) con
 
     Addr baseAddr = (req->addrs[0]) & baseAddrMask_;
 
-    MemEvent *me = new MemEvent(getName(), req->addrs[0], baseAddr, cmd);
+    MemEvent *me = new MemEvent(id_, req->addrs[0], baseAddr, cmd);
 
-    me->setRqstr(rqstr_);
-    me->setDst(rqstr_);
+    me->setRqstrId(rqstr_);
+    me->setDstId(rqstr_);
     me->setSize(req->size);
 
     if (SimpleMem::Request::Write == req->cmd)  {
@@ -196,9 +197,9 @@ MemEventBase* MemHierarchyInterface::createMemEvent(SimpleMem::Request *req) con
 
 MemEventBase* MemHierarchyInterface::createCustomEvent(SimpleMem::Request * req) const {
     Addr baseAddr = (req->addrs[0]) & baseAddrMask_;
-    CustomCmdEvent * cme = new CustomCmdEvent(getName().c_str(), req->addrs[0], baseAddr, Command::CustomReq, req->getCustomOpc(), req->size);
-    cme->setRqstr(rqstr_);
-    cme->setDst(rqstr_);
+    CustomCmdEvent * cme = new CustomCmdEvent(id_, req->addrs[0], baseAddr, Command::CustomReq, req->getCustomOpc(), req->size);
+    cme->setRqstrId(rqstr_);
+    cme->setDstId(rqstr_);
 
     if(req->flags & SimpleMem::Request::F_NONCACHEABLE)
         cme->setFlag(MemEvent::F_NONCACHEABLE);
@@ -78,7 +78,8 @@ protected:
     Output      output;
     Addr        baseAddrMask_;
     Addr        lineSize_;
-    std::string rqstr_;
+    EndpointId  id_;        // This interface, resolved once at construction
+    EndpointId  rqstr_;     // The cache or memory this interface is connected to, learned during init
     std::map<MemEventBase::id_type, Interfaces::SimpleMem::Request*> requests_;
     SST::Link*  link_;
 
@@ -34,6 +34,8 @@ MemHierarchyScratchInterface::MemHierarchyScratchInterface(SST::ComponentId_t id
     setDefaultTimeBase(time);
 
     output.init("", 1, 0, Output::STDOUT);
+    id_ = EndpointRegistry::intern(getName());
+    rqstr_ = EndpointRegistry::NoEndpoint;
 
     bool found;
     UnitAlgebra size = UnitAlgebra(params.find<std::string>("scratchpad_size", "0B", found));
@@ -69,7 +71,7 @@ void MemHierarchyScratchInterface::init(unsigned int phase) {
                 MemEventInitCoherence * memEventC = static_cast<MemEventInitCoherence*>(memEvent);
                 baseAddrMask_ = ~(memEventC->getLineSize() - 1);
                 lineSize_ = memEventC->getLineSize();
-                rqstr_ = memEventC->getSrc();
+                rqstr_ = memEventC->getSrcId();
                 allNoncache_ = (Endpoint::Scratchpad == memEventC->getType());
                 initDone_ = true;
             }
@@ -131,7 +133,7 @@ MemEvent * MemHierarchyScratchInterface::createMemEvent(SimpleMem::Request * req
 
     Addr baseAddr = req->addrs[0] & baseAddrMask_;
 
-    MemEvent * me = new MemEvent(getName(), req->addrs[0], baseAddr, cmd);
+    MemEvent * me = new MemEvent(id_, req->addrs[0], baseAddr, cmd);
 
     /* Set remote memory accesses to noncacheable so that any cache avoids trying to cache the response */
     if (me->getAddr() >= remoteMemStart_ || allNoncache_) {
@@ -139,9 +141,9 @@ MemEvent * MemHierarchyScratchInterface::createMemEvent(SimpleMem::Request * req
     }
 
     me->setSize(req->size);
-    me->setRqstr(rqstr_);
-    me->setSrc(rqstr_);
-    me->setDst(rqstr_);
+    me->setRqstrId(rqstr_);
+    me->setSrcId(rqstr_);
+    me->setDstId(rqstr_);
 
     if (SimpleMem::Request::Write == req->cmd) {
         if (req->data.size() == 0) req->data.resize(req->size, 0);
@@ -162,7 +164,7 @@ MoveEvent* MemHierarchyScratchInterface::createMoveEvent(SimpleMem::Request *req
         default: output.fatal(CALL_INFO, -1, "Unknown req->cmd in createMoveEvent()\n");
     }
 
-    MoveEvent *me = new MoveEvent(getName(), req->addrs[1], req->addrs[1], req->addrs[0], req->addrs[0], cmd);
+    MoveEvent *me = new MoveEvent(id_, req->addrs[1], req->addrs[1], req->addrs[0], req->addrs[0], cmd);
 
     if (cmd == Command::Get) {
         me->setDstBaseAddr(req->addrs[0] & baseAddrMask_);
@@ -170,9 +172,9 @@ MoveEvent* MemHierarchyScratchInterface::createMoveEvent(SimpleMem::Request *req
         me->setSrcBaseAddr(req->addrs[1] & baseAddrMask_);
     }
 
-    me->setRqstr(rqstr_);
-    me->setSrc(rqstr_);
-    me->setDst(rqstr_);
+    me->setRqstrId(rqstr_);
+    me->setSrcId(rqstr_);
+    me->setDstId(rqstr_);
     me->setSize(req->size);
 
     me->setDstVirtualAddress(req->getVirtualAddress());
@@ -90,7 +90,8 @@ private:
     std::map<SST::Event::id_type, Interfaces::SimpleMem::Request*> requests_;
     Addr baseAddrMask_;
     Addr lineSize_;
-    std::string rqstr_;
+    EndpointId id_;         // This interface, resolved once at construction
+    EndpointId rqstr_;      // The scratchpad this interface is connected to, learned during init
     Addr remoteMemStart_;
     bool allNoncache_;
 
@@ -17,6 +17,8 @@
 #define _MEMHIERARCHY_MEMLINKBASE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
@@ -78,7 +80,16 @@ public:
     virtual bool isClocked() { return false; }
     virtual void init(unsigned int UNUSED(phase)) { }
     virtual void finish() { }
-    virtual void setup() { }
+
+    /* Every component's init is done by setup, so index the destinations by ID and publish the endpoint names */
+    virtual void setup() {
+        destIds.clear();
+        std::set<EndpointInfo>* dests = getDests();
+        for (std::set<EndpointInfo>::const_iterator it = dests->begin(); it != dests->end(); it++) {
+            destIds.push_back(std::make_pair(it->region, EndpointRegistry::intern(it->name)));
+        }
+        EndpointRegistry::publish();
+    }
 
     /* Debug - triggered by output.fatal() or SIGUSR2 */
     virtual void printStatus(Output &out) {
@@ -103,6 +114,14 @@ public:
     /* Functions for managing communication according to address */
     virtual std::string findTargetDestination(Addr addr) =0;
 
+    /* ID of findTargetDestination(addr). Does not touch names once setup has indexed the destinations */
+    EndpointId findTargetDestinationId(Addr addr) {
+        for (std::vector<std::pair<MemRegion, EndpointId> >::const_iterator it = destIds.begin(); it != destIds.end(); it++) {
+            if (it->first.contains(addr)) return it->second;
+        }
+        return EndpointRegistry::intern(findTargetDestination(addr));
+    }
+
     virtual bool isRequestAddressValid(Addr addr) { return info.region.contains(addr); }
 
     /* Functions for managing source/destination information */
@@ -135,6 +154,7 @@ protected:
 
     // Data structures
     std::queue<MemEventInit*> initReceiveQ;     // queue for messages received during init
+    std::vector<std::pair<MemRegion, EndpointId> > destIds;  // getDests() in the same order, with names resolved
 
 private:
 
@@ -62,6 +62,20 @@ void MemNIC::build(Params& params) {
 
     // Packet size
     packetHeaderBytes = extractPacketHeaderSize(params, "min_packet_size");
+
+    // Batching
+    batching = params.find<bool>("batching", false);
+    batchCycles = params.find<uint64_t>("batch_cycles", 0);
+    batchMaxEvents = params.find<size_t>("batch_max_events", 8);
+    batchEntryBytes = extractPacketHeaderSize(params, "batch_entry_size", "4B");
+    cycle = 0;
+    statBatchSize = nullptr;
+
+    if (batching) {
+        if (batchMaxEvents == 0)
+            dbg.fatal(CALL_INFO, -1, "Invalid param(%s): batch_max_events - must be at least 1.\n", getName().c_str());
+        statBatchSize = registerStatistic<uint64_t>("batch_size");
+    }
 }
 
 void MemNIC::init(unsigned int phase) {
@@ -74,7 +88,16 @@ void MemNIC::init(unsigned int phase) {
  * Returns whether anything sent this cycle
  */
 bool MemNIC::clock() {
-    if (sendQueue.empty()) return true;
+    while (!batchDeadlines.empty() && batchDeadlines.front().first <= cycle) {
+        std::unordered_map<uint64_t,Batch>::iterator it = openBatches.find(batchDeadlines.front().second);
+        // The batch may have been sent early and a new one opened since
+        if (it != openBatches.end() && it->second.deadline == batchDeadlines.front().first)
+            sendBatch(it);
+        batchDeadlines.pop();
+    }
+    cycle++;
+
+    if (sendQueue.empty()) return openBatches.empty();
 
     drainQueue(&sendQueue, link_control);
 
@@ -89,25 +112,39 @@ bool MemNIC::recvNotify(int) {
     MemRtrEvent * mre = doRecv(link_control);
     if (mre) {
         MemEventBase* ev = mre->event;
-        delete mre;
         if (ev) {
-            if (is_debug_event(ev)) {
-                dbg.debug(_L9_, "%s, memNIC recv: src: %s. cmd: %s\n",
-                        getName().c_str(), ev->getSrc().c_str(), CommandString[(int)ev->getCmd()]);
-            }
-            (*recvHandler)(ev);
+            deliver(ev);
+        } else if (MemRtrBatchEvent * mrbe = dynamic_cast<MemRtrBatchEvent*>(mre)) {
+            for (std::vector<MemEventBase*>::iterator it = mrbe->events.begin(); it != mrbe->events.end(); it++)
+                deliver(*it);
         }
+        delete mre;
     }
     return true;
 }
 
+void MemNIC::deliver(MemEventBase * ev) {
+    if (is_debug_event(ev)) {
+        dbg.debug(_L9_, "%s, memNIC recv: src: %s. cmd: %s\n",
+                getName().c_str(), ev->getSrc().c_str(), CommandString[(int)ev->getCmd()]);
+    }
+    (*recvHandler)(ev);
+}
+
 
 /* Send event to memNIC */
 void MemNIC::send(MemEventBase *ev) {
+    uint64_t dest = lookupNetworkAddress(ev->getDstId());
+
+    if (batching && (ev->getPayloadSize() == 0 || openBatches.find(dest) != openBatches.end())) {
+        addToBatch(dest, ev);
+        return;
+    }
+
     SimpleNetwork::Request *req = new SimpleNetwork::Request();
     MemRtrEvent * mre = new MemRtrEvent(ev);
     req->src = info.addr;
-    req->dest = lookupNetworkAddress(ev->getDst());
+    req->dest = dest;
     req->size_in_bits = getSizeInBits(ev);
     req->vn = 0;
 
@@ -116,11 +153,55 @@ void MemNIC::send(MemEventBase *ev) {
                 getName().c_str(), ev->getDst().c_str(), req->size_in_bits, CommandString[(int)ev->getCmd()]);
     }
 
+    if (batching)
+        statBatchSize->addData(1);
+
     req->givePayload(mre);
     sendQueue.push(req);
 }
 
 
+/* Add an event to the destination's open batch, opening one if needed */
+void MemNIC::addToBatch(uint64_t dest, MemEventBase *ev) {
+    std::unordered_map<uint64_t,Batch>::iterator it = openBatches.find(dest);
+    if (it == openBatches.end()) {
+        it = openBatches.insert(std::make_pair(dest, Batch())).first;
+        it->second.bytes = packetHeaderBytes;
+        it->second.deadline = cycle + batchCycles;
+        batchDeadlines.push(std::make_pair(it->second.deadline, dest));
+    } else {
+        it->second.bytes += batchEntryBytes;
+    }
+    it->second.events.push_back(ev);
+    it->second.bytes += ev->getPayloadSize();
+
+    if (is_debug_event(ev)) {
+        dbg.debug(_L9_, "%s, memNIC adding to batch: dst: %s, events: %zu, cmd: %s\n",
+                getName().c_str(), ev->getDst().c_str(), it->second.events.size(), CommandString[(int)ev->getCmd()]);
+    }
+
+    if (it->second.events.size() >= batchMaxEvents || ev->getPayloadSize() != 0)
+        sendBatch(it);
+}
+
+/* Move a batch to the send queue. A batch of one is sent as a plain event. */
+void MemNIC::sendBatch(std::unordered_map<uint64_t,Batch>::iterator it) {
+    SimpleNetwork::Request *req = new SimpleNetwork::Request();
+    req->src = info.addr;
+    req->dest = it->first;
+    req->size_in_bits = 8 * it->second.bytes;
+    req->vn = 0;
+
+    statBatchSize->addData(it->second.events.size());
+
+    if (it->second.events.size() == 1)
+        req->givePayload(new MemRtrEvent(it->second.events.front()));
+    else
+        req->givePayload(new MemRtrBatchEvent(it->second.events));
+    sendQueue.push(req);
+    openBatches.erase(it);
+}
+
 /** Helper functions **/
 
 /* Calculate size in bits of an event */
@@ -136,12 +217,25 @@ void MemNIC::printStatus(Output &out) {
     // Since this is just debug/fatal we're just going to read out the queue & re-populate it
     std::queue<SST::Interfaces::SimpleNetwork::Request*> tmpQ;
     while (!sendQueue.empty()) {
-        MemEventBase * ev = static_cast<MemRtrEvent*>(sendQueue.front()->inspectPayload())->event;
-        out.output("      %s\n", ev->getVerboseString().c_str());
+        MemRtrEvent * mre = static_cast<MemRtrEvent*>(sendQueue.front()->inspectPayload());
+        if (mre->event) {
+            out.output("      %s\n", mre->event->getVerboseString().c_str());
+        } else if (MemRtrBatchEvent * mrbe = dynamic_cast<MemRtrBatchEvent*>(mre)) {
+            for (std::vector<MemEventBase*>::iterator it = mrbe->events.begin(); it != mrbe->events.end(); it++)
+                out.output("      (batched) %s\n", (*it)->getVerboseString().c_str());
+        }
         tmpQ.push(sendQueue.front());
         sendQueue.pop();
     }
     tmpQ.swap(sendQueue);
+    if (!openBatches.empty()) {
+        out.output("    Open batches (%zu):\n", openBatches.size());
+        for (std::unordered_map<uint64_t,Batch>::iterator it = openBatches.begin(); it != openBatches.end(); it++) {
+            out.output("      Dest %" PRIu64 ", deadline %" PRIu64 "\n", it->first, it->second.deadline);
+            for (std::vector<MemEventBase*>::iterator ev = it->second.events.begin(); ev != it->second.events.end(); ev++)
+                out.output("        %s\n", (*ev)->getVerboseString().c_str());
+        }
+    }
     out.output("    Link status: \n");
     link_control->printStatus(out);
     out.output("  End MemHierarchy::MemNIC\n");
@@ -152,10 +246,13 @@ void MemNIC::emergencyShutdownDebug(Output &out) {
     MemRtrEvent * mre = doRecv(link_control);
     while (mre != nullptr) {
         MemEventBase * ev = mre->event;
-        delete mre;
         if (ev) {
             out.output("      Undelivered message: %s\n", ev->getVerboseString().c_str());
+        } else if (MemRtrBatchEvent * mrbe = dynamic_cast<MemRtrBatchEvent*>(mre)) {
+            for (std::vector<MemEventBase*>::iterator it = mrbe->events.begin(); it != mrbe->events.end(); it++)
+                out.output("      Undelivered message: %s\n", (*it)->getVerboseString().c_str());
         }
+        delete mre;
         mre = doRecv(link_control);
     }
 }
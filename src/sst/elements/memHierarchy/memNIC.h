@@ -19,6 +19,7 @@
 #include <string>
 #include <unordered_map>
 #include <queue>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/output.h>
@@ -60,9 +61,17 @@ public:
     SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(MemNIC, "memHierarchy", "MemNIC", SST_ELI_ELEMENT_VERSION(1,0,0),
             "Memory-oriented network interface", SST::MemHierarchy::MemLinkBase)
 
-    SST_ELI_DOCUMENT_PARAMS( MEMNIC_ELI_PARAMS )
+    SST_ELI_DOCUMENT_PARAMS( MEMNIC_ELI_PARAMS,
+        { "batching",                    "(bool) Coalesce messages to the same destination into one network packet", "false"},
+        { "batch_cycles",                "(uint) Batching: cycles a message may wait for others to the same destination. 0 coalesces only messages sent in the same cycle", "0"},
+        { "batch_max_events",            "(uint) Batching: maximum messages per packet", "8"},
+        { "batch_entry_size",            "(string) Batching: size added to a packet for each message after the first, on top of the message's payload", "4B"} )
 
-    SST_ELI_DOCUMENT_PORTS( {"port", "Link to network", { "memHierarchy.MemRtrEvent" } } )
+    /* Registered only when batching */
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "batch_size",                  "Number of messages in each packet sent", "count", 3 } )
+
+    SST_ELI_DOCUMENT_PORTS( {"port", "Link to network", { "memHierarchy.MemRtrEvent", "memHierarchy.MemRtrBatchEvent" } } )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( { "linkcontrol", "Network interface"} )
 
@@ -93,6 +102,29 @@ public:
     void printStatus(Output &out);
     void emergencyShutdownDebug(Output &out);
 
+    // Several events to the same destination sent as one packet
+    class MemRtrBatchEvent : public MemRtrEvent {
+        public:
+            std::vector<MemEventBase*> events;
+
+            MemRtrBatchEvent() : MemRtrEvent() { }
+            MemRtrBatchEvent(std::vector<MemEventBase*>& evs) : MemRtrEvent() { events.swap(evs); }
+
+            virtual Event* clone(void) override {
+                MemRtrBatchEvent * mrbe = new MemRtrBatchEvent(*this);
+                for (size_t i = 0; i < events.size(); i++)
+                    mrbe->events[i] = events[i]->clone();
+                return mrbe;
+            }
+
+            void serialize_order(SST::Core::Serialization::serializer &ser) override {
+                MemRtrEvent::serialize_order(ser);
+                ser & events;
+            }
+
+            ImplementSerializable(SST::MemHierarchy::MemNIC::MemRtrBatchEvent);
+    };
+
 private:
 
     // Other parameters
@@ -104,9 +136,35 @@ private:
     // Event queues
     std::queue<SST::Interfaces::SimpleNetwork::Request*> sendQueue; // Queue of events waiting to be sent (sent on clock)
 
+    /*
+     * Batching
+     * Events to a destination collect in an open batch until it is full, its
+     * deadline passes, or an event with data joins it. Events with data never
+     * open a batch since they are large enough to be worth a packet, but they
+     * do close one so that events to a destination stay in order.
+     */
+    struct Batch {
+        std::vector<MemEventBase*> events;
+        size_t bytes;
+        uint64_t deadline;
+    };
+
+    bool batching;
+    uint64_t batchCycles;
+    size_t batchMaxEvents;
+    size_t batchEntryBytes;
+    uint64_t cycle;                                     // Clock ticks, for batch deadlines
+    std::unordered_map<uint64_t,Batch> openBatches;     // Network address -> open batch
+    std::queue<std::pair<uint64_t,uint64_t> > batchDeadlines; // (deadline, network address) in deadline order
+
+    Statistic<uint64_t>* statBatchSize;
+
 private:
 
     void build(Params &params);
+    void addToBatch(uint64_t dest, MemEventBase * ev);
+    void sendBatch(std::unordered_map<uint64_t,Batch>::iterator it);
+    void deliver(MemEventBase * ev);
 };
 
 } //namespace memHierarchy
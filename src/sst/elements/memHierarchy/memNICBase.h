@@ -19,6 +19,7 @@
 #include <string>
 #include <unordered_map>
 #include <queue>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/output.h>
@@ -222,6 +223,10 @@ class MemNICBase : public MemLinkBase {
                 if (imre) {
                     // Record name->address map for all other endpoints
                     networkAddressMap.insert(std::make_pair(imre->info.name, imre->info.addr));
+                    EndpointId id = EndpointRegistry::intern(imre->info.name);
+                    if (id >= networkAddressById.size())
+                        networkAddressById.resize(id + 1, (uint64_t)NoNetworkAddress);
+                    networkAddressById[id] = imre->info.addr;
                     processInitMemRtrEvent(imre);
                     delete imre;
                 } else {
@@ -264,6 +269,14 @@ class MemNICBase : public MemLinkBase {
             return it->second;
         }
 
+        // Lookup the network address for a given endpoint ID, used on the send path
+        uint64_t lookupNetworkAddress(EndpointId dst) const {
+            if (dst >= networkAddressById.size() || networkAddressById[dst] == NoNetworkAddress) {
+                dbg.fatal(CALL_INFO, -1, "%s (MemNICBase), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), EndpointRegistry::name(dst).c_str());
+            }
+            return networkAddressById[dst];
+        }
+
         /*
          * Some helper functions to avoid needing to repeat code everywhere
          */
@@ -331,6 +344,8 @@ class MemNICBase : public MemLinkBase {
 
         // Data structures
         std::unordered_map<std::string,uint64_t> networkAddressMap; // Map of name -> address for each network endpoint
+        std::vector<uint64_t> networkAddressById;                   // Same map indexed by EndpointId
+        static const uint64_t NoNetworkAddress = (uint64_t)-1;
         std::set<EndpointInfo> sourceEndpointInfo;
         std::set<EndpointInfo> destEndpointInfo;
 
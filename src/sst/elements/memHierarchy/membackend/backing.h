@@ -18,6 +18,12 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -27,13 +33,18 @@ namespace Backend {
 class Backing {
 public:
     Backing( ) { }
-    ~Backing() { }
+    virtual ~Backing() { }
 
     virtual void set( Addr addr, uint8_t value ) = 0;
-    virtual void set( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void set( Addr addr, size_t size, const uint8_t* data) = 0;
 
     virtual uint8_t get( Addr addr) = 0;
-    virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void get( Addr addr, size_t size, uint8_t* data) = 0;
+
+    /* Save/load populated memory. Only supported by stores that track which pages are populated */
+    virtual bool supportsSnapshot() { return false; }
+    virtual void dump( std::string file ) { }
+    virtual void restore( std::string file ) { }
 };
 
 class BackingMMAP : public Backing {
@@ -66,24 +77,22 @@ public:
         m_buffer[addr - m_offset ] = value;
     }
 
-    void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            m_buffer[addr + i] = data[i];
+    void set( Addr addr, size_t size, const uint8_t* data ) {
+        memcpy(m_buffer + (addr - m_offset), data, size);
     }
 
     uint8_t get( Addr addr ) {
         return m_buffer[addr - m_offset];
     }
 
-    void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+    void get( Addr addr, size_t size, uint8_t* data ) {
+        memcpy(data, m_buffer + (addr - m_offset), size);
     }
 
 private:
     uint8_t* m_buffer;
     int m_fd;
-    int m_size;
+    size_t m_size;
     size_t m_offset;
 };
 
@@ -97,79 +106,271 @@ public:
             out.fatal(CALL_INFO, -1, "BackingMalloc: Error - size must be a power of two. Got: %zu\n", size);
         }
         m_shift = log2Of(m_allocUnit);
+        m_lastUnit = 0;
+        m_lastData = nullptr;
+    }
+
+    ~BackingMalloc() {
+        for (std::unordered_map<Addr,uint8_t*>::iterator it = m_buffer.begin(); it != m_buffer.end(); it++)
+            free(it->second);
     }
 
     void set( Addr addr, uint8_t value ) {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        m_buffer[bAddr][offset] = value;
+        allocIfNeeded(bAddr)[offset] = value;
     }
 
-    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+    void set( Addr addr, size_t size, const uint8_t* data ) {
         /* Account for size exceeding alloc unit size */
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
-
         while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
-            offset++;
-            dataOffset++;
-
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+            size_t span = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            memcpy(allocIfNeeded(bAddr) + offset, data + dataOffset, span);
+            dataOffset += span;
+            offset = 0;
+            bAddr++;
         }
     }
 
-    void get (Addr addr, size_t size, std::vector<uint8_t> &data) {
+    void get( Addr addr, size_t size, uint8_t* data ) {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
-
         while (dataOffset != size) {
-            data[dataOffset] = m_buffer[bAddr][offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
+            size_t span = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            memcpy(data + dataOffset, allocIfNeeded(bAddr) + offset, span);
+            dataOffset += span;
+            offset = 0;
+            bAddr++;
         }
     }
 
     uint8_t get( Addr addr ) {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        return m_buffer[bAddr][offset];
+        return allocIfNeeded(bAddr)[offset];
     }
 
 private:
-    void allocIfNeeded(Addr bAddr) {
-        if (m_buffer.find(bAddr) == m_buffer.end()) {
+    /* Return the unit for bAddr, allocating it if needed. Consecutive accesses usually hit the same unit */
+    uint8_t* allocIfNeeded(Addr bAddr) {
+        if (m_lastData && m_lastUnit == bAddr)
+            return m_lastData;
+        std::unordered_map<Addr,uint8_t*>::iterator it = m_buffer.find(bAddr);
+        if (it == m_buffer.end()) {
             uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
             if (!data) {
                 Output out("", 1, 0, Output::STDOUT);
                 out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
             }
-            m_buffer[bAddr] = data;
+            it = m_buffer.insert(std::make_pair(bAddr, data)).first;
         }
+        m_lastUnit = bAddr;
+        m_lastData = it->second;
+        return m_lastData;
     }
 
     std::unordered_map<Addr,uint8_t*> m_buffer;
+    Addr m_lastUnit;
+    uint8_t* m_lastData;
     unsigned int m_allocUnit;
     unsigned int m_shift;
 };
 
+/*
+ * Sparse backing store for large, mostly untouched address spaces.
+ *
+ * Pages are located through a two-level radix directory and allocated on
+ * first write; reads of unpopulated pages return zeros without allocating.
+ * Pages of 2MiB or more are mmap'd and marked for transparent huge pages.
+ * Populated pages can be dumped to and restored from a snapshot file:
+ *   header: "SSTMEMPG", uint64 page size, uint64 page count
+ *   pages:  uint64 page number, page data (all-zero pages are skipped)
+ */
+class BackingSparse : public Backing {
+public:
+    BackingSparse(size_t pageSize) : Backing(), m_pageSize(pageSize), m_populated(0) {
+        if (!isPowerOfTwo(m_pageSize)) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - page size must be a power of two. Got: %zu\n", pageSize);
+        }
+        m_pageShift = log2Of(m_pageSize);
+        m_useMmap = m_pageSize >= HugePageSize;
+    }
+
+    ~BackingSparse() {
+        for (size_t i = 0; i < m_dir.size(); i++) {
+            if (!m_dir[i]) continue;
+            for (size_t j = 0; j < DirSize; j++) {
+                if (m_dir[i][j]) freePage(m_dir[i][j]);
+            }
+            delete [] m_dir[i];
+        }
+    }
+
+    void set( Addr addr, uint8_t value ) {
+        getPage(addr >> m_pageShift, true)[addr & (m_pageSize - 1)] = value;
+    }
+
+    void set( Addr addr, size_t size, const uint8_t* data ) {
+        size_t done = 0;
+        while (done != size) {
+            Addr offset = (addr + done) & (m_pageSize - 1);
+            size_t span = std::min(size - done, (size_t)(m_pageSize - offset));
+            memcpy(getPage((addr + done) >> m_pageShift, true) + offset, data + done, span);
+            done += span;
+        }
+    }
+
+    uint8_t get( Addr addr ) {
+        uint8_t* page = getPage(addr >> m_pageShift, false);
+        return page ? page[addr & (m_pageSize - 1)] : 0;
+    }
+
+    void get( Addr addr, size_t size, uint8_t* data ) {
+        size_t done = 0;
+        while (done != size) {
+            Addr offset = (addr + done) & (m_pageSize - 1);
+            size_t span = std::min(size - done, (size_t)(m_pageSize - offset));
+            uint8_t* page = getPage((addr + done) >> m_pageShift, false);
+            if (page)
+                memcpy(data + done, page + offset, span);
+            else
+                memset(data + done, 0, span);
+            done += span;
+        }
+    }
+
+    uint64_t getPopulatedPages() { return m_populated; }
+
+    bool supportsSnapshot() { return true; }
+
+    void dump( std::string file ) {
+        FILE* fp = fopen(file.c_str(), "wb");
+        if (!fp)
+            snapshotError("unable to open snapshot file for writing", file);
+
+        std::vector<uint8_t> zero(m_pageSize, 0);
+        uint64_t count = 0;
+        for (size_t i = 0; i < m_dir.size(); i++) {
+            if (!m_dir[i]) continue;
+            for (size_t j = 0; j < DirSize; j++) {
+                if (m_dir[i][j] && memcmp(m_dir[i][j], zero.data(), m_pageSize) != 0) count++;
+            }
+        }
+
+        uint64_t header[2] = { (uint64_t)m_pageSize, count };
+        bool ok = fwrite(snapshotMagic(), 1, 8, fp) == 8 && fwrite(header, sizeof(uint64_t), 2, fp) == 2;
+        for (size_t i = 0; ok && i < m_dir.size(); i++) {
+            if (!m_dir[i]) continue;
+            for (size_t j = 0; ok && j < DirSize; j++) {
+                uint8_t* page = m_dir[i][j];
+                if (!page || memcmp(page, zero.data(), m_pageSize) == 0) continue;
+                uint64_t pageNum = ((uint64_t)i << DirBits) | j;
+                ok = fwrite(&pageNum, sizeof(uint64_t), 1, fp) == 1 && fwrite(page, 1, m_pageSize, fp) == m_pageSize;
+            }
+        }
+        if (fclose(fp) != 0 || !ok)
+            snapshotError("failed writing snapshot file", file);
+    }
+
+    /* Snapshot page size need not match this store's page size */
+    void restore( std::string file ) {
+        FILE* fp = fopen(file.c_str(), "rb");
+        if (!fp)
+            snapshotError("unable to open snapshot file for reading", file);
+
+        char magic[8];
+        uint64_t header[2];
+        if (fread(magic, 1, 8, fp) != 8 || memcmp(magic, snapshotMagic(), 8) != 0 || fread(header, sizeof(uint64_t), 2, fp) != 2 || header[0] == 0) {
+            fclose(fp);
+            snapshotError("not a valid snapshot file", file);
+        }
+
+        std::vector<uint8_t> buffer(header[0]);
+        for (uint64_t i = 0; i < header[1]; i++) {
+            uint64_t pageNum;
+            if (fread(&pageNum, sizeof(uint64_t), 1, fp) != 1 || fread(buffer.data(), 1, buffer.size(), fp) != buffer.size()) {
+                fclose(fp);
+                snapshotError("snapshot file is truncated", file);
+            }
+            set(pageNum * header[0], buffer.size(), buffer.data());
+        }
+        fclose(fp);
+    }
+
+private:
+    static const unsigned int DirBits = 12;             // Each second-level table covers 4096 pages
+    static const size_t DirSize = (size_t)1 << DirBits;
+    static const size_t MaxDirEntries = (size_t)1 << 24; // Caps the top level at 128MB of pointers
+    static const size_t HugePageSize = (size_t)1 << 21;
+    static const char* snapshotMagic() { return "SSTMEMPG"; }
+
+    uint8_t* getPage(Addr pageNum, bool alloc) {
+        Addr top = pageNum >> DirBits;
+        if (top >= m_dir.size()) {
+            if (!alloc) return nullptr;
+            if (top >= MaxDirEntries) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "BackingSparse: Error - address 0x%" PRIx64 " is beyond the range supported with %zu byte pages. Use a larger backing_size_unit.\n",
+                        (uint64_t)(pageNum << m_pageShift), m_pageSize);
+            }
+            m_dir.resize(top + 1, nullptr);
+        }
+        uint8_t** table = m_dir[top];
+        if (!table) {
+            if (!alloc) return nullptr;
+            table = m_dir[top] = new uint8_t*[DirSize]();
+        }
+        uint8_t*& page = table[pageNum & (DirSize - 1)];
+        if (!page && alloc)
+            page = allocPage();
+        return page;
+    }
+
+    uint8_t* allocPage() {
+        uint8_t* page;
+        if (m_useMmap) {
+            page = (uint8_t*)mmap(NULL, m_pageSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+            if (page == MAP_FAILED) page = nullptr;
+#ifdef MADV_HUGEPAGE
+            if (page) madvise(page, m_pageSize, MADV_HUGEPAGE);
+#endif
+        } else {
+            page = (uint8_t*)calloc(1, m_pageSize);
+        }
+        if (!page) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to allocate a %zu byte page.\n", m_pageSize);
+        }
+        m_populated++;
+        return page;
+    }
+
+    void freePage(uint8_t* page) {
+        if (m_useMmap)
+            munmap(page, m_pageSize);
+        else
+            free(page);
+    }
+
+    void snapshotError(const char* msg, std::string& file) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.fatal(CALL_INFO, -1, "BackingSparse: Error - %s: '%s'.\n", msg, file.c_str());
+    }
+
+    std::vector<uint8_t**> m_dir;   // Top level of the page directory, grown on demand
+    size_t m_pageSize;
+    unsigned int m_pageShift;
+    bool m_useMmap;
+    uint64_t m_populated;
+};
+
 }
 }
 }
@@ -15,6 +15,8 @@
 
 
 #include <sst_config.h>
+#include <algorithm>
+
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memoryController.h"
 #include "membackend/memBackendConvertor.h"
@@ -31,7 +33,7 @@ using namespace SST::MemHierarchy;
 
 
 MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBackend* backend, uint32_t request_width) :
-    SubComponent(id), m_cycleCount(0), m_reqId(0), m_backend(backend)
+    SubComponent(id), m_cycleCount(0), m_slots(1), m_numPending(0), m_backend(backend)
 {
     m_dbg.init("",
             params.find<uint32_t>("debug_level", 0),
@@ -86,10 +88,69 @@ void MemBackendConvertor::handleMemEvent(  MemEvent* ev ) {
 }
 
 void MemBackendConvertor::handleCustomEvent( CustomCmdInfo * info) {
+    if (info->usesAccesses()) {
+        issueBulk(new BulkCmd(info));
+        return;
+    }
+
     uint32_t id = genReqId();
     CustomReq* req = new CustomReq( info, id );
+    m_slots[id].req = req;
     m_requestQueue.push_back( req );
-    m_pendingRequests[id] = req;
+}
+
+/* Next line access for a bulk command; consecutive accesses to the same line are merged */
+bool MemBackendConvertor::nextBulkAccess( BulkCmd* cmd, Addr& line, bool& write ) {
+    std::vector<CustomCmdInfo::AccessRange>& ranges = cmd->info->getAccessRanges();
+    while (cmd->range < ranges.size()) {
+        CustomCmdInfo::AccessRange& range = ranges[cmd->range];
+        if (cmd->elem == range.count) {
+            cmd->range++;
+            cmd->elem = 0;
+            continue;
+        }
+
+        Addr base = range.start + cmd->elem * range.stride;
+        Addr addr = base + cmd->offset;
+        Addr lineAddr = addr - (addr % m_frontendRequestWidth);
+        Addr nextLine = lineAddr + m_frontendRequestWidth;
+        if (nextLine >= base + range.bytes) {
+            cmd->elem++;
+            cmd->offset = 0;
+        } else {
+            cmd->offset = nextLine - base;
+        }
+
+        if (cmd->started && lineAddr == cmd->lastLine && range.write == cmd->lastWrite)
+            continue;
+        cmd->started = true;
+        cmd->lastLine = lineAddr;
+        cmd->lastWrite = range.write;
+        line = lineAddr;
+        write = range.write;
+        return true;
+    }
+    return false;
+}
+
+/* Queue the command's accesses up to its in-flight limit, and respond once all have completed */
+void MemBackendConvertor::issueBulk( BulkCmd* cmd ) {
+    Addr line;
+    bool write;
+    uint32_t max = cmd->info->getMaxOutstanding();
+    while ((max == 0 || cmd->inFlight < max) && nextBulkAccess(cmd, line, write)) {
+        MemEvent* ev = new MemEvent(getName(), line, line, write ? Command::PutM : Command::GetS, m_frontendRequestWidth);
+        ev->setDeliveryTime(m_cycleCount);
+        setupMemReq(ev, cmd);
+        cmd->inFlight++;
+    }
+
+    if (cmd->inFlight == 0) {
+        CustomCmdInfo* info = cmd->info;
+        sendResponse(info->getID(), info->getFlags());
+        delete info;
+        delete cmd;
+    }
 }
 
 bool MemBackendConvertor::clock(Cycle_t cycle) {
@@ -118,6 +179,8 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
 
         if ( req->issueDone() ) {
             Debug(_L10_, "Completed issue of request\n");
+            if ( req->isMemEv() )
+                dequeueLine( static_cast<MemReq*>(req) );
             m_requestQueue.pop_front();
         }
     }
@@ -125,7 +188,7 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
     if (cycleWithIssue)
         stat_cyclesWithIssue->addData(1);
 
-    stat_outstandingReqs->addData( m_pendingRequests.size() );
+    stat_outstandingReqs->addData( m_numPending );
 
     bool unclock = !m_clockBackend;
     if (m_clockBackend)
@@ -147,7 +210,7 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
 void MemBackendConvertor::turnClockOn(Cycle_t cycle) {
     Cycle_t cyclesOff = cycle - m_cycleCount;
     for (Cycle_t i = 0; i < cyclesOff; i++)
-        stat_outstandingReqs->addData( m_pendingRequests.size() );
+        stat_outstandingReqs->addData( m_numPending );
     m_cycleCount = cycle;
     m_clockOn = true;
 }
@@ -168,18 +231,16 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
     }
 
     uint32_t id = BaseReq::getBaseId(reqId);
-    MemEvent* resp = NULL;
+    BaseReq* req = findReq( id );
 
-    if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+    if ( !req ) {
         m_dbg.fatal(CALL_INFO, -1, "memory request not found; id=%" PRId32 "\n", id);
     }
 
-    BaseReq* req = m_pendingRequests[id];
-
     req->decrement( );
 
     if ( req->isDone() ) {
-        m_pendingRequests.erase(id);
+        BulkCmd* bulk = nullptr;
 
         if (!req->isMemEv()) {
             CustomCmdInfo * info = static_cast<CustomReq*>(req)->getInfo();
@@ -190,34 +251,51 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
         } else {
 
             MemEvent* event = static_cast<MemReq*>(req)->getMemEvent();
+            bulk = m_slots[id].bulk;
 
             Debug(_L10_,"doResponse req is done. %s\n", event->getBriefString().c_str());
 
-            Cycle_t latency = m_cycleCount - event->getDeliveryTime();
+            if (!bulk) {
+                Cycle_t latency = m_cycleCount - event->getDeliveryTime();
 
-            doResponseStat( event->getCmd(), latency );
+                doResponseStat( event->getCmd(), latency );
 
-            if (!flags) flags = event->getFlags();
-            SST::Event::id_type evID = event->getID();
-            sendResponse(event->getID(), flags); // Needs to occur before a flush is completed since flush is dependent
+                if (!flags) flags = event->getFlags();
+                sendResponse(event->getID(), flags); // Needs to occur before a flush is completed since flush is dependent
+            }
 
             // TODO clock responses
             // Check for flushes that are waiting on this event to finish
-            if (m_dependentRequests.find(evID) != m_dependentRequests.end()) {
-                std::set<MemEvent*, memEventCmp> flushes = m_dependentRequests.find(evID)->second;
-
-                for (std::set<MemEvent*, memEventCmp>::iterator it = flushes.begin(); it != flushes.end(); it++) {
-                    (m_waitingFlushes.find(*it)->second).erase(evID);
-                    if ((m_waitingFlushes.find(*it)->second).empty()) {
-                        MemEvent * flush = *it;
-                        sendResponse(flush->getID(), (flush->getFlags() | MemEvent::F_SUCCESS));
-                        m_waitingFlushes.erase(flush);
-                    }
-                }
-                m_dependentRequests.erase(evID);
-            }
+            if (!m_slots[id].flushes.empty())
+                completeFlushes(id);
+
+            if (bulk)
+                delete event;
         }
+        releaseReqId(id);
         delete req;
+
+        if (bulk) {
+            bulk->inFlight--;
+            issueBulk(bulk);
+        }
+    }
+}
+
+/* Request 'id' is done; respond to any flushes that were only waiting on it, in event ID order */
+void MemBackendConvertor::completeFlushes( uint32_t id ) {
+    std::vector<FlushWait*> done;
+    for (std::vector<FlushWait*>::iterator it = m_slots[id].flushes.begin(); it != m_slots[id].flushes.end(); it++) {
+        if (--(*it)->remaining == 0)
+            done.push_back(*it);
+    }
+
+    std::sort(done.begin(), done.end(), [](FlushWait* a, FlushWait* b) { return a->flush->getID() < b->flush->getID(); });
+
+    for (std::vector<FlushWait*>::iterator it = done.begin(); it != done.end(); it++) {
+        MemEvent * flush = (*it)->flush;
+        sendResponse(flush->getID(), (flush->getFlags() | MemEvent::F_SUCCESS));
+        delete *it;
     }
 }
 
@@ -22,6 +22,8 @@
 #include <sst/core/warnmacros.h>
 
 #include "sst/elements/memHierarchy/memEvent.h"
+#include "sst/elements/memHierarchy/addrHashMap.h"
+#include "sst/elements/memHierarchy/ringBuffer.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
 
 namespace SST {
@@ -157,12 +159,12 @@ class MemBackendConvertor : public SubComponent {
     virtual bool isBackendClocked() { return m_clockBackend; }
 
     virtual const std::string getRequestor( ReqId reqId ) {
-        uint32_t id = BaseReq::getBaseId(reqId);
-        if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+        BaseReq* req = findReq( BaseReq::getBaseId(reqId) );
+        if ( !req ) {
             m_dbg.fatal(CALL_INFO, -1, "memory request not found\n");
         }
 
-        return m_pendingRequests[id]->getRqstr();
+        return req->getRqstr();
     }
 
     virtual void setCallbackHandlers(std::function<void(Event::id_type,uint32_t)> responseCB, std::function<Cycle_t()> clockenableCB);
@@ -172,10 +174,13 @@ class MemBackendConvertor : public SubComponent {
     // such that all the requests are consolidated in one place
   protected:
     virtual ~MemBackendConvertor() {
-        while ( m_requestQueue.size()) {
-            delete m_requestQueue.front();
-            m_requestQueue.pop_front();
+        std::set<FlushWait*> flushes;
+        for ( std::vector<ReqSlot>::iterator it = m_slots.begin(); it != m_slots.end(); it++ ) {
+            delete it->req;
+            flushes.insert(it->flushes.begin(), it->flushes.end());
         }
+        for ( std::set<FlushWait*>::iterator it = flushes.begin(); it != flushes.end(); it++ )
+            delete *it;
     }
 
     void doResponse( ReqId reqId, uint32_t flags = 0 );
@@ -192,39 +197,67 @@ class MemBackendConvertor : public SubComponent {
 
 
 
-    bool setupMemReq( MemEvent* ev ) {
+    /* A custom command charged as the line reads and writes it makes (CustomCmdInfo::usesAccesses) */
+    struct BulkCmd {
+        BulkCmd(CustomCmdInfo* i) : info(i), range(0), elem(0), offset(0), lastLine(0), lastWrite(false), started(false), inFlight(0) { }
+        CustomCmdInfo* info;
+        size_t range;       // Position of the next access: range, element within it, offset within the element
+        uint64_t elem;
+        uint64_t offset;
+        Addr lastLine;      // Last access issued, so an access is not repeated for the next element on the same line
+        bool lastWrite;
+        bool started;
+        uint32_t inFlight;
+    };
+
+    bool nextBulkAccess( BulkCmd* cmd, Addr& line, bool& write );
+    void issueBulk( BulkCmd* cmd );
+
+    /* A flush waits for every request to its line that was still queued when it arrived */
+    bool setupMemReq( MemEvent* ev, BulkCmd* bulk = nullptr ) {
         if ( Command::FlushLine == ev->getCmd() || Command::FlushLineInv == ev->getCmd() ) {
-            // TODO optimize if this becomes a problem, it is slow
-            std::set<SST::Event::id_type> dependsOn;
-            for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end(); it++) {
-                if (!(*it)->isMemEv())
-                    continue;
-                MemReq * mr = static_cast<MemReq*>(*it);
-                if (mr->baseAddr() == ev->getBaseAddr()) {
-                    MemEvent * req = mr->getMemEvent();
-                    dependsOn.insert(req->getID());
-                    if (m_dependentRequests.find(req->getID()) == m_dependentRequests.end()) {
-                        std::set<MemEvent*, memEventCmp> flushSet;
-                        flushSet.insert(ev);
-                        m_dependentRequests.insert(std::make_pair(req->getID(), flushSet));
-                    } else {
-                        (m_dependentRequests.find(req->getID())->second).insert(ev);
-                    }
-                }
-            }
+            AddrHashMap<LineQueue>::iterator line = m_queuedLines.find(ev->getBaseAddr());
+            if (line == m_queuedLines.end()) return false;
 
-            if (dependsOn.empty()) return false;
-            m_waitingFlushes.insert(std::make_pair(ev, dependsOn));
+            FlushWait* wait = new FlushWait(ev);
+            for (uint32_t id = line->second.head; id != NoSlot; id = m_slots[id].nextInLine) {
+                m_slots[id].flushes.push_back(wait);
+                wait->remaining++;
+            }
             return true;
         }
 
         uint32_t id = genReqId();
         MemReq* req = new MemReq( ev, id );
+        m_slots[id].req = req;
+        m_slots[id].bulk = bulk;
         m_requestQueue.push_back( req );
-        m_pendingRequests[id] = req;
+
+        AddrHashMap<LineQueue>::iterator line = m_queuedLines.find(ev->getBaseAddr());
+        if (line == m_queuedLines.end()) {
+            LineQueue& queue = m_queuedLines[ev->getBaseAddr()];
+            queue.head = id;
+            queue.tail = id;
+        } else {
+            m_slots[line->second.tail].nextInLine = id;
+            line->second.tail = id;
+        }
         return true;
     }
 
+    /* Request has issued completely and left the request queue, which is FIFO per line too */
+    void dequeueLine( MemReq* req ) {
+        uint32_t id = BaseReq::getBaseId(req->id());
+        AddrHashMap<LineQueue>::iterator line = m_queuedLines.find(req->baseAddr());
+        if (m_slots[id].nextInLine == NoSlot)
+            m_queuedLines.erase(line);
+        else
+            line->second.head = m_slots[id].nextInLine;
+        m_slots[id].nextInLine = NoSlot;
+    }
+
+    void completeFlushes( uint32_t id );
+
     inline void doClockStat( ) {
         stat_totalCycles->addData(1);
     }
@@ -277,18 +310,61 @@ class MemBackendConvertor : public SubComponent {
     std::function<Cycle_t()> m_enableClock; // Re-enable parent's clock
     std::function<void(Event::id_type id, uint32_t)> m_notifyResponse; // notify parent of response
 
-    uint32_t genReqId( ) { return ++m_reqId; }
+    /*
+     * Request IDs index m_slots directly and are recycled once a request completes,
+     * so the table stays as large as the peak number of outstanding requests.
+     * ID 0 is never handed out.
+     */
+    static const uint32_t NoSlot = 0xFFFFFFFF;
+
+    struct FlushWait {
+        FlushWait(MemEvent* ev) : flush(ev), remaining(0) { }
+        MemEvent* flush;
+        uint32_t remaining;     // Requests still to complete before the flush is done
+    };
 
-    uint32_t m_reqId;
+    struct ReqSlot {
+        ReqSlot() : req(nullptr), nextInLine(NoSlot), bulk(nullptr) { }
+        BaseReq* req;
+        uint32_t nextInLine;                // Next queued request to the same line
+        BulkCmd* bulk;                      // Custom command this access was made for, if any
+        std::vector<FlushWait*> flushes;    // Flushes waiting on this request
+    };
 
-    typedef std::map<uint32_t,BaseReq*> PendingRequests;
+    struct LineQueue {
+        uint32_t head;  // Oldest queued request to the line
+        uint32_t tail;  // Newest
+    };
 
-    std::deque<BaseReq*>    m_requestQueue;
-    PendingRequests         m_pendingRequests;
-    uint32_t                m_frontendRequestWidth;
+    uint32_t genReqId( ) {
+        m_numPending++;
+        if (m_freeSlots.empty()) {
+            m_slots.push_back(ReqSlot());
+            return m_slots.size() - 1;
+        }
+        uint32_t id = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return id;
+    }
 
-    std::map<MemEvent*, std::set<SST::Event::id_type> > m_waitingFlushes; // Set of request IDs for each flush
-    std::map<SST::Event::id_type, std::set<MemEvent*, memEventCmp> > m_dependentRequests; // Reverse map, set of flushes for each request ID, for faster lookup
+    void releaseReqId( uint32_t id ) {
+        m_slots[id].req = nullptr;
+        m_slots[id].bulk = nullptr;
+        m_slots[id].flushes.clear();
+        m_freeSlots.push_back(id);
+        m_numPending--;
+    }
+
+    BaseReq* findReq( uint32_t id ) {
+        return id < m_slots.size() ? m_slots[id].req : nullptr;
+    }
+
+    RingBuffer<BaseReq*>    m_requestQueue;
+    std::vector<ReqSlot>    m_slots;
+    std::vector<uint32_t>   m_freeSlots;
+    uint32_t                m_numPending;
+    AddrHashMap<LineQueue>  m_queuedLines;      // Requests in m_requestQueue by line
+    uint32_t                m_frontendRequestWidth;
 
     Statistic<uint64_t>* stat_GetSLatency;
     Statistic<uint64_t>* stat_GetSXLatency;
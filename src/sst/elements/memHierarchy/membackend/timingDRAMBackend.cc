@@ -58,10 +58,23 @@ void TimingDRAM::build(Params& params) {
 
     m_mapper->setNumChannels( numChannels );
 
+    /* Scheduler statistics exist only when there is a scheduler to report on */
+    SchedStats* stats = nullptr;
+    if ( params.find<std::string>("channel.scheduler", "bank") == "frfcfs" ) {
+        m_schedStats.rowHit          = registerStatistic<uint64_t>("row_already_open");
+        m_schedStats.rowMissNoRP     = registerStatistic<uint64_t>("no_row_open");
+        m_schedStats.rowMissRP       = registerStatistic<uint64_t>("wrong_row_open");
+        m_schedStats.turnarounds     = registerStatistic<uint64_t>("bus_turnarounds");
+        m_schedStats.writeDrains     = registerStatistic<uint64_t>("write_drains");
+        m_schedStats.readQueueDepth  = registerStatistic<uint64_t>("read_queue_depth");
+        m_schedStats.writeQueueDepth = registerStatistic<uint64_t>("write_queue_depth");
+        stats = &m_schedStats;
+    }
+
     tmpParams = params.find_prefix_params("channel." );
     for ( unsigned i=0; i < numChannels; i++ ) {
         using std::placeholders::_1;
-        m_channels.push_back(loadComponentExtension<Channel>( std::bind(&TimingDRAM::handleResponse, this, _1), tmpParams, id, i, output, m_mapper ));
+        m_channels.push_back(loadComponentExtension<Channel>( std::bind(&TimingDRAM::handleResponse, this, _1), tmpParams, id, i, output, m_mapper, stats ));
     }
 }
 
@@ -93,8 +106,9 @@ bool TimingDRAM::clock(Cycle_t cycle)
 // Channel
 //==================================================================================
 
-TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handler, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0)
+TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handler, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper, SchedStats* stats ) :
+    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0),
+    m_sched(nullptr), m_lastColWrite(-1)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Channel:@p():@l:mc=" << mc << ":chan=" << myNum << ": ";
@@ -105,6 +119,25 @@ TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handl
 
     m_pendingCount = 0;
 
+    std::string scheduler = params.find<std::string>("scheduler", "bank");
+    if ( scheduler == "frfcfs" ) {
+        m_sched = new Scheduler();
+        m_sched->drainWrites = false;
+        m_sched->queuedReads = 0;
+        m_sched->queuedWrites = 0;
+        m_sched->writeHigh = params.find<unsigned>("write_high_watermark", (m_maxPendingTrans * 3) / 4);
+        m_sched->writeLow = params.find<unsigned>("write_low_watermark", m_maxPendingTrans / 4);
+        m_sched->rowHitCap = params.find<unsigned>("row_hit_cap", 4);
+        m_sched->stats = stats;
+
+        if ( m_sched->writeHigh == 0 || m_sched->writeLow >= m_sched->writeHigh ) {
+            m_output->fatal(CALL_INFO, -1, "Invalid param(channel): write_low_watermark (%u) must be less than write_high_watermark (%u) and write_high_watermark must be greater than 0.\n",
+                    m_sched->writeLow, m_sched->writeHigh);
+        }
+    } else if ( scheduler != "bank" ) {
+        m_output->fatal(CALL_INFO, -1, "Invalid param(channel): scheduler, '%s'. Options are 'bank' and 'frfcfs'.\n", scheduler.c_str());
+    }
+
     m_mapper->setNumRanks( numRanks );
 
     if (m_printConfig)
@@ -112,15 +145,42 @@ TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handl
     if ( m_printConfig ) {
         m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "max pending trans: %d\n",m_maxPendingTrans);
         m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "number of ranks:   %d\n",numRanks);
+        m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "scheduler:         %s\n",scheduler.c_str());
+        if ( m_sched ) {
+            m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "write watermarks:  %u/%u\n",m_sched->writeLow, m_sched->writeHigh);
+            m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "row hit cap:       %u\n",m_sched->rowHitCap);
+        }
         m_printConfig = false;
     }
 
     Params tmpParams = params.find_prefix_params("rank." );
     for ( unsigned i=0; i<numRanks; i++ ) {
-        m_ranks.push_back( loadComponentExtension<Rank>( tmpParams, mc, myNum, i, output, mapper ) );
+        m_ranks.push_back( loadComponentExtension<Rank>( tmpParams, mc, myNum, i, output, mapper, m_sched ) );
     }
 }
 
+/* Switch between serving reads and draining writes */
+void TimingDRAM::Channel::updateMode()
+{
+    if ( m_sched->drainWrites ) {
+        if ( m_sched->queuedWrites == 0 || ( m_sched->queuedWrites <= m_sched->writeLow && m_sched->queuedReads != 0 ) ) {
+            m_sched->drainWrites = false;
+            if (is_debug)
+                m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK, "end write drain: reads=%u writes=%u\n",
+                        m_sched->queuedReads, m_sched->queuedWrites);
+        }
+    } else if ( m_sched->queuedWrites >= m_sched->writeHigh || ( m_sched->queuedReads == 0 && m_sched->queuedWrites != 0 ) ) {
+        m_sched->drainWrites = true;
+        m_sched->stats->writeDrains->addData(1);
+        if (is_debug)
+            m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK, "start write drain: reads=%u writes=%u\n",
+                    m_sched->queuedReads, m_sched->queuedWrites);
+    }
+
+    m_sched->stats->readQueueDepth->addData(m_sched->queuedReads);
+    m_sched->stats->writeQueueDepth->addData(m_sched->queuedWrites);
+}
+
 void TimingDRAM::Channel::clock( SimTime_t cycle )
 {
     if (is_debug)
@@ -161,6 +221,9 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
         m_pendingCount--;
     }
 
+    if ( m_sched )
+        updateMode();
+
     /* For each rank, check if there's a command to issue */
     Cmd* cmd = popCmd( cycle, m_dataBusAvailCycle );
     if ( cmd ) {
@@ -170,6 +233,13 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
 
         m_dataBusAvailCycle = cmd->issue();
 
+        if ( m_sched && cmd->getTrans() ) {
+            int isWrite = cmd->getTrans()->isWrite ? 1 : 0;
+            if ( m_lastColWrite != -1 && m_lastColWrite != isWrite )
+                m_sched->stats->turnarounds->addData(1);
+            m_lastColWrite = isWrite;
+        }
+
         m_issuedCmds.push_back(cmd);
     }
 }
@@ -206,8 +276,9 @@ TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBus
 // Rank
 //==================================================================================
 
-TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0)
+TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned myNum, Output* output, AddrMapper* mapper, Scheduler* sched ) :
+    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0), m_sched( sched ),
+    m_banksActive(0), m_banksBusy(0), m_readReady(0), m_writeReady(0)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Rank:@p():@l:mc=" << mc << ":chan=" << chan << ":rank=" << myNum <<": ";
@@ -215,6 +286,10 @@ TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned
 
     int banks = params.find<int>("numBanks", 8);
 
+    if ( banks < 1 || banks > 64 ) {
+        m_output->fatal(CALL_INFO, -1, "Invalid param(rank): numBanks, '%d'. Must be between 1 and 64.\n", banks);
+    }
+
     m_mapper->setNumBanks( banks );
 
     if (m_printConfig)
@@ -226,7 +301,7 @@ TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned
 
     Params tmpParams = params.find_prefix_params("bank." );
     for ( unsigned i=0; i<banks; i++ ) {
-        m_banks.push_back( loadComponentExtension<Bank>( tmpParams, mc, chan, myNum, i, output ) );
+        m_banks.push_back( loadComponentExtension<Bank>( tmpParams, mc, chan, myNum, i, output, sched ) );
     }
 }
 
@@ -235,37 +310,59 @@ TimingDRAM::Cmd* TimingDRAM::Rank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
     if (is_debug)
         m_output->verbosePrefix(prefix(),CALL_INFO, 5, DBG_MASK, "\n" );
 
-    unsigned current = m_nextBankUp;
-    for ( unsigned i = 0; i < m_banks.size(); i++ ) {
-        if (m_banksActive.find(current) != m_banksActive.end()) {
-            Cmd* cmd = m_banks[current]->popCmd( cycle, dataBusAvailCycle );
+    /* Under frfcfs only banks with commands pending or transactions of the type being served can issue */
+    uint64_t candidates = m_banksActive;
+    if ( m_sched )
+        candidates = m_banksBusy | ( m_sched->drainWrites ? m_writeReady : m_readReady );
 
-            if (m_banks[current]->isIdle())
-                m_banksActive.erase(current);
+    /* Visit candidates in round-robin order starting at m_nextBankUp */
+    uint64_t upper = candidates & (~(uint64_t)0 << m_nextBankUp);
+    uint64_t lower = candidates & ~upper;
 
-            if ( cmd ) {
-                if ( current == m_nextBankUp ) {
-                    ++m_nextBankUp;
-                    m_nextBankUp %= m_banks.size();
-                    if (is_debug)
-                        m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK, "rank %d next up\n",m_nextBankUp);
-                }
-                return cmd;
+    while ( upper | lower ) {
+        uint64_t& bits = upper ? upper : lower;
+        unsigned current = __builtin_ctzll(bits);
+        bits &= bits - 1;
+
+        Cmd* cmd = m_banks[current]->popCmd( cycle, dataBusAvailCycle );
+
+        updateReady(current);
+
+        if ( cmd ) {
+            if ( current == m_nextBankUp ) {
+                ++m_nextBankUp;
+                m_nextBankUp %= m_banks.size();
+                if (is_debug)
+                    m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK, "rank %d next up\n",m_nextBankUp);
             }
+            return cmd;
         }
-
-        ++current;
-        current %= m_banks.size();
     }
     return nullptr;
 }
 
+void TimingDRAM::Rank::updateReady( unsigned bank )
+{
+    uint64_t bit = (uint64_t)1 << bank;
+    Bank* b = m_banks[bank];
+
+    if ( b->isIdle() )
+        m_banksActive &= ~bit;
+
+    if ( m_sched ) {
+        m_banksBusy = b->needsPoll() ? (m_banksBusy | bit) : (m_banksBusy & ~bit);
+        m_readReady = b->hasReads() ? (m_readReady | bit) : (m_readReady & ~bit);
+        m_writeReady = b->hasWrites() ? (m_writeReady | bit) : (m_writeReady & ~bit);
+    }
+}
+
 //==================================================================================
 // Bank
 //==================================================================================
 
-TimingDRAM::Bank::Bank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned rank, unsigned myNum, Output* output ) :
-    ComponentExtension(id), m_output( output ), m_lastCmd(nullptr), m_bank(myNum), m_rank(rank), m_row( -1 )
+TimingDRAM::Bank::Bank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned rank, unsigned myNum, Output* output, Scheduler* sched ) :
+    ComponentExtension(id), m_output( output ), m_lastCmd(nullptr), m_bank(myNum), m_rank(rank), m_row( -1 ),
+    m_transQ(nullptr), m_sched( sched ), m_hitStreak(0)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Bank:@p():@l:mc=" << mc << ":chan=" << chan << ":rank=" << rank << ":bank=" << myNum <<": ";
@@ -277,12 +374,15 @@ TimingDRAM::Bank::Bank( ComponentId_t id, Params& params, unsigned mc, unsigned
     m_trp_lat = params.find<unsigned int>("TRP", 11);
     m_data_lat = params.find<unsigned int>("dataCycles", 4);
 
-    std::string name = params.find<std::string>("transactionQ", "memHierarchy.fifoTransactionQ");
-    Params tmpParams = params.find_prefix_params("transactionQ." );
-    m_transQ = loadAnonymousSubComponent<TransactionQ>(name, "transactionQ", 0, ComponentInfo::INSERT_STATS, tmpParams);
+    /* The frfcfs scheduler orders transactions itself */
+    std::string name = m_sched ? "frfcfs" : params.find<std::string>("transactionQ", "memHierarchy.fifoTransactionQ");
+    if ( ! m_sched ) {
+        Params tmpParams = params.find_prefix_params("transactionQ." );
+        m_transQ = loadAnonymousSubComponent<TransactionQ>(name, "transactionQ", 0, ComponentInfo::INSERT_STATS, tmpParams);
+    }
 
     std::string ppName = params.find<std::string>("pagePolicy", "memHierarchy.simplePagePolicy");
-    tmpParams = params.find_prefix_params("pagePolicy." );
+    Params tmpParams = params.find_prefix_params("pagePolicy." );
     m_pagePolicy = loadAnonymousSubComponent<PagePolicy>(ppName, "pagePolicy", 0, ComponentInfo::INSERT_STATS, tmpParams);
 
     if (m_printConfig)
@@ -325,7 +425,15 @@ void TimingDRAM::Bank::update( SimTime_t current )
         return;
     }
 
-    Transaction* trans = m_transQ->pop(m_row);
+    Transaction* trans;
+    if ( m_sched ) {
+        /* Choose once the previous transaction's commands are out so the open row is known */
+        if ( ! m_cmdQ.empty() )
+            return;
+        trans = pickTrans();
+    } else {
+        trans = m_transQ->pop(m_row);
+    }
 
     if ( ! trans ) {
         return;
@@ -335,6 +443,48 @@ void TimingDRAM::Bank::update( SimTime_t current )
         m_output->verbosePrefix(prefix(),CALL_INFO, 2, DBG_MASK, "addr=%#" PRIx64 " current row=%d trans row=%d, time=%" PRIu64 "\n",
                 trans->addr, m_row, trans->row, trans->createTime );
 
+    pushCmds( trans );
+}
+
+/*
+ * Take the oldest transaction of the type the channel is serving, preferring
+ * the oldest one to the open row. At most rowHitCap row hits in a row may
+ * bypass an older transaction so that a stream of hits cannot starve it.
+ */
+Transaction* TimingDRAM::Bank::pickTrans()
+{
+    std::deque<Transaction*>& queue = m_sched->drainWrites ? m_writes : m_reads;
+    if ( queue.empty() )
+        return nullptr;
+
+    std::deque<Transaction*>::iterator pick = queue.begin();
+    if ( m_row != -1 && m_hitStreak < m_sched->rowHitCap ) {
+        std::deque<Transaction*>::iterator iter = queue.begin();
+        while ( iter != queue.end() && (*iter)->row != m_row )
+            ++iter;
+        if ( iter != queue.end() )
+            pick = iter;
+    }
+
+    m_hitStreak = ( pick == queue.begin() ) ? 0 : m_hitStreak + 1;
+
+    Transaction* trans = *pick;
+    queue.erase(pick);
+
+    ( trans->isWrite ? m_sched->queuedWrites : m_sched->queuedReads )--;
+
+    if ( m_row == -1 )
+        m_sched->stats->rowMissNoRP->addData(1);
+    else if ( trans->row == m_row )
+        m_sched->stats->rowHit->addData(1);
+    else
+        m_sched->stats->rowMissRP->addData(1);
+
+    return trans;
+}
+
+void TimingDRAM::Bank::pushCmds( Transaction* trans )
+{
     Cmd* cmd;
 
     if ( trans->row != m_row ) {
@@ -14,6 +14,7 @@
 #define _H_SST_MEMH_TIMING_DRAM_BACKEND
 
 #include <queue>
+#include <deque>
 
 #include <sst/core/componentExtension.h>
 
@@ -44,15 +45,29 @@ public:
             {"channels", "Number of channels", "1"},
             {"channel.numRanks", "Number of ranks per channel", "1"},
             {"channel.transaction_Q_size", "Size of transaction queue", "32"},
+            {"channel.scheduler", "Transaction scheduling: 'bank' issues each bank's transactions in the order its transactionQ returns them; 'frfcfs' schedules row hits first and batches writes using the watermarks below", "bank"},
+            {"channel.write_high_watermark", "frfcfs: number of queued writes at which the channel switches to draining writes", "3/4 of transaction_Q_size"},
+            {"channel.write_low_watermark", "frfcfs: number of queued writes at which a write drain ends if reads are waiting", "1/4 of transaction_Q_size"},
+            {"channel.row_hit_cap", "frfcfs: maximum consecutive row hits a bank serves ahead of an older request to another row", "4"},
             {"channel.rank.numBanks", "Number of banks per rank", "8"},
             {"channel.rank.bank.CL", "Column access latency in cycles", "11"},
             {"channel.rank.bank.CL_WR", "Column write latency", "11"},
             {"channel.rank.bank.RCD", "Row access latency in cycles", "11"},
             {"channel.rank.bank.TRP", "Precharge delay in cycles", "11"},
             {"channel.rank.bank.dataCycles", "", "4"},
-            {"channel.rank.bank.transactionQ", "Transaction queue model (subcomponent)", "memHierarchy.fifoTransactionQ"},
+            {"channel.rank.bank.transactionQ", "Transaction queue model (subcomponent), not used by the frfcfs scheduler", "memHierarchy.fifoTransactionQ"},
             {"channel.rank.bank.pagePolicy", "Policy subcomponent for managing row buffer", "memHierarchy.simplePagePolicy"})
 
+    /* Registered only when channel.scheduler is frfcfs */
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"row_already_open",    "Number of transactions that found their row open", "count", 1},
+            {"no_row_open",         "Number of transactions that found no row open", "count", 1},
+            {"wrong_row_open",      "Number of transactions that found another row open", "count", 1},
+            {"bus_turnarounds",     "Number of read-to-write and write-to-read switches on the data bus", "count", 2},
+            {"write_drains",        "Number of times a channel switched to draining writes", "count", 2},
+            {"read_queue_depth",    "Reads queued at a channel, sampled each cycle", "requests", 3},
+            {"write_queue_depth",   "Writes queued at a channel, sampled each cycle", "requests", 3} )
+
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
             {"transactionQ", "Transaction queue model", "SST::MemHierarchy::TimingDRAM_NS::TransactionQ"},
             {"pagePolicy", "Policy subcomponent for managing row buffer", "SST::MemHierarchy::TimingDRAM_NS::PagePolicy"} )
@@ -63,16 +78,46 @@ private:
 
     class Cmd;
 
+    struct SchedStats {
+        Statistic<uint64_t>* rowHit;
+        Statistic<uint64_t>* rowMissNoRP;
+        Statistic<uint64_t>* rowMissRP;
+        Statistic<uint64_t>* turnarounds;
+        Statistic<uint64_t>* writeDrains;
+        Statistic<uint64_t>* readQueueDepth;
+        Statistic<uint64_t>* writeQueueDepth;
+    };
+
+    /*
+     * Channel-wide state for the frfcfs scheduler, shared with the channel's banks.
+     * Banks take transactions of the type being served (reads, or writes while
+     * draining), row hits first. The channel switches to draining writes at the
+     * high watermark, or when no reads are queued, and back once writes fall to
+     * the low watermark with reads waiting, so bus turnarounds come in batches.
+     */
+    struct Scheduler {
+        bool        drainWrites;
+        unsigned    queuedReads;
+        unsigned    queuedWrites;
+        unsigned    writeHigh;
+        unsigned    writeLow;
+        unsigned    rowHitCap;
+        SchedStats* stats;
+    };
+
     class Bank : public ComponentExtension {
 
         static bool m_printConfig;
 
       public:
         static const uint64_t DBG_MASK = (1 << 3);
-        Bank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, unsigned bank, Output* );
+        Bank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, unsigned bank, Output*, Scheduler* );
 
         void pushTrans( Transaction* trans ) {
-            m_transQ->push(trans);
+            if ( m_sched )
+                ( trans->isWrite ? m_writes : m_reads ).push_back( trans );
+            else
+                m_transQ->push(trans);
         }
 
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
@@ -100,14 +145,24 @@ private:
         }
 
         bool isIdle() {
-            return (m_row == -1 || !m_pagePolicy->canClose()) && m_cmdQ.empty() && m_transQ->empty();
+            return !needsPoll() && ( m_sched ? m_reads.empty() && m_writes.empty() : m_transQ->empty() );
+        }
+
+        /* Has commands to issue or an open row the page policy may close */
+        bool needsPoll() {
+            return (m_row != -1 && m_pagePolicy->canClose()) || !m_cmdQ.empty();
         }
 
+        bool hasReads() { return !m_reads.empty(); }
+        bool hasWrites() { return !m_writes.empty(); }
+
         unsigned getRank() { return m_rank; }
         unsigned getBank() { return m_bank; }
 
       private:
         void update( SimTime_t );
+        Transaction* pickTrans();
+        void pushCmds( Transaction* trans );
         const char* prefix() { return m_pre.c_str(); }
 
         Output*             m_output;
@@ -126,6 +181,12 @@ private:
         std::deque<Cmd*>    m_cmdQ;
         TransactionQ*       m_transQ;
         PagePolicy*         m_pagePolicy;
+
+        // frfcfs only
+        Scheduler*                  m_sched;
+        std::deque<Transaction*>    m_reads;
+        std::deque<Transaction*>    m_writes;
+        unsigned                    m_hitStreak;    // Row hits taken ahead of an older transaction
     };
 
     class Cmd {
@@ -236,7 +297,7 @@ private:
       public:
         static const uint64_t DBG_MASK = (1 << 2);
 
-        Rank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, Output*, AddrMapper* );
+        Rank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, Output*, AddrMapper*, Scheduler* );
 
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
 
@@ -249,11 +310,16 @@ private:
 
             m_banks[bank]->pushTrans( trans );
 
-            m_banksActive.insert(bank);
+            uint64_t bit = (uint64_t)1 << bank;
+            m_banksActive |= bit;
+            if ( trans->isWrite )
+                m_writeReady |= bit;
+            else
+                m_readReady |= bit;
         }
 
         bool hasActiveBanks() {
-            return !m_banksActive.empty();
+            return m_banksActive != 0;
         }
 
       private:
@@ -263,9 +329,17 @@ private:
         AddrMapper*     m_mapper;
         std::string     m_pre;
 
+        void updateReady( unsigned bank );
+
         unsigned            m_nextBankUp;
         std::vector<Bank*>  m_banks;
-        std::set<unsigned>  m_banksActive;
+        Scheduler*          m_sched;
+
+        /* Bank bitmaps: any work pending, commands or page closes pending, reads queued, writes queued */
+        uint64_t            m_banksActive;
+        uint64_t            m_banksBusy;
+        uint64_t            m_readReady;
+        uint64_t            m_writeReady;
     };
 
     class Channel : public ComponentExtension {
@@ -275,7 +349,7 @@ private:
       public:
         static const uint64_t DBG_MASK = (1 << 1);
 
-        Channel( ComponentId_t, std::function<void(ReqId)>, Params&, unsigned mc, unsigned chan, Output*, AddrMapper* );
+        Channel( ComponentId_t, std::function<void(ReqId)>, Params&, unsigned mc, unsigned chan, Output*, AddrMapper*, SchedStats* );
 
         bool issue( SimTime_t createTime, ReqId id, Addr addr, bool isWrite, unsigned numBytes ) {
 
@@ -291,6 +365,8 @@ private:
             Transaction* trans = new Transaction( createTime, id, addr, isWrite, numBytes, m_mapper->getBank(addr),
                                                 m_mapper->getRow(addr) );
             m_pendingCount++;
+            if ( m_sched )
+                ( isWrite ? m_sched->queuedWrites : m_sched->queuedReads )++;
             m_ranks[ rank ]->pushTrans( trans );
             return true;
         }
@@ -299,6 +375,7 @@ private:
 
       private:
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
+        void updateMode();
         const char* prefix() { return m_pre.c_str(); }
         Output*             m_output;
         AddrMapper*         m_mapper;
@@ -315,6 +392,9 @@ private:
         std::queue<Transaction*> m_retiredTrans;
 
         std::function<void(ReqId)> m_responseHandler;
+
+        Scheduler*          m_sched;        // nullptr unless frfcfs
+        int                 m_lastColWrite; // Direction of the last column command, -1 before the first
     };
 
     static bool m_printConfig;
@@ -335,6 +415,7 @@ private:
     std::vector<Channel*> m_channels;
     AddrMapper* m_mapper;
     SimTime_t   m_cycle;
+    SchedStats  m_schedStats;
 
 };
 
@@ -56,6 +56,8 @@ using namespace SST::MemHierarchy;
 /*************************** Memory Controller ********************/
 MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Component(id), backing_(NULL) {
 
+    memId_ = EndpointRegistry::intern(getName());
+
     int debugLevel = params.find<int>("debug_level", 0);
 
     lineSize_ = params.find<uint64_t>("cache_line_size", 64);
@@ -135,8 +137,8 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
     std::string backingType = params.find<std::string>("backing", "mmap", found); /* Default to using an mmap backing store, fall back on malloc */
     backing_ = nullptr;
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -174,7 +176,19 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
         }
     } else if (backingType == "malloc") {
         backing_ = new Backend::BackingMalloc(sizeBytes);
+    } else if (backingType == "sparse") {
+        backing_ = new Backend::BackingSparse(sizeBytes);
+    }
+
+    /* Snapshots of populated memory, for warm-starting functional state */
+    std::string backingInFile = params.find<std::string>("backing_in_file", "");
+    backingOutFile_ = params.find<std::string>("backing_out_file", "");
+    if ((!backingInFile.empty() || !backingOutFile_.empty()) && (!backing_ || !backing_->supportsSnapshot())) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_in_file/backing_out_file require backing = 'sparse'. You specified backing = '%s'\n",
+                getName().c_str(), backingType.c_str());
     }
+    if (!backingInFile.empty())
+        backing_->restore(backingInFile);
 
     /* Clock Handler */
     std::string clockfreq = params.find<std::string>("clock");
@@ -440,17 +454,17 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
     switch (it->second.status) {
         case AccessStatus::MISS_WB:
             /* Write back data to memory */
-            remoteWr = new MemEvent(getName(), blockAddr, blockAddr, Command::PutM, lineSize_);
+            remoteWr = new MemEvent(memId_, blockAddr, blockAddr, Command::PutM, lineSize_);
             readData(remoteWr);
             remoteWr->setFlag(MemEvent::F_NORESPONSE); // Don't send a response to this
-            remoteWr->setDst(link_->findTargetDestination(remoteWr->getBaseAddr()));
+            remoteWr->setDstId(link_->findTargetDestinationId(remoteWr->getBaseAddr()));
             link_->send(remoteWr);
         case AccessStatus::MISS:
             /* Read new data from memory */
             remoteRd = new MemEvent(*ev);
             remoteRd->setCmd(Command::GetS);
-            remoteRd->setSrc(getName());
-            remoteRd->setDst(link_->findTargetDestination(remoteRd->getBaseAddr()));
+            remoteRd->setSrcId(memId_);
+            remoteRd->setDstId(link_->findTargetDestinationId(remoteRd->getBaseAddr()));
             if (remoteRd->queryFlag(MemEvent::F_NORESPONSE))
                 remoteRd->clearFlag(MemEvent::F_NORESPONSE);
             it->second.reqev = remoteRd;
@@ -592,6 +606,8 @@ void MemCacheController::finish(void) {
         Cycle_t cycle = turnClockOn();
         memBackendConvertor_->turnClockOn(cycle);
     }
+    if (!backingOutFile_.empty())
+        backing_->dump(backingOutFile_);
     memBackendConvertor_->finish();
     link_->finish();
 }
@@ -606,7 +622,8 @@ void MemCacheController::writeData(MemEvent* event) {
     if (event->getCmd() == Command::PutM) { /* Write request to memory */
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        const Payload& data = event->getPayload();
+        backing_->set(addr, event->getSize(), data.data());
 
         return;
     }
@@ -614,7 +631,8 @@ void MemCacheController::writeData(MemEvent* event) {
     if (noncacheable && event->getCmd() == Command::GetX) {
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        const Payload& data = event->getPayload();
+        backing_->set(addr, event->getSize(), data.data());
 
         return;
     }
@@ -628,11 +646,10 @@ void MemCacheController::readData(MemEvent* event) {
 
     localAddr = toLocalAddr(localAddr);
 
-    vector<uint8_t> payload;
-    payload.resize(event->getSize(), 0);
+    Payload payload(event->getSize());
 
     if (backing_)
-        backing_->get(localAddr, event->getSize(), payload);
+        backing_->get(localAddr, event->getSize(), payload.data());
 
     event->setPayload(payload);
 }
@@ -680,7 +697,7 @@ void MemCacheController::processInitEvent( MemEventInit* me ) {
         if (is_debug_event(me)) { Debug(_L9_,"Memory init %s - Received GetX for %" PRIx64 " size %zu\n", getName().c_str(), me->getAddr(),me->getPayload().size()); }
         MemEventInit * mEv = me->clone();
         mEv->setSrc(getName());
-        mEv->setDst(link_->findTargetDestination(mEv->getRoutingAddress()));
+        mEv->setDstId(link_->findTargetDestinationId(mEv->getRoutingAddress()));
         link_->sendInitData(mEv);
     }
     delete me;
@@ -42,9 +42,11 @@ public:
             {"num_caches",          "(uint) Total number of memory caches", "1"},\
             {"cache_num",           "(uint) Index of this cache between 0 and num_caches-1", "0"}, \
             {"cache_line_size",     "(uint) Cache line size in bytes", "64"}, \
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
-            {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' - pages allocated on first write, for large sparsely used memories", "mmap"},\
+            {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity. For 'sparse' backing stores, page size (2MiB or larger uses huge pages where available)", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_in_file",     "(string) For 'sparse' backing stores, optional snapshot file to load memory contents from", ""},\
+            {"backing_out_file",    "(string) For 'sparse' backing stores, optional snapshot file to write populated memory to at the end of simulation", ""},\
             {"verbose",             "(uint) Output verbosity for warnings/errors. 0[fatal error only], 1[warnings], 2[full state dump on fatal error]","1"},\
             {"debug",               "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},\
             {"debug_level",         "(uint) Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},\
@@ -148,8 +150,11 @@ protected:
     Output dbg;
     std::set<Addr> DEBUG_ADDR;
 
+    EndpointId memId_;  // This controller, source of the events it builds
+
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    std::string             backingOutFile_;    // Snapshot populated memory here at finish
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
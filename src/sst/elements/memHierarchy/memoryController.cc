@@ -56,6 +56,8 @@ using namespace SST::MemHierarchy;
 /*************************** Memory Controller ********************/
 MemController::MemController(ComponentId_t id, Params &params) : Component(id), backing_(NULL) {
 
+    memId_ = EndpointRegistry::intern(getName());
+
     int debugLevel = params.find<int>("debug_level", 0);
 
     fixupParam( params, "backend", "backendConvertor.backend" );
@@ -254,8 +256,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -293,7 +295,19 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         }
     } else if (backingType == "malloc") {
         backing_ = new Backend::BackingMalloc(sizeBytes);
+    } else if (backingType == "sparse") {
+        backing_ = new Backend::BackingSparse(sizeBytes);
+    }
+
+    /* Snapshots of populated memory, for warm-starting functional state */
+    std::string backingInFile = params.find<std::string>("backing_in_file", "");
+    backingOutFile_ = params.find<std::string>("backing_out_file", "");
+    if ((!backingInFile.empty() || !backingOutFile_.empty()) && (!backing_ || !backing_->supportsSnapshot())) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_in_file/backing_out_file require backing = 'sparse'. You specified backing = '%s'\n",
+                getName().c_str(), backingType.c_str());
     }
+    if (!backingInFile.empty())
+        backing_->restore(backingInFile);
 
     /* Clock Handler */
     std::string clockfreq = params.find<std::string>("clock");
@@ -318,6 +332,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
                     std::bind(static_cast<void(MemController::*)(Addr,std::vector<uint8_t>*)>(&MemController::writeData), this, _1, _2));
         }
     }
+    if (customCommandHandler_)
+        customCommandHandler_->setAddrTranslator(std::bind(&MemController::translateToLocal, this, _1));
 }
 
 void MemController::handleEvent(SST::Event* event) {
@@ -544,6 +560,8 @@ void MemController::finish(void) {
         Cycle_t cycle = turnClockOn();
         memBackendConvertor_->turnClockOn(cycle);
     }
+    if (!backingOutFile_.empty())
+        backing_->dump(backingOutFile_);
     memBackendConvertor_->finish();
     link_->finish();
 }
@@ -556,7 +574,8 @@ void MemController::writeData(MemEvent* event) {
     if (event->getCmd() == Command::PutM) { /* Write request to memory */
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        const Payload& data = event->getPayload();
+        backing_->set(addr, event->getSize(), data.data());
 
         return;
     }
@@ -564,7 +583,8 @@ void MemController::writeData(MemEvent* event) {
     if (noncacheable && event->getCmd() == Command::GetX) {
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        const Payload& data = event->getPayload();
+        backing_->set(addr, event->getSize(), data.data());
 
         return;
     }
@@ -576,11 +596,10 @@ void MemController::readData(MemEvent* event) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
     Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
 
-    vector<uint8_t> payload;
-    payload.resize(event->getSize(), 0);
+    Payload payload(event->getSize());
 
     if (backing_)
-        backing_->get(localAddr, event->getSize(), payload);
+        backing_->get(localAddr, event->getSize(), payload.data());
 
     event->setPayload(payload);
 }
@@ -588,20 +607,18 @@ void MemController::readData(MemEvent* event) {
 
 /* Backing store interactions for custom command subcomponents */
 void MemController::writeData(Addr addr, std::vector<uint8_t> * data) {
-    if (!backing_) return;
+    if (!backing_ || data->empty()) return;
 
-    for (size_t i = 0; i < data->size(); i++)
-        backing_->set(addr + i, data->at(i));
+    backing_->set(addr, data->size(), data->data());
 }
 
 
 void MemController::readData(Addr addr, size_t bytes, std::vector<uint8_t> &data) {
     data.resize(bytes, 0);
 
-    if (!backing_) return;
+    if (!backing_ || bytes == 0) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
+    backing_->get(addr, bytes, data.data());
 }
 
 
@@ -643,7 +660,7 @@ void MemController::processInitEvent( MemEventInit* me ) {
         Addr addr = me->getAddr();
         if (is_debug_event(me)) { Debug(_L9_,"Memory init %s - Received GetX for %" PRIx64 " size %zu\n", getName().c_str(), me->getAddr(),me->getPayload().size()); }
         if ( isRequestAddressValid(addr) && backing_ ) {
-            backing_->set(addr, me->getPayload().size(), me->getPayload());
+            backing_->set(addr, me->getPayload().size(), me->getPayload().data());
         }
     } else if (Command::NULLCMD == me->getCmd()) {
         if (is_debug_event(me)) { Debug(_L9_, "Memory (%s) received init event: %s\n", getName().c_str(), me->getVerboseString().c_str()); }
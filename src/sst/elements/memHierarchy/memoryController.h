@@ -50,9 +50,11 @@ public:
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},\
             {"listenercount",       "(uint) Counts the number of listeners attached to this controller, these are modules for tracing or components like prefetchers", "0"},\
             {"listener%(listenercount)d", "(string) Loads a listener module into the controller", ""},\
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
-            {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' - pages allocated on first write, for large sparsely used memories", "mmap"},\
+            {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity. For 'sparse' backing stores, page size (2MiB or larger uses huge pages where available)", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_in_file",     "(string) For 'sparse' backing stores, optional snapshot file to load memory contents from", ""},\
+            {"backing_out_file",    "(string) For 'sparse' backing stores, optional snapshot file to write populated memory to at the end of simulation", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
@@ -121,8 +123,11 @@ protected:
     Output dbg;
     std::set<Addr> DEBUG_ADDR;
 
+    EndpointId memId_;  // This controller, source of the events it builds
+
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    std::string             backingOutFile_;    // Snapshot populated memory here at finish
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
@@ -46,6 +46,14 @@ public:
         dstBaseAddr_ = dstBaseAddr;
     }
 
+    MoveEvent(EndpointId src, Addr srcAddr, Addr srcBaseAddr, Addr dstAddr, Addr dstBaseAddr, Command cmd) : MemEventBase(src, cmd) {
+        initialize();
+        srcAddr_ = srcAddr;
+        srcBaseAddr_ = srcBaseAddr;
+        dstAddr_ = dstAddr;
+        dstBaseAddr_ = dstBaseAddr;
+    }
+
     MoveEvent * makeResponse() override {
         MoveEvent * ev = new MoveEvent(*this);
         ev->setResponse(this);
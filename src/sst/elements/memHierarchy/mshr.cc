@@ -27,6 +27,8 @@ MSHR::MSHR(Output* debug, int maxSize, string cacheName, std::set<Addr> debugAdd
     size_ = 0;
     prefetchCount_ = 0;
     ownerName_ = cacheName;
+    freeSlots_ = MSHRRegister::NoSlot;
+    statProbeLength_ = nullptr;
 
     d2_ = new Output();
     d2_->init("", 10, 0, (Output::output_location_t)1);
@@ -34,6 +36,168 @@ MSHR::MSHR(Output* debug, int maxSize, string cacheName, std::set<Addr> debugAdd
     DEBUG_ADDR = debugAddr;
 }
 
+MSHR::~MSHR() {
+    delete d2_;
+    for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++) {
+        for (uint32_t idx = it->second.head; idx != MSHRRegister::NoSlot; idx = slot(idx).next) {
+            if (slot(idx).entry.getType() == MSHREntryType::Evict)
+                delete slot(idx).entry.getPointers();
+        }
+    }
+    for (std::vector<std::list<Addr>*>::iterator it = freePointerLists_.begin(); it != freePointerLists_.end(); it++)
+        delete *it;
+    for (std::vector<MSHRSlot*>::iterator it = slabs_.begin(); it != slabs_.end(); it++)
+        delete [] *it;
+}
+
+/***** Entry pool & per-address queues *****/
+
+uint32_t MSHR::allocSlot(const MSHREntry& entry) {
+    if (freeSlots_ == MSHRRegister::NoSlot) {
+        uint32_t base = slabs_.size() << SlabShift;
+        MSHRSlot* slab = new MSHRSlot[SlabMask + 1];
+        slabs_.push_back(slab);
+        for (uint32_t i = SlabMask + 1; i > 0; i--) {
+            slab[i-1].next = freeSlots_;
+            freeSlots_ = base + i - 1;
+        }
+    }
+    uint32_t idx = freeSlots_;
+    MSHRSlot& s = slot(idx);
+    freeSlots_ = s.next;
+    s.entry = entry;
+    s.prev = MSHRRegister::NoSlot;
+    s.next = MSHRRegister::NoSlot;
+    return idx;
+}
+
+void MSHR::freeSlot(uint32_t idx) {
+    MSHRSlot& s = slot(idx);
+    if (s.entry.getType() == MSHREntryType::Evict) {
+        s.entry.getPointers()->clear();
+        freePointerLists_.push_back(s.entry.getPointers());
+    }
+    s.entry = MSHREntry();
+    s.next = freeSlots_;
+    freeSlots_ = idx;
+}
+
+std::list<Addr>* MSHR::allocPointerList() {
+    if (freePointerLists_.empty())
+        return new std::list<Addr>;
+    std::list<Addr>* ptrs = freePointerLists_.back();
+    freePointerLists_.pop_back();
+    return ptrs;
+}
+
+/* Caller must check that index < reg->count */
+uint32_t MSHR::slotAt(MSHRRegister* reg, size_t index) {
+    uint32_t idx = reg->head;
+    while (index-- > 0)
+        idx = slot(idx).next;
+    return idx;
+}
+
+void MSHR::linkBack(MSHRRegister* reg, uint32_t idx) {
+    MSHRSlot& s = slot(idx);
+    s.prev = reg->tail;
+    s.next = MSHRRegister::NoSlot;
+    if (reg->tail != MSHRRegister::NoSlot)
+        slot(reg->tail).next = idx;
+    else
+        reg->head = idx;
+    reg->tail = idx;
+    reg->count++;
+}
+
+void MSHR::linkFront(MSHRRegister* reg, uint32_t idx) {
+    MSHRSlot& s = slot(idx);
+    s.prev = MSHRRegister::NoSlot;
+    s.next = reg->head;
+    if (reg->head != MSHRRegister::NoSlot)
+        slot(reg->head).prev = idx;
+    else
+        reg->tail = idx;
+    reg->head = idx;
+    reg->count++;
+}
+
+/* Insert idx ahead of pos, or at the tail if pos is NoSlot */
+void MSHR::linkBefore(MSHRRegister* reg, uint32_t idx, uint32_t pos) {
+    if (pos == MSHRRegister::NoSlot) {
+        linkBack(reg, idx);
+    } else if (pos == reg->head) {
+        linkFront(reg, idx);
+    } else {
+        MSHRSlot& s = slot(idx);
+        s.prev = slot(pos).prev;
+        s.next = pos;
+        slot(s.prev).next = idx;
+        slot(pos).prev = idx;
+        reg->count++;
+    }
+}
+
+void MSHR::unlink(MSHRRegister* reg, uint32_t idx) {
+    MSHRSlot& s = slot(idx);
+    if (s.prev != MSHRRegister::NoSlot)
+        slot(s.prev).next = s.next;
+    else
+        reg->head = s.next;
+    if (s.next != MSHRRegister::NoSlot)
+        slot(s.next).prev = s.prev;
+    else
+        reg->tail = s.prev;
+    reg->count--;
+}
+
+MSHRRegister* MSHR::lookup(Addr addr) {
+    MSHRBlock::iterator it = mshr_.find(addr);
+    if (statProbeLength_)
+        statProbeLength_->addData(mshr_.getLastProbeLength());
+    return (it == mshr_.end()) ? nullptr : &(it->second);
+}
+
+/* Like lookup, but adds an empty register for addr if there is none, in the same probe */
+MSHRRegister* MSHR::lookupOrInsert(Addr addr) {
+    MSHRRegister* reg = &(mshr_[addr]);
+    if (statProbeLength_)
+        statProbeLength_->addData(mshr_.getLastProbeLength());
+    return reg;
+}
+
+/* Front entry of addr's queue, which must exist */
+MSHREntry* MSHR::frontEntry(Addr addr) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
+    }
+    if (reg->count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    return &(slot(reg->head).entry);
+}
+
+/* Unlink and free an entry, erasing the address if its queue is now empty */
+void MSHR::removeSlot(Addr addr, MSHRRegister* reg, uint32_t idx, std::string action) {
+    if (slot(idx).entry.getType() == MSHREntryType::Event)
+        size_--;
+
+    if (is_debug_addr(addr))
+        printDebug(10, action, addr, slot(idx).entry.getString());
+
+    unlink(reg, idx);
+    freeSlot(idx);
+
+    if (reg->count == 0) {
+        if (is_debug_addr(addr))
+            printDebug(10, "Erase", addr, "");
+        mshr_.erase(addr);
+    }
+}
+
+/***** MSHR interface *****/
+
 int MSHR::getMaxSize() {
     return maxSize_;
 }
@@ -43,164 +207,115 @@ int MSHR::getSize() {
 }
 
 unsigned int MSHR::getSize(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
-        return 0;
-    else
-        return mshr_.find(addr)->second.entries.size();
+    MSHRRegister* reg = lookup(addr);
+    return reg ? reg->count : 0;
 }
 
 bool MSHR::exists(Addr addr) {
-    return mshr_.find(addr) != mshr_.end();
+    return lookup(addr) != nullptr;
 }
 
 MSHREntry MSHR::getEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, mshr_.find(addr)->second.entries.size());
+    if (reg->count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, (size_t)reg->count);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-    std::advance(it, index);
-    return *it;
+    return slot(slotAt(reg, index)).entry;
 }
 
 MSHREntry MSHR::getFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->count == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front();
+    return slot(reg->head).entry;
 }
 
 void MSHR::removeEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
-    if (reg->entries.size() <= index) {
+    if (reg->count <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries.begin();
-    std::advance(entry, index);
-
-    if (entry->getType() == MSHREntryType::Event)
-        size_--;
-
-    if (is_debug_addr(addr))
-        printDebug(10, "Remove", addr, (*entry).getString().c_str());
-
-    reg->entries.erase(entry);
-    if (reg->entries.empty()) {
-        if (is_debug_addr(addr))
-            printDebug(10, "Erase", addr, "");
-            //d_->debug(_L10_, "M: %-41" PRIu64 " %-20s Erase        0x%-16" PRIx64 " %-10d\n",
-            //        Simulation::getSimulation()->getCurrentSimCycle(), ownerName_.c_str(), addr, size_);
-            //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
-    }
+    removeSlot(addr, reg, slotAt(reg, index), "Remove");
 }
 
 void MSHR::removeFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
-    if (reg->entries.empty()) {
+    if (reg->count == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
 
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::removeFront(0x%" PRIx64 ", %s)\n", addr, reg->entries.front().getString().c_str());
-
-    if (getFrontType(addr) == MSHREntryType::Event)
-        size_--;
-
-    if (is_debug_addr(addr))
-        printDebug(10, "RemFr", addr, (reg->entries.front()).getString().c_str());
-
-    reg->entries.pop_front();
-    if (reg->entries.empty()) {
-        if (is_debug_addr(addr))
-            printDebug(10, "Erase", addr, "");
-            //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
-    }
+    removeSlot(addr, reg, reg->head, "RemFr");
 }
 
 MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getEntryType(0x%" PRIx64 ", %zu)\n", addr, index);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
+    if (reg->count <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shoerter than index.\n", ownerName_.c_str(), addr, index);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-    std::advance(it, index);
-    return it->getType();
+    return slot(slotAt(reg, index)).entry.getType();
 }
 
 MSHREntryType MSHR::getFrontType(Addr addr) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getFrontType(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-    return mshr_.find(addr)->second.entries.front().getType();
+    return frontEntry(addr)->getType();
 }
 
 MemEventBase* MSHR::getEntryEvent(Addr addr, size_t index) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getEntryEvent(0x%" PRIx64 ", %zu)\n", addr, index);
-
-    if (mshr_.find(addr) == mshr_.end() || mshr_.find(addr)->second.entries.size() <= index)
+    MSHRRegister* reg = lookup(addr);
+    if (!reg || reg->count <= index)
         return nullptr;
 
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-    std::advance(it, index);
-    if (it->getType() != MSHREntryType::Event)
+    MSHREntry* entry = &(slot(slotAt(reg, index)).entry);
+    if (entry->getType() != MSHREntryType::Event)
         return nullptr;
-    return it->getEvent();
+    return entry->getEvent();
 }
 
 
 MemEventBase* MSHR::getFrontEvent(Addr addr) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getFrontEvent(0x%" PRIx64 ")\n", addr);
-    if (getFrontType(addr) != MSHREntryType::Event) {
+    MSHREntry* entry = frontEntry(addr);
+    if (entry->getType() != MSHREntryType::Event) {
         return nullptr;
     }
-    return mshr_.find(addr)->second.entries.front().getEvent();
+    return entry->getEvent();
 }
 
 MemEventBase* MSHR::getFirstEventEntry(Addr addr, Command cmd) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getFirstEventEntry(0x%" PRIx64 ", %s)\n", addr, CommandString[(int)cmd]);
-
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = lookup(addr);
+    if (!reg)
         return nullptr;
 
-    for (std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin(); it != mshr_.find(addr)->second.entries.end(); it++) {
-        if (it->getType() == MSHREntryType::Event && it->getEvent()->getCmd() == cmd)
-            return it->getEvent();
+    for (uint32_t idx = reg->head; idx != MSHRRegister::NoSlot; idx = slot(idx).next) {
+        MSHREntry* entry = &(slot(idx).entry);
+        if (entry->getType() == MSHREntryType::Event && entry->getEvent()->getCmd() == cmd)
+            return entry->getEvent();
     }
     return nullptr;
 }
 
 std::list<Addr>* MSHR::getEvictPointers(Addr addr) {
-    if (getFrontType(addr) != MSHREntryType::Evict)
+    MSHREntry* entry = frontEntry(addr);
+    if (entry->getType() != MSHREntryType::Evict)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr);
 
-    return mshr_.find(addr)->second.entries.front().getPointers();
+    return entry->getPointers();
 }
 
 // Return whether we should retry a new event or not
@@ -215,34 +330,46 @@ bool MSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
     }
 
     // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
-    if (getFrontType(addr) == MSHREntryType::Evict) {
-        MSHREntry * entry = &(mshr_.find(addr)->second.entries.front());
+    MSHRRegister* reg = lookup(addr);
+    MSHREntry * entry = &(slot(reg->head).entry);
+    if (entry->getType() == MSHREntryType::Evict) {
         entry->getPointers()->remove(addrPtr);
         if (entry->getPointers()->empty()) {
-            removeFront(addr);
+            removeSlot(addr, reg, reg->head, "RemFr");
             return true;
         }
     } else {
-        std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-        it++;
-        if (it->getType() != MSHREntryType::Evict)
+        uint32_t idx = slot(reg->head).next;
+        if (idx == MSHRRegister::NoSlot || slot(idx).entry.getType() != MSHREntryType::Evict)
             d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr, addrPtr);
-        it->getPointers()->remove(addrPtr);
-        if (it->getPointers()->empty()) {
-            removeEntry(addr, 1);
+        entry = &(slot(idx).entry);
+        entry->getPointers()->remove(addrPtr);
+        if (entry->getPointers()->empty()) {
+            removeSlot(addr, reg, idx, "Remove");
         }
     }
     return false;
 }
 
 bool MSHR::pendingWriteback(Addr addr) {
-    return exists(addr) && getFrontType(addr) == MSHREntryType::Writeback;
+    MSHRRegister* reg = lookup(addr);
+    if (!reg)
+        return false;
+    if (reg->count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    return slot(reg->head).entry.getType() == MSHREntryType::Writeback;
 }
 
 bool MSHR::pendingWritebackIsDowngrade(Addr addr) {
-    if (pendingWriteback(addr))
-        return mshr_.find(addr)->second.entries.front().getDowngrade();
-    return false;
+    MSHRRegister* reg = lookup(addr);
+    if (!reg)
+        return false;
+    if (reg->count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    MSHREntry* entry = &(slot(reg->head).entry);
+    return entry->getType() == MSHREntryType::Writeback && entry->getDowngrade();
 }
 
 int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest, bool stallEvict) {
@@ -258,39 +385,26 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
     // Success
     size_++;
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(event, stallEvict));
+    uint32_t idx = allocSlot(MSHREntry(event, stallEvict));
+    MSHRRegister* reg = lookupOrInsert(addr);
 
-        mshr_.insert(std::make_pair(addr, reg));
+    // A new register is empty, so both paths put the event at pos 0
+    if (pos == -1 || pos > (int)reg->count) {
+        linkBack(reg, idx);
         if (is_debug_addr(addr)) {
             stringstream reason;
-            reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=0";
+            reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (reg->count - 1);
             printDebug(10, "InsEv", addr, reason.str());
-
         }
-
-        return 0;
+        return (reg->count - 1);
     } else {
-        if (pos == -1 || pos > mshr_.find(addr)->second.entries.size()) {
-            mshr_.find(addr)->second.entries.push_back(MSHREntry(event, stallEvict));
-            if (is_debug_addr(addr)) {
-                stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries.size() - 1);
-                printDebug(10, "InsEv", addr, reason.str());
-            }
-            return (mshr_.find(addr)->second.entries.size() - 1);
-        } else {
-            std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-            std::advance(it, pos);
-            mshr_.find(addr)->second.entries.insert(it, MSHREntry(event, stallEvict));
-            if (is_debug_addr(addr)) {
-                stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
-                printDebug(10, "InsEv", addr, reason.str());
-            }
-            return pos;
+        linkBefore(reg, idx, (pos == (int)reg->count) ? MSHRRegister::NoSlot : slotAt(reg, pos));
+        if (is_debug_addr(addr)) {
+            stringstream reason;
+            reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
+            printDebug(10, "InsEv", addr, reason.str());
         }
+        return pos;
     }
 }
 
@@ -298,75 +412,56 @@ MemEventBase* MSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
     if (is_debug_addr(addr))
         printDebug(10, "SwpEv", addr, "");
 
-    if (mshr_.find(addr)->second.entries.empty())
+    MSHRRegister* reg = lookup(addr);
+    if (reg->count == 0)
         return nullptr;
 
-    return  mshr_.find(addr)->second.entries.front().swapEvent(event);
+    return slot(reg->head).entry.swapEvent(event);
 }
 
 void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
-    if (reg->entries.size() <= index) {
+    if (reg->count <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries.begin();
-    std::advance(entry, index);
-
-    MSHREntry tmpEntry = *entry;
+    uint32_t idx = slotAt(reg, index);
 
     if (is_debug_addr(addr))
-        printDebug(10, "MvEnt", addr, entry->getString());
-    reg->entries.erase(entry);
-    reg->entries.push_front(tmpEntry);
+        printDebug(10, "MvEnt", addr, slot(idx).entry.getString());
+    unlink(reg, idx);
+    linkFront(reg, idx);
 }
 
 bool MSHR::insertWriteback(Addr addr, bool downgrade) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::insertWriteback(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr)) {
         stringstream reason;
         reason << "Downgrade: " << (downgrade ? "T" : "F");
         printDebug(10, "InsWB", addr, reason.str());
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(downgrade));
-        mshr_.insert(std::make_pair(addr, reg));
-    } else {
-        mshr_.find(addr)->second.entries.push_front(MSHREntry(downgrade));
-    }
+    uint32_t idx = allocSlot(MSHREntry(downgrade));
+    linkFront(lookupOrInsert(addr), idx);
 
     return true;
 }
 
 
 bool MSHR::insertEviction(Addr oldAddr, Addr newAddr) {
-//    if (is_debug_addr(oldAddr) || is_debug_addr(newAddr))
-//        d_->debug(_L10_, "    MSHR::insertEviction(0x%" PRIx64 ", 0x%" PRIx64 ")\n", oldAddr, newAddr);
-
     if (is_debug_addr(oldAddr) || is_debug_addr(newAddr)) {
         stringstream reason;
         reason << "to 0x" << std::hex << newAddr;
         printDebug(10, "InsPtr", oldAddr, reason.str());
     }
 
-    if (mshr_.find(oldAddr) == mshr_.end()) {  // No MSHR entry for oldAddr
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(newAddr));
-        mshr_.insert(std::make_pair(oldAddr, reg));
-    } else {
-        list<MSHREntry>* entries = &(mshr_.find(oldAddr)->second.entries);
-        if (!entries->empty() && entries->back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
-            entries->back().getPointers()->push_back(newAddr);
-        } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
-            entries->push_back(MSHREntry(newAddr));
-        }
+    MSHRRegister* reg = lookupOrInsert(oldAddr);
+    if (reg->count != 0 && slot(reg->tail).entry.getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
+        slot(reg->tail).entry.getPointers()->push_back(newAddr);
+    } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
+        linkBack(reg, allocSlot(MSHREntry(newAddr, allocPointerList())));
     }
     return true;
 }
@@ -375,53 +470,53 @@ void MSHR::addPendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "IncRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::addPendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.addPendingRetry();
+    reg->addPendingRetry();
 }
 
 void MSHR::removePendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "DecRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removePendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.removePendingRetry();
+    reg->removePendingRetry();
 }
 
 uint32_t MSHR::getPendingRetries(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = lookup(addr);
+    if (!reg)
         return 0;
 
-    return mshr_.find(addr)->second.getPendingRetries();
+    return reg->getPendingRetries();
 }
 
 
 void MSHR::setInProgress(Addr addr, bool value) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setInProgress(0x%" PRIx64 ")\n", addr);
     if (is_debug_addr(addr))
         printDebug(20, "InProg", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->count == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setInProgress(value);
+    slot(reg->head).entry.setInProgress(value);
 }
 
 bool MSHR::getInProgress(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg || reg->count == 0) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        return false;
-    }
-    return mshr_.find(addr)->second.entries.front().getInProgress();
+    return slot(reg->head).entry.getInProgress();
 }
 
 void MSHR::setStalledForEvict(Addr addr, bool set) {
@@ -432,58 +527,59 @@ void MSHR::setStalledForEvict(Addr addr, bool set) {
             printDebug(20, "Unstall", addr, "");
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->count == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setStalledForEvict(set);
+    slot(reg->head).entry.setStalledForEvict(set);
 }
 
 bool MSHR::getStalledForEvict(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
-        return false;
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg || reg->count == 0) {
         return false;
     }
-    return mshr_.find(addr)->second.entries.front().getStalledForEvict();
+    return slot(reg->head).entry.getStalledForEvict();
 }
 
 void MSHR::setProfiled(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->count == 0) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setProfiled();
+    slot(reg->head).entry.setProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getProfiled(0x%" PRIx64 "\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->count == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front().getProfiled();
+    return slot(reg->head).entry.getProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr, SST::Event::id_type id) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = lookup(addr);
+    if (!reg)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
-    if (mshr_.find(addr)->second.entries.empty())
+    if (reg->count == 0)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
-        if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
-            return jt->getProfiled();
+    for (uint32_t idx = reg->head; idx != MSHRRegister::NoSlot; idx = slot(idx).next) {
+        MSHREntry* entry = &(slot(idx).entry);
+        if (entry->getType() == MSHREntryType::Event && entry->getEvent()->getID() == id) {
+            return entry->getProfiled();
         }
     }
     return true; // default so we don't attempt to profile what isn't there
@@ -493,35 +589,37 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->count == 0) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
-        if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
-            jt->setProfiled();
+    for (uint32_t idx = reg->head; idx != MSHRRegister::NoSlot; idx = slot(idx).next) {
+        MSHREntry* entry = &(slot(idx).entry);
+        if (entry->getType() == MSHREntryType::Event && entry->getEvent()->getID() == id) {
+            entry->setProfiled();
             return;
         }
     }
 }
 
+/* Oldest event entry; ties go to the lowest address so the result does not depend on table order */
 MSHREntry* MSHR::getOldestEntry() {
-    bool first = false;
     MSHREntry* entry = nullptr;
-    uint64_t time;
+    SimTime_t time = 0;
+    Addr addr = 0;
 
     for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++) {
-        for (list<MSHREntry>::iterator jt = it->second.entries.begin(); jt != it->second.entries.end(); jt++) {
-            if (jt->getType() == MSHREntryType::Event) {
-                if (!first) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                } else if (jt->getStartTime() < time) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                }
+        for (uint32_t idx = it->second.head; idx != MSHRRegister::NoSlot; idx = slot(idx).next) {
+            MSHREntry* candidate = &(slot(idx).entry);
+            if (candidate->getType() != MSHREntryType::Event)
+                continue;
+            if (entry == nullptr || candidate->getStartTime() < time || (candidate->getStartTime() == time && it->first < addr)) {
+                entry = candidate;
+                time = candidate->getStartTime();
+                addr = it->first;
             }
         }
     }
@@ -529,110 +627,98 @@ MSHREntry* MSHR::getOldestEntry() {
 }
 
 void MSHR::incrementAcksNeeded(Addr addr) {
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::incrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        mshr_.insert(std::make_pair(addr, reg));
-    }
-    mshr_.find(addr)->second.acksNeeded++;
+    MSHRRegister* reg = lookupOrInsert(addr);
+    reg->acksNeeded++;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "IncAck", addr, reason.str());
     }
 }
 
 /* Decrement acks needed and return if we're done waiting (acksNeeded == 0) */
 bool MSHR::decrementAcksNeeded(Addr addr) {
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::decrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.acksNeeded == 0) {
+    if (reg->acksNeeded == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.acksNeeded--;
+    reg->acksNeeded--;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "DecAck", addr, reason.str());
     }
 
-    return (mshr_.find(addr)->second.acksNeeded == 0);
+    return (reg->acksNeeded == 0);
 }
 
 uint32_t MSHR::getAcksNeeded(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         return 0;
     }
-    return (mshr_.find(addr)->second.acksNeeded);
+    return reg->acksNeeded;
 }
 
-void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+void MSHR::setData(Addr addr, const Payload& data, bool dirty) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
     if (is_debug_addr(addr))
         printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
 
-    mshr_.find(addr)->second.dataBuffer = data;
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataBuffer = data;
+    reg->dataDirty = dirty;
 }
 
 void MSHR::clearData(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::clearData(0x%" PRIx64 ")\n", addr);
     if (is_debug_addr(addr))
         printDebug(10, "ClrData", addr, "");
 
-    mshr_.find(addr)->second.dataBuffer.clear();
-    mshr_.find(addr)->second.dataDirty = false;
+    MSHRRegister* reg = lookup(addr);
+    reg->dataBuffer.clear();
+    reg->dataDirty = false;
 }
 
-vector<uint8_t>& MSHR::getData(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+Payload& MSHR::getData(Addr addr) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataBuffer;
+    return reg->dataBuffer;
 }
 
 bool MSHR::hasData(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = lookup(addr);
+    if (!reg)
         return false;
-    return !(mshr_.find(addr)->second.dataBuffer.empty());
+    return !(reg->dataBuffer.empty());
 }
 
 bool MSHR::getDataDirty(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getDataDirty(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataDirty;
+    return reg->dataDirty;
 }
 
 void MSHR::setDataDirty(Addr addr, bool dirty) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setDataDirty(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr))
         printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = lookup(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataDirty = dirty;
 
 }
 
@@ -658,12 +744,15 @@ void MSHR::printDebug(uint32_t lev, std::string action, Addr addr, std::string r
 // Print status. Called by cache controller on EmergencyShutdown and printStatus()
 void MSHR::printStatus(Output &out) {
     out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\b", ownerName_.c_str(), size_, prefetchCount_);
-    for (std::map<Addr,MSHRRegister>::iterator it = mshr_.begin(); it != mshr_.end(); it++) {   // Iterate over addresses
-        out.output("      Entry: Addr = 0x%" PRIx64 "\n", (it->first));
-        for (std::list<MSHREntry>::iterator it2 = it->second.entries.begin(); it2 != it->second.entries.end(); it2++) { // Iterate over entries for each address
-            out.output("        %s\n", it2->getString().c_str());
+    std::vector<Addr> addrs;
+    for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++)
+        addrs.push_back(it->first);
+    std::sort(addrs.begin(), addrs.end());
+    for (std::vector<Addr>::iterator it = addrs.begin(); it != addrs.end(); it++) {   // Iterate over addresses
+        out.output("      Entry: Addr = 0x%" PRIx64 "\n", *it);
+        for (uint32_t idx = mshr_.find(*it)->second.head; idx != MSHRRegister::NoSlot; idx = slot(idx).next) { // Iterate over entries for each address
+            out.output("        %s\n", slot(idx).entry.getString().c_str());
         }
     }
     out.output("    End MSHR Status for %s\n", ownerName_.c_str());
 }
-
@@ -17,6 +17,8 @@
 #define _MSHR_H_
 
 #include <map>
+#include <list>
+#include <vector>
 #include <string>
 #include <sstream>
 
@@ -28,6 +30,8 @@
 
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/addrHashMap.h"
+#include "sst/elements/memHierarchy/payload.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -45,6 +49,10 @@ enum class MSHREntryType { Event, Evict, Writeback };
 
 class MSHREntry {
     public:
+        // Empty entry, used by the MSHR's entry pool
+        MSHREntry() : type(MSHREntryType::Event), evictPtrs(nullptr), event(nullptr), time(0),
+            needEvict(false), inProgress(false), profiled(false), downgrade(false) { }
+
         // Event entry
         MSHREntry(MemEventBase* ev, bool stallEvict) {
             type = MSHREntryType::Event;
@@ -70,11 +78,11 @@ class MSHREntry {
             downgrade = downgr;
         }
 
-        // Evict entry
-        MSHREntry(Addr addr) {
+        // Evict entry, ptrs is an empty list owned by the MSHR
+        MSHREntry(Addr addr, std::list<Addr>* ptrs) {
             type = MSHREntryType::Evict;
             event = nullptr;
-            evictPtrs = new std::list<Addr>;
+            evictPtrs = ptrs;
             evictPtrs->push_back(addr);
             time = Simulation::getSimulation()->getCurrentSimCycle();
             inProgress = false;
@@ -163,11 +171,18 @@ class MSHREntry {
         bool downgrade;             // Specific to Writeback type
 };
 
+/*
+ * Per-address state. The entry queue is intrusive: entries live in the
+ * MSHR's slab pool and are linked by pool index, head to tail.
+ */
 struct MSHRRegister {
-    MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0) { }
-    list<MSHREntry> entries;
+    MSHRRegister() : head(NoSlot), tail(NoSlot), count(0), acksNeeded(0), dataDirty(false), pendingRetries(0) { }
+    static const uint32_t NoSlot = 0xFFFFFFFF;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t count;
     uint32_t acksNeeded;
-    vector<uint8_t> dataBuffer;
+    Payload dataBuffer;
     bool dataDirty;
     uint32_t pendingRetries;
 
@@ -176,7 +191,7 @@ struct MSHRRegister {
     void removePendingRetry() { pendingRetries--; }
 };
 
-typedef map<Addr, MSHRRegister> MSHRBlock;
+typedef AddrHashMap<MSHRRegister> MSHRBlock;
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
@@ -186,6 +201,10 @@ public:
 
     // used externally
     MSHR(Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr);
+    ~MSHR();
+
+    // Record the probe length of each address lookup
+    void setProbeLengthStatistic(Statistic<uint64_t>* stat) { statProbeLength_ = stat; }
 
     int getMaxSize();
     int getSize();
@@ -244,9 +263,9 @@ public:
     bool decrementAcksNeeded(Addr addr);
     uint32_t getAcksNeeded(Addr addr);
 
-    void setData(Addr addr, vector<uint8_t>& data, bool dirty = false);
+    void setData(Addr addr, const Payload& data, bool dirty = false);
     void clearData(Addr addr);
-    vector<uint8_t>& getData(Addr addr);
+    Payload& getData(Addr addr);
     bool hasData(Addr addr);
     bool getDataDirty(Addr addr);
     void setDataDirty(Addr addr, bool dirty);
@@ -257,6 +276,36 @@ private:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
+    /* Entry pool. Slabs are never moved so entry pointers stay valid while the entry is queued */
+    struct MSHRSlot {
+        MSHREntry entry;
+        uint32_t prev;
+        uint32_t next;
+    };
+    static const uint32_t SlabShift = 6;
+    static const uint32_t SlabMask = (1 << SlabShift) - 1;
+
+    MSHRSlot& slot(uint32_t idx) { return slabs_[idx >> SlabShift][idx & SlabMask]; }
+    uint32_t allocSlot(const MSHREntry& entry);
+    void freeSlot(uint32_t idx);
+    uint32_t slotAt(MSHRRegister* reg, size_t index);
+    void linkBack(MSHRRegister* reg, uint32_t idx);
+    void linkFront(MSHRRegister* reg, uint32_t idx);
+    void linkBefore(MSHRRegister* reg, uint32_t idx, uint32_t pos);
+    void unlink(MSHRRegister* reg, uint32_t idx);
+    std::list<Addr>* allocPointerList();
+
+    /* Lookup returns nullptr if addr is not in the MSHR */
+    MSHRRegister* lookup(Addr addr);
+    MSHRRegister* lookupOrInsert(Addr addr);
+    MSHREntry* frontEntry(Addr addr);
+    void removeSlot(Addr addr, MSHRRegister* reg, uint32_t idx, std::string action);
+
+    std::vector<MSHRSlot*> slabs_;
+    uint32_t freeSlots_;
+    std::vector<std::list<Addr>*> freePointerLists_;
+    Statistic<uint64_t>* statProbeLength_;
+
     MSHRBlock mshr_;
     Output* d_;
     Output* d2_;
@@ -69,41 +69,148 @@ MultiThreadL1::MultiThreadL1(ComponentId_t id, Params &params) : Component(id) {
     /* Setup throughput limiting */
     requestsPerCycle = params.find<uint64_t>("requests_per_cycle", 0);
     responsesPerCycle = params.find<uint64_t>("responses_per_cycle", 0);
+
+    std::string arb = params.find<std::string>("arbitration", "oldest");
+    if (arb == "oldest") arbitration = Arbitration::Oldest;
+    else if (arb == "roundrobin") arbitration = Arbitration::RoundRobin;
+    else if (arb == "bandwidth") arbitration = Arbitration::Bandwidth;
+    else output.fatal(CALL_INFO, -1, "Invalid param(%s): arbitration - must be 'oldest', 'roundrobin', or 'bandwidth'. You specified: %s\n", getName().c_str(), arb.c_str());
+
+    unsigned int threads = threadLinks.size();
+    requestQueues.resize(threads);
+    pendingRequests = 0;
+    requestSeq = 0;
+    rrNext = 0;
+
+    /* Stride scheduling: a thread's pass advances by stride per request, so
+     * threads are served in proportion to their weights */
+    std::vector<uint64_t> weights;
+    params.find_array<uint64_t>("thread_weights", weights);
+    weights.resize(threads, 1);
+    const uint64_t strideScale = 1 << 20;
+    for (unsigned int i = 0; i < threads; i++) {
+        if (weights[i] == 0)
+            output.fatal(CALL_INFO, -1, "Invalid param(%s): thread_weights - weights must be at least 1\n", getName().c_str());
+        stride.push_back(strideScale / weights[i]);
+    }
+    pass.resize(threads, 0);
+    globalPass = 0;
+
+    /* Tag each thread's requests with its own source */
+    tagBase = 0;
+    for (unsigned int i = 0; i < threads; i++) {
+        threadTags.push_back(EndpointRegistry::intern(getName() + ":thread" + std::to_string(i)));
+        if (i == 0 || threadTags[i] < tagBase)
+            tagBase = threadTags[i];
+    }
+    for (unsigned int i = 0; i < threads; i++) {
+        if (threadTags[i] - tagBase >= tagThread.size())
+            tagThread.resize(threadTags[i] - tagBase + 1, -1);
+        tagThread[threadTags[i] - tagBase] = i;
+    }
+    threadSrcs.resize(threads, EndpointRegistry::NoEndpoint);
+
+    /* Statistics */
+    threadStats = params.find<bool>("thread_statistics", false);
+    if (threadStats) {
+        outstanding.resize(threads);
+        for (unsigned int i = 0; i < threads; i++) {
+            std::string subid = "thread" + std::to_string(i);
+            stat_requests.push_back(registerStatistic<uint64_t>("requests", subid));
+            stat_responses.push_back(registerStatistic<uint64_t>("responses", subid));
+            stat_queueDelay.push_back(registerStatistic<uint64_t>("queue_delay", subid));
+            stat_latency.push_back(registerStatistic<uint64_t>("request_latency", subid));
+        }
+    }
 }
 
 MultiThreadL1::~MultiThreadL1() {
-    while (requestQueue.size()) {
-        delete requestQueue.front();
-        requestQueue.pop();
+    for (unsigned int i = 0; i < requestQueues.size(); i++) {
+        while (!requestQueues[i].empty()) {
+            delete requestQueues[i].front().event;
+            requestQueues[i].pop_front();
+        }
     }
-    while (responseQueue.size()) {
+    while (!responseQueue.empty()) {
         delete responseQueue.front();
-        responseQueue.pop();
+        responseQueue.pop_front();
     }
 }
 
 void MultiThreadL1::handleRequest(SST::Event * ev, unsigned int threadid) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
     if (!clockOn) enableClock();
-    threadRequestMap.insert(std::make_pair(event->getID(), threadid));
-    requestQueue.push(event);
+
+    threadSrcs[threadid] = event->getSrcId();
+    event->setSrcId(threadTags[threadid]);
+
+    /* A thread that was idle does not get credit for the time it had nothing to send */
+    if (requestQueues[threadid].empty() && pass[threadid] < globalPass)
+        pass[threadid] = globalPass;
+
+    requestQueues[threadid].push_back(Request(event, requestSeq++, timestamp));
+    pendingRequests++;
 }
 
 void MultiThreadL1::handleResponse(SST::Event * ev) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
     if (!clockOn) enableClock();
-    responseQueue.push(event);
+    responseQueue.push_back(event);
+}
+
+/* Select the thread whose request is sent next. At least one request must be pending */
+unsigned int MultiThreadL1::arbitrate() {
+    unsigned int threads = requestQueues.size();
+    unsigned int best = threads;
+    switch (arbitration) {
+        case Arbitration::Oldest:
+            for (unsigned int i = 0; i < threads; i++) {
+                if (!requestQueues[i].empty() && (best == threads || requestQueues[i].front().seq < requestQueues[best].front().seq))
+                    best = i;
+            }
+            break;
+        case Arbitration::RoundRobin:
+            for (unsigned int n = 0; n < threads; n++) {
+                unsigned int i = (rrNext + n) % threads;
+                if (!requestQueues[i].empty()) {
+                    best = i;
+                    break;
+                }
+            }
+            rrNext = (best + 1) % threads;
+            break;
+        case Arbitration::Bandwidth:
+            for (unsigned int n = 0; n < threads; n++) {
+                unsigned int i = (rrNext + n) % threads;
+                if (!requestQueues[i].empty() && (best == threads || pass[i] < pass[best]))
+                    best = i;
+            }
+            globalPass = pass[best];
+            pass[best] += stride[best];
+            rrNext = (best + 1) % threads;
+            break;
+    }
+    return best;
 }
 
 bool MultiThreadL1::tick(SST::Cycle_t cycle) {
     timestamp++;
 
-    uint64_t sendcount = (requestsPerCycle == 0) ? requestQueue.size() : requestsPerCycle;
+    uint64_t sendcount = (requestsPerCycle == 0) ? pendingRequests : requestsPerCycle;
 
-    /* Drain request queue */
-    while (!requestQueue.empty() && sendcount > 0) {
-        cacheLink->send(requestQueue.front());
-        requestQueue.pop();
+    /* Drain request queues */
+    while (pendingRequests != 0 && sendcount > 0) {
+        unsigned int thread = arbitrate();
+        Request& req = requestQueues[thread].front();
+        if (threadStats) {
+            stat_requests[thread]->addData(1);
+            stat_queueDelay[thread]->addData(timestamp - req.arrival);
+            if (!req.event->queryFlag(MemEventBase::F_NORESPONSE))
+                outstanding[thread].push_back({req.event->getID(), req.arrival});
+        }
+        cacheLink->send(req.event);
+        requestQueues[thread].pop_front();
+        pendingRequests--;
         sendcount--;
     }
 
@@ -112,23 +219,47 @@ bool MultiThreadL1::tick(SST::Cycle_t cycle) {
     /* Drain response queue */
     while (!responseQueue.empty() && sendcount > 0) {
         MemEventBase * event = responseQueue.front();
-        responseQueue.pop();
-
-        unsigned int linkid = threadRequestMap.find(event->getResponseToID())->second;
-        threadRequestMap.erase(event->getResponseToID());
-        threadLinks[linkid]->send(event);
-
+        responseQueue.pop_front();
+        deliverResponse(event);
         sendcount--;
     }
 
     /* Turn off clock if queues are empty */
-    if (requestQueue.empty() && responseQueue.empty()) {
+    if (pendingRequests == 0 && responseQueue.empty()) {
         clockOn = false;
         return true;
     }
     return false;
 }
 
+/* Responses are addressed to the tag their request carried. Events that
+ * do not answer a thread's request (e.g., invalidations) go to every thread */
+void MultiThreadL1::deliverResponse(MemEventBase* event) {
+    int thread = getThread(event->getDstId());
+    if (thread < 0) {
+        for (unsigned int i = 0; i < threadLinks.size(); i++)
+            threadLinks[i]->send(event->clone());
+        delete event;
+        return;
+    }
+
+    if (threadStats) {
+        stat_responses[thread]->addData(1);
+        vector<Outstanding>& out = outstanding[thread];
+        for (size_t i = 0; i < out.size(); i++) {
+            if (out[i].id == event->getResponseToID()) {
+                stat_latency[thread]->addData(timestamp - out[i].arrival);
+                out[i] = out.back();
+                out.pop_back();
+                break;
+            }
+        }
+    }
+
+    event->setDstId(threadSrcs[thread]);
+    threadLinks[thread]->send(event);
+}
+
 inline void MultiThreadL1::enableClock() {
     clockOn = true;
     timestamp = reregisterClock(clock, clockHandler);
@@ -16,8 +16,7 @@
 #ifndef _MEMHIERARCHY_MULTITHREADL1_H_
 #define _MEMHIERARCHY_MULTITHREADL1_H_
 
-#include <map>
-#include <queue>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -28,6 +27,7 @@
 
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/ringBuffer.h"
 
 using namespace std;
 
@@ -43,6 +43,9 @@ public:
             {"clock",               "(string) Clock frequency or period with units (Hz or s; SI units OK).", NULL},
             {"requests_per_cycle",  "(uint) Number of requests to forward to L1 each cycle (for all threads combined). 0 indicates unlimited", "0"},
             {"responses_per_cycle", "(uint) Number of responses to forward to threads each cycle (for all threads combined). 0 indicates unlimited", "0"},
+            {"arbitration",         "(string) How threads share requests_per_cycle. Options: oldest[requests are sent in arrival order], roundrobin[one request per thread in turn], bandwidth[each thread gets a share of requests in proportion to its thread_weights entry]", "oldest"},
+            {"thread_weights",      "(array) For bandwidth arbitration: relative share of each thread, e.g., [2,1,1]. Unlisted threads get 1", "[]"},
+            {"thread_statistics",   "(bool) Register the per-thread statistics", "false"},
             {"debug",               "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",         "(uint) Debug verbosity level. Between 0 and 10", "0"},
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""} )
@@ -51,6 +54,13 @@ public:
           {"cache", "Link to L1 cache", {"memHierarchy.MemEventBase"} },
           {"thread%(port)d", "Links to threads/cores", {"memHierarchy.MemEventBase"} } )
 
+    /* Registered with subid "thread<N>" if thread_statistics is set */
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"requests",        "Requests forwarded to the cache for the thread", "requests", 1},
+            {"responses",       "Responses returned to the thread", "responses", 1},
+            {"queue_delay",     "Cycles each request waited for arbitration", "cycles", 2},
+            {"request_latency", "Cycles from a request's arrival at the shim until its response is forwarded to the thread", "cycles", 2} )
+
 /* Begin class definition */
     /** Constructor & destructor */
     MultiThreadL1(ComponentId_t id, Params &params);
@@ -86,14 +96,53 @@ private:
     Clock::Handler<MultiThreadL1>*  clockHandler;
     TimeConverter* clock;
 
-    /** Track outstanding requests for routing responses correctly */
-    std::map<Event::id_type, unsigned int> threadRequestMap;
+    /** Routing: each thread's requests are sent with a per-thread source ID so
+     *  a response's destination identifies the thread without a lookup table.
+     *  The destination is set back to the thread's own source before delivery */
+    vector<EndpointId> threadTags;      // Source ID given to each thread's requests
+    vector<EndpointId> threadSrcs;      // Source ID each thread used
+    vector<int> tagThread;              // Tag ID - tagBase -> thread, -1 if not a tag
+    EndpointId tagBase;
+    int getThread(EndpointId tag) {
+        return (tag >= tagBase && tag - tagBase < tagThread.size()) ? tagThread[tag - tagBase] : -1;
+    }
 
     /** Throughput control */
+    struct Request {
+        MemEventBase* event;
+        uint64_t seq;       // Arrival order across all threads
+        uint64_t arrival;   // Cycle the request arrived
+        Request() : event(nullptr), seq(0), arrival(0) { }
+        Request(MemEventBase* ev, uint64_t s, uint64_t a) : event(ev), seq(s), arrival(a) { }
+    };
+    enum class Arbitration { Oldest, RoundRobin, Bandwidth };
+    Arbitration arbitration;
     uint64_t requestsPerCycle;
     uint64_t responsesPerCycle;
-    std::queue<MemEventBase*> requestQueue;
-    std::queue<MemEventBase*> responseQueue;
+    vector<RingBuffer<Request> > requestQueues;     // One per thread
+    RingBuffer<MemEventBase*> responseQueue;
+    uint64_t pendingRequests;
+    uint64_t requestSeq;
+    unsigned int rrNext;                            // RoundRobin: thread to check first
+    vector<uint64_t> stride;                        // Bandwidth: pass increment per request, inversely proportional to weight
+    vector<uint64_t> pass;                          // Bandwidth: thread with the lowest pass goes next
+    uint64_t globalPass;                            // Bandwidth: pass of the last thread served
+
+    unsigned int arbitrate();
+
+    /** Per-thread statistics */
+    bool threadStats;
+    struct Outstanding {
+        Event::id_type id;
+        uint64_t arrival;
+    };
+    vector<vector<Outstanding> > outstanding;      // Only tracked if threadStats
+    vector<Statistic<uint64_t>*> stat_requests;
+    vector<Statistic<uint64_t>*> stat_responses;
+    vector<Statistic<uint64_t>*> stat_queueDelay;
+    vector<Statistic<uint64_t>*> stat_latency;
+
+    void deliverResponse(MemEventBase* event);
 
     inline void enableClock();
 };
@@ -0,0 +1,111 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <new>
+
+#include "payload.h"
+
+using namespace SST::MemHierarchy;
+
+/*
+ * Blocks are bucketed by capacity: 16B, 32B, ... 4KB. Larger payloads go straight
+ * to the allocator. Each thread keeps its own free lists; a block freed on a thread
+ * other than the one that allocated it simply joins the freeing thread's list.
+ * A free block's header is overwritten with the link to the next free block.
+ */
+namespace {
+
+const uint32_t minShift = 4;
+const uint32_t maxShift = 12;
+const uint32_t numClasses = maxShift - minShift + 1;
+const uint32_t maxFreePerClass = 4096;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct FreeLists {
+    FreeBlock* head[numClasses];
+    uint32_t count[numClasses];
+
+    FreeLists() {
+        for (uint32_t i = 0; i < numClasses; i++) {
+            head[i] = nullptr;
+            count[i] = 0;
+        }
+    }
+
+    ~FreeLists() {
+        for (uint32_t i = 0; i < numClasses; i++) {
+            while (head[i]) {
+                FreeBlock* next = head[i]->next;
+                ::operator delete(head[i]);
+                head[i] = next;
+            }
+        }
+    }
+};
+
+thread_local FreeLists freeLists;
+
+/* Size class for a request, or numClasses if it is too large to pool */
+inline uint32_t sizeClass(size_t size) {
+    uint32_t cls = 0;
+    while (cls < numClasses && ((size_t)1 << (cls + minShift)) < size)
+        cls++;
+    return cls;
+}
+
+}
+
+Payload::Block* Payload::allocate(size_t size) {
+    uint32_t cls = sizeClass(size);
+    uint32_t capacity = cls < numClasses ? (1 << (cls + minShift)) : size;
+    Block* block;
+
+    if (cls < numClasses && freeLists.head[cls]) {
+        FreeBlock* free = freeLists.head[cls];
+        freeLists.head[cls] = free->next;
+        freeLists.count[cls]--;
+        block = reinterpret_cast<Block*>(free);
+    } else {
+        block = static_cast<Block*>(::operator new(sizeof(Block) + capacity));
+    }
+
+    new (&block->refs) std::atomic<uint32_t>(1);
+    block->capacity = capacity;
+    return block;
+}
+
+void Payload::deallocate(Block* block) {
+    uint32_t cls = sizeClass(block->capacity);
+    if (cls < numClasses && freeLists.count[cls] < maxFreePerClass) {
+        FreeBlock* free = reinterpret_cast<FreeBlock*>(block);
+        free->next = freeLists.head[cls];
+        freeLists.head[cls] = free;
+        freeLists.count[cls]++;
+        return;
+    }
+    ::operator delete(block);
+}
+
+size_t Payload::pooledBytes() {
+    size_t bytes = 0;
+    for (uint32_t i = 0; i < numClasses; i++)
+        bytes += (size_t)freeLists.count[i] * (sizeof(Block) + (1 << (i + minShift)));
+    return bytes;
+}
@@ -0,0 +1,192 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_PAYLOAD_H
+#define MEMHIERARCHY_PAYLOAD_H
+
+#include <stdint.h>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Data carried by MemEvents and held in MSHR data buffers and cache lines.
+ *
+ * Storage is a reference counted block taken from per-thread free lists
+ * bucketed by power of two size, so line sized payloads are recycled instead
+ * of going through the allocator for every event. Copying a Payload shares the
+ * block; the block is duplicated only when a shared payload is written. A line
+ * that is read and forwarded, or buffered in an MSHR and then installed, is
+ * never copied.
+ *
+ * The interface is the subset of std::vector<uint8_t> the hierarchy uses.
+ * Non-const accessors (operator[], data(), begin()) unshare the block first,
+ * so pointers obtained from them must not be held across a copy of the payload.
+ */
+class Payload {
+public:
+    Payload() : block_(nullptr), size_(0) { }
+
+    explicit Payload(size_t size, uint8_t value = 0) : block_(nullptr), size_(0) {
+        resize(size, value);
+    }
+
+    Payload(const uint8_t* data, size_t size) : block_(nullptr), size_(0) {
+        assign(data, size);
+    }
+
+    Payload(const std::vector<uint8_t>& vec) : block_(nullptr), size_(0) {
+        assign(vec.data(), vec.size());
+    }
+
+    Payload(const Payload& other) : block_(other.block_), size_(other.size_) {
+        if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Payload(Payload&& other) : block_(other.block_), size_(other.size_) {
+        other.block_ = nullptr;
+        other.size_ = 0;
+    }
+
+    ~Payload() { release(); }
+
+    Payload& operator=(const Payload& other) {
+        if (other.block_) other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+        release();
+        block_ = other.block_;
+        size_ = other.size_;
+        return *this;
+    }
+
+    Payload& operator=(Payload&& other) {
+        if (this != &other) {
+            release();
+            block_ = other.block_;
+            size_ = other.size_;
+            other.block_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    Payload& operator=(const std::vector<uint8_t>& vec) {
+        assign(vec.data(), vec.size());
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /* Drop the contents and return the block to the pool if this was its last user */
+    void clear() {
+        release();
+        size_ = 0;
+    }
+
+    /* New bytes are set to value; shrinking keeps the block (and any sharing) */
+    void resize(size_t size, uint8_t value = 0) {
+        if (size > size_) {
+            reserveUnique(size, true);
+            std::memset(block_->bytes() + size_, value, size - size_);
+        }
+        size_ = size;
+    }
+
+    void assign(const uint8_t* data, size_t size) {
+        if (size == 0) {
+            clear();
+            return;
+        }
+        reserveUnique(size, false);
+        std::memcpy(block_->bytes(), data, size);
+        size_ = size;
+    }
+
+    const uint8_t* data() const { return block_ ? block_->bytes() : nullptr; }
+    uint8_t* data() { unshare(); return block_ ? block_->bytes() : nullptr; }
+
+    const uint8_t& operator[](size_t i) const { return block_->bytes()[i]; }
+    uint8_t& operator[](size_t i) { unshare(); return block_->bytes()[i]; }
+
+    const uint8_t& at(size_t i) const {
+        if (i >= size_)
+            throw std::out_of_range("Payload::at");
+        return block_->bytes()[i];
+    }
+
+    const uint8_t* begin() const { return data(); }
+    const uint8_t* end() const { return data() + size_; }
+    uint8_t* begin() { return data(); }
+    uint8_t* end() { return data() + size_; }
+
+    /* Bytes [offset, offset + size); a slice covering the whole payload shares it */
+    Payload slice(size_t offset, size_t size) const {
+        if (offset == 0 && size == size_)
+            return *this;
+        return Payload(data() + offset, size);
+    }
+
+    std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(begin(), end()); }
+    operator std::vector<uint8_t>() const { return toVector(); }
+
+    /* True if another Payload refers to the same storage */
+    bool shared() const { return block_ && block_->refs.load(std::memory_order_acquire) > 1; }
+
+    /* Bytes held per-thread in the free lists, for debug/statistics */
+    static size_t pooledBytes();
+
+private:
+    struct Block {
+        std::atomic<uint32_t> refs;
+        uint32_t capacity;
+        uint8_t* bytes() { return reinterpret_cast<uint8_t*>(this + 1); }
+    };
+
+    static Block* allocate(size_t size);
+    static void deallocate(Block* block);
+
+    void release() {
+        if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            deallocate(block_);
+        block_ = nullptr;
+    }
+
+    /* Make block_ exclusively owned with room for size bytes, keeping the contents if copy is set */
+    void reserveUnique(size_t size, bool copy) {
+        if (block_ && block_->capacity >= size && block_->refs.load(std::memory_order_acquire) == 1)
+            return;
+        Block* block = allocate(size);
+        if (copy && size_ != 0)
+            std::memcpy(block->bytes(), block_->bytes(), size_);
+        release();
+        block_ = block;
+    }
+
+    void unshare() {
+        if (shared())
+            reserveUnique(size_, true);
+    }
+
+    Block* block_;
+    uint32_t size_;
+};
+
+}}
+
+#endif // MEMHIERARCHY_PAYLOAD_H
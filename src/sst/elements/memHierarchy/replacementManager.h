@@ -77,6 +77,9 @@ class ReplacementPolicy : public SubComponent{
         virtual void update(uint64_t id, ReplacementInfo * rInfo) = 0;
         virtual void replaced(uint64_t id) = 0;
 
+        /* A new line with address addr was placed at id. Policies that insert differently than they promote on a hit, or that key on the address, override this */
+        virtual void installed(uint64_t id, Addr addr, ReplacementInfo * rInfo) { update(id, rInfo); }
+
         // Get replacement candidates
         virtual uint64_t getBestCandidate() = 0;
         virtual uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) = 0;
@@ -705,6 +708,306 @@ public:
 };
 
 
+/* ------------------------------------------------------------------------------------------
+ *  Re-reference interval prediction (RRIP)
+ *  - Each line has a 2-bit re-reference prediction value (RRPV): 0 = reuse expected soon,
+ *    3 = reuse expected in the distant future. RRPVs are packed 32 to a word, per set.
+ *  - A hit sets the line's RRPV to 0. The victim is the first line in the set with RRPV 3;
+ *    if there is none, every line in the set is aged until one has it.
+ *  - The variants differ only in the RRPV a newly installed line is given.
+ *  - Replacement algorithm assumes indices are contiguous for the set
+ * ------------------------------------------------------------------------------------------*/
+class RRIPBase : public ReplacementPolicy {
+public:
+    RRIPBase(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0), agePending(false) {
+        ways = associativity;
+        sets = lines / associativity;
+        wordsPerSet = (ways + WaysPerWord - 1) / WaysPerWord;
+        uint64_t lastWays = ways % WaysPerWord;
+        lastWordMask = lastWays ? (((uint64_t)1 << (2 * lastWays)) - 1) : ~(uint64_t)0;
+
+        // Unused fields in a set's last word stay 0 and are masked out of searches
+        rrpv.resize(sets * wordsPerSet, 0);
+    }
+
+    virtual ~RRIPBase() { }
+
+    /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    /* Hit: predict near-immediate reuse */
+    void update(uint64_t id, ReplacementInfo * rInfo) { setRRPV(id, 0); }
+
+    void installed(uint64_t id, Addr addr, ReplacementInfo * rInfo) { setRRPV(id, insertionRRPV(id / ways, id, addr)); }
+
+    /* Aging is deferred from the search to here so that a search that does not end in an eviction has no effect */
+    void replaced(uint64_t id) {
+        if (agePending && id == bestCandidate)
+            ageSet(id / ways);
+        agePending = false;
+        setRRPV(id, MaxRRPV);
+    }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        agePending = false;
+        for (uint64_t i = 0; i < ways; i++) {
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = rInfo[i]->getIndex();
+                return bestCandidate;
+            }
+        }
+
+        uint64_t set = rInfo[0]->getIndex() / ways;
+        uint64_t* words = &rrpv[set * wordsPerSet];
+
+        // Find the first line with the largest RRPV in the set; the set is aged if it is replaced
+        for (int value = MaxRRPV; value >= 0; value--) {
+            for (uint64_t w = 0; w < wordsPerSet; w++) {
+                uint64_t match = matchFields(words[w], value) & wordMask(w);
+                if (match) {
+                    agePending = (value != MaxRRPV);
+                    bestCandidate = rInfo[w * WaysPerWord + __builtin_ctzll(match) / 2]->getIndex();
+                    return bestCandidate;
+                }
+            }
+        }
+        bestCandidate = rInfo[0]->getIndex(); // Not reached, some RRPV is always found
+        return bestCandidate;
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+protected:
+    static const uint64_t MaxRRPV = 3;
+
+    /* RRPV for a line newly installed at id in set */
+    virtual uint64_t insertionRRPV(uint64_t set, uint64_t id, Addr addr) = 0;
+
+    uint64_t ways;
+    uint64_t sets;
+
+private:
+    static const uint64_t WaysPerWord = 32;
+    static const uint64_t LowBits = 0x5555555555555555ULL;
+
+    uint64_t wordMask(uint64_t w) const { return (w == wordsPerSet - 1) ? lastWordMask : ~(uint64_t)0; }
+
+    /* Low bit of each 2-bit field in word that equals value */
+    static uint64_t matchFields(uint64_t word, uint64_t value) {
+        uint64_t diff = word ^ (value * LowBits);
+        return ~(diff | (diff >> 1)) & LowBits;
+    }
+
+    /* Age every line in the set until the largest RRPV is MaxRRPV */
+    void ageSet(uint64_t set) {
+        uint64_t* words = &rrpv[set * wordsPerSet];
+        for (int value = MaxRRPV; value > 0; value--) {
+            for (uint64_t w = 0; w < wordsPerSet; w++) {
+                if (matchFields(words[w], value) & wordMask(w)) {
+                    if (value != MaxRRPV) {
+                        for (uint64_t a = 0; a < wordsPerSet; a++)
+                            words[a] += (MaxRRPV - value) * (LowBits & wordMask(a));
+                    }
+                    return;
+                }
+            }
+        }
+        for (uint64_t a = 0; a < wordsPerSet; a++)
+            words[a] += MaxRRPV * (LowBits & wordMask(a));
+    }
+
+    void setRRPV(uint64_t id, uint64_t value) {
+        uint64_t way = id % ways;
+        uint64_t& word = rrpv[(id / ways) * wordsPerSet + way / WaysPerWord];
+        uint64_t shift = 2 * (way % WaysPerWord);
+        word = (word & ~((uint64_t)3 << shift)) | (value << shift);
+    }
+
+    uint64_t bestCandidate;
+    bool agePending;    // bestCandidate was chosen over lines below MaxRRPV, age its set when it is replaced
+    uint64_t wordsPerSet;
+    uint64_t lastWordMask;
+    std::vector<uint64_t> rrpv;
+};
+
+class SRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction, new lines are predicted to be reused in the intermediate future", SST::MemHierarchy::ReplacementPolicy);
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) { }
+    virtual ~SRRIP() { }
+
+protected:
+    uint64_t insertionRRPV(uint64_t set, uint64_t id, Addr addr) { return MaxRRPV - 1; }
+};
+
+class BRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction, most new lines are predicted to be reused in the distant future, which resists thrashing", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"bimodal_throttle", "One in this many new lines is inserted as in SRRIP rather than as distant", "32"} )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity), bimodalCount(0) {
+        bimodalThrottle = params.find<uint64_t>("bimodal_throttle", 32);
+    }
+    virtual ~BRRIP() { }
+
+protected:
+    uint64_t insertionRRPV(uint64_t set, uint64_t id, Addr addr) {
+        if (++bimodalCount >= bimodalThrottle) {
+            bimodalCount = 0;
+            return MaxRRPV - 1;
+        }
+        return MaxRRPV;
+    }
+
+private:
+    uint64_t bimodalThrottle;
+    uint64_t bimodalCount;
+};
+
+/* Set dueling between SRRIP and BRRIP: a few leader sets always use one or the other and a
+ * saturating counter tracks which of them misses less. The remaining sets follow the winner. */
+class DRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction, chooses between SRRIP and BRRIP insertion using set dueling", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"bimodal_throttle", "BRRIP: one in this many new lines is inserted as in SRRIP rather than as distant", "32"},
+            {"leader_sets", "Number of leader sets dedicated to each of SRRIP and BRRIP", "32"},
+            {"psel_bits", "Width of the policy selection counter", "10"} )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity), bimodalCount(0) {
+        bimodalThrottle = params.find<uint64_t>("bimodal_throttle", 32);
+        uint64_t leaders = params.find<uint64_t>("leader_sets", 32);
+        uint64_t pselBits = params.find<uint64_t>("psel_bits", 10);
+        if (pselBits == 0 || pselBits > 32)
+            pselBits = 10;
+
+        // One SRRIP and one BRRIP leader in each group of constituency sets
+        constituency = leaders ? sets / leaders : sets;
+        if (constituency < 2)
+            constituency = 2;
+
+        pselMax = ((uint64_t)1 << pselBits) - 1;
+        psel = pselMax / 2;
+    }
+    virtual ~DRRIP() { }
+
+protected:
+    uint64_t insertionRRPV(uint64_t set, uint64_t id, Addr addr) {
+        uint64_t member = set % constituency;
+        bool bimodal;
+
+        // Every insertion is a miss; a miss in a leader set is a vote against its policy
+        if (member == 0) {
+            if (psel < pselMax) psel++;
+            bimodal = false;
+        } else if (member == constituency / 2) {
+            if (psel > 0) psel--;
+            bimodal = true;
+        } else {
+            bimodal = psel > pselMax / 2;
+        }
+
+        if (!bimodal)
+            return MaxRRPV - 1;
+        if (++bimodalCount >= bimodalThrottle) {
+            bimodalCount = 0;
+            return MaxRRPV - 1;
+        }
+        return MaxRRPV;
+    }
+
+private:
+    uint64_t bimodalThrottle;
+    uint64_t bimodalCount;
+    uint64_t constituency;
+    uint64_t psel;
+    uint64_t pselMax;
+};
+
+/* Signature-based hit prediction (SHiP-Mem) on top of SRRIP: lines are grouped by memory region,
+ * and a table of saturating counters learns whether lines from each region tend to be reused
+ * before eviction. Lines from regions that are not reused are inserted as distant. */
+class SHiP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(SHiP, "memHierarchy", "replacement.ship", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "signature-based hit prediction, SRRIP with insertion guided by the reuse history of each line's memory region", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"region_size", "Bytes of address space sharing a signature, power of 2", "16384"},
+            {"shct_entries", "Entries in the signature history counter table, power of 2 no greater than 65536", "16384"} )
+
+    SHiP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) {
+        uint64_t regionSize = params.find<uint64_t>("region_size", 16384);
+        uint64_t entries = params.find<uint64_t>("shct_entries", 16384);
+        if (regionSize == 0 || (regionSize & (regionSize - 1)) != 0 || entries == 0 || (entries & (entries - 1)) != 0 || entries > 65536) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: region_size and shct_entries must be powers of 2 and shct_entries no greater than 65536. You specified %" PRIu64 " and %" PRIu64 ".\n",
+                    getName().c_str(), regionSize, entries);
+        }
+
+        regionShift = 0;
+        while (((uint64_t)1 << regionShift) < regionSize)
+            regionShift++;
+        shctMask = entries - 1;
+
+        // Counters start weakly reused so new regions get the SRRIP insertion
+        shct.resize(entries, 1);
+        signature.resize(lines, 0);
+        live.resize((lines + 63) / 64, 0);
+        reused.resize((lines + 63) / 64, 0);
+    }
+
+    virtual ~SHiP() { }
+
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        RRIPBase::update(id, rInfo);
+        if (testBit(live, id)) {
+            setBit(reused, id);
+            if (shct[signature[id]] < MaxCount)
+                shct[signature[id]]++;
+        }
+    }
+
+    void replaced(uint64_t id) {
+        if (testBit(live, id) && !testBit(reused, id) && shct[signature[id]] > 0)
+            shct[signature[id]]--;
+        clearBit(live, id);
+        clearBit(reused, id);
+        RRIPBase::replaced(id);
+    }
+
+protected:
+    uint64_t insertionRRPV(uint64_t set, uint64_t id, Addr addr) {
+        uint64_t region = addr >> regionShift;
+        signature[id] = (region ^ (region >> 16) ^ (region >> 32)) & shctMask;
+        setBit(live, id);
+        clearBit(reused, id);
+        return shct[signature[id]] == 0 ? MaxRRPV : MaxRRPV - 1;
+    }
+
+private:
+    static const uint8_t MaxCount = 7;
+
+    static bool testBit(const std::vector<uint64_t>& bits, uint64_t id) { return (bits[id / 64] >> (id % 64)) & 1; }
+    static void setBit(std::vector<uint64_t>& bits, uint64_t id) { bits[id / 64] |= (uint64_t)1 << (id % 64); }
+    static void clearBit(std::vector<uint64_t>& bits, uint64_t id) { bits[id / 64] &= ~((uint64_t)1 << (id % 64)); }
+
+    uint64_t regionShift;
+    uint64_t shctMask;
+    std::vector<uint8_t> shct;          // 3-bit saturating reuse counters, by signature
+    std::vector<uint16_t> signature;    // Signature of the line at each index
+    std::vector<uint64_t> live;         // Line was installed and has not been replaced since
+    std::vector<uint64_t> reused;       // Line has been hit since it was installed
+};
+
+
 }}
 
 
@@ -0,0 +1,91 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_RINGBUFFER_H
+#define MEMHIERARCHY_RINGBUFFER_H
+
+#include <vector>
+#include <cstddef>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * FIFO over a power-of-two array, used for request queues.
+ *
+ * Elements live in one contiguous allocation that is reused as the queue
+ * drains and refills, so steady-state push/pop never allocates. The capacity
+ * is a soft bound: a push to a full buffer doubles it rather than failing,
+ * since callers upstream of a backend have no way to refuse a request.
+ * Provides the subset of the std::deque interface the queues use.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    RingBuffer(size_t capacity = 16) : head_(0), size_(0) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        buf_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return buf_.size(); }
+
+    T& front() { return buf_[head_]; }
+    T& back() { return buf_[(head_ + size_ - 1) & mask_]; }
+
+    /* i-th element from the front */
+    T& operator[](size_t i) { return buf_[(head_ + i) & mask_]; }
+    const T& operator[](size_t i) const { return buf_[(head_ + i) & mask_]; }
+
+    void push_back(const T& val) {
+        if (size_ == buf_.size())
+            grow();
+        buf_[(head_ + size_) & mask_] = val;
+        size_++;
+    }
+
+    void pop_front() {
+        buf_[head_] = T();
+        head_ = (head_ + 1) & mask_;
+        size_--;
+    }
+
+    void clear() {
+        while (size_ != 0)
+            pop_front();
+        head_ = 0;
+    }
+
+private:
+    void grow() {
+        std::vector<T> buf(buf_.size() * 2);
+        for (size_t i = 0; i < size_; i++)
+            buf[i] = buf_[(head_ + i) & mask_];
+        buf_.swap(buf);
+        head_ = 0;
+        mask_ = buf_.size() - 1;
+    }
+
+    std::vector<T> buf_;
+    size_t head_;
+    size_t size_;
+    size_t mask_;
+};
+
+}}
+
+#endif // MEMHIERARCHY_RINGBUFFER_H
@@ -67,6 +67,9 @@ using namespace SST::MemHierarchy;
  */
 
 Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
+    scratchId_ = EndpointRegistry::intern(getName());
+    cpuId_ = EndpointRegistry::NoEndpoint;
+
     // Output
     int debugLevel = params.find<int>("debug_level", 0);
     dbg.init("", debugLevel, 0, (Output::output_location_t)params.find<int>("debug", 0));
@@ -139,8 +142,8 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -177,6 +180,8 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
         }
     } else if (backingType == "malloc") {
         backing_ = new Backend::BackingMalloc(sizeBytes);
+    } else if (backingType == "sparse") {
+        backing_ = new Backend::BackingSparse(sizeBytes);
     }
 
     // Assume no caching, may change during init
@@ -299,7 +304,7 @@ void Scratchpad::init(unsigned int phase) {
             }
         } else { // Not a NULLCMD
             MemEventInit * memRequest = new MemEventInit(getName(), initEv->getCmd(), initEv->getAddr() - remoteAddrOffset_, initEv->getPayload());
-            memRequest->setDst(linkDown_->findTargetDestination(memRequest->getAddr()));
+            memRequest->setDstId(linkDown_->findTargetDestinationId(memRequest->getAddr()));
             linkDown_->sendInitData(memRequest);
         }
         delete initEv;
@@ -316,7 +321,12 @@ void Scratchpad::init(unsigned int phase) {
 
 
 /* setup. Empty for now */
-void Scratchpad::setup() { }
+void Scratchpad::setup() {
+    // Invalidations always go to the processor-side endpoint, resolve it once
+    if (!linkUp_->getSources()->empty())
+        cpuId_ = EndpointRegistry::intern(linkUp_->getSources()->begin()->name);
+    EndpointRegistry::publish();
+}
 
 
 /*
@@ -440,7 +450,7 @@ bool Scratchpad::clock(Cycle_t cycle) {
 
     while (!memMsgQueue_.empty() && memMsgQueue_.begin()->first < timestamp_) {
         MemEvent * sendEv = memMsgQueue_.begin()->second;
-        sendEv->setDst(linkDown_->findTargetDestination(sendEv->getBaseAddr()));
+        sendEv->setDstId(linkDown_->findTargetDestinationId(sendEv->getBaseAddr()));
 
         if (is_debug_event(sendEv)) {
             debug = true;
@@ -513,8 +523,8 @@ void Scratchpad::handleScratchRead(MemEvent * ev) {
     if (caching_ && !ev->queryFlag(MemEvent::F_NONCACHEABLE)) // Send data in exclusive state to let caches decide what to do with it
         response->setCmd(Command::GetXResp);
 
-    MemEvent * read = new MemEvent(getName(), ev->getAddr(), ev->getBaseAddr(), Command::GetS, ev->getSize());
-    read->setRqstr(ev->getRqstr());
+    MemEvent * read = new MemEvent(scratchId_, ev->getAddr(), ev->getBaseAddr(), Command::GetS, ev->getSize());
+    read->setRqstrId(ev->getRqstrId());
     read->setVirtualAddress(ev->getVirtualAddress());
     read->setInstructionPointer(ev->getInstructionPointer());
 
@@ -523,9 +533,9 @@ void Scratchpad::handleScratchRead(MemEvent * ev) {
     outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
 
     if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        std::vector<uint8_t> data = doScratchRead(read);
+        Payload data = doScratchRead(read);
         response->setPayload(data);
-        mshr_.insert(std::make_pair(ev->getBaseAddr(), std::list<MSHREntry>(1,MSHREntry(ev->getID(), Command::GetS, true, false))));
+        mshr_[ev->getBaseAddr()].push_back(MSHREntry(ev->getID(), Command::GetS, true, false));
         if (caching_ && !ev->queryFlag(MemEvent::F_NONCACHEABLE)) {
             cacheStatus_.at(ev->getBaseAddr()/scratchLineSize_) = true;
         }
@@ -600,8 +610,8 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
     MemEvent * response = nullptr;
     response = ev->makeResponse();
 
-    MemEvent * write = new MemEvent(getName(), ev->getAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload());
-    write->setRqstr(ev->getRqstr());
+    MemEvent * write = new MemEvent(scratchId_, ev->getAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload());
+    write->setRqstrId(ev->getRqstrId());
     write->setVirtualAddress(ev->getVirtualAddress());
     write->setInstructionPointer(ev->getInstructionPointer());
     write->setFlag(MemEvent::F_NORESPONSE);
@@ -610,8 +620,8 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
         /* For directory - jump write ahead of a Put so we have correct data but otherwise
          * do not resolve race by treating writeback as ackinv since it may not actually signal that
          * the block is not present in caches */
-        std::list<MSHREntry>* entry = &(mshr_.find(ev->getBaseAddr())->second);
-        for (std::list<MSHREntry>::iterator it = entry->begin(); it != entry->end(); it++) {
+        AddrQueueMap<MSHREntry>::Queue* entry = &(mshr_.find(ev->getBaseAddr())->second);
+        for (AddrQueueMap<MSHREntry>::Queue::iterator it = entry->begin(); it != entry->end(); it++) {
             if (it->cmd == Command::Put) {
                 if (it == entry->begin()) {
                     doScratchWrite(write);
@@ -675,9 +685,9 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
 
     // Issue remote read
     ev->setSrcBaseAddr((ev->getSrcAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
-    MemEvent * remoteRead = new MemEvent(getName(), ev->getSrcAddr() - remoteAddrOffset_, ev->getSrcBaseAddr(), Command::GetS, ev->getSize());
+    MemEvent * remoteRead = new MemEvent(scratchId_, ev->getSrcAddr() - remoteAddrOffset_, ev->getSrcBaseAddr(), Command::GetS, ev->getSize());
     remoteRead->setFlag(MemEvent::F_NONCACHEABLE);
-    remoteRead->setRqstr(ev->getRqstr());
+    remoteRead->setRqstrId(ev->getRqstrId());
     remoteRead->setVirtualAddress(ev->getSrcVirtualAddress());
     remoteRead->setInstructionPointer(ev->getInstructionPointer());
     responseIDMap_.insert(std::make_pair(remoteRead->getID(), ev->getID()));
@@ -697,7 +707,7 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
         Addr baseAddr = ev->getDstBaseAddr() + i*scratchLineSize_;
         if (mshr_.find(baseAddr) == mshr_.end()) {
             bool needAck = startGet(baseAddr, ev);
-            mshr_.insert(std::make_pair(baseAddr, std::list<MSHREntry>(1, MSHREntry(ev->getID(), Command::Get, true, needAck))));
+            mshr_[baseAddr].push_back(MSHREntry(ev->getID(), Command::Get, true, needAck));
         } else {
             mshr_.find(baseAddr)->second.push_back(MSHREntry(ev->getID(), Command::Get, true));
         }
@@ -732,7 +742,7 @@ void Scratchpad::handleScratchPut(MemEventBase * event) {
     MoveEvent * response = ev->makeResponse();
     ev->setDstBaseAddr((ev->getDstBaseAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
 
-    MemEvent * remoteWrite = new MemEvent(getName(), ev->getDstAddr() - remoteAddrOffset_, ev->getDstBaseAddr(), Command::GetX, ev->getSize());
+    MemEvent * remoteWrite = new MemEvent(scratchId_, ev->getDstAddr() - remoteAddrOffset_, ev->getDstBaseAddr(), Command::GetX, ev->getSize());
     remoteWrite->setZeroPayload(ev->getSize());
     remoteWrite->setFlag(MemEvent::F_NONCACHEABLE);
     remoteWrite->setFlag(MemEvent::F_NORESPONSE);
@@ -748,7 +758,7 @@ void Scratchpad::handleScratchPut(MemEventBase * event) {
 
         if (mshr_.find(baseAddr) == mshr_.end()) {
             bool needAck = startPut(baseAddr, ev);
-            mshr_.insert(std::make_pair(baseAddr, std::list<MSHREntry>(1, MSHREntry(ev->getID(), Command::Put, !needAck, needAck))));
+            mshr_[baseAddr].push_back(MSHREntry(ev->getID(), Command::Put, !needAck, needAck));
         } else {
             mshr_.find(baseAddr)->second.push_back(MSHREntry(ev->getID(), Command::Put));
         }
@@ -847,15 +857,15 @@ void Scratchpad::handleAckInv(MemEventBase * event) {
 
         uint32_t size = deriveSize(addr, baseAddr, request->getSrcAddr(), request->getSize());
 
-        MemEvent * read = new MemEvent(getName(), addr, baseAddr, Command::GetS, size);
-        read->setRqstr(request->getRqstr());
+        MemEvent * read = new MemEvent(scratchId_, addr, baseAddr, Command::GetS, size);
+        read->setRqstrId(request->getRqstrId());
         read->setVirtualAddress(request->getSrcVirtualAddress());
         read->setInstructionPointer(request->getInstructionPointer());
         responseIDMap_.insert(std::make_pair(read->getID(),requestID));
         responseIDAddrMap_.insert(std::make_pair(read->getID(), baseAddr));
 
-        std::vector<uint8_t> data = doScratchRead(read);
-        std::vector<uint8_t> payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
+        Payload data = doScratchRead(read);
+        Payload payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
         uint32_t offset = addr - request->getSrcAddr();
         for (uint32_t i = 0; i < size; i++) {
             payload[i+offset] = data[i];
@@ -892,8 +902,8 @@ void Scratchpad::handleFetchResp(MemEventBase * event) {
 
     // Send a write to scratch if the line was dirty since we forcefully invalidated
     if (response->getDirty()) {
-        MemEvent * write = new MemEvent(getName(), response->getAddr(), baseAddr, Command::PutM, response->getPayload());
-        write->setRqstr(put->getRqstr());
+        MemEvent * write = new MemEvent(scratchId_, response->getAddr(), baseAddr, Command::PutM, response->getPayload());
+        write->setRqstrId(put->getRqstrId());
         write->setVirtualAddress(put->getSrcVirtualAddress());
         write->setInstructionPointer(put->getInstructionPointer());
         write->setFlag(MemEvent::F_NORESPONSE);
@@ -907,7 +917,7 @@ void Scratchpad::handleFetchResp(MemEventBase * event) {
     uint32_t size = deriveSize(addr, baseAddr, put->getSrcAddr(), put->getSize());
 
     // Update write payload
-    std::vector<uint8_t> payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
+    Payload payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
     uint32_t offset = addr - put->getSrcAddr();
     for (uint32_t i = 0; i < size; i++) {
         payload[i+offset] = response->getPayload()[i];
@@ -970,9 +980,9 @@ void Scratchpad::handleRemoteRead(MemEvent * event) {
     stat_RemoteReadReceived->addData(1);
 
     event->setBaseAddr((event->getAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
-    MemEvent * request = new MemEvent(getName(), event->getAddr() - remoteAddrOffset_, event->getBaseAddr(), Command::GetS, event->getSize());
+    MemEvent * request = new MemEvent(scratchId_, event->getAddr() - remoteAddrOffset_, event->getBaseAddr(), Command::GetS, event->getSize());
     request->setFlag(MemEvent::F_NONCACHEABLE); // Use byte not line address
-    request->setRqstr(event->getRqstr());
+    request->setRqstrId(event->getRqstrId());
     request->setVirtualAddress(event->getVirtualAddress());
     request->setInstructionPointer(event->getInstructionPointer());
 
@@ -994,10 +1004,10 @@ void Scratchpad::handleRemoteWrite(MemEvent * event) {
     stat_RemoteWriteReceived->addData(1);
 
     event->setBaseAddr((event->getAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
-    MemEvent * request = new MemEvent(getName(), event->getAddr() - remoteAddrOffset_, event->getBaseAddr(), Command::GetX, event->getPayload());
+    MemEvent * request = new MemEvent(scratchId_, event->getAddr() - remoteAddrOffset_, event->getBaseAddr(), Command::GetX, event->getPayload());
     request->setFlag(MemEvent::F_NORESPONSE);
     request->setFlag(MemEvent::F_NONCACHEABLE);
-    request->setRqstr(event->getRqstr());
+    request->setRqstrId(event->getRqstrId());
     request->setVirtualAddress(event->getVirtualAddress());
     request->setInstructionPointer(event->getInstructionPointer());
 
@@ -1029,9 +1039,9 @@ void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_typ
         // Create write
         uint32_t size = (baseAddr + scratchLineSize_) - addr;
         if (size > bytesLeft) size = bytesLeft;
-        std::vector<uint8_t> data(response->getPayload()[payloadOffset],response->getPayload()[payloadOffset+size]);
-        MemEvent * write = new MemEvent(getName(), addr, baseAddr, Command::PutM, data);
-        write->setRqstr(request->getRqstr());
+        Payload data = response->getPayload().slice(payloadOffset, size);
+        MemEvent * write = new MemEvent(scratchId_, addr, baseAddr, Command::PutM, data);
+        write->setRqstrId(request->getRqstrId());
         write->setVirtualAddress(request->getDstVirtualAddress());
         write->setInstructionPointer(request->getInstructionPointer());
         write->setFlag(MemEvent::F_NORESPONSE);
@@ -1053,7 +1063,7 @@ void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_typ
             if (mshr_.find(baseAddr) == mshr_.end()) {
                 dbg.fatal(CALL_INFO, -1, "ERROR: remoteGetResponse but no matching entry in mshr for address 0x%" PRIx64 "\n", baseAddr);
             }
-            for (std::list<MSHREntry>::iterator it = mshr_.find(baseAddr)->second.begin(); it != mshr_.find(baseAddr)->second.end(); it++) {
+            for (AddrQueueMap<MSHREntry>::Queue::iterator it = mshr_.find(baseAddr)->second.begin(); it != mshr_.find(baseAddr)->second.end(); it++) {
                 if (it->id == requestID) {
                     it->scratch = write;
                     it->needData = false;
@@ -1092,7 +1102,7 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
         MSHREntry * entry = &(mshr_.find(baseAddr)->second.front());
 
         if (entry->cmd == Command::GetS) {
-            std::vector<uint8_t> readData = doScratchRead(entry->scratch);
+            Payload readData = doScratchRead(entry->scratch);
             static_cast<MemEvent*>(outstandingEventList_.find(entry->id)->second.response)->setPayload(readData);
 
             if (is_debug_addr(baseAddr))
@@ -1156,13 +1166,12 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
 }
 
 // Helper methods
-std::vector<uint8_t> Scratchpad::doScratchRead(MemEvent * event) {
+Payload Scratchpad::doScratchRead(MemEvent * event) {
     stat_ScratchReadIssued->addData(1);
 
-    std::vector<uint8_t> data;
-    data.resize(event->getSize(), 0);
+    Payload data(event->getSize());
     if (backing_) {
-        backing_->get(event->getAddr(), event->getSize(), data);
+        backing_->get(event->getAddr(), event->getSize(), data.data());
     }
     dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Scratch:Send  0x%-16" PRIx64 " (%s)\n",
             Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), event->getAddr(), event->getBriefString().c_str());
@@ -1174,7 +1183,8 @@ void Scratchpad::doScratchWrite(MemEvent * event) {
     stat_ScratchWriteIssued->addData(1);
 
     if (backing_) {
-        backing_->set(event->getAddr(), event->getSize(), event->getPayload());
+        const Payload& data = event->getPayload();
+        backing_->set(event->getAddr(), event->getSize(), data.data());
     }
 
     dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Scratch:Send  0x%-16" PRIx64 " (%s)\n",
@@ -1193,9 +1203,9 @@ void Scratchpad::sendResponse(MemEventBase * event) {
  */
 bool Scratchpad::startGet(Addr baseAddr, MoveEvent * get) {
     if (caching_ && cacheStatus_.at(baseAddr/scratchLineSize_) == true) {
-        MemEvent * inv = new MemEvent(getName(), baseAddr, baseAddr, Command::ForceInv, scratchLineSize_);
-        inv->setRqstr(get->getRqstr());
-        inv->setDst(linkUp_->getSources()->begin()->name);
+        MemEvent * inv = new MemEvent(scratchId_, baseAddr, baseAddr, Command::ForceInv, scratchLineSize_);
+        inv->setRqstrId(get->getRqstrId());
+        inv->setDstId(cpuId_);
         inv->setVirtualAddress(get->getDstVirtualAddress());
         inv->setInstructionPointer(get->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
@@ -1213,9 +1223,9 @@ bool Scratchpad::startGet(Addr baseAddr, MoveEvent * get) {
  */
 bool Scratchpad::startPut(Addr baseAddr, MoveEvent * put) {
     if (caching_ && cacheStatus_.at(baseAddr/scratchLineSize_) == true) {
-        MemEvent * inv = new MemEvent(getName(), baseAddr, baseAddr, Command::FetchInv, scratchLineSize_);
-        inv->setRqstr(put->getRqstr());
-        inv->setDst(put->getSrc());
+        MemEvent * inv = new MemEvent(scratchId_, baseAddr, baseAddr, Command::FetchInv, scratchLineSize_);
+        inv->setRqstrId(put->getRqstrId());
+        inv->setDstId(put->getSrcId());
         inv->setVirtualAddress(put->getSrcVirtualAddress());
         inv->setInstructionPointer(put->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Put            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
@@ -1229,16 +1239,16 @@ bool Scratchpad::startPut(Addr baseAddr, MoveEvent * put) {
             addr = put->getSrcAddr();
         uint32_t size = deriveSize(addr, baseAddr, put->getSrcAddr(), put->getSize());
 
-        MemEvent * read = new MemEvent(getName(), addr, baseAddr, Command::GetS, size);
-        read->setRqstr(put->getRqstr());
+        MemEvent * read = new MemEvent(scratchId_, addr, baseAddr, Command::GetS, size);
+        read->setRqstrId(put->getRqstrId());
         read->setVirtualAddress(put->getSrcVirtualAddress());
         read->setInstructionPointer(put->getInstructionPointer());
         responseIDMap_.insert(std::make_pair(read->getID(), put->getID()));
         responseIDAddrMap_.insert(std::make_pair(read->getID(), baseAddr));
 
-        std::vector<uint8_t> data = doScratchRead(read);
+        Payload data = doScratchRead(read);
 
-        std::vector<uint8_t> payload = outstandingEventList_.find(put->getID())->second.remoteWrite->getPayload();
+        Payload payload = outstandingEventList_.find(put->getID())->second.remoteWrite->getPayload();
         uint32_t offset = addr - put->getSrcAddr();
         for (uint32_t i = 0; i < size; i++) {
             payload[i+offset] = data[i];
@@ -29,6 +29,7 @@
 #include "sst/elements/memHierarchy/moveEvent.h"
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/addrHashMap.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -46,8 +47,8 @@ public:
             {"size",                "(string) Size of the scratchpad in bytes (B), SI units ok", NULL},
             {"scratch_line_size",   "(string) Number of bytes in a scratch line with units. 'size' must be divisible by this number.", "64B"},
             {"memory_line_size",    "(string) Number of bytes in a remote memory line with units. Used to set base addresses for routing.", "64B"},
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "malloc"},\
-            {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse'", "malloc"},\
+            {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity. For 'sparse' backing stores, page size", "1MiB"},\
             {"memory_addr_offset",  "(uint) Amount to offset remote addresses by. Default is 'size' so that remote memory addresses start at 0", "size"},
             {"response_per_cycle",  "(uint) Maximum number of responses to return to processor each cycle. 0 is unlimited", "0"},
             {"backendConvertor",    "(string) Backend convertor to use for the scratchpad", "memHierarchy.scratchpadBackendConvertor"},
@@ -86,6 +87,9 @@ public:
     // Output for warnings, etc.
     Output out;
 
+    EndpointId scratchId_;  // This scratchpad, source of the events it builds
+    EndpointId cpuId_;      // Processor-side endpoint, resolved in setup()
+
     // Handler for backend responses
     void handleScratchResponse(SST::Event::id_type id);
 
@@ -136,7 +140,7 @@ private:
     // Helper methods
     void updateMSHR(Addr baseAddr);
 
-    std::vector<uint8_t> doScratchRead(MemEvent * read);
+    Payload doScratchRead(MemEvent * read);
     void doScratchWrite(MemEvent * write);
     void sendResponse(MemEventBase * event);
 
@@ -178,6 +182,9 @@ private:
             bool needData;          // Waiting on data? (from scratch or remote)
             bool needAck;           // Waiting on ack? (from cache)
 
+            // Empty entry, used by the MSHR's entry pool
+            MSHREntry() : scratch(nullptr), cmd(Command::NULLCMD), needData(false), needAck(false) { }
+
             // For events not yet started
             MSHREntry(SST::Event::id_type id, Command cmd, MemEvent * scratch = nullptr) : id(id), scratch(scratch), cmd(cmd), needData(false), needAck(false) { }
 
@@ -225,7 +232,7 @@ private:
     std::map<SST::Event::id_type,SST::Event::id_type> responseIDMap_;   // Map a forwarded request ID to a original request ID
     std::map<SST::Event::id_type,Addr> responseIDAddrMap_;              // Map an outstanding scratch request ID to the request's baseAddr
     std::map<SST::Event::id_type,OutstandingEvent> outstandingEventList_; // List of all outstanding events
-    std::map<Addr,std::list<MSHREntry> > mshr_; // MSHR for scratch accesses
+    AddrQueueMap<MSHREntry> mshr_; // MSHR for scratch accesses
 
 
     // Outgoing message queues - map send timestamp to event
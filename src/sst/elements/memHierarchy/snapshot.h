@@ -0,0 +1,169 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SNAPSHOT_H
+#define MEMHIERARCHY_SNAPSHOT_H
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <sst/core/output.h>
+
+#include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Binary snapshots of warmed cache and directory state.
+ *
+ * A warmup run writes each cache's and directory's stable lines at the end of
+ * simulation; later runs load them during setup so timing experiments start
+ * warm. Memory contents are snapshotted separately by sparse backing stores.
+ *   header:  "SSTMHSNP", uint32 version, string kind
+ *   body:    written by the component named in kind
+ * Integers are stored in host byte order. Endpoints (owners, sharers) are
+ * stored by name since EndpointIds depend on the order names are interned.
+ */
+class SnapshotWriter {
+public:
+    SnapshotWriter(const std::string& file, const std::string& kind) : file_(file) {
+        fp_ = fopen(file.c_str(), "wb");
+        if (!fp_)
+            error("unable to open snapshot file for writing");
+        putBytes(magic(), 8);
+        put((uint32_t)Version);
+        putString(kind);
+    }
+
+    ~SnapshotWriter() {
+        if (fclose(fp_) != 0)
+            error("failed writing snapshot file");
+    }
+
+    template <typename T>
+    void put(const T& val) { putBytes(&val, sizeof(T)); }
+
+    void putBytes(const void* data, size_t size) {
+        if (size != 0 && fwrite(data, 1, size, fp_) != size)
+            error("failed writing snapshot file");
+    }
+
+    void putString(const std::string& str) {
+        put((uint32_t)str.size());
+        putBytes(str.data(), str.size());
+    }
+
+    void putEndpoint(EndpointId id) {
+        putString(id == EndpointRegistry::NoEndpoint ? std::string() : EndpointRegistry::name(id));
+    }
+
+    template <typename Iter>
+    void putEndpoints(Iter begin, Iter end, uint32_t count) {
+        put(count);
+        for (Iter it = begin; it != end; it++)
+            putEndpoint(*it);
+    }
+
+    static const char* magic() { return "SSTMHSNP"; }
+    static const uint32_t Version = 1;
+
+private:
+    void error(const char* msg) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.fatal(CALL_INFO, -1, "Snapshot: Error - %s: %s\n", msg, file_.c_str());
+    }
+
+    std::string file_;
+    FILE* fp_;
+};
+
+class SnapshotReader {
+public:
+    /* Fails unless the file is a snapshot written for kind */
+    SnapshotReader(const std::string& file, const std::string& kind) : file_(file) {
+        fp_ = fopen(file.c_str(), "rb");
+        if (!fp_)
+            error("unable to open snapshot file for reading");
+        char magic[8];
+        getBytes(magic, 8);
+        if (memcmp(magic, SnapshotWriter::magic(), 8) != 0 || get<uint32_t>() != SnapshotWriter::Version)
+            error("not a valid snapshot file");
+        std::string fileKind = getString();
+        if (fileKind != kind) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "Snapshot: Error - %s holds state for a '%s', expected a '%s'\n", file_.c_str(), fileKind.c_str(), kind.c_str());
+        }
+    }
+
+    ~SnapshotReader() { fclose(fp_); }
+
+    template <typename T>
+    T get() {
+        T val;
+        getBytes(&val, sizeof(T));
+        return val;
+    }
+
+    void getBytes(void* data, size_t size) {
+        if (size != 0 && fread(data, 1, size, fp_) != size)
+            error("snapshot file is truncated");
+    }
+
+    std::string getString() {
+        uint32_t size = get<uint32_t>();
+        std::string str(size, '\0');
+        getBytes(&str[0], size);
+        return str;
+    }
+
+    EndpointId getEndpoint() {
+        std::string name = getString();
+        return name.empty() ? EndpointRegistry::NoEndpoint : EndpointRegistry::intern(name);
+    }
+
+    void getEndpoints(std::vector<EndpointId>& ids) {
+        uint32_t count = get<uint32_t>();
+        ids.clear();
+        for (uint32_t i = 0; i < count; i++)
+            ids.push_back(getEndpoint());
+    }
+
+    /* Report a snapshot that does not match the component loading it */
+    void mismatch(const char* what) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.fatal(CALL_INFO, -1, "Snapshot: Error - %s does not match this component: %s\n", file_.c_str(), what);
+    }
+
+private:
+    void error(const char* msg) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.fatal(CALL_INFO, -1, "Snapshot: Error - %s: %s\n", msg, file_.c_str());
+    }
+
+    std::string file_;
+    FILE* fp_;
+};
+
+/* Only lines in stable states are snapshotted; lines with transactions in flight are dropped */
+inline bool isSnapshotState(State state) {
+    return state == S || state == E || state == O || state == M;
+}
+
+}}
+
+#endif // MEMHIERARCHY_SNAPSHOT_H
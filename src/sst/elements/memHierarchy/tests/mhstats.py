@@ -0,0 +1,66 @@
+# Helpers for testsuites that check console statistics instead of matching a reference file.
+# Statistics must be written with sst.statOutputConsole, whose Accumulator lines look like
+#    l2cache.CacheHits : Accumulator : Sum.u64 = 12; SumSQ.u64 = 12; Count.u64 = 12; ...
+# Testsuites outside memHierarchy add this directory to sys.path to import it.
+
+from sst_unittest_support import *
+
+COMPLETE = "Simulation is complete, simulated time:"
+
+# Run an SDL and read its statistics, asserting that the error file is empty and that
+# 'finished' appeared in the output. Returns (outfile, stats) where stats maps each
+# statistic's full name to a dict of its fields, e.g. stats["l2cache.CacheHits"]["Sum.u64"].
+def run_and_read_statistics(test, sdlfile, testDataFileName, model_options="", set_cwd=None, finished=COMPLETE, check_errfile=True):
+    outdir = test.get_test_output_run_dir()
+    outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+    errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+    mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+    other_args = "--model-options=\"{0}\"".format(model_options) if model_options else ""
+    if set_cwd is None:
+        test.run_sst(sdlfile, outfile, errfile, other_args=other_args, mpi_out_files=mpioutfiles)
+    else:
+        test.run_sst(sdlfile, outfile, errfile, set_cwd=set_cwd, other_args=other_args, mpi_out_files=mpioutfiles)
+
+    testing_remove_component_warning_from_file(outfile)
+
+    if check_errfile:
+        test.assertFalse(os_test_file(errfile, "-s"), "{0} has Non-empty Error File {1}".format(testDataFileName, errfile))
+
+    stats, found = read_statistics(outfile, finished)
+    test.assertTrue(found is not None, "{0}: did not find '{1}' in output file {2}".format(testDataFileName, finished, outfile))
+    return outfile, stats
+
+# Parse the Accumulator lines of an output file. Returns (stats, found) where found is the
+# last line containing marker, stripped, or None if there is none.
+def read_statistics(outfile, marker=COMPLETE):
+    stats = {}
+    found = None
+    with open(outfile, 'r') as fp:
+        for line in fp:
+            if marker in line:
+                found = line.strip()
+            if " : Accumulator : " in line:
+                name, values = line.split(" : Accumulator : ", 1)
+                fields = {}
+                for field in values.split(";"):
+                    if " = " in field:
+                        key, value = field.strip().split(" = ", 1)
+                        fields[key] = float(value) if "." in value else int(value)
+                stats[name.strip()] = fields
+    return stats, found
+
+# Total one field of a statistic over every component (and subid) that reports it,
+# optionally only for components whose name starts with 'component'
+def statistic_total(stats, stat, field="Sum.u64", component=""):
+    return sum(fields.get(field, 0) for name, fields in stats.items()
+               if name.startswith(component) and stat in name.split(".")[1:])
+
+# Largest value of one field of a statistic over every component (and subid) that reports it
+def statistic_max(stats, stat, field="Max.u64", component=""):
+    return max([fields.get(field, 0) for name, fields in stats.items()
+                if name.startswith(component) and stat in name.split(".")[1:]] or [0])
+
+# Whether any component whose name starts with 'component' reports the statistic
+def has_statistic(stats, stat, component=""):
+    return any(name.startswith(component) and stat in name.split(".")[1:] for name in stats)
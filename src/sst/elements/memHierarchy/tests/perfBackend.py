@@ -0,0 +1,104 @@
+# Memory backend throughput microbenchmark
+# Drives a memory controller with random (GUPS) misses through a tiny L1 so that the number of
+# requests in flight at the backend convertor is set by the CPU's pending request limit.
+# Compare backends and load levels by timing runs and reading the convertor statistics:
+#   time sst perfBackend.py --model-options="--backend=simpleMem --outstanding=1"
+#   time sst perfBackend.py --model-options="--backend=timingDRAM --outstanding=64"
+#   sst perfBackend.py --model-options="--backend=timingDRAM --scheduler=frfcfs"
+#   for n in 1 2 4 8 16 32 64; do time sst perfBackend.py --model-options="--outstanding=$n"; done
+import sst
+import sys
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--backend", default="simpleMem", help="Memory backend: simpleMem or timingDRAM")
+parser.add_argument("--outstanding", default="16", help="Maximum requests pending at the CPU (1-64)")
+parser.add_argument("--count", default="500000", help="Number of GUPS updates")
+parser.add_argument("--scheduler", default="bank", help="timingDRAM channel scheduler: bank or frfcfs")
+args = parser.parse_args(sys.argv[1:])
+
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stopAtCycle", "0 ns")
+
+memory_mb = 512
+
+cpu = sst.Component("cpu", "miranda.BaseCPU")
+cpu.addParams({
+    "verbose" : 0,
+    "clock" : "2GHz",
+    "max_reqs_cycle" : 2,
+    "maxmemreqpending" : args.outstanding,
+})
+gen = cpu.setSubComponent("generator", "miranda.GUPSGenerator")
+gen.addParams({
+    "verbose" : 0,
+    "count" : args.count,
+    "max_address" : memory_mb * 1024 * 1024 // 2,
+})
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "1",
+    "cache_frequency" : "2 Ghz",
+    "coherence_protocol" : "MESI",
+    "associativity" : "2",
+    "cache_line_size" : "64",
+    "cache_size" : "1KiB",
+    "L1" : "1",
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1.2GHz",
+    "backing" : "none",
+})
+
+if args.backend == "simpleMem":
+    memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+        "access_time" : "50 ns",
+        "mem_size" : str(memory_mb) + "MiB",
+    })
+elif args.backend == "timingDRAM":
+    memory = memctrl.setSubComponent("backend", "memHierarchy.timingDRAM")
+    memory.addParams({
+        "id" : 0,
+        "addrMapper" : "memHierarchy.roundRobinAddrMapper",
+        "addrMapper.interleave_size" : "64B",
+        "addrMapper.row_size" : "1KiB",
+        "clock" : "1.2GHz",
+        "mem_size" : str(memory_mb) + "MiB",
+        "channels" : 2,
+        "channel.numRanks" : 2,
+        "channel.rank.numBanks" : 8,
+        "channel.transaction_Q_size" : 64,
+        "channel.scheduler" : args.scheduler,
+        "channel.rank.bank.CL" : 14,
+        "channel.rank.bank.CL_WR" : 12,
+        "channel.rank.bank.RCD" : 14,
+        "channel.rank.bank.TRP" : 14,
+        "channel.rank.bank.dataCycles" : 2,
+        "channel.rank.bank.pagePolicy" : "memHierarchy.simplePagePolicy",
+        "channel.rank.bank.transactionQ" : "memHierarchy.reorderTransactionQ",
+        "channel.rank.bank.pagePolicy.close" : 0,
+    })
+else:
+    print("Unknown backend: " + args.backend)
+    sys.exit(1)
+
+sst.setStatisticLoadLevel(3)
+sst.setStatisticOutput("sst.statOutputConsole")
+memctrl.enableStatistics(["outstanding_requests", "cycles_with_issue", "cycles_attempted_issue_but_rejected", "total_cycles"])
+if args.backend == "timingDRAM" and args.scheduler == "frfcfs":
+    memory.enableStatistics(["row_already_open", "no_row_open", "wrong_row_open", "bus_turnarounds", "write_drains"])
+    memory.enableStatistics(["read_queue_depth", "write_queue_depth"], {
+        "type" : "sst.HistogramStatistic",
+        "minvalue" : "0",
+        "binwidth" : "8",
+        "numbins" : "8",
+    })
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (cpu, "cache_link", "100ps"), (l1cache, "high_network_0", "100ps") )
+link_l1_mem = sst.Link("link_l1_mem")
+link_l1_mem.connect( (l1cache, "low_network_0", "100ps"), (memctrl, "direct_link", "100ps") )
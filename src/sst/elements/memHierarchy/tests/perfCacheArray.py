@@ -0,0 +1,82 @@
+# Cache array timing workload (a full simulation, not a microbenchmark)
+# Drives a large L2 with random (GUPS) traffic so that cache array lookups and replacements are a
+# large share of simulation wall time. Compare layouts by timing runs with different options:
+#   time sst perfCacheArray.py --model-options="--layout=line"
+#   time sst perfCacheArray.py --model-options="--layout=flat"
+#   time sst perfCacheArray.py --model-options="--event_driven=1 --l2banks=4"
+import sst
+import sys
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--layout", default="line", help="Cache array layout: line or flat")
+parser.add_argument("--l2size", default="8MiB", help="L2 cache size")
+parser.add_argument("--l2assoc", default="16", help="L2 associativity")
+parser.add_argument("--count", default="1000000", help="Number of GUPS updates")
+parser.add_argument("--event_driven", default="0", help="L2 event-driven scheduling: 0 or 1")
+parser.add_argument("--l2banks", default="0", help="L2 banks, 0 for no bank limit")
+args = parser.parse_args(sys.argv[1:])
+
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stopAtCycle", "0 ns")
+
+memory_mb = 1024
+
+cpu = sst.Component("cpu", "miranda.BaseCPU")
+cpu.addParams({
+    "verbose" : 0,
+})
+gen = cpu.setSubComponent("generator", "miranda.GUPSGenerator")
+gen.addParams({
+    "verbose" : 0,
+    "count" : args.count,
+    "max_address" : memory_mb * 1024 * 1024 // 2,
+})
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "2",
+    "cache_frequency" : "2 Ghz",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "32KiB",
+    "L1" : "1",
+    "array_layout" : args.layout,
+})
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2 Ghz",
+    "coherence_protocol" : "MESI",
+    "associativity" : args.l2assoc,
+    "cache_line_size" : "64",
+    "cache_size" : args.l2size,
+    "mshr_num_entries" : "64",
+    "array_layout" : args.layout,
+    "event_driven" : args.event_driven,
+    "banks" : args.l2banks,
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "backing" : "none",
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50 ns",
+    "mem_size" : str(memory_mb) + "MiB",
+})
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+l2cache.enableAllStatistics()
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (cpu, "cache_link", "100ps"), (l1cache, "high_network_0", "100ps") )
+link_l1_l2 = sst.Link("link_l1_l2")
+link_l1_l2.connect( (l1cache, "low_network_0", "100ps"), (l2cache, "high_network_0", "100ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "100ps"), (memctrl, "direct_link", "100ps") )
@@ -0,0 +1,137 @@
+# Replacement policy benchmark
+# Replays a prospero trace (or a miranda generator when no trace is given) through a small L1 and
+# an L2 that uses the selected replacement policy. The miranda workload is a 3D stencil whose planes
+# are reused within a sweep but whose mesh is larger than the L2, so repeated sweeps thrash
+# recency-based policies.
+# Run under sst to simulate one policy; the L2 statistics give the miss rate.
+#   sst perfReplacement.py --model-options="--policy=drrip --trace=sstprospero-0-0-bin.trace --tracetype=Binary"
+# Run with python to simulate each of a list of policies and print the L2 miss rate and the wall time
+# per L2 access (cost per access). Other options are passed through to each sst run.
+#   python perfReplacement.py --policies=lru,srrip,brrip,drrip,ship --mesh=32
+import sys
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--policy", default="lru", help="L2 replacement policy: lru, lfu, mru, random, nmru, srrip, brrip, drrip, or ship")
+parser.add_argument("--trace", default="", help="Prospero trace file; if empty, miranda generates the accesses")
+parser.add_argument("--tracetype", default="Text", help="Prospero trace format: Text, Binary, or CompressedBinary")
+parser.add_argument("--l2size", default="256KiB", help="L2 cache size")
+parser.add_argument("--l2assoc", default="16", help="L2 associativity")
+parser.add_argument("--mesh", default="64", help="Miranda stencil mesh dimension (mesh^3 doubles)")
+parser.add_argument("--iterations", default="4", help="Miranda stencil sweeps over the mesh")
+
+try:
+    import sst
+except ImportError:
+    import os
+    import subprocess
+    import time
+
+    parser.add_argument("--policies", default="lru,srrip,brrip,drrip,ship", help="Comma separated policies to compare")
+    parser.add_argument("--sst", default="sst", help="sst executable")
+    args = parser.parse_args(sys.argv[1:])
+
+    options = ["--%s=%s" % (key, value) for key, value in sorted(vars(args).items()) if key not in ("policy", "policies", "sst")]
+
+    print("%-8s %12s %12s %10s %10s %14s" % ("policy", "accesses", "misses", "miss rate", "wall (s)", "ns per access"))
+    failed = False
+    for policy in args.policies.split(","):
+        start = time.time()
+        proc = subprocess.Popen([args.sst, os.path.abspath(__file__), "--model-options=" + " ".join(options + ["--policy=" + policy])],
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        output = proc.communicate()[0]
+        elapsed = time.time() - start
+        stats = {}
+        for line in output.splitlines():
+            if " : Accumulator : " in line:
+                name, values = line.split(" : Accumulator : ", 1)
+                fields = dict(field.strip().split(" = ") for field in values.split(";") if " = " in field)
+                if name.strip().startswith("l2cache"):
+                    stat = name.strip().split(".")[-1]
+                    stats[stat] = stats.get(stat, 0) + int(fields.get("Sum.u64", 0))
+        hits = stats.get("CacheHits", 0)
+        misses = stats.get("CacheMisses", 0)
+        if proc.returncode != 0 or hits + misses == 0:
+            print("%-8s sst failed (%d)" % (policy, proc.returncode))
+            failed = True
+            continue
+        accesses = hits + misses
+        print("%-8s %12d %12d %10.4f %10.2f %14.1f" % (policy, accesses, misses, float(misses) / accesses, elapsed, elapsed * 1e9 / accesses))
+    sys.exit(1 if failed else 0)
+
+args = parser.parse_args(sys.argv[1:])
+
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stopAtCycle", "0 ns")
+
+memory_mb = 1024
+
+if args.trace != "":
+    cpu = sst.Component("cpu", "prospero.prosperoCPU")
+    cpu.addParams({
+        "verbose" : 0,
+        "reader" : "prospero.Prospero" + args.tracetype + "TraceReader",
+        "readerParams.file" : args.trace,
+    })
+else:
+    cpu = sst.Component("cpu", "miranda.BaseCPU")
+    cpu.addParams({
+        "verbose" : 0,
+        "clock" : "2GHz",
+        "maxmemreqpending" : 16,
+    })
+    gen = cpu.setSubComponent("generator", "miranda.Stencil3DBenchGenerator")
+    gen.addParams({
+        "verbose" : 0,
+        "nx" : args.mesh,
+        "ny" : args.mesh,
+        "nz" : args.mesh,
+        "startz" : 0,
+        "endz" : args.mesh,
+        "iterations" : args.iterations,
+    })
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "2",
+    "cache_frequency" : "2 Ghz",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "16KiB",
+    "L1" : "1",
+})
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2 Ghz",
+    "coherence_protocol" : "MESI",
+    "associativity" : args.l2assoc,
+    "cache_line_size" : "64",
+    "cache_size" : args.l2size,
+    "mshr_num_entries" : "64",
+    "replacement_policy" : args.policy,
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "backing" : "none",
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50 ns",
+    "mem_size" : str(memory_mb) + "MiB",
+})
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+l2cache.enableAllStatistics()
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (cpu, "cache_link", "100ps"), (l1cache, "high_network_0", "100ps") )
+link_l1_l2 = sst.Link("link_l1_l2")
+link_l1_l2.connect( (l1cache, "low_network_0", "100ps"), (l2cache, "high_network_0", "100ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "100ps"), (memctrl, "direct_link", "100ps") )
@@ -1,8 +1,15 @@
 # Automatically generated SST Python input
 import sst
+import sys
+import argparse
 from mhlib import componentlist
 
 # Test timingDRAM with transactionQ = reorderTransactionQ and AddrMapper=roundRobinAddrMapper and pagepolicy=simplePagePolicy(open)
+# --scheduler=frfcfs swaps the per-bank queues for the channel's FR-FCFS scheduler, with watermarks
+# low enough that the channel drains writes
+parser = argparse.ArgumentParser()
+parser.add_argument("--scheduler", default="bank", help="timingDRAM channel scheduler: bank or frfcfs")
+args = parser.parse_args(sys.argv[1:])
 
 # Define the simulation components
 cpu_params = {
@@ -146,6 +153,12 @@ memory.addParams({
     "channel.rank.printconfig" : 0,
     "channel.rank.bank.printconfig" : 0,
 })
+if args.scheduler == "frfcfs":
+    memory.addParams({
+        "channel.scheduler" : "frfcfs",
+        "channel.write_high_watermark" : 4,
+        "channel.write_low_watermark" : 1,
+    })
 
 # Do lower memory hierarchy links
 link_bus_l3 = sst.Link("link_bus_l3")
@@ -163,4 +176,5 @@ sst.setStatisticLoadLevel(7)
 sst.setStatisticOutput("sst.statOutputConsole")
 for a in componentlist:
     sst.enableAllStatisticsForComponentType(a)
-
+if args.scheduler == "frfcfs":
+    memory.enableAllStatistics()
@@ -0,0 +1,88 @@
+# Event-driven cache scheduling functional test
+# Two trivialCPUs issue faster than their L1s' small MSHRs can drain, so the L1s reject requests
+# every few cycles, and both L1s share a bus to an L2. --event_driven sets event_driven on every
+# cache and --banks sets each cache's bank count. Scheduling must not change the simulation, so a
+# run with --event_driven=1 must match the same run with --event_driven=0.
+#   sst testEventDriven.py --model-options="--event_driven=1 --banks=2"
+import sst
+import sys
+import argparse
+from mhlib import componentlist
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--event_driven", type=int, default=0, help="Set event_driven on every cache")
+parser.add_argument("--banks", type=int, default=0, help="Banks per cache, 0 for unbanked")
+args = parser.parse_args(sys.argv[1:])
+
+verbose = 2
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "2 Ghz" })
+
+for x in range(2):
+    cpu = sst.Component("cpu" + str(x), "memHierarchy.trivialCPU")
+    cpu.addParams({
+        "memSize" : "0x10000",
+        "num_loadstore" : "4000",
+        "commFreq" : "2",
+        "rngseed" : 7 + x,
+        "do_write" : "1",
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+    l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "4",
+        "cache_frequency" : "2 Ghz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "2",
+        "cache_line_size" : "64",
+        "cache_size" : "2 KiB",
+        "mshr_num_entries" : "4",
+        "banks" : args.banks,
+        "L1" : "1",
+        "event_driven" : args.event_driven,
+        "verbose" : verbose,
+    })
+
+    link_cpu_l1cache = sst.Link("link_cpu_l1cache_" + str(x))
+    link_cpu_l1cache.connect( (iface, "port", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+    link_l1cache_bus = sst.Link("link_l1cache_bus_" + str(x))
+    link_l1cache_bus.connect( (l1cache, "low_network_0", "1000ps"), (bus, "high_network_" + str(x), "1000ps") )
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "16 KiB",
+    "mshr_num_entries" : "8",
+    "banks" : args.banks,
+    "event_driven" : args.event_driven,
+    "verbose" : verbose,
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100 ns",
+    "mem_size" : "512MiB",
+})
+
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+link_bus_l2cache = sst.Link("link_bus_l2cache")
+link_bus_l2cache.connect( (bus, "low_network_0", "1000ps"), (l2cache, "high_network_0", "1000ps") )
+link_l2cache_mem = sst.Link("link_l2cache_mem")
+link_l2cache_mem.connect( (l2cache, "low_network_0", "10000ps"), (memctrl, "direct_link", "10000ps") )
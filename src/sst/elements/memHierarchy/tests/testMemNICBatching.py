@@ -0,0 +1,120 @@
+# MemNIC batching
+# Read/write trivialCPUs with private L1s share a 32 line footprint through one directory over
+# merlin, so the network carries many data-less requests, invalidations and acks for the NICs
+# to coalesce.
+#   sst testMemNICBatching.py --model-options="--batch_cycles=10"
+import sst
+import sys
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--cores", type=int, default=4, help="Number of CPUs, each with a private L1")
+parser.add_argument("--batching", type=int, default=1, help="Enable batching in every MemNIC")
+parser.add_argument("--batch_cycles", type=int, default=0, help="Cycles a message may wait for others to the same destination")
+args = parser.parse_args(sys.argv[1:])
+
+cores = args.cores
+coreclock = "2.4GHz"
+uncoreclock = "1.4GHz"
+network_bw = "60GB/s"
+
+nic_params = {
+    "network_bw" : network_bw,
+    "batching" : args.batching,
+    "batch_cycles" : args.batch_cycles,
+}
+
+comp_network = sst.Component("network", "merlin.hr_router")
+comp_network.addParams({
+      "xbar_bw" : network_bw,
+      "link_bw" : network_bw,
+      "input_buf_size" : "2KiB",
+      "num_ports" : cores + 2,
+      "flit_size" : "36B",
+      "output_buf_size" : "2KiB",
+      "id" : "0",
+})
+comp_network.setSubComponent("topology","merlin.singlerouter")
+
+nics = []
+for x in range(cores):
+    comp_cpu = sst.Component("cpu" + str(x), "memHierarchy.trivialCPU")
+    comp_cpu.addParams({
+        "clock" : coreclock,
+        "commFreq" : 4,
+        "rngseed" : 20+x,
+        "do_write" : 1,
+        "num_loadstore" : 2000,
+        "memSize" : 32*64,
+        "verbose" : 1,
+    })
+    iface = comp_cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+    l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    l1cache.addParams({
+        "cache_frequency" : coreclock,
+        "access_latency_cycles" : 3,
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "cache_size" : "1KiB",  # Half the footprint, so lines are also evicted
+        "associativity" : 2,
+        "L1" : 1,
+    })
+    l1toC = l1cache.setSubComponent("cpulink", "memHierarchy.MemLink")
+    l1NIC = l1cache.setSubComponent("memlink", "memHierarchy.MemNIC")
+    l1NIC.addParams(nic_params)
+    l1NIC.addParams({ "group" : 1 })
+    nics.append(l1NIC)
+
+    cpu_l1_link = sst.Link("link_cpu_cache_" + str(x))
+    cpu_l1_link.connect ( (iface, "port", "500ps"), (l1toC, "port", "500ps") )
+
+    l1_network_link = sst.Link("link_l1_network_" + str(x))
+    l1_network_link.connect( (l1NIC, "port", "100ps"), (comp_network, "port" + str(x), "100ps") )
+
+dirctrl = sst.Component("directory", "memHierarchy.DirectoryController")
+dirctrl.addParams({
+    "clock" : uncoreclock,
+    "coherence_protocol" : "MESI",
+    "entry_cache_size" : 32768,
+    "addr_range_start" : 0,
+})
+dirNIC = dirctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+dirNIC.addParams(nic_params)
+dirNIC.addParams({
+    "group" : 2,
+    "network_input_buffer_size" : "2KiB",
+    "network_output_buffer_size" : "2KiB",
+})
+nics.append(dirNIC)
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "500MHz",
+    "backing" : "none",
+    "addr_range_start" : 0,
+})
+memNIC = memctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+memNIC.addParams(nic_params)
+memNIC.addParams({
+    "group" : 3,
+    "network_input_buffer_size" : "2KiB",
+    "network_output_buffer_size" : "2KiB",
+})
+nics.append(memNIC)
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50 ns",
+    "mem_size" : "512MiB",
+})
+
+link_directory_network = sst.Link("link_directory_network")
+link_directory_network.connect( (dirNIC, "port", "100ps"), (comp_network, "port" + str(cores), "100ps") )
+link_memory_network = sst.Link("link_memory_network")
+link_memory_network.connect( (memNIC, "port", "100ps",), (comp_network, "port" + str(cores + 1), "100ps") )
+
+sst.setStatisticLoadLevel(5)
+sst.setStatisticOutput("sst.statOutputConsole")
+if args.batching:
+    for nic in nics:
+        nic.enableStatistics(["batch_size"])
@@ -0,0 +1,73 @@
+# MultiThreadL1 arbitration functional test
+# Three trivialCPU threads share one L1 through a multithreadL1 shim that forwards one request
+# per cycle, so the threads contend under the arbitration given by --arbitration (default oldest).
+# For bandwidth arbitration thread 0 is weighted 2 and the others 1.
+#   sst testMultithreadL1.py --model-options="--arbitration=roundrobin"
+import sst
+import sys
+import argparse
+from mhlib import componentlist
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--arbitration", default="oldest", help="multithreadL1 arbitration")
+args = parser.parse_args(sys.argv[1:])
+
+verbose = 2
+
+smt = sst.Component("smt", "memHierarchy.multithreadL1")
+smt.addParams({
+    "clock" : "2GHz",
+    "requests_per_cycle" : 1,
+    "responses_per_cycle" : 1,
+    "arbitration" : args.arbitration,
+    "thread_weights" : "[2,1,1]",
+    "thread_statistics" : "true",
+})
+
+for thread in range(3):
+    cpu = sst.Component("cpu" + str(thread), "memHierarchy.trivialCPU")
+    cpu.addParams({
+        "memSize" : "0x10000",
+        "num_loadstore" : "2000",
+        "commFreq" : "2",
+        "rngseed" : str(7 + thread),
+        "do_write" : "1",
+        "clock" : "2GHz",
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+    link_cpu_smt = sst.Link("link_cpu{0}_smt".format(thread))
+    link_cpu_smt.connect( (iface, "port", "500ps"), (smt, "thread" + str(thread), "500ps") )
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "4",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+    "associativity" : "4",
+    "cache_line_size" : "64",
+    "cache_size" : "8 KiB",
+    "L1" : "1",
+    "verbose" : verbose,
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100 ns",
+    "mem_size" : "512MiB",
+})
+
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+link_smt_l1cache = sst.Link("link_smt_l1cache")
+link_smt_l1cache.connect( (smt, "cache", "500ps"), (l1cache, "high_network_0", "500ps") )
+link_mem_bus = sst.Link("link_mem_bus_link")
+link_mem_bus.connect( (l1cache, "low_network_0", "10000ps"), (memctrl, "direct_link", "10000ps") )
@@ -0,0 +1,76 @@
+# Replacement policy functional test
+# A trivialCPU whose footprint is four times the L2 drives a 2-level hierarchy, so the L2 evicts
+# constantly with the replacement policy given by --policy (default srrip). --layout sets both
+# caches' array_layout.
+#   sst testReplacement.py --model-options="--policy=ship"
+#   sst testReplacement.py --model-options="--policy=lru --layout=flat"
+import sst
+import sys
+import argparse
+from mhlib import componentlist
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--policy", default="srrip", help="L2 replacement policy")
+parser.add_argument("--layout", default="line", help="Cache array layout: line or flat")
+args = parser.parse_args(sys.argv[1:])
+
+verbose = 2
+
+cpu = sst.Component("cpu", "memHierarchy.trivialCPU")
+cpu.addParams({
+      "memSize" : "0x10000",
+      "num_loadstore" : "5000",
+      "commFreq" : "100",
+      "do_write" : "1"
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "4",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+    "associativity" : "4",
+    "cache_line_size" : "64",
+    "cache_size" : "2 KiB",
+    "L1" : "1",
+    "array_layout" : args.layout,
+    "verbose" : verbose,
+})
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : args.policy,
+    "coherence_protocol" : "MSI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "16 KiB",
+    "array_layout" : args.layout,
+    "verbose" : verbose,
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100 ns",
+    "mem_size" : "512MiB",
+})
+
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+link_cpu_l1cache = sst.Link("link_cpu_l1cache_link")
+link_cpu_l1cache.connect( (iface, "port", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+link_l1cache_l2cache = sst.Link("link_l1cache_l2cache_link")
+link_l1cache_l2cache.connect( (l1cache, "low_network_0", "10000ps"), (l2cache, "high_network_0", "1000ps") )
+link_mem_bus = sst.Link("link_mem_bus_link")
+link_mem_bus.connect( (l2cache, "low_network_0", "10000ps"), (memctrl, "direct_link", "10000ps") )
@@ -0,0 +1,127 @@
+# Cache snapshot round trip
+# A trivialCPU warms a 2-level hierarchy and each cache writes its lines to a snapshot at the end of
+# the run. Loading those snapshots into a run with no accesses and saving again must reproduce them.
+# --directory=1 puts a DirectoryController, reached over merlin, between the L2 and memory and
+# snapshots it as well.
+#   sst testSnapshot.py --model-options="--accesses=1000 --out=warm"
+#   sst testSnapshot.py --model-options="--accesses=0 --in=warm --out=restored"
+#   sst testSnapshot.py --model-options="--directory=1 --accesses=1000 --out=warm"
+import sst
+import sys
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--accesses", default="1000", help="Loads and stores issued by the CPU")
+parser.add_argument("--in", dest="snapin", default="", help="Prefix of the snapshots to load, <prefix>-l1.snap, <prefix>-l2.snap and <prefix>-dir.snap")
+parser.add_argument("--out", dest="snapout", default="", help="Prefix of the snapshots to write")
+parser.add_argument("--directory", type=int, default=0, help="Put a directory between the L2 and memory")
+args = parser.parse_args(sys.argv[1:])
+
+verbose = 2
+
+def snapshot(comp, name):
+    if args.snapin != "":
+        comp.addParams({ "snapshot_in_file" : args.snapin + "-" + name + ".snap" })
+    if args.snapout != "":
+        comp.addParams({ "snapshot_out_file" : args.snapout + "-" + name + ".snap" })
+
+cpu = sst.Component("cpu", "memHierarchy.trivialCPU")
+cpu.addParams({
+      "memSize" : "0x4000",
+      "num_loadstore" : args.accesses,
+      "commFreq" : "100",
+      "do_write" : "1"
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "4",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "4",
+    "cache_line_size" : "64",
+    "cache_size" : "2 KiB",
+    "L1" : "1",
+    "verbose" : verbose,
+})
+snapshot(l1cache, "l1")
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "8 KiB",
+    "verbose" : verbose,
+})
+snapshot(l2cache, "l2")
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100 ns",
+    "mem_size" : "512MiB",
+})
+
+link_cpu_l1cache = sst.Link("link_cpu_l1cache_link")
+link_cpu_l1cache.connect( (iface, "port", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+if args.directory:
+    # A cache with a NIC needs its link to the L1 declared as a subcomponent too
+    l2toL1 = l2cache.setSubComponent("cpulink", "memHierarchy.MemLink")
+    link_l1cache_l2cache = sst.Link("link_l1cache_l2cache_link")
+    link_l1cache_l2cache.connect( (l1cache, "low_network_0", "10000ps"), (l2toL1, "port", "1000ps") )
+
+    l2NIC = l2cache.setSubComponent("memlink", "memHierarchy.MemNIC")
+    l2NIC.addParams({
+        "group" : 1,
+        "network_bw" : "25GB/s",
+    })
+
+    network = sst.Component("network", "merlin.hr_router")
+    network.addParams({
+        "xbar_bw" : "25GB/s",
+        "link_bw" : "25GB/s",
+        "input_buf_size" : "1KiB",
+        "num_ports" : 2,
+        "flit_size" : "72B",
+        "output_buf_size" : "1KiB",
+        "id" : "0",
+    })
+    network.setSubComponent("topology", "merlin.singlerouter")
+
+    dirctrl = sst.Component("directory", "memHierarchy.DirectoryController")
+    dirctrl.addParams({
+        "coherence_protocol" : "MESI",
+        "entry_cache_size" : 1024,
+        "addr_range_start" : 0,
+        "verbose" : verbose,
+    })
+    snapshot(dirctrl, "dir")
+    dirNIC = dirctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+    dirNIC.addParams({
+        "group" : 2,
+        "network_bw" : "25GB/s",
+    })
+    dirMemLink = dirctrl.setSubComponent("memlink", "memHierarchy.MemLink")
+    memToDir = memctrl.setSubComponent("cpulink", "memHierarchy.MemLink")
+
+    link_l2_network = sst.Link("link_l2_network")
+    link_l2_network.connect( (l2NIC, "port", "1000ps"), (network, "port0", "1000ps") )
+    link_dir_network = sst.Link("link_dir_network")
+    link_dir_network.connect( (dirNIC, "port", "1000ps"), (network, "port1", "1000ps") )
+    link_dir_mem = sst.Link("link_dir_mem")
+    link_dir_mem.connect( (dirMemLink, "port", "10000ps"), (memToDir, "port", "10000ps") )
+else:
+    link_l1cache_l2cache = sst.Link("link_l1cache_l2cache_link")
+    link_l1cache_l2cache.connect( (l1cache, "low_network_0", "10000ps"), (l2cache, "high_network_0", "1000ps") )
+    link_mem_bus = sst.Link("link_mem_bus_link")
+    link_mem_bus.connect( (l2cache, "low_network_0", "10000ps"), (memctrl, "direct_link", "10000ps") )
@@ -3,6 +3,12 @@
 from sst_unittest import *
 from sst_unittest_support import *
 
+import filecmp
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, dirpath)
+from mhstats import *
+
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
 
@@ -109,8 +115,201 @@ class testcase_memHierarchy_Component(SSTTestCase):
     def test_memHierarchy_sdl9_2(self):
         self.memHierarchy_Template("sdl9-2")
 
+    def test_memHierarchy_replacement_srrip(self):
+        self.memHierarchy_replacement_Template("srrip")
+
+    def test_memHierarchy_replacement_brrip(self):
+        self.memHierarchy_replacement_Template("brrip")
+
+    def test_memHierarchy_replacement_drrip(self):
+        self.memHierarchy_replacement_Template("drrip")
+
+    def test_memHierarchy_replacement_ship(self):
+        self.memHierarchy_replacement_Template("ship")
+
+    def test_memHierarchy_array_layout_flat(self):
+        self.memHierarchy_array_layout_Template("flat")
+
+    def test_memHierarchy_event_driven_unbanked(self):
+        self.memHierarchy_event_driven_Template(0)
+
+    def test_memHierarchy_event_driven_banked(self):
+        self.memHierarchy_event_driven_Template(2)
+
+    def test_memHierarchy_multithreadL1_oldest(self):
+        self.memHierarchy_multithreadL1_Template("oldest")
+
+    def test_memHierarchy_multithreadL1_roundrobin(self):
+        self.memHierarchy_multithreadL1_Template("roundrobin")
+
+    def test_memHierarchy_multithreadL1_bandwidth(self):
+        self.memHierarchy_multithreadL1_Template("bandwidth")
+
+    def test_memHierarchy_memNIC_batching_0(self):
+        self.memHierarchy_memNIC_batching_Template(0)
+
+    def test_memHierarchy_memNIC_batching_10(self):
+        self.memHierarchy_memNIC_batching_Template(10)
+
+    # The scheduler reorders requests, so rather than matching a reference file every CPU
+    # must finish and the channels must have switched between reading and draining writes
+    def test_memHierarchy_timingDRAM_frfcfs(self):
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/testBackendTimingDRAM-1.py".format(test_path)
+
+        outfile, stats = run_and_read_statistics(self, sdlfile, "test_memHierarchy_timingDRAM_frfcfs", "--scheduler=frfcfs", set_cwd=test_path, check_errfile=False)
+
+        with open(outfile, 'r') as fp:
+            completed = sum(1 for line in fp if "TrivialCPU: Test Completed Successfuly" in line)
+        self.assertEqual(completed, 8, "timingDRAM frfcfs test: {0} of 8 CPUs completed all their requests".format(completed))
+        for stat in ["row_already_open", "no_row_open", "wrong_row_open", "bus_turnarounds", "write_drains"]:
+            self.assertTrue(has_statistic(stats, stat), "timingDRAM frfcfs test: statistic {0} missing from {1}".format(stat, outfile))
+        issued = sum(statistic_total(stats, stat) for stat in ["row_already_open", "no_row_open", "wrong_row_open"])
+        self.assertTrue(issued > 0, "timingDRAM frfcfs test: the scheduler issued no transactions")
+        self.assertTrue(statistic_total(stats, "write_drains") > 0, "timingDRAM frfcfs test: the channels never drained writes")
+        self.assertTrue(statistic_total(stats, "bus_turnarounds") > 0, "timingDRAM frfcfs test: the data bus never switched between reads and writes")
+
+    @unittest.skipIf(testing_check_get_num_ranks() > 1, "memHierarchy: test_memHierarchy_snapshot skipped if ranks > 1")
+    def test_memHierarchy_snapshot(self):
+        self.memHierarchy_snapshot_Template("test_memHierarchy_snapshot", False)
+
+    @unittest.skipIf(testing_check_get_num_ranks() > 1, "memHierarchy: test_memHierarchy_snapshot_directory skipped if ranks > 1")
+    def test_memHierarchy_snapshot_directory(self):
+        self.memHierarchy_snapshot_Template("test_memHierarchy_snapshot_directory", True)
+
+    def test_memHierarchy_directory_footprint(self):
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/testDirectoryFootprint.py".format(test_path)
+
+        # Up to four sharers fit inline in a directory entry; with eight cores each of the
+        # 32 shared lines needs sharer storage outside the entry, which the peak must include
+        footprint = {}
+        for cores in [4, 8]:
+            testDataFileName = "test_memHierarchy_directory_footprint_{0}".format(cores)
+            outfile, stats = run_and_read_statistics(self, sdlfile, testDataFileName, "--cores={0}".format(cores), set_cwd=test_path, check_errfile=False)
+            self.assertTrue(has_statistic(stats, "directory_footprint"), "directory_footprint missing from {0}".format(outfile))
+            footprint[cores] = statistic_total(stats, "directory_footprint")
+
+        self.assertTrue(footprint[4] > 0, "directory footprint with 4 cores is 0")
+        self.assertTrue(footprint[8] >= footprint[4] + 32 * 8,
+                "directory footprint with 8 cores ({0} bytes) does not include sharer storage beyond 4 cores ({1} bytes)".format(footprint[8], footprint[4]))
+
 #####
 
+    # Warm the caches (and directory) and save them, then load the snapshots into a run that
+    # makes no accesses and save them again; the two must be identical
+    def memHierarchy_snapshot_Template(self, testcase, directory):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        sdlfile = "{0}/testSnapshot.py".format(test_path)
+
+        runs = [("warm", "--accesses=1000 --out={0}/{1}_warm".format(outdir, testcase)),
+                ("restored", "--accesses=0 --in={0}/{1}_warm --out={0}/{1}_restored".format(outdir, testcase))]
+        for (name, options) in runs:
+            outfile = "{0}/{1}_{2}.out".format(outdir, testcase, name)
+            errfile = "{0}/{1}_{2}.err".format(outdir, testcase, name)
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args="--model-options=\"--directory={0} {1}\"".format(int(directory), options))
+            self.assertFalse(os_test_file(errfile, "-s"), "snapshot {0} run has Non-empty Error File {1}".format(name, errfile))
+
+        for comp in ["l1", "l2", "dir"] if directory else ["l1", "l2"]:
+            warm = "{0}/{1}_warm-{2}.snap".format(outdir, testcase, comp)
+            restored = "{0}/{1}_restored-{2}.snap".format(outdir, testcase, comp)
+            self.assertTrue(os.path.getsize(warm) > 64, "snapshot of {0} after warmup holds no entries: {1}".format(comp, warm))
+            self.assertTrue(filecmp.cmp(warm, restored, shallow=False), "snapshot of {0} changed after a load and save: {1} and {2} differ".format(comp, warm, restored))
+
+    # The outcome of each access depends on the policy, so rather than matching a reference
+    # file the run must finish every access with the L2 evicting under the policy
+    def memHierarchy_replacement_Template(self, policy):
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/testReplacement.py".format(test_path)
+
+        outfile, stats = run_and_read_statistics(self, sdlfile, "test_memHierarchy_replacement_{0}".format(policy), "--policy={0}".format(policy), set_cwd=test_path, check_errfile=False)
+
+        # Statistics of the L2's subcomponents are named after the L2 as well
+        for stat in ["CacheHits", "CacheMisses", "evict_M", "evict_S"]:
+            self.assertTrue(has_statistic(stats, stat, "l2cache"), "replacement test {0}: L2 statistic {1} missing from {2}".format(policy, stat, outfile))
+        self.assertTrue(statistic_total(stats, "CacheHits", component="l2cache") > 0, "replacement test {0}: no L2 hits".format(policy))
+        self.assertTrue(statistic_total(stats, "CacheMisses", component="l2cache") > 0, "replacement test {0}: no L2 misses".format(policy))
+        evictions = statistic_total(stats, "evict_M", component="l2cache") + statistic_total(stats, "evict_S", component="l2cache")
+        self.assertTrue(evictions > 0, "replacement test {0}: the L2 never evicted".format(policy))
+
+    # The layout only changes how lookups find a tag, so a run with it must produce exactly the
+    # statistics and end time of the default line layout
+    def memHierarchy_array_layout_Template(self, layout):
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/testReplacement.py".format(test_path)
+
+        results = {}
+        for name in ("line", layout):
+            testDataFileName = "test_memHierarchy_array_layout_{0}".format(name)
+            outfile, stats = run_and_read_statistics(self, sdlfile, testDataFileName, "--policy=lru --layout={0}".format(name), set_cwd=test_path, check_errfile=False)
+            results[name] = (read_statistics(outfile)[1], stats)
+
+        self.assertTrue(statistic_total(results["line"][1], "CacheHits", component="l2cache") > 0, "array layout test: no L2 hits with the line layout")
+        self.assertEqual(results[layout][0], results["line"][0], "array layout {0} changed the simulated end time".format(layout))
+        self.assertEqual(results[layout][1], results["line"][1], "array layout {0} changed the statistics of the line layout".format(layout))
+
+    # Batching changes when messages reach the network, so rather than matching a reference file
+    # every CPU must finish all its accesses and the NICs must have sent batched packets
+    def memHierarchy_memNIC_batching_Template(self, batch_cycles):
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/testMemNICBatching.py".format(test_path)
+        cores = 4
+
+        testDataFileName = "test_memHierarchy_memNIC_batching_{0}".format(batch_cycles)
+        outfile, stats = run_and_read_statistics(self, sdlfile, testDataFileName, "--cores={0} --batch_cycles={1}".format(cores, batch_cycles), set_cwd=test_path)
+
+        with open(outfile, 'r') as fp:
+            completed = sum(1 for line in fp if "TrivialCPU: Test Completed Successfuly" in line)
+        packets = statistic_total(stats, "batch_size", "Count.u64")
+        messages = statistic_total(stats, "batch_size")
+
+        self.assertEqual(completed, cores, "memNIC batching test {0}: {1} of {2} CPUs completed all their requests".format(batch_cycles, completed, cores))
+        self.assertTrue(packets > 0, "memNIC batching test {0}: batch_size recorded no packets in {1}".format(batch_cycles, outfile))
+        self.assertTrue(messages >= packets, "memNIC batching test {0}: {1} packets carried only {2} messages".format(batch_cycles, packets, messages))
+        if batch_cycles > 0:
+            self.assertTrue(messages > packets, "memNIC batching test {0}: no packet carried more than one message".format(batch_cycles))
+
+    # Event-driven scheduling only skips retries that cannot succeed, so a run with it must produce
+    # exactly the output of the same clocked run
+    def memHierarchy_event_driven_Template(self, banks):
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/testEventDriven.py".format(test_path)
+
+        outfiles = {}
+        for event_driven in (0, 1):
+            testDataFileName = "test_memHierarchy_event_driven_{0}_banks{1}".format(event_driven, banks)
+            outfiles[event_driven], stats = run_and_read_statistics(self, sdlfile, testDataFileName, "--event_driven={0} --banks={1}".format(event_driven, banks), set_cwd=test_path, check_errfile=False)
+            if banks != 0 and event_driven == 0:
+                self.assertTrue(statistic_total(stats, "Bank_conflicts") > 0, "event-driven test with {0} banks: no bank conflicts in {1}".format(banks, outfiles[0]))
+
+        # Sorted, since with several ranks or threads output lines can interleave differently
+        output = {}
+        for event_driven, outfile in outfiles.items():
+            with open(outfile, 'r') as fp:
+                output[event_driven] = sorted(fp.readlines())
+        self.assertTrue(output[0] == output[1], "event-driven test with {0} banks: output {1} does not match the clocked output {2}".format(banks, outfiles[1], outfiles[0]))
+
+    # The order threads are served in depends on the arbitration, so rather than matching a
+    # reference file every thread must get a response for each request it sent and every
+    # request must have passed through arbitration
+    def memHierarchy_multithreadL1_Template(self, arbitration):
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/testMultithreadL1.py".format(test_path)
+
+        outfile, stats = run_and_read_statistics(self, sdlfile, "test_memHierarchy_multithreadL1_{0}".format(arbitration), "--arbitration={0}".format(arbitration), set_cwd=test_path, check_errfile=False)
+
+        for thread in range(3):
+            subid = "thread{0}".format(thread)
+            for stat in ["requests", "responses", "queue_delay"]:
+                self.assertTrue("smt.{0}.{1}".format(stat, subid) in stats, "multithreadL1 test {0}: statistic {1}.{2} missing from {3}".format(arbitration, stat, subid, outfile))
+            requests = stats["smt.requests.{0}".format(subid)]["Sum.u64"]
+            responses = stats["smt.responses.{0}".format(subid)]["Sum.u64"]
+            arbitrated = stats["smt.queue_delay.{0}".format(subid)]["Count.u64"]
+            self.assertTrue(requests > 0, "multithreadL1 test {0}: {1} sent no requests".format(arbitration, subid))
+            self.assertEqual(requests, responses, "multithreadL1 test {0}: {1} sent {2} requests but got {3} responses".format(arbitration, subid, requests, responses))
+            self.assertEqual(requests, arbitrated, "multithreadL1 test {0}: {1} sent {2} requests but {3} were arbitrated".format(arbitration, subid, requests, arbitrated))
+
     def memHierarchy_Template(self, testcase):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -109,6 +109,9 @@ hr_router::~hr_router()
     delete [] in_port_busy;
     delete [] out_port_busy;
     delete [] progress_vcs;
+    delete [] port_active_vc_count;
+    delete [] xfer_port;
+    delete [] xfer_flits;
 
     for ( int i = 0 ; i < num_ports ; i++ ) {
         delete ports[i];
@@ -122,6 +125,7 @@ hr_router::~hr_router()
 hr_router::hr_router(ComponentId_t cid, Params& params) :
     Router(cid),
     num_vcs(-1),
+    num_xfers(0),
     output(Simulation::getSimulation()->getSimulationOutput())
 {
 
@@ -238,6 +242,21 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     bool oql_track_port = params.find<bool>("oql_track_port","false");
     bool oql_track_remote = params.find<bool>("oql_track_remote","false");
 
+    flit_level = params.find<bool>("flit_level",false);
+    speculative = params.find<bool>("speculative",false);
+    int pipeline_depth = params.find<int>("pipeline_depth",4);
+    if ( pipeline_depth < 1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router: pipeline_depth must be at least 1\n");
+    }
+    // Packet-level mode behaves as a single stage pipeline, which
+    // leaves nothing to speculate on
+    pipeline_delay = 0;
+    if ( flit_level ) pipeline_delay = pipeline_depth - 1;
+    speculative = speculative && pipeline_delay > 0;
+    if ( speculative ) pipeline_delay--;
+    pipelined = pipeline_delay > 0 || speculative;
+    std::string credit_latency = params.find<std::string>("credit_latency","");
+
     params.enableVerify(false);
 
     Params pc_params = params.find_prefix_params("portcontrol:");
@@ -246,6 +265,8 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     if (pc_params.contains("network_inspectors")) pc_params.insert("network_inspectors", params.find<std::string>("network_inspectors", ""));
     pc_params.insert("oql_track_port", params.find<std::string>("oql_track_port","false"));
     pc_params.insert("oql_track_remote", params.find<std::string>("oql_track_remote","false"));
+    pc_params.insert("flit_level", flit_level ? "true" : "false");
+    if ( credit_latency != "" ) pc_params.insert("credit_latency", credit_latency);
 
     for ( int i = 0; i < num_ports; i++ ) {
         in_port_busy[i] = 0;
@@ -285,6 +306,12 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     arb =
         loadAnonymousSubComponent<XbarArbitration>(xbar_arb, "XbarArb", 0, ComponentInfo::INSERT_STATS, empty_params);
 
+    // Holding heads in the pipeline works by keeping them out of the
+    // active maps, so the arbiter must only look at those
+    if ( flit_level && !arb->usesActiveMaps() ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router: flit_level is not supported with xbar_arb %s\n", xbar_arb.c_str());
+    }
+
     my_clock_handler = new Clock::Handler<hr_router>(this,&hr_router::clock_handler);
     xbar_tc = registerClock( xbar_clock, my_clock_handler);
     num_routers++;
@@ -330,7 +357,7 @@ hr_router::notifyEvent()
 
 #if !VERIFY_DECLOCKING
     // Fix up the busy variables
-    for ( int i = 0; i < num_ports; i++ ) {
+    for ( int i = busy_ports.findNext(0,num_ports); i != -1; i = busy_ports.findNext(i+1,num_ports) ) {
     	// Should stop at zero, need to find a clean way to do this
     	// with no branch.  For now it should work.
         int64_t tmp = in_port_busy[i] - elapsed_cycles;
@@ -339,6 +366,7 @@ hr_router::notifyEvent()
         tmp = out_port_busy[i] - elapsed_cycles;
     	if ( tmp < 0 ) out_port_busy[i] = 0;
         else out_port_busy[i] = tmp;
+        if ( in_port_busy[i] == 0 && out_port_busy[i] == 0 ) busy_ports.clear(i);
     }
 #endif
     // Report skipped cycles to arbitration unit.
@@ -379,8 +407,9 @@ hr_router::clock_handler(Cycle_t cycle)
 {
     // If there are no events in the input queues, then we can remove
     // ourselves from the clock queue, as long as the arbitration unit
-    // says it's okay.
-    if ( get_vcs_with_data() == 0 ) {
+    // says it's okay.  Packets still crossing the xbar a flit at a
+    // time keep the clock running.
+    if ( get_vcs_with_data() == 0 && num_xfers == 0 ) {
 #if VERIFY_DECLOCKING
         if ( clocking ) {
             if ( arb->isOkayToPauseClock() ) {
@@ -402,6 +431,14 @@ hr_router::clock_handler(Cycle_t cycle)
 #endif
     }
 
+    // In flit-level mode, move the next flit of each packet crossing
+    // the xbar and release the heads that have cleared the pipeline
+    // before arbitrating
+    if ( flit_level ) {
+        if ( num_xfers != 0 ) advanceTransfers();
+        if ( !staged_heads.empty() ) advancePipeline();
+    }
+
     // All we need to do is arbitrate the crossbar
 #if VERIFY_DECLOCKING
     arb->arbitrate(ports,in_port_busy,out_port_busy,progress_vcs,clocking);
@@ -409,12 +446,32 @@ hr_router::clock_handler(Cycle_t cycle)
     arb->arbitrate(ports,in_port_busy,out_port_busy,progress_vcs);
 #endif
 
-    // Move the events and decrement the busy values
-    for ( int i = 0; i < num_ports; i++ ) {
+    // Move the events.  Only ports that had data going into
+    // arbitration can have a progress or stall entry.  A recv() can
+    // only clear the bit of the port being visited, so walking the
+    // bitmap while moving events is safe.
+    for ( int i = active_ports.findNext(0,num_ports); i != -1; i = active_ports.findNext(i+1,num_ports) ) {
         // if ( progress_vcs[i] != -1 ) {
         if ( progress_vcs[i] > -1 ) {
             internal_router_event* ev = ports[i]->recv(progress_vcs[i]);
+            int flits = ev->getFlitCount();
             ports[ev->getNextPort()]->send(ev,ev->getVC());
+            busy_ports.set(i);
+            busy_ports.set(ev->getNextPort());
+
+            if ( flit_level ) {
+                if ( flits > 1 ) {
+                    xfer_port[i] = ev->getNextPort();
+                    xfer_flits[i] = flits - 1;
+                    num_xfers++;
+                }
+                // The packet behind this one has to go through the
+                // pipeline before it can be arbitrated
+                if ( pipelined && vc_heads[i * num_vcs + progress_vcs[i]] != NULL ) {
+                    setHeadActive(i, progress_vcs[i], false);
+                    stageHead(i, progress_vcs[i]);
+                }
+            }
 
             if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
                 output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
@@ -436,16 +493,101 @@ hr_router::clock_handler(Cycle_t cycle)
         else if ( progress_vcs[i] == -2 ) {
                 xbar_stalls[i]->addData(1);
         }
+    }
 
+    // Decrement the busy values
+    for ( int i = busy_ports.findNext(0,num_ports); i != -1; i = busy_ports.findNext(i+1,num_ports) ) {
         // Should stop at zero, need to find a clean way to do this
         // with no branch.  For now it should work.
         if ( in_port_busy[i] != 0 ) in_port_busy[i]--;
         if ( out_port_busy[i] != 0 ) out_port_busy[i]--;
+        if ( in_port_busy[i] == 0 && out_port_busy[i] == 0 ) busy_ports.clear(i);
     }
 
     return false;
 }
 
+void
+hr_router::vcHeadChanged(int port, int vc, bool has_data)
+{
+    // A VC only drains after its head was arbitrated, so a VC losing
+    // its data is never one still held in the pipeline
+    if ( has_data && pipelined ) stageHead(port, vc);
+    else setHeadActive(port, vc, has_data);
+}
+
+void
+hr_router::setHeadActive(int port, int vc, bool active)
+{
+    if ( active ) {
+        active_vcs.set(port * num_vcs + vc);
+        if ( port_active_vc_count[port]++ == 0 ) active_ports.set(port);
+    }
+    else {
+        active_vcs.clear(port * num_vcs + vc);
+        if ( --port_active_vc_count[port] == 0 ) active_ports.clear(port);
+    }
+    arb->vcHeadChanged(port, vc, active);
+}
+
+void
+hr_router::stageHead(int port, int vc)
+{
+    staged_head_t head;
+    head.port = port;
+    head.vc = vc;
+    head.remaining = pipeline_delay;
+    head.speculative = speculative;
+    staged_heads.push_back(head);
+}
+
+void
+hr_router::advancePipeline()
+{
+    size_t kept = 0;
+    for ( size_t i = 0; i < staged_heads.size(); i++ ) {
+        staged_head_t& head = staged_heads[i];
+        if ( head.remaining > 0 ) {
+            head.remaining--;
+            staged_heads[kept++] = head;
+            continue;
+        }
+        // Speculative switch allocation fails if VC allocation
+        // would have, costing the stage that was skipped
+        if ( head.speculative ) {
+            internal_router_event* ev = vc_heads[head.port * num_vcs + head.vc];
+            if ( !ports[ev->getNextPort()]->spaceToSend(ev->getVC(), 1) ) {
+                head.speculative = false;
+                staged_heads[kept++] = head;
+                continue;
+            }
+        }
+        setHeadActive(head.port, head.vc, true);
+    }
+    staged_heads.resize(kept);
+}
+
+void
+hr_router::advanceTransfers()
+{
+    // Every input port with a transfer in progress is busy
+    for ( int i = busy_ports.findNext(0,num_ports); i != -1; i = busy_ports.findNext(i+1,num_ports) ) {
+        if ( xfer_flits[i] == 0 ) continue;
+        int out = xfer_port[i];
+        if ( ports[out]->sendFlit() ) {
+            ports[i]->recvFlit();
+            if ( --xfer_flits[i] == 0 ) num_xfers--;
+        }
+        else {
+            // No room in the output buffer, hold both sides of the
+            // xbar for another cycle
+            in_port_busy[i]++;
+            out_port_busy[out]++;
+            xbar_stalls[i]->addData(1);
+        }
+    }
+}
+
 void hr_router::setup()
 {
     for ( int i = 0; i < num_ports; i++ ) {
@@ -562,6 +704,11 @@ hr_router::recvTopologyEvent(int port, TopologyEvent* ev) {
 void
 hr_router::init_vcs()
 {
+    // Arbiters read a port's VCs from active_vcs as a single word
+    if ( num_vcs > 64 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router supports at most 64 VCs per port, %d requested\n", num_vcs);
+    }
+
     vc_heads = new internal_router_event*[num_ports*num_vcs];
     xbar_in_credits = new int[num_ports*num_vcs];
     output_queue_lengths = new int[num_ports*num_vcs];
@@ -571,6 +718,18 @@ hr_router::init_vcs()
         output_queue_lengths[i] = 0;
     }
 
+    active_ports.resize(num_ports);
+    active_vcs.resize(num_ports*num_vcs);
+    busy_ports.resize(num_ports);
+    port_active_vc_count = new int[num_ports];
+    xfer_port = new int[num_ports];
+    xfer_flits = new int[num_ports];
+    for ( int i = 0; i < num_ports; i++ ) {
+        port_active_vc_count[i] = 0;
+        xfer_port[i] = -1;
+        xfer_flits[i] = 0;
+    }
+
     for ( int i = 0; i < num_ports; i++ ) {
         ports[i]->initVCs(num_vns,vcs_per_vn.data(),&vc_heads[i*num_vcs],&xbar_in_credits[i*num_vcs],&output_queue_lengths[i*num_vcs]);
     }
@@ -580,6 +739,7 @@ hr_router::init_vcs()
 
     // Now that we have the number of VCs we can finish initializing
     // arbitration logic
+    arb->setActiveMaps(&active_ports,&active_vcs);
     arb->setPorts(num_ports,num_vcs);
 
 
@@ -67,6 +67,10 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
+        {"flit_level",         "Model the router at flit level: packets cross the xbar as a wormhole of flits and only need space for the head flit to start.  Requires xbar_arb_lru, xbar_arb_rr or xbar_arb_age.", "false"},
+        {"pipeline_depth",     "Flit-level mode only.  Router cycles from a packet reaching the head of its input VC to its head flit crossing the xbar.", "4"},
+        {"speculative",        "Flit-level mode only.  Perform VC and switch allocation in parallel, saving a pipeline stage unless the output VC has no space.", "false"},
+        {"credit_latency",     "Delay for returning input buffer credits upstream.  If not set, credits use output_latency.", ""},
         {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
     )
 
@@ -116,6 +120,36 @@ private:
     int* out_port_busy;
     int* progress_vcs;
 
+    // Ports with any input VC holding a packet, input VCs holding a
+    // packet (indexed port * num_vcs + vc) and ports with a non-zero
+    // busy count.  Lets the clock handler skip idle ports.
+    ActiveBitmap active_ports;
+    ActiveBitmap active_vcs;
+    ActiveBitmap busy_ports;
+    int* port_active_vc_count;
+
+    // Flit-level mode.  A new VC head waits pipeline_delay cycles
+    // (route computation and VC allocation) before it is handed to
+    // the xbar arbiter.  With speculation it waits one cycle less,
+    // plus one cycle if its output VC turns out to have no space.
+    bool flit_level;
+    bool speculative;
+    int pipeline_delay;
+    bool pipelined;
+    struct staged_head_t {
+        int port;
+        int vc;
+        int remaining;
+        bool speculative;
+    };
+    std::vector<staged_head_t> staged_heads;
+
+    // Flit-level mode.  Flits left to move for the packet crossing
+    // the xbar from each input port, and the output port they go to.
+    int* xfer_port;
+    int* xfer_flits;
+    int num_xfers;
+
     /* int input_buf_size; */
     /* int output_buf_size; */
     UnitAlgebra input_buf_size;
@@ -132,6 +166,10 @@ private:
     static void sigHandler(int signal);
 
     void init_vcs();
+    void setHeadActive(int port, int vc, bool active);
+    void stageHead(int port, int vc);
+    void advancePipeline();
+    void advanceTransfers();
     Statistic<uint64_t>** xbar_stalls;
 
     Output& output;
@@ -146,6 +184,7 @@ public:
     void finish();
 
     void notifyEvent();
+    void vcHeadChanged(int port, int vc, bool has_data);
     int const* getOutputBufferCredits() {return xbar_in_credits;}
     int const* getOutputQueueLengths() {return output_queue_lengths;}
 
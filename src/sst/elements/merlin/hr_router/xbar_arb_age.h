@@ -132,6 +132,8 @@ public:
         delete[] entries;
     }
 
+    bool usesActiveMaps() { return true; }
+
      void setPorts(int num_ports_s, int num_vcs_s) {
         num_ports = num_ports_s;
         num_vcs = num_vcs_s;
@@ -161,31 +163,26 @@ public:
                    )
     {
 
-        for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
-
-
         // Find all ports that have data and who's inputs to the xbar
         // aren't busy.  Sort them by prioritizing on injection time.
-        // Oldest gets top priority.
-        int index = 0;
-        for ( int i = 0; i < num_ports; i++ ) {
+        // Oldest gets top priority.  Entries are pushed in port, vc
+        // order so ties resolve the same as a full scan.
+        for ( int i = active_ports->findNext(0,num_ports); i != -1; i = active_ports->findNext(i+1,num_ports) ) {
+            progress_vc[i] = -1;
             if ( in_port_busy[i] > 0 ) {
-                index += num_vcs;
                 continue; // No need to consider port if input to xbar is busy
             }
 
             vc_heads = ports[i]->getVCHeads();
-            for ( int j = 0; j < num_vcs; j++ ) {
-                internal_router_event* src_event = vc_heads[j];
-                if ( src_event != NULL ) {
-                    entries[index].next_port = vc_heads[j]->getNextPort();
-                    entries[index].next_vc = vc_heads[j]->getVC();
-                    entries[index].injection_time = vc_heads[j]->getEncapsulatedEvent()->getInjectionTime();
-                    entries[index].size_in_flits = vc_heads[j]->getFlitCount();
-
-                    age_queue.push(&entries[index]);
-                }
-                index++;
+            int index = i * num_vcs;
+            for ( uint64_t bits = active_vcs->getBits(index, num_vcs); bits != 0; bits &= bits - 1 ) {
+                int j = __builtin_ctzll(bits);
+                entries[index + j].next_port = vc_heads[j]->getNextPort();
+                entries[index + j].next_vc = vc_heads[j]->getVC();
+                entries[index + j].injection_time = vc_heads[j]->getEncapsulatedEvent()->getInjectionTime();
+                entries[index + j].size_in_flits = vc_heads[j]->getFlitCount();
+
+                age_queue.push(&entries[index + j]);
             }
 
         }
@@ -22,6 +22,7 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "sst/elements/merlin/router.h"
@@ -50,10 +51,27 @@ private:
     int rr_port_shadow;
 #endif
 
-    typedef std::pair<uint16_t,uint16_t> priority_entry_t;
-    priority_entry_t* priority[2];
-    priority_entry_t* cur_list;
-    priority_entry_t* next_list;
+    // Priority order of all (port,vc) entries is kept as a rank per
+    // entry.  Entries satisfied in a cycle move behind everything else,
+    // the first one satisfied ending up last, while the rest keep their
+    // relative order.  Only entries with data are held in the active
+    // list (sorted by rank), so idle VCs cost nothing per cycle.
+    struct priority_entry_t {
+        uint64_t rank;
+        uint16_t port;
+        uint16_t vc;
+
+        priority_entry_t() : rank(0), port(0), vc(0) {}
+        priority_entry_t(uint64_t rank, uint16_t port, uint16_t vc) :
+            rank(rank), port(port), vc(vc)
+        {}
+
+        bool operator<(const priority_entry_t& other) const { return rank < other.rank; }
+    };
+    std::vector<priority_entry_t> active;
+    uint64_t* rank;
+    uint64_t next_rank;
+    std::vector<priority_entry_t> satisfied;
 
     int total_entries;
 
@@ -64,35 +82,42 @@ private:
 public:
 
     xbar_arb_lru(ComponentId_t cid, Params& param) :
-        XbarArbitration(cid)
+        XbarArbitration(cid),
+        rank(NULL)
     {
     }
 
     ~xbar_arb_lru() {
+        if ( rank != NULL ) delete [] rank;
     }
 
+    bool usesActiveMaps() { return true; }
+
     void setPorts(int num_ports_s, int num_vcs_s) {
         num_ports = num_ports_s;
         num_vcs = num_vcs_s;
 
         total_entries = num_ports * num_vcs;
 
-        priority[0] = new priority_entry_t[total_entries];
-        priority[1] = new priority_entry_t[total_entries];
-        cur_list = priority[0];
-        next_list = priority[1];
-
-        int index = 0;
-        for ( int i = 0; i < num_ports; i++ ) {
-            for ( int j = 0; j < num_vcs; j++ ) {
-                cur_list[index++] = priority_entry_t(i,j);
-            }
+        // Initial priority is port major, vc minor
+        rank = new uint64_t[total_entries];
+        for ( int i = 0; i < total_entries; i++ ) {
+            rank[i] = i;
         }
-
+        next_rank = total_entries;
+        active.reserve(total_entries);
+        satisfied.reserve(num_ports);
 
         vc_heads = new internal_router_event*[num_vcs];
     }
 
+    void vcHeadChanged(int port, int vc, bool has_data) {
+        priority_entry_t entry(rank[port * num_vcs + vc],port,vc);
+        std::vector<priority_entry_t>::iterator it = std::lower_bound(active.begin(), active.end(), entry);
+        if ( has_data ) active.insert(it, entry);
+        else active.erase(it);
+    }
+
     // Naming convention is from point of view of the xbar.  So,
     // in_port_busy is >0 if someone is writing to that xbar port and
     // out_port_busy is >0 if that xbar port being read.
@@ -105,91 +130,62 @@ public:
                    )
     {
 
-        for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
-
-        // std::cout << "---------" << std::endl;
-        // for ( int i = 0; i < total_entries; i++ ) {
-        //     std::cout << priority[cur_list][i].first << ", " << priority[cur_list][i].second << std::endl;
-        // }
-        // std::cout << "---------" << std::endl;
+        for ( int i = active_ports->findNext(0,num_ports); i != -1; i = active_ports->findNext(i+1,num_ports) ) {
+            progress_vc[i] = -1;
+        }
 
-        // Run through the priority list
-        // for ( priority_list_t::iterator it = priority.begin(); it != priority.end(); ) {
-        // int sat_index = total_entries - 1;
-        // int unsat_index = 0;
+        // Run through the entries with data in priority order,
+        // compacting the unsatisfied ones in place
+        size_t unsat = 0;
+        for ( size_t i = 0; i < active.size(); i++ ) {
 
-        priority_entry_t* sat_list = &next_list[total_entries-1];
-        priority_entry_t* unsat_list = next_list;
+            const priority_entry_t check = active[i];
+            int port = check.port;
+            int vc = check.vc;
 
-        for ( int i = 0; i < total_entries; i++ ) {
+            // if the output of this port is busy, nothing to do.
+            if ( in_port_busy[port] > 0 ) {
+                active[unsat++] = check;
+                continue;
+            }
 
-            // const priority_entry_t& check = priority[cur_list][i];
-            const priority_entry_t& check = cur_list[i];
+            vc_heads = ports[port]->getVCHeads();
+            internal_router_event* src_event = vc_heads[vc];
 
-            /* std::cout << check.first << ", " << check.second << std::endl; */
+            // Have an event, see if it can be progressed
+            int next_port = src_event->getNextPort();
+            int next_vc = src_event->getVC();
 
-            int port = check.first;
-            int vc = check.second;
+            // We can progress if the next port's input is not
+            // busy and there are enough credits.
+            if ( out_port_busy[next_port] <= 0 &&
+                 ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) {
 
-            // std::cout << check.first << ", " << check.second << std::endl;
+                // Tell the router what to move
+                progress_vc[port] = vc;
 
-            vc_heads = ports[port]->getVCHeads();
+                // Need to set the busy values
+                in_port_busy[port] = src_event->getFlitCount();
+                out_port_busy[next_port] = src_event->getFlitCount();
 
-            // if the output of this port is busy or if there is no
-            // event to be processed, nothing to do.
-            internal_router_event* src_event = vc_heads[vc];
-            if ( in_port_busy[port] <= 0 && src_event != NULL) {
-                // Have an event, see if it can be progressed
-                int next_port = src_event->getNextPort();
-                int next_vc = src_event->getVC();
-
-                // We can progress if the next port's input is not
-                // busy and there are enough credits.
-                if ( out_port_busy[next_port] <= 0 &&
-                     ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) {
-
-                    // Tell the router what to move
-                    progress_vc[port] = vc;
-
-                    // Need to set the busy values
-                    in_port_busy[port] = src_event->getFlitCount();
-                    out_port_busy[next_port] = src_event->getFlitCount();
-
-
-                    // Copy data to new list
-                    // std::cout << "putting at bottom of list" << std::endl;
-                    // next_list[sat_index--] = check;
-                    *sat_list = check;
-                    --sat_list;
-                }
-                else {
-                    // std::cout << "putting at top of list" << std::endl;
-                    // next_list[unsat_index++] = check;
-                    *unsat_list = check;
-                    ++unsat_list;
-                    progress_vc[port] = -2;
-                }
+                satisfied.push_back(check);
             }
             else {
-                // std::cout << "putting at top of list" << std::endl;
-                // next_list[unsat_index++] = check;
-                *unsat_list = check;
-                ++unsat_list;
+                active[unsat++] = check;
+                progress_vc[port] = -2;
             }
         }
 
-        // std::cout << "+++++++++" << std::endl;
-        // for ( int i = 0; i < total_entries; i++ ) {
-        //     std::cout << priority[next_list][i].first << ", " << priority[cur_list][i].second << std::endl;
-        // }
-        // std::cout << "+++++++++" << std::endl;
-
-        // cur_list ^= next_list;
-        // next_list ^= cur_list;
-        // cur_list ^= next_list;
-        priority_entry_t* tmp = cur_list;
-        cur_list = next_list;
-        next_list = tmp;
+        // Move satisfied entries to the bottom of the list, first
+        // satisfied goes last
+        active.resize(unsat);
+        for ( int i = satisfied.size() - 1; i >= 0; i-- ) {
+            priority_entry_t& entry = satisfied[i];
+            entry.rank = next_rank++;
+            rank[entry.port * num_vcs + entry.vc] = entry.rank;
+            active.push_back(entry);
+        }
+        satisfied.clear();
         return;
     }
 
@@ -22,6 +22,7 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "sst/elements/merlin/router.h"
@@ -51,6 +52,15 @@ private:
     int *rr_vcs;
     int rr_port;
 
+    // Only ports with data are visited, but the round robin VC pointer
+    // of every port advances on each cycle its xbar input is not busy.
+    // Idle ports are caught up lazily: arb_cycle counts arbitration
+    // cycles, rr_synced is the last cycle folded into rr_vcs for a port
+    // and busy_until the first cycle its xbar input is free again.
+    uint64_t arb_cycle;
+    uint64_t* rr_synced;
+    uint64_t* busy_until;
+
 #if VERIFY_DECLOCKING
     int rr_port_shadow;
 #endif
@@ -63,22 +73,33 @@ public:
 
     xbar_arb_rr(ComponentId_t cid, Params& params) :
         XbarArbitration(cid),
-        rr_vcs(NULL)
+        rr_vcs(NULL),
+        rr_synced(NULL),
+        busy_until(NULL)
     {
     }
 
     ~xbar_arb_rr() {
         if ( rr_vcs != NULL ) delete [] rr_vcs;
+        if ( rr_synced != NULL ) delete [] rr_synced;
+        if ( busy_until != NULL ) delete [] busy_until;
     }
 
+    bool usesActiveMaps() { return true; }
+
     void setPorts(int num_ports_s, int num_vcs_s) {
         num_ports = num_ports_s;
         num_vcs = num_vcs_s;
 
         rr_vcs = new int[num_ports];
+        rr_synced = new uint64_t[num_ports];
+        busy_until = new uint64_t[num_ports];
         for ( int i = 0; i < num_ports; i++ ) {
             rr_vcs[i] = 0;
+            rr_synced[i] = 0;
+            busy_until[i] = 0;
         }
+        arb_cycle = 0;
 
         rr_port = 0;
 #if VERIFY_DECLOCKING
@@ -87,6 +108,21 @@ public:
         vc_heads = new internal_router_event*[num_vcs];
     }
 
+    // Advance rr_vcs for the arbitration cycles in (rr_synced,upto]
+    // in which the port was skipped while its xbar input was free
+    void syncPort(int port, uint64_t upto) {
+        uint64_t from = std::max(rr_synced[port] + 1, busy_until[port]);
+        if ( upto >= from ) {
+            rr_vcs[port] = (rr_vcs[port] + (upto - from + 1) % num_vcs) % num_vcs;
+        }
+        rr_synced[port] = upto;
+    }
+
+    void markVisited(int port, int busy) {
+        rr_synced[port] = arb_cycle;
+        busy_until[port] = arb_cycle + busy;
+    }
+
     // Naming convention is from point of view of the xbar.  So,
     // in_port_busy is >0 if someone is writing to that xbar port and
     // out_port_busy is >0 if that xbar port being read.
@@ -98,50 +134,69 @@ public:
 #endif
                    )
     {
-        // Run through each of the ports, giving first pick in a round robin fashion
-        // for ( int port = rr_port, pcount = 0; pcount < num_ports; port = (port+1) % num_ports, pcount++ ) {
-        for ( int port = rr_port, pcount = 0; pcount < num_ports; port = ((port != num_ports-1) ? port+1 : 0), pcount++ ) {
-
-            vc_heads = ports[port]->getVCHeads();
-
-            // Overwrite old data
-            progress_vc[port] = -1;
-            // if the output of this port is busy, nothing to do.
-            if ( in_port_busy[port] > 0 ) {
-                continue;
+        arb_cycle++;
+
+        // Run through each of the ports with data, giving first pick in
+        // a round robin fashion.  First pass covers [rr_port,num_ports),
+        // second pass wraps around to [0,rr_port).
+        for ( int ppass = 0; ppass < 2; ppass++ ) {
+            int pbegin = ppass == 0 ? rr_port : 0;
+            int pend = ppass == 0 ? num_ports : rr_port;
+            for ( int chunk = pbegin; chunk < pend; chunk += 64 ) {
+                for ( uint64_t pbits = active_ports->getBits(chunk, std::min(64, pend - chunk)); pbits != 0; pbits &= pbits - 1 ) {
+                    int port = chunk + __builtin_ctzll(pbits);
+
+                    syncPort(port, arb_cycle - 1);
+                    vc_heads = ports[port]->getVCHeads();
+
+                    // Overwrite old data
+                    progress_vc[port] = -1;
+                    // if the output of this port is busy, nothing to do.
+                    if ( in_port_busy[port] > 0 ) {
+                        markVisited(port, in_port_busy[port]);
+                        continue;
+                    }
+
+                    // See what we should progress for this port, only
+                    // looking at VCs that have an event.  Visit
+                    // [rr_vcs,num_vcs) first, then wrap around.
+                    uint64_t vcs = active_vcs->getBits(port * num_vcs, num_vcs);
+                    uint64_t first = vcs & (~(uint64_t)0 << rr_vcs[port]);
+                    uint64_t order[2] = { first, vcs & ~first };
+                    for ( int vpass = 0; vpass < 2; vpass++ ) {
+                        uint64_t bits = order[vpass];
+                        for ( ; bits != 0; bits &= bits - 1 ) {
+                            int vc = __builtin_ctzll(bits);
+                            internal_router_event* src_event = vc_heads[vc];
+
+                            // Have an event, see if it can be progressed
+                            int next_port = src_event->getNextPort();
+
+                            // We can progress if the next port's input is not
+                            // busy and there are enough credits.
+                            if ( out_port_busy[next_port] > 0 ) continue;
+
+                            // Need to see if the VC has enough credits
+                            int next_vc = src_event->getVC();
+
+                            // See if there is enough space
+                            if ( !ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) continue;
+
+                            // Tell the router what to move
+                            progress_vc[port] = vc;
+
+                            // Need to set the busy values
+                            in_port_busy[port] = src_event->getFlitCount();
+                            out_port_busy[next_port] = src_event->getFlitCount();
+                            break;  // Go to next port;
+                        }
+                        if ( bits != 0 ) break;
+                    }
+                    // Increemnt rr_vcs for next time
+                    rr_vcs[port] = (rr_vcs[port] + 1) % num_vcs;
+                    markVisited(port, in_port_busy[port]);
+                }
             }
-
-            // See what we should progress for this port
-            // for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = (vc+1) % num_vcs, vcount++ ) {
-            for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = ((vc != num_vcs-1) ? (vc+1) : 0), vcount++ ) {
-
-                // If there is no event, move to next VC
-                internal_router_event* src_event = vc_heads[vc];
-                if ( src_event == NULL ) continue;
-
-                // Have an event, see if it can be progressed
-                int next_port = src_event->getNextPort();
-
-                // We can progress if the next port's input is not
-                // busy and there are enough credits.
-                if ( out_port_busy[next_port] > 0 ) continue;
-
-                // Need to see if the VC has enough credits
-                int next_vc = src_event->getVC();
-
-                // See if there is enough space
-                if ( !ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) continue;
-
-                // Tell the router what to move
-                progress_vc[port] = vc;
-
-                // Need to set the busy values
-                in_port_busy[port] = src_event->getFlitCount();
-                out_port_busy[next_port] = src_event->getFlitCount();
-                break;  // Go to next port;
-            }
-            // Increemnt rr_vcs for next time
-            rr_vcs[port] = (rr_vcs[port] + 1) % num_vcs;
         }
         rr_port = (rr_port + 1) % num_ports;
 
@@ -162,10 +217,19 @@ public:
                          ", cycles = " << cycles << std::endl;
 #else
         rr_port = (rr_port + cycles) % num_ports;
+
+        // No arbitration happens while the clock is off, so fold in
+        // everything up to now and count the gap as already accounted
+        for ( int i = 0; i < num_ports; i++ ) {
+            syncPort(i, arb_cycle);
+            rr_synced[i] = arb_cycle + cycles;
+        }
+        arb_cycle += cycles;
 #endif
     }
 
     void dumpState(std::ostream& stream) {
+        for ( int i = 0; i < num_ports; i++ ) syncPort(i, arb_cycle);
         stream << "Current round robin port: " << rr_port << std::endl;
         stream << "  Current round robin VC by port:" << std::endl;
         for ( int i = 0; i < num_ports; i++ ) {
@@ -57,18 +57,21 @@ PortControl::send(internal_router_event* ev, int vc)
     }
 #endif
     
-	xbar_in_credits[vc] -= ev->getFlitCount();
-    if ( oql_track_port ) {
-        int flits = ev->getFlitCount();
-        for ( int i = 0; i < num_vcs; ++i ) {
-            output_queue_lengths[i] += flits;
-        }
-    }
-    else {
-        output_queue_lengths[vc] += ev->getFlitCount();
-    }
+    // In flit-level mode only the head flit arrives now, the rest
+    // follow through sendFlit()
+    int flits = flit_level ? 1 : ev->getFlitCount();
+	xbar_in_credits[vc] -= flits;
+    addOutputQueueLength(vc, flits);
 	ev->setVC(vc);
 
+    if ( flit_level && ev->getFlitCount() > 1 ) {
+        xfer_out_ev = ev;
+        xfer_out_vc = vc;
+        xfer_out_arrived = 1;
+        xfer_out_remaining = ev->getFlitCount() - 1;
+        xfer_out_streaming = false;
+    }
+
 	output_buf[vc].push(ev);
 	if ( waiting ) {
 	    output_timing->send(1,NULL); 
@@ -84,10 +87,68 @@ PortControl::send(internal_router_event* ev, int vc)
 bool
 PortControl::spaceToSend(int vc, int flits)
 {
+    // In flit-level mode a packet can start once there is room for
+    // its head flit
+    if ( flit_level ) flits = 1;
 	if (xbar_in_credits[vc] < flits) return false;
 	return true;
 }
 
+bool
+PortControl::sendFlit()
+{
+    if ( !xfer_out_streaming ) {
+        if ( xbar_in_credits[xfer_out_vc] < 1 ) return false;
+        xbar_in_credits[xfer_out_vc]--;
+        xfer_out_arrived++;
+        addOutputQueueLength(xfer_out_vc, 1);
+    }
+    else if ( oql_track_remote ) {
+        // The remote port will return credits for the whole packet
+        addOutputQueueLength(xfer_out_vc, 1);
+    }
+
+    if ( --xfer_out_remaining == 0 ) {
+        xfer_out_ev = NULL;
+        xfer_out_streaming = false;
+    }
+    return true;
+}
+
+void
+PortControl::recvFlit()
+{
+    xfer_in_remaining--;
+    returnCredits(xfer_in_vc_return, 1);
+}
+
+void
+PortControl::returnCredits(int vc, int credits)
+{
+	port_ret_credits[vc] += credits;
+
+	// For now, we're just going to send the credits back to the
+	// other side.  The required BW to do this will not be taken
+	// into account.
+    credit_event* ce = new credit_event(vc,port_ret_credits[vc]);
+    if ( credit_tc ) port_link->send(1,credit_tc,ce);
+    else port_link->send(1,ce);
+	port_ret_credits[vc] = 0;
+}
+
+void
+PortControl::addOutputQueueLength(int vc, int flits)
+{
+    if ( oql_track_port ) {
+        for ( int i = 0; i < num_vcs; ++i ) {
+            output_queue_lengths[i] += flits;
+        }
+    }
+    else {
+        output_queue_lengths[vc] += flits;
+    }
+}
+
 internal_router_event*
 PortControl::recv(int vc)
 {
@@ -104,7 +165,7 @@ PortControl::recv(int vc)
 	// Need to update vc_heads
 	if ( input_buf[vc].empty() ) {
 	    vc_heads[vc] = NULL;
-	    parent->dec_vcs_with_data();
+	    parent->dec_vcs_with_data(port_number, vc);
 	}
 	else {
         auto event = input_buf[vc].front();
@@ -113,14 +174,16 @@ PortControl::recv(int vc)
 	}
 	
     int vc_return = topo->isHostPort(port_number) ? event->getCreditReturnVC() : vc;
-	// Figure out how many credits to return
-	port_ret_credits[vc_return] += event->getFlitCount();
-
-	// For now, we're just going to send the credits back to the
-	// other side.  The required BW to do this will not be taken
-	// into account.
-	port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return])); 
-	port_ret_credits[vc_return] = 0;
+	// Figure out how many credits to return.  In flit-level mode
+	// only the head flit has left the buffer, the rest are returned
+	// through recvFlit()
+    int flits = event->getFlitCount();
+    if ( flit_level ) {
+        xfer_in_vc_return = vc_return;
+        xfer_in_remaining = flits - 1;
+        flits = 1;
+    }
+    returnCredits(vc_return, flits);
     
 #if TRACK
     if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
@@ -144,6 +207,15 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     output_buf_count(NULL),
     port_ret_credits(NULL),
     port_out_credits(NULL),
+    credit_tc(NULL),
+    flit_level(false),
+    xfer_out_ev(NULL),
+    xfer_out_vc(0),
+    xfer_out_arrived(0),
+    xfer_out_remaining(0),
+    xfer_out_streaming(false),
+    xfer_in_vc_return(0),
+    xfer_in_remaining(0),
     idle_start(0),
 	sai_win_start(0),
 	sai_port_disabled(false),
@@ -308,6 +380,12 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     oql_track_port = params.find<bool>("oql_track_port",false);
     oql_track_remote = params.find<bool>("oql_track_remote",false);
 
+    flit_level = params.find<bool>("flit_level",false);
+    std::string credit_latency = params.find<std::string>("credit_latency","");
+    if ( credit_latency != "" ) {
+        credit_tc = getTimeConverter(credit_latency);
+    }
+
     Params arb_params = params.find_prefix_params("arbitration:");
 
     std::string output_arb_name = params.find<std::string>("output_arb","merlin.arb.output.basic");
@@ -812,7 +890,7 @@ PortControl::handle_input_n2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, rtr_event->getVC(), rtr_event);
             vc_heads[curr_vc] = rtr_event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number, curr_vc);
 	    }
 	    
 	    if ( event->getTraceType() != SST::Interfaces::SimpleNetwork::Request::NONE ) {
@@ -896,7 +974,7 @@ PortControl::handle_input_r2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, event->getVC(), event);
             vc_heads[curr_vc] = event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number, curr_vc);
 	    }
 	    
 	    if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
@@ -963,18 +1041,19 @@ PortControl::handle_output(Event* ev) {
         // If this is a host port, then we return it to the VN instead of the VC
         // send_event->setVC(vc_to_send);
         
-	    // Need to return credits to the output buffer
+	    // Need to return credits to the output buffer.  Only the flits
+	    // that have crossed the xbar hold credits; the rest of a
+	    // packet still in flight now stream through.
 	    int size = send_event->getFlitCount();
-	    xbar_in_credits[vc_to_send] += size;
+        int buffered = size;
+        if ( send_event == xfer_out_ev ) {
+            buffered = xfer_out_arrived;
+            xfer_out_ev = NULL;
+            xfer_out_streaming = true;
+        }
+	    xbar_in_credits[vc_to_send] += buffered;
         if ( !oql_track_remote ) {
-            if ( oql_track_port ) {
-                for ( int i = 0; i < num_vcs; ++i ) {
-                    output_queue_lengths[i] -= size;
-                }
-            }
-            else {
-                output_queue_lengths[vc_to_send] -= size;
-            }
+            addOutputQueueLength(vc_to_send, -buffered);
         }
         
 	    // Send an event to wake up again after this packet is sent.
@@ -69,6 +69,8 @@ public:
         {"vn_remap_shm_size",  "Size of shared memory region for vn remapping.  If empty, no remapping is done", "-1"},
         {"oql_track_port",     ""},
         {"oql_track_remote",   ""},
+        {"flit_level",         "Move packets through the router a flit at a time (wormhole) rather than as a whole.", "false"},
+        {"credit_latency",     "Delay for returning input buffer credits to the upstream port.  If not set, credits use output_latency.", ""},
         {"output_arb",         "Arbitration unit to be used for port output", "merlin.arb.output.basic"}
     )
 
@@ -179,6 +181,26 @@ private:
     int* port_ret_credits;
     int* port_out_credits;
 
+    // Returned credits are delayed by credit_latency when it is set
+    TimeConverter* credit_tc;
+
+    // Flit-level mode.  Only the head flit of a packet takes output
+    // buffer space when the packet is sent over the xbar; the rest
+    // arrive through sendFlit().  If the link sends the packet before
+    // its tail arrives, the remaining flits stream straight through
+    // and never occupy the output buffer.
+    bool flit_level;
+    internal_router_event* xfer_out_ev;
+    int xfer_out_vc;
+    int xfer_out_arrived;
+    int xfer_out_remaining;
+    bool xfer_out_streaming;
+
+    // Flit-level mode.  Input buffer credits are returned a flit at a
+    // time as the packet last received drains through recvFlit().
+    int xfer_in_vc_return;
+    int xfer_in_remaining;
+
     // Represents the start of when a port was idle
     // If the buffer was empty we instantiate this to the current time
     SimTime_t idle_start;
@@ -250,6 +272,8 @@ public:
     // Returns NULL if no event in input_buf[vc]. Otherwise, returns
     // the next event.
     internal_router_event* recv(int vc);
+    bool sendFlit();
+    void recvFlit();
     internal_router_event** getVCHeads() {
     	return vc_heads;
     }
@@ -289,6 +313,8 @@ private:
     void handle_input_n2r(Event* ev);
     void handle_input_r2r(Event* ev);
     void handle_output(Event* ev);
+    void returnCredits(int vc, int credits);
+    void addOutputQueueLength(int vc, int flits);
 	void handleSAIWindow(Event* ev);
 	void reenablePort(Event* ev);
 
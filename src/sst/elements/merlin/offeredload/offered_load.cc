@@ -105,7 +105,7 @@ OfferedLoad::OfferedLoad(ComponentId_t cid, Params& params) :
 
     pattern_params = new Params();
     // packetDestGen = static_cast<TargetGenerator*>(loadSubComponent(pattern, this, params));
-    pattern_params->insert(params.find_prefix_params("pattern"));
+    pattern_params->insert(params.find_prefix_params("pattern."));
     pattern_params->insert("pattern_gen",pattern);
 
     UnitAlgebra warmup_time_ua = params.find<UnitAlgebra>("warmup_time","5us");
@@ -175,13 +175,16 @@ void OfferedLoad::finish()
         // }
 
 
-        // Now, write out a summary table with just the latencies
+        // Now, write out a summary table with the latencies and the
+        // load accepted during the collection window, as a fraction of
+        // link bandwidth
 
-        out.output("%9s %9s\n","Offered","Average");
-        out.output("%9s %9s\n","Load ","Latency");
+        out.output("%9s %15s %9s\n","Offered","Average","Accepted");
+        out.output("%9s %15s %9s\n","Load ","Latency","Load ");
         for ( auto ev : complete_event ) {
             UnitAlgebra average = UnitAlgebra("1ps") * ev->sum / ev->count;
-            out.output("%9.2f %15s",offered_load[ev->generation],average.toStringBestSI().c_str());
+            double accepted = (double)ev->count * serialization_time.getRoundedValue() / ((double)collect_time * num_peers);
+            out.output("%9.2f %15s %9.2f",offered_load[ev->generation],average.toStringBestSI().c_str(),accepted);
             if ( ev->backup > 0 ) out.output("*\n");
             else out.output("\n");
         }
@@ -130,7 +130,7 @@ public:
         {"linkcontrol",      "SimpleNetwork object to use as interface to network.","merlin.linkcontrol"},
         {"buffer_size",      "Size of input and output buffers.","1kB"},
         {"packet_size",      "Packet size specified in either b or B (can include SI prefix).","32B"},
-        {"pattern",          "Traffic pattern to use.","merlin.targetgen.uniform"},
+        {"pattern",          "Traffic pattern to use; its parameters are given with a pattern. prefix.","merlin.targetgen.uniform"},
         {"offered_load",     "Load to be offered to network.  Valid range: 0 < offered_load <= 1.0."},
         {"warmup_time",      "Time to wait before recording latencies","1us"},
         {"collect_time",     "Time to collect data after warmup","20us"},
@@ -61,6 +61,9 @@ class OfferedLoadJob(Job):
         id = self._nid_map.index(nID)
         nic.addParam("id", id)
 
-        return (networkif, portname)
+        #  Add the linkcontrol
+        networkif, port_name = self.network_interface.build(nic,"networkIF",0,self.job_id,self.size,id,True)
+
+        return (networkif, port_name)
 
 
@@ -28,11 +28,77 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
+#include <stdint.h>
 
 namespace SST {
 namespace Merlin {
 
 #define VERIFY_DECLOCKING 0
+
+/**
+   Fixed size bitset with word-at-a-time scans, used by hr_router to
+   track which ports and input VCs have data so arbitration can skip
+   idle ones.
+ */
+class ActiveBitmap {
+public:
+    ActiveBitmap() : num_bits(0) {}
+
+    void resize(int bits) {
+        num_bits = bits;
+        words.assign((bits + 63) / 64, 0);
+    }
+
+    int size() const { return num_bits; }
+
+    inline void set(int bit) { words[bit >> 6] |= (uint64_t)1 << (bit & 63); }
+    inline void clear(int bit) { words[bit >> 6] &= ~((uint64_t)1 << (bit & 63)); }
+    inline bool test(int bit) const { return (words[bit >> 6] >> (bit & 63)) & 1; }
+
+    bool any() const {
+        for ( size_t i = 0; i < words.size(); i++ ) {
+            if ( words[i] ) return true;
+        }
+        return false;
+    }
+
+    int count() const {
+        int total = 0;
+        for ( size_t i = 0; i < words.size(); i++ ) total += __builtin_popcountll(words[i]);
+        return total;
+    }
+
+    // Returns the first set bit in [begin,end), or -1 if there is none
+    int findNext(int begin, int end) const {
+        if ( begin >= end ) return -1;
+        int w = begin >> 6;
+        uint64_t bits = words[w] & (~(uint64_t)0 << (begin & 63));
+        int last_w = (end - 1) >> 6;
+        while ( true ) {
+            if ( bits ) {
+                int bit = (w << 6) + __builtin_ctzll(bits);
+                return bit < end ? bit : -1;
+            }
+            if ( ++w > last_w ) return -1;
+            bits = words[w];
+        }
+    }
+
+    // Returns bits [begin,begin+count) in the low bits of a word,
+    // count must be at most 64
+    inline uint64_t getBits(int begin, int count) const {
+        int w = begin >> 6;
+        int off = begin & 63;
+        uint64_t bits = words[w] >> off;
+        if ( off != 0 && off + count > 64 ) bits |= words[w + 1] << (64 - off);
+        return count == 64 ? bits : bits & (((uint64_t)1 << count) - 1);
+    }
+
+private:
+    int num_bits;
+    std::vector<uint64_t> words;
+};
     
 const int INIT_BROADCAST_ADDR = -1;
 
@@ -68,10 +134,13 @@ public:
    
     virtual void notifyEvent() {}
 
-    inline void inc_vcs_with_data() { vcs_with_data++; }
-    inline void dec_vcs_with_data() { vcs_with_data--; }
+    inline void inc_vcs_with_data(int port, int vc) { vcs_with_data++; vcHeadChanged(port, vc, true); }
+    inline void dec_vcs_with_data(int port, int vc) { vcs_with_data--; vcHeadChanged(port, vc, false); }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
+    // Called when an input VC gains its first packet or drains
+    virtual void vcHeadChanged(int port, int vc, bool has_data) {}
+
     virtual int const* getOutputBufferCredits() = 0;
     virtual void sendTopologyEvent(int port, TopologyEvent* ev) = 0;
     virtual void recvTopologyEvent(int port, TopologyEvent* ev) = 0;
@@ -450,6 +519,15 @@ public:
     // the next event.
     virtual internal_router_event* recv(int vc) = 0;
     virtual internal_router_event** getVCHeads() = 0;
+
+    // Flit-level mode only.  send() and recv() move just the head
+    // flit of a packet; the router then moves the rest one flit per
+    // cycle.  sendFlit() moves the next flit into the output buffer
+    // of the packet last sent and returns false if there is no room
+    // for it.  recvFlit() releases the next flit of the packet last
+    // received from the input buffer.
+    virtual bool sendFlit() { return true; }
+    virtual void recvFlit() {}
     
     // time_base is a frequency which represents the bandwidth of the link in flits/second.
     PortInterface(ComponentId_t cid) :
@@ -504,10 +582,25 @@ public:
     SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Merlin::XbarArbitration)
     
     XbarArbitration(ComponentId_t cid) :
-        SubComponent(cid)
+        SubComponent(cid),
+        active_ports(NULL),
+        active_vcs(NULL)
     {}
     virtual ~XbarArbitration() {}
 
+    // The router owns both bitmaps.  active_ports has a bit per port
+    // with any input VC holding a packet, active_vcs a bit per
+    // (port * num_vcs + vc).  progress_vc only needs to be written for
+    // ports set in active_ports; the router ignores the other entries.
+    void setActiveMaps(const ActiveBitmap* ports, const ActiveBitmap* vcs) {
+        active_ports = ports;
+        active_vcs = vcs;
+    }
+    virtual void vcHeadChanged(int port, int vc, bool has_data) {}
+    // True if only VCs set in active_vcs are considered, which lets
+    // the router hold a VC back from arbitration by clearing its bit
+    virtual bool usesActiveMaps() { return false; }
+
 #if VERIFY_DECLOCKING
     virtual void arbitrate(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc, bool clocking) = 0;
 #else
@@ -517,7 +610,10 @@ public:
     virtual bool isOkayToPauseClock() { return true; }
     virtual void reportSkippedCycles(Cycle_t cycles) {};
     virtual void dumpState(std::ostream& stream) {};
-	
+
+protected:
+    const ActiveBitmap* active_ports;
+    const ActiveBitmap* active_vcs;
 };
 
 }
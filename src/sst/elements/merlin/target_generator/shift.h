@@ -0,0 +1,73 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_SHIFT_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_SHIFT_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class ShiftDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        ShiftDist,
+        "merlin",
+        "targetgen.shift",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates a shift pattern.  Returns (id + shift) mod num_peers; with shift set to the endpoints in a dragonfly group every group sends to the next one.",
+        SST::Merlin::TargetGenerator)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"shift",   "Distance from each endpoint to its target","1"}
+    )
+
+    int shift;
+    int dest;
+
+public:
+
+    ShiftDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        shift = params.find<int>("shift",1);
+        initialize(id, num_peers);
+    }
+
+    ~ShiftDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        dest = ((id + shift) % num_peers + num_peers) % num_peers;
+    }
+
+    int getNextValue(void) {
+        return dest;
+    }
+
+    void seed(uint32_t val) {
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
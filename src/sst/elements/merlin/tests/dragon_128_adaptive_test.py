@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# The dragon_128_test network with one routing algorithm, driven by
+# merlin.offered_load.  Endpoint 0 prints the average latency and the
+# accepted load (fraction of link bandwidth) at each offered load; loads
+# marked with * backed up at the endpoints.  Used to compare the adaptive
+# dragonfly algorithms with minimal routing:
+#
+#   sst dragon_128_adaptive_test.py --model-options="--algorithm=ugal-g --pattern=group-shift"
+#
+# Options:
+#   --algorithm=NAME   minimal, valiant, adaptive-local, ugal-l, ugal-g or par (default ugal-l)
+#   --pattern=NAME     uniform, or group-shift, where every endpoint sends to
+#                      its peer in the next group (default uniform)
+#   --loads=LIST       comma separated offered loads (default 0.2,0.4,0.6,0.8)
+#   --size=SIZE        packet size (default 64B)
+
+import sys
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+algorithm = "ugal-l"
+pattern = "uniform"
+loads = [0.2, 0.4, 0.6, 0.8]
+size = "64B"
+
+for arg in sys.argv[1:]:
+    if arg.startswith("--algorithm="):
+        algorithm = arg.split("=",1)[1]
+    elif arg.startswith("--pattern="):
+        pattern = arg.split("=",1)[1]
+    elif arg.startswith("--loads="):
+        loads = [float(x) for x in arg.split("=",1)[1].split(",")]
+    elif arg.startswith("--size="):
+        size = arg.split("=",1)[1]
+    else:
+        print("Unknown option: %s"%arg)
+        sys.exit(1)
+
+if pattern not in ("uniform", "group-shift"):
+    print("Unknown pattern: %s"%pattern)
+    sys.exit(1)
+
+
+# Adds the shift to the pattern parameters of every endpoint
+class GroupShiftJob(OfferedLoadJob):
+    def __init__(self,job_id,size,shift):
+        OfferedLoadJob.__init__(self,job_id,size)
+        self._declareClassVariables(["_shift"])
+        self._shift = shift
+
+    def build(self, nID, extraKeys):
+        keys = dict(extraKeys)
+        keys["pattern.shift"] = self._shift
+        return OfferedLoadJob.build(self, nID, keys)
+
+
+if __name__ == "__main__":
+
+    ### Setup the topology
+    topo = topoDragonFly()
+    topo.hosts_per_router = 4
+    topo.routers_per_group = 8
+    topo.intergroup_links = 4
+    topo.num_groups = 4
+    topo.algorithm = algorithm
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+
+    topo.router = router
+    topo.link_latency = "20ns"
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    if pattern == "group-shift":
+        ep = GroupShiftJob(0,topo.getNumNodes(),topo.hosts_per_router * topo.routers_per_group)
+        ep.pattern = "merlin.targetgen.shift"
+    else:
+        ep = OfferedLoadJob(0,topo.getNumNodes())
+        ep.pattern = "merlin.targetgen.uniform"
+    ep.network_interface = networkif
+    ep.offered_load = loads
+    ep.message_size = size
+    ep.link_bw = "4GB/s"
+    ep.warmup_time = "2us"
+    ep.collect_time = "5us"
+    ep.drain_time = "10us"
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Single high radix hr_router with a test_nic on every port, all to all
+# traffic.  Used to time crossbar arbitration as the radix grows:
+#
+#   sst hr_router_radix_bench.py --model-options="--radix=64 --arb=merlin.xbar_arb_rr"
+#
+# Options:
+#   --radix=N        number of router ports (default 16; try 16, 48, 64)
+#   --arb=NAME       crossbar arbiter (default merlin.xbar_arb_lru)
+#   --messages=N     messages sent to each peer by every endpoint (default 20)
+#   --vns=N          number of virtual networks (default 2)
+
+import sys
+import sst
+
+radix = 16
+arb = "merlin.xbar_arb_lru"
+messages = 20
+vns = 2
+
+for arg in sys.argv[1:]:
+    if arg.startswith("--radix="):
+        radix = int(arg.split("=",1)[1])
+    elif arg.startswith("--arb="):
+        arb = arg.split("=",1)[1]
+    elif arg.startswith("--messages="):
+        messages = int(arg.split("=",1)[1])
+    elif arg.startswith("--vns="):
+        vns = int(arg.split("=",1)[1])
+    else:
+        print("Unknown option: %s"%arg)
+        sys.exit(1)
+
+print("hr_router radix bench: radix = %d, xbar_arb = %s, messages = %d, vns = %d"%(radix, arb, messages, vns))
+
+link_lat = "20ns"
+
+rtr = sst.Component("router", "merlin.hr_router")
+rtr.addParams({
+    "id" : 0,
+    "num_ports" : radix,
+    "num_vns" : vns,
+    "xbar_arb" : arb,
+    "link_bw" : "4GB/s",
+    "xbar_bw" : "4GB/s",
+    "flit_size" : "8B",
+    "input_latency" : "20ns",
+    "output_latency" : "20ns",
+    "input_buf_size" : "4kB",
+    "output_buf_size" : "4kB",
+})
+rtr.setSubComponent("topology", "merlin.singlerouter")
+
+for i in range(radix):
+    nic = sst.Component("testNic.%d"%i, "merlin.test_nic")
+    nic.addParams({
+        "id" : i,
+        "num_peers" : radix,
+        "num_messages" : messages,
+        "message_size" : "64B",
+    })
+    linkif = nic.setSubComponent("networkIF", "merlin.linkcontrol")
+    linkif.addParams({
+        "link_bw" : "4GB/s",
+        "input_buf_size" : "1kB",
+        "output_buf_size" : "1kB",
+    })
+
+    link = sst.Link("link:%d"%i)
+    link.connect( (linkif, "rtr_port", link_lat), (rtr, "port%d"%i, link_lat) )
@@ -0,0 +1,114 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Latency versus offered load on a 2D mesh of hr_routers driven by
+# merlin.offered_load with uniform random traffic.  Endpoint 0 prints
+# the average latency at each load; loads marked with * backed up at
+# the endpoints, i.e. they are past saturation.  Used to compare the
+# packet-level router with the flit-level pipeline:
+#
+#   sst offered_load_curve.py --model-options="--flit-level --depth=4 --speculative"
+#
+# Options:
+#   --flit-level       use the flit-level router model
+#   --depth=N          router pipeline depth in flit-level mode (default 4)
+#   --speculative      speculative VC and switch allocation
+#   --credit-lat=TIME  credit return latency (default output_latency)
+#   --shape=SHAPE      mesh shape (default 4x4)
+#   --size=SIZE        packet size (default 64B)
+#   --loads=LIST       comma separated offered loads (default 0.1,0.2,...,0.9)
+
+import sys
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+flit_level = False
+depth = 4
+speculative = False
+credit_lat = None
+shape = "4x4"
+size = "64B"
+loads = [0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9]
+
+for arg in sys.argv[1:]:
+    if arg == "--flit-level":
+        flit_level = True
+    elif arg.startswith("--depth="):
+        depth = int(arg.split("=",1)[1])
+    elif arg == "--speculative":
+        speculative = True
+    elif arg.startswith("--credit-lat="):
+        credit_lat = arg.split("=",1)[1]
+    elif arg.startswith("--shape="):
+        shape = arg.split("=",1)[1]
+    elif arg.startswith("--size="):
+        size = arg.split("=",1)[1]
+    elif arg.startswith("--loads="):
+        loads = [float(x) for x in arg.split("=",1)[1].split(",")]
+    else:
+        print("Unknown option: %s"%arg)
+        sys.exit(1)
+
+if __name__ == "__main__":
+
+    ### Setup the topology
+    topo = topoMesh()
+    topo.shape = shape
+    topo.width = "x".join(["1"] * len(shape.split("x")))
+    topo.local_ports = 1
+    topo.link_latency = "20ns"
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "4GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "1kB"
+    router.output_buf_size = "1kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+    if flit_level:
+        router.flit_level = "true"
+        router.pipeline_depth = depth
+        router.speculative = "true" if speculative else "false"
+    if credit_lat:
+        router.credit_latency = credit_lat
+
+    topo.router = router
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = OfferedLoadJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.offered_load = loads
+    ep.pattern = "merlin.targetgen.uniform"
+    ep.message_size = size
+    ep.link_bw = "4GB/s"
+    ep.warmup_time = "5us"
+    ep.collect_time = "20us"
+    ep.drain_time = "50us"
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
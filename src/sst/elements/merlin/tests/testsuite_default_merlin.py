@@ -3,6 +3,8 @@
 from sst_unittest import *
 from sst_unittest_support import *
 
+import re
+
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
 
@@ -63,6 +65,20 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_hyperx_128(self):
          self.merlin_test_template("hyperx_128_test")
 
+    def test_merlin_torus_16_flit_lru(self):
+        self.merlin_flit_test_template("torus_16_flit_test", "merlin.xbar_arb_lru")
+
+    def test_merlin_torus_16_flit_rr(self):
+        self.merlin_flit_test_template("torus_16_flit_test", "merlin.xbar_arb_rr")
+
+    def test_merlin_torus_16_flit_age(self):
+        self.merlin_flit_test_template("torus_16_flit_test", "merlin.xbar_arb_age")
+
+    # ugal-g reads global link occupancy through unsynchronized shared memory
+    @unittest.skipIf(testing_check_get_num_ranks() > 1 or testing_check_get_num_threads() > 1, "merlin: test_merlin_dragon_128_adaptive skipped if ranks > 1 or threads > 1")
+    def test_merlin_dragon_128_adaptive(self):
+        self.merlin_dragon_adaptive_test_template("dragon_128_adaptive_test")
+
 #####
 
     def merlin_test_template(self, testcase):
@@ -90,3 +106,82 @@ class testcase_merlin_Component(SSTTestCase):
         # Perform the test
         cmp_result = testing_compare_sorted_diff(testcase, outfile, reffile)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+#####
+
+    # Flit-level timing differs between the arbiters, so the reference file
+    # holds the output with the cycle stamps, stall counts and simulated
+    # time taken out: every NIC must finish sending and receive every
+    # packet with each arbiter.
+    def merlin_flit_test_template(self, testcase, xbar_arb):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        arbname = xbar_arb.split("_")[-1]
+        testDataFileName="test_merlin_{0}_{1}".format(testcase, arbname)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        reffile = "{0}/refFiles/test_merlin_{1}.out".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        otherargs = '--model-options=\"--arb={0}\"'.format(xbar_arb)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+        testing_remove_component_warning_from_file(outfile)
+
+        output = []
+        with open(outfile, 'r') as fp:
+            for line in fp:
+                line = " ".join(re.sub(r"^\d+:", "", line).split())
+                if not line or line.endswith("stalled cycles."):
+                    continue
+                if line.startswith("Simulation is complete"):
+                    line = "Simulation is complete"
+                output.append(line)
+
+        with open(reffile, 'r') as fp:
+            reference = [line.strip() for line in fp if line.strip()]
+
+        self.assertEqual(sorted(output), sorted(reference), "{0}: output file {1} does not match Reference File {2} once cycle stamps are removed".format(testDataFileName, outfile, reffile))
+
+#####
+
+    # Adversarial group-to-group traffic saturates the minimal routes
+    # between neighbouring groups.  Each adaptive algorithm must accept more
+    # of the highest offered load than minimal routing; the latency and
+    # accepted load of every run are logged.  There is no reference file
+    # because the comparison is the result.
+    def merlin_dragon_adaptive_test_template(self, testcase):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        loads = "0.2,0.6"
+
+        accepted = {}
+        for algorithm in ["minimal", "ugal-l", "ugal-g", "par"]:
+            testDataFileName="test_merlin_{0}_{1}".format(testcase, algorithm)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+            otherargs = '--model-options=\"--algorithm={0} --pattern=group-shift --loads={1}\"'.format(algorithm, loads)
+
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            # Rows are: offered load, average latency, accepted load, and * if backed up
+            rows = []
+            with open(outfile, 'r') as fp:
+                for line in fp:
+                    match = re.search(r"(\d+\.\d+)\s+(\S+ ?\S*s)\s+(\d+\.\d+)(\*?)\s*$", line)
+                    if match:
+                        rows.append((float(match.group(1)), match.group(2), float(match.group(3)), match.group(4)))
+            self.assertEqual(len(rows), len(loads.split(",")), "{0}: expected one row per offered load in {1}".format(testDataFileName, outfile))
+            for row in rows:
+                log_debug("{0}: offered {1:.2f} latency {2} accepted {3:.2f}{4}".format(algorithm, row[0], row[1], row[2], row[3]))
+            accepted[algorithm] = rows[-1][2]
+
+        for algorithm in ["ugal-l", "ugal-g", "par"]:
+            self.assertTrue(accepted[algorithm] > accepted["minimal"],
+                            "{0} accepted {1:.2f} of the offered load under group-shift traffic, no more than minimal ({2:.2f})".format(algorithm, accepted[algorithm], accepted["minimal"]))
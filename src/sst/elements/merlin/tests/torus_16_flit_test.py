@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# All-to-all test traffic on a 4x4 torus of hr_routers in flit-level
+# mode, with a 3 stage speculative pipeline.  Packets are 8 flits and the
+# output buffers hold 4 packets, so worms stall in the xbar.
+#
+#   sst torus_16_flit_test.py --model-options="--arb=merlin.xbar_arb_rr"
+#
+# Options:
+#   --arb=ARB   xbar arbiter (default merlin.xbar_arb_lru)
+
+import sys
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+xbar_arb = "merlin.xbar_arb_lru"
+
+for arg in sys.argv[1:]:
+    if arg.startswith("--arb="):
+        xbar_arb = arg.split("=",1)[1]
+    else:
+        print("Unknown option: %s"%arg)
+        sys.exit(1)
+
+if __name__ == "__main__":
+
+    ### Setup the topology
+    topo = topoTorus()
+    topo.shape = "4x4"
+    topo.width = "1x1"
+    topo.local_ports = 1
+    topo.link_latency = "20ns"
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "4GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "1kB"
+    router.output_buf_size = "256B"
+    router.num_vns = 1
+    router.xbar_arb = xbar_arb
+    router.flit_level = "true"
+    router.pipeline_depth = 3
+    router.speculative = "true"
+
+    topo.router = router
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = TestJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.num_messages = 10
+    ep.message_size = "64B"
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
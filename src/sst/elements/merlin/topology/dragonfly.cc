@@ -83,6 +83,7 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
     }
     
     adaptive_threshold = p.find<double>("adaptive_threshold",2.0);
+    ugal_bias = p.find<int>("ugal_bias",32);
     
     // Get the global link map
     std::vector<int64_t> global_link_map;
@@ -141,6 +142,20 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
             vns[i].algorithm = MINIMAL;
             vns[i].num_vcs = 2;
         }
+        else if ( !vn_route_algos[i].compare("ugal-l") ) {
+            vns[i].algorithm = UGAL_L;
+            vns[i].num_vcs = 3;
+        }
+        else if ( !vn_route_algos[i].compare("ugal-g") ) {
+            vns[i].algorithm = UGAL_G;
+            vns[i].num_vcs = 3;
+        }
+        else if ( !vn_route_algos[i].compare("par") ) {
+            // A packet diverted in its source group moves up a VC
+            // before it takes its first global link
+            vns[i].algorithm = PAR;
+            vns[i].num_vcs = 4;
+        }
         else {
             fatal(CALL_INFO_LONG,1,"ERROR: Unknown routing algorithm specified: %s\n",vn_route_algos[i].c_str());
         }
@@ -152,6 +167,38 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
 
     rng = new RNG::XORShiftRNG(rtr_id+1);
 
+    // Set up the global link congestion snapshot if ugal-g is used
+    global_congestion = NULL;
+    congestion_period = 0;
+    last_congestion_update = 0;
+    bool use_global_congestion = false;
+    for ( int i = 0; i < num_vns; ++i ) {
+        if ( vns[i].algorithm == UGAL_G ) use_global_congestion = true;
+    }
+    if ( use_global_congestion ) {
+        // The snapshot is read through the region's raw pointer, which
+        // only sees routers in this process, and is written without
+        // synchronization, so other threads would race on it
+        RankInfo ranks = Simulation::getSimulation()->getNumRanks();
+        if ( ranks.rank > 1 || ranks.thread > 1 ) {
+            output.fatal(CALL_INFO, -1, "ugal-g reads global link occupancy through unsynchronized shared memory and is not supported with more than one rank or thread.\n");
+        }
+        UnitAlgebra period(p.find<std::string>("global_congestion_period","100ns"));
+        if ( !period.hasUnits("s") ) {
+            output.fatal(CALL_INFO, -1, "global_congestion_period must be specified in units of s.\n");
+        }
+        congestion_period = (period / UnitAlgebra("1ns")).getRoundedValue();
+
+        SharedRegion* cr = Simulation::getSharedRegionManager()->getGlobalSharedRegion("dragonfly_global_congestion",
+                                                                                       params.g * params.a * params.h * sizeof(int32_t),
+                                                                                       new SharedRegionMerger());
+        for ( uint32_t i = 0; i < params.h; i++ ) {
+            cr->modifyArray((group_id * params.a + router_id) * params.h + i, (int32_t)0);
+        }
+        cr->publish();
+        global_congestion = static_cast<int32_t*>(cr->getRawPtr());
+    }
+
     output.verbose(CALL_INFO, 1, 1, "%u:%u:  ID: %u   Params:  p = %u  a = %u  k = %u  h = %u  g = %u\n",
             group_id, router_id, rtr_id, params.p, params.a, params.k, params.h, params.g);
 }
@@ -353,9 +400,138 @@ void topo_dragonfly::route_adaptive_local(int port, int vc, internal_router_even
 
 }
 
+/* Occupancy of all of a port's output queues, in flits */
+int topo_dragonfly::port_load(uint32_t port)
+{
+    int load = 0;
+    for ( int i = 0; i < num_vcs; i++ ) {
+        load += output_queue_lengths[port * num_vcs + i];
+    }
+    return load;
+}
+
+/* This router's own links are read directly, others from the snapshot */
+int topo_dragonfly::global_link_load(uint32_t from_group, uint32_t to_group, uint32_t global_slice)
+{
+    const RouterPortPair& pair = global_link(from_group, to_group, global_slice);
+    if ( from_group == group_id && pair.router == router_id ) return port_load(pair.port);
+    return global_congestion[(from_group * params.a + pair.router) * params.h + pair.port - (params.p + params.a - 1)];
+}
+
+void topo_dragonfly::update_global_congestion()
+{
+    SimTime_t now = getCurrentSimTimeNano();
+    if ( now - last_congestion_update < congestion_period ) return;
+    last_congestion_update = now;
+
+    int32_t* links = &global_congestion[(group_id * params.a + router_id) * params.h];
+    for ( uint32_t i = 0; i < params.h; i++ ) {
+        links[i] = port_load(params.p + params.a - 1 + i);
+    }
+}
+
+/* Cheapest route to dest_group through via_group (dest_group itself for
+ * the minimal route), trying num_slices global slices starting at slice.
+ * Cost is the UGAL estimate: congestion times the hop count, where hops
+ * count a local hop to the global link if it is on another router, each
+ * global link, and a local hop in each group entered. */
+topo_dragonfly::ugalRoute
+topo_dragonfly::ugal_route_to_group(RouteAlgo algo, uint32_t via_group, uint32_t dest_group, uint32_t slice, uint32_t num_slices)
+{
+    ugalRoute best;
+    best.cost = -1;
+    for ( uint32_t i = 0; i < num_slices; i++ ) {
+        uint32_t s = (slice + i) % params.n;
+        uint32_t port = port_for_group(via_group, s);
+
+        int hops = is_global_port(port) ? 2 : 3;
+        int64_t load = port_load(port);
+        if ( algo == UGAL_G && !is_global_port(port) ) load += global_link_load(group_id, via_group, s);
+        if ( via_group != dest_group ) {
+            hops += 2;
+            if ( algo == UGAL_G ) load += global_link_load(via_group, dest_group, s);
+        }
+
+        int64_t cost = load * hops;
+        if ( best.cost < 0 || cost < best.cost ) {
+            best.port = port;
+            best.slice = s;
+            best.cost = cost;
+        }
+    }
+    return best;
+}
+
+void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
+{
+    if ( global_congestion ) update_global_congestion();
+
+    int vn = ev->getVN();
+    RouteAlgo algo = vns[vn].algorithm;
+    if ( algo != UGAL_L && algo != UGAL_G && algo != PAR ) return;
+
+    topo_dragonfly_event *td_ev = static_cast<topo_dragonfly_event*>(ev);
+    uint32_t num_slices = params.n > 1 ? 2 : 1;
+
+    if ( (uint32_t)port < params.p ) {
+        // Source router.  process_input set up a minimal route; take
+        // the valiant route through mid_group_shadow instead if its
+        // estimated delay is lower by more than the bias.
+        if ( td_ev->dest.group == group_id ) {
+            if ( td_ev->dest.router == router_id || td_ev->dest.mid_group_shadow == td_ev->dest.router ) return;
+
+            int direct_route_port = port_for_router(td_ev->dest.router);
+            int valiant_route_port = port_for_router(td_ev->dest.mid_group_shadow);
+            int64_t direct_cost = port_load(direct_route_port);
+            int64_t valiant_cost = 2 * (int64_t)port_load(valiant_route_port);
+            if ( direct_cost > valiant_cost + ugal_bias ) {
+                td_ev->dest.mid_group = td_ev->dest.mid_group_shadow;
+                td_ev->setNextPort(valiant_route_port);
+            }
+            return;
+        }
+
+        ugalRoute direct = ugal_route_to_group(algo, td_ev->dest.group, td_ev->dest.group, td_ev->global_slice_shadow, num_slices);
+        if ( td_ev->dest.mid_group_shadow != td_ev->dest.group ) {
+            ugalRoute valiant = ugal_route_to_group(algo, td_ev->dest.mid_group_shadow, td_ev->dest.group, td_ev->global_slice_shadow, num_slices);
+            if ( direct.cost > valiant.cost + ugal_bias ) {
+                td_ev->dest.mid_group = td_ev->dest.mid_group_shadow;
+                td_ev->global_slice = valiant.slice;
+                td_ev->setNextPort(valiant.port);
+                return;
+            }
+        }
+        td_ev->global_slice = direct.slice;
+        td_ev->setNextPort(direct.port);
+        return;
+    }
+
+    if ( algo != PAR ) return;
+
+    // Progressive adaptive routing: a minimally routed packet that has
+    // taken a local hop in its source group is now at the router with
+    // its global link, and may still divert to the valiant route.  The
+    // global slice is fixed at this point, since changing it could need
+    // another local hop.  A diverted packet moves up a VC so local hops
+    // in the source group never form a cycle.
+    if ( is_global_port(port) || td_ev->src_group != group_id || td_ev->dest.group == group_id ) return;
+    if ( vc != vns[vn].start_vc || td_ev->dest.mid_group != td_ev->dest.group ) return;
+    if ( td_ev->dest.mid_group_shadow == td_ev->dest.group ) return;
+
+    ugalRoute direct = ugal_route_to_group(algo, td_ev->dest.group, td_ev->dest.group, td_ev->global_slice, 1);
+    ugalRoute valiant = ugal_route_to_group(algo, td_ev->dest.mid_group_shadow, td_ev->dest.group, td_ev->global_slice, num_slices);
+    if ( direct.cost > valiant.cost + ugal_bias ) {
+        td_ev->dest.mid_group = td_ev->dest.mid_group_shadow;
+        td_ev->global_slice = valiant.slice;
+        td_ev->setNextPort(valiant.port);
+        td_ev->setVC(vc+1);
+    }
+}
+
 void topo_dragonfly::route_packet(int port, int vc, internal_router_event* ev) {
     route_nonadaptive(port,vc,ev);
     route_adaptive_local(port,vc,ev);
+    route_ugal(port,vc,ev);
 }
 
 internal_router_event* topo_dragonfly::process_input(RtrEvent* ev)
@@ -372,6 +548,7 @@ internal_router_event* topo_dragonfly::process_input(RtrEvent* ev)
         else {
             dstAddr.mid_group = dstAddr.group;
         }
+        dstAddr.mid_group_shadow = dstAddr.mid_group;
         break;
     case VALIANT:
     case ADAPTIVE_LOCAL:
@@ -389,9 +566,35 @@ internal_router_event* topo_dragonfly::process_input(RtrEvent* ev)
                 // dstAddr.mid_group = rand() % params.g;
             } while ( dstAddr.mid_group == group_id || dstAddr.mid_group == dstAddr.group );
         }
+        dstAddr.mid_group_shadow = dstAddr.mid_group;
+        break;
+    case UGAL_L:
+    case UGAL_G:
+    case PAR:
+        // Start on the minimal route, with a random valiant route in
+        // mid_group_shadow for route_ugal to choose instead.  When
+        // there is no valiant route, mid_group_shadow is the minimal
+        // route.
+        if ( dstAddr.group == group_id ) {
+            dstAddr.mid_group = dstAddr.router;
+            dstAddr.mid_group_shadow = dstAddr.router;
+            if ( params.a > 2 && dstAddr.router != router_id ) {
+                do {
+                    dstAddr.mid_group_shadow = rng->generateNextUInt32() % params.a;
+                } while ( dstAddr.mid_group_shadow == router_id || dstAddr.mid_group_shadow == dstAddr.router );
+            }
+        }
+        else {
+            dstAddr.mid_group = dstAddr.group;
+            dstAddr.mid_group_shadow = dstAddr.group;
+            if ( params.g > 2 ) {
+                do {
+                    dstAddr.mid_group_shadow = rng->generateNextUInt32() % params.g;
+                } while ( dstAddr.mid_group_shadow == group_id || dstAddr.mid_group_shadow == dstAddr.group );
+            }
+        }
         break;
     }
-    dstAddr.mid_group_shadow = dstAddr.mid_group;
 
     topo_dragonfly_event *td_ev = new topo_dragonfly_event(dstAddr);
     td_ev->src_group = group_id;
@@ -554,27 +757,33 @@ uint32_t topo_dragonfly::router_to_group(uint32_t group)
 }
 
 
-/* returns local router port if group can't be reached from this router */
-uint32_t topo_dragonfly::port_for_group(uint32_t group, uint32_t slice, int id)
+/* Router and port in from_group with the global link to to_group */
+const RouterPortPair& topo_dragonfly::global_link(uint32_t from_group, uint32_t to_group, uint32_t slice)
 {
     // Look up global port to use
     switch ( global_route_mode ) {
     case ABSOLUTE:
-        if ( group >= group_id ) group--;
+        if ( to_group >= from_group ) to_group--;
         break;
     case RELATIVE:
-        if ( group > group_id ) {
-            group = group - group_id - 1;
+        if ( to_group > from_group ) {
+            to_group = to_group - from_group - 1;
         }
         else {
-            group = params.g - group_id + group - 1;
+            to_group = params.g - from_group + to_group - 1;
         }
         break;
     default:
         break;
     }
 
-    const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,slice);
+    return group_to_global_port.getRouterPortPair(to_group,slice);
+}
+
+/* returns local router port if group can't be reached from this router */
+uint32_t topo_dragonfly::port_for_group(uint32_t group, uint32_t slice, int id)
+{
+    const RouterPortPair& pair = global_link(group_id, group, slice);
 
     if ( pair.router == router_id ) {
         return pair.port;
@@ -84,8 +84,10 @@ public:
         {"dragonfly:intergroup_per_router", "Number of links per router connected to other groups."},
         {"dragonfly:intergroup_links",      "Number of links between each pair of groups."},
         {"dragonfly:num_groups",            "Number of groups in network."},
-        {"dragonfly:algorithm",             "Routing algorithm to use [minmal (default) | valiant].", "minimal"},
+        {"dragonfly:algorithm",             "Routing algorithm to use [minmal (default) | valiant | adaptive-local | ugal-l | ugal-g | par]. ugal-g needs a single rank and thread.", "minimal"},
         {"dragonfly:adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
+        {"dragonfly:ugal_bias",             "Bias toward minimal routes for ugal-l, ugal-g and par, in flits of estimated queueing delay.", "32"},
+        {"dragonfly:global_congestion_period", "How often routers publish the occupancy of their global links for ugal-g. Only routers on the same rank see the occupancy and it is not synchronized between threads, so ugal-g is fatal with more than one rank or thread.", "100ns"},
         {"dragonfly:global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"dragonfly:global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
 
@@ -94,8 +96,10 @@ public:
         {"intergroup_per_router", "Number of links per router connected to other groups."},
         {"intergroup_links",      "Number of links between each pair of groups."},
         {"num_groups",            "Number of groups in network."},
-        {"algorithm",             "Routing algorithm to use [minmal (default) | valiant].", "minimal"},
+        {"algorithm",             "Routing algorithm to use [minmal (default) | valiant | adaptive-local | ugal-l | ugal-g | par]. ugal-g needs a single rank and thread.", "minimal"},
         {"adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
+        {"ugal_bias",             "Bias toward minimal routes for ugal-l, ugal-g and par, in flits of estimated queueing delay.", "32"},
+        {"global_congestion_period", "How often routers publish the occupancy of their global links for ugal-g. Only routers on the same rank see the occupancy and it is not synchronized between threads, so ugal-g is fatal with more than one rank or thread.", "100ns"},
         {"global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
     )
@@ -115,16 +119,35 @@ public:
         uint32_t n;  /* # of links between groups in a pair */
     };
 
+    /* UGAL_L, UGAL_G and PAR choose between the minimal route and a
+     * valiant route at the source router by comparing estimated delay:
+     * congestion along the route times its hop count.  UGAL_L only looks
+     * at this router's output queues, UGAL_G adds the occupancy of the
+     * global links on each route, and PAR also reconsiders a minimal
+     * route at the router that owns the source group's global link.
+     */
     enum RouteAlgo {
         MINIMAL,
         VALIANT,
-        ADAPTIVE_LOCAL
+        ADAPTIVE_LOCAL,
+        UGAL_L,
+        UGAL_G,
+        PAR
     };
 
     RouteToGroup group_to_global_port;
 
     struct dgnflyParams params;
     double adaptive_threshold;
+    int ugal_bias;
+
+    /* Snapshot of every global link's output queue occupancy, indexed by
+     * (group * a + router) * h + global port.  Each router writes its own
+     * links at most once per congestion_period.  NULL unless a VN uses
+     * ugal-g. */
+    int32_t* global_congestion;
+    SimTime_t congestion_period;
+    SimTime_t last_congestion_update;
     uint32_t group_id;
     uint32_t router_id;
 
@@ -175,6 +198,8 @@ private:
     uint32_t router_to_group(uint32_t group);
     uint32_t port_for_router(uint32_t router);
     uint32_t port_for_group(uint32_t group, uint32_t global_slice, int id = -1);
+    const RouterPortPair& global_link(uint32_t from_group, uint32_t to_group, uint32_t global_slice);
+    bool is_global_port(uint32_t port) { return port >= params.p + params.a - 1; }
 
     struct vn_info {
         int start_vc;
@@ -186,6 +211,18 @@ private:
 
     void route_nonadaptive(int port, int vc, internal_router_event* ev);
     void route_adaptive_local(int port, int vc, internal_router_event* ev);
+    void route_ugal(int port, int vc, internal_router_event* ev);
+
+    struct ugalRoute {
+        uint32_t port;
+        uint32_t slice;
+        int64_t cost;
+    };
+
+    ugalRoute ugal_route_to_group(RouteAlgo algo, uint32_t via_group, uint32_t dest_group, uint32_t slice, uint32_t num_slices);
+    int port_load(uint32_t port);
+    int global_link_load(uint32_t from_group, uint32_t to_group, uint32_t global_slice);
+    void update_global_congestion();
 
     
 };
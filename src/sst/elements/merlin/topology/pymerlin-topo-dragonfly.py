@@ -25,7 +25,7 @@ class topoDragonFly(Topology):
         Topology.__init__(self)
         self._declareClassVariables(["link_latency","host_link_latency","global_link_map"])
         self._declareParams("main",["hosts_per_router","routers_per_group","intergroup_links","num_groups",
-                                    "algorithm","adaptive_threshold","global_routes"])
+                                    "algorithm","adaptive_threshold","ugal_bias","global_congestion_period","global_routes"])
         self.global_routes = "absolute"
         self._subscribeToPlatformParamSet("topology")
 
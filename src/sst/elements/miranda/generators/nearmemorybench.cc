@@ -0,0 +1,103 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/nearmemorybench.h>
+#include <sst/elements/memHierarchy/customcmd/nearMemoryCmd.h>
+
+using namespace SST::Miranda;
+using SST::MemHierarchy::NearMemoryCmd;
+
+NearMemoryBenchGenerator::NearMemoryBenchGenerator( ComponentId_t id, Params& params ) :
+	RequestGenerator(id, params) {
+
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+
+	out = new Output("NearMemoryBenchGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	n = params.find<uint64_t>("n", 1024);
+	iterations = params.find<uint64_t>("iterations", 4);
+	stride = params.find<uint64_t>("stride", 16);
+
+	if(stride < elemSize) {
+		out->fatal(CALL_INFO, -1, "NearMemoryBenchGenerator: stride (%" PRIu64 ") must be at least %" PRIu64 " bytes\n", stride, elemSize);
+	}
+
+	start_a = params.find<uint64_t>("start_a", 0);
+	start_b = params.find<uint64_t>("start_b", start_a + (n * elemSize));
+	start_c = params.find<uint64_t>("start_c", start_b + (n * elemSize));
+
+	iteration = 0;
+
+	out->verbose(CALL_INFO, 1, 0, "Elements:          %" PRIu64 "\n", n);
+	out->verbose(CALL_INFO, 1, 0, "Iterations:        %" PRIu64 "\n", iterations);
+	out->verbose(CALL_INFO, 1, 0, "Stride of c:       %" PRIu64 " bytes\n", stride);
+	out->verbose(CALL_INFO, 1, 0, "Start of array a @ 0x%" PRIx64 "\n", start_a);
+	out->verbose(CALL_INFO, 1, 0, "Start of array b @ 0x%" PRIx64 "\n", start_b);
+	out->verbose(CALL_INFO, 1, 0, "Start of array c @ 0x%" PRIx64 "\n", start_c);
+}
+
+NearMemoryBenchGenerator::~NearMemoryBenchGenerator() {
+	delete out;
+}
+
+CustomOpRequest* NearMemoryBenchGenerator::makeCommand(uint32_t opcode, uint64_t addr, uint64_t dst, uint64_t count, uint64_t elemStride, uint64_t value) {
+	NearMemoryCmd cmd;
+	cmd.dst = dst;
+	cmd.count = count;
+	cmd.stride = elemStride;
+	cmd.elemSize = elemSize;
+	cmd.value = value;
+
+	CustomOpRequest* req = new CustomOpRequest(addr, elemSize, opcode);
+	req->setPayload(cmd.encode());
+	return req;
+}
+
+void NearMemoryBenchGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	if(iteration == iterations) {
+		return;
+	}
+
+	out->verbose(CALL_INFO, 4, 0, "Iteration: %" PRIu64 "\n", iteration);
+
+	// A dirty line of a in the cache has to be shot down before the memset
+	q->push_back(new MemoryOpRequest(start_a, elemSize, WRITE));
+	q->push_back(new FenceOpRequest());
+
+	// Memset and memcpy count bytes
+	q->push_back(makeCommand(NearMemoryCmd::Memset, start_a, 0, n * elemSize, 0, iteration + 1));
+	q->push_back(new FenceOpRequest());
+	q->push_back(makeCommand(NearMemoryCmd::Memcpy, start_a, start_b, n * elemSize, 0, 0));
+	q->push_back(new FenceOpRequest());
+	q->push_back(makeCommand(NearMemoryCmd::Scatter, start_b, start_c, n, stride, 0));
+	q->push_back(new FenceOpRequest());
+	q->push_back(makeCommand(NearMemoryCmd::Reduce, start_c, 0, n, stride, 0));
+	q->push_back(new FenceOpRequest());
+
+	q->push_back(new MemoryOpRequest(start_c, elemSize, READ));
+	q->push_back(new FenceOpRequest());
+
+	iteration++;
+}
+
+bool NearMemoryBenchGenerator::isFinished() {
+	return (iteration == iterations);
+}
+
+void NearMemoryBenchGenerator::completed() {
+
+}
@@ -0,0 +1,84 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_NEAR_MEMORY_BENCH_GEN
+#define _H_SST_MIRANDA_NEAR_MEMORY_BENCH_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <queue>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Drives memHierarchy.nearMemoryCustomCmdHandler. Each iteration stores to
+ * array a through the caches, then sets a with a memset, copies it to b,
+ * scatters b into c with a stride, sums c with a reduction and loads c back.
+ * Steps are separated by fences. Addresses are used unmapped in the command
+ * operands, so the CPU should use the linear page map.
+ */
+class NearMemoryBenchGenerator : public RequestGenerator {
+
+public:
+	NearMemoryBenchGenerator( ComponentId_t id, Params& params );
+	~NearMemoryBenchGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		NearMemoryBenchGenerator,
+		"miranda",
+		"NearMemoryBenchGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Issues memset, memcpy, scatter and reduce commands for memHierarchy.nearMemoryCustomCmdHandler",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "n",                "Sets the number of 8-byte elements in each array", "1024" },
+		{ "iterations",       "Sets the number of times the command sequence is issued", "4" },
+		{ "stride",           "Sets the distance in bytes between the elements of array c", "16" },
+		{ "start_a",          "Sets the start address of the array a", "0" },
+		{ "start_b",          "Sets the start address of the array b", "start_a + n * 8" },
+		{ "start_c",          "Sets the start address of the array c", "start_b + n * 8" }
+	)
+
+private:
+	static const uint64_t elemSize = 8;
+
+	CustomOpRequest* makeCommand(uint32_t opcode, uint64_t addr, uint64_t dst, uint64_t count, uint64_t stride, uint64_t value);
+
+	uint64_t start_a;
+	uint64_t start_b;
+	uint64_t start_c;
+
+	uint64_t n;
+	uint64_t stride;
+	uint64_t iterations;
+	uint64_t iteration;
+
+	Output*  out;
+
+};
+
+}
+}
+
+#endif
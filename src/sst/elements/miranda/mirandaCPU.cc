@@ -283,7 +283,10 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
     if (statBytes[operation] != nullptr)
         statBytes[operation]->addData(reqLength);
 
-    if(lineOffset + reqLength > cacheLine) {
+    // Commands with a payload describe their operands there and are never split
+    const bool hasPayload = isCustom && !static_cast<CustomOpRequest*>(req)->getPayload().empty();
+
+    if(lineOffset + reqLength > cacheLine && !hasPayload) {
         // Request is for a split operation (i.e. split over cache lines)
     	const uint64_t lowerLength = cacheLine - lineOffset;
         const uint64_t upperLength = reqLength - lowerLength;
@@ -353,6 +356,7 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
                     SimpleMem::Request::CustomCmd,
                     memMgr->mapAddress(reqAddress), reqLength,
                     creq->getOpcode(),0,0);
+            request->data = creq->getPayload();
         }else{
             // issue standard request
 	    request = new SimpleMem::Request(
@@ -23,6 +23,7 @@
 #include <sst/core/output.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Miranda {
@@ -205,8 +206,13 @@ public:
     ~CustomOpRequest() {}
     uint32_t getOpcode() const { return opcode; }
 
+    /* Operands sent with the command; addresses in them are not mapped */
+    void setPayload(const std::vector<uint8_t>& data) { payload = data; }
+    const std::vector<uint8_t>& getPayload() const { return payload; }
+
 protected:
     uint32_t opcode;
+    std::vector<uint8_t> payload;
 };
 
 class FenceOpRequest : public GeneratorRequest {
@@ -0,0 +1,68 @@
+import sst
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stopAtCycle", "0 ns")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "miranda.BaseCPU")
+comp_cpu.addParams({
+	"verbose" : 0,
+	"clock" : "2.4GHz",
+	"printStats" : 1,
+})
+
+gen = comp_cpu.setSubComponent("generator", "miranda.NearMemoryBenchGenerator")
+gen.addParams({
+	"verbose" : 0,
+	"n" : 256,
+	"iterations" : 4,
+	"stride" : 16,
+})
+
+# Enable statistics outputs
+comp_cpu.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+comp_l1cache.addParams({
+      "access_latency_cycles" : "2",
+      "cache_frequency" : "2.4 GHz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "4",
+      "cache_line_size" : "64",
+      "L1" : "1",
+      "cache_size" : "8KB"
+})
+
+# Enable statistics outputs
+comp_l1cache.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+# CoherentMemController shoots down the lines each command touches
+comp_memctrl = sst.Component("memory", "memHierarchy.CoherentMemController")
+comp_memctrl.addParams({
+      "clock" : "1GHz",
+})
+handler = comp_memctrl.setSubComponent("customCmdHandler", "memHierarchy.nearMemoryCustomCmdHandler")
+handler.addParams({
+      "line_size" : "64",
+})
+handler.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+memory = comp_memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+      "access_time" : "100 ns",
+      "mem_size" : "512MiB",
+})
+
+
+# Define the simulation links
+link_cpu_cache_link = sst.Link("link_cpu_cache_link")
+link_cpu_cache_link.connect( (comp_cpu, "cache_link", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+link_cpu_cache_link.setNoCut()
+
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (comp_l1cache, "low_network_0", "50ps"), (comp_memctrl, "direct_link", "50ps") )
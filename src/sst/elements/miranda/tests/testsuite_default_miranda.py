@@ -67,6 +67,9 @@ class testcase_miranda_Component(SSTTestCase):
     def test_miranda_gupsgen(self):
         self.miranda_test_template("gupsgen")
 
+    def test_miranda_nearmemorybench(self):
+        self.miranda_nearmemory_test_template("nearmemorybench")
+
 #####
 
     def miranda_test_template(self, testcase, timeout=240):
@@ -99,3 +102,44 @@ class testcase_miranda_Component(SSTTestCase):
         # Perform the test
         cmp_result = testing_compare_sorted_diff(testcase, outfile, reffile)
 
+#####
+
+    # The handler's command and byte counts follow from the generator's
+    # parameters in nearmemorybench.py (n = 256 8-byte elements, 4 iterations),
+    # so they are checked directly instead of against a reference file
+    def miranda_nearmemory_test_template(self, testcase, timeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_miranda_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=timeout)
+
+        self.assertFalse(os_test_file(errfile, "-s"), "miranda test {0} has Non-empty Error File {1}".format(testDataFileName, errfile))
+
+        stats = {}
+        with open(outfile, 'r') as fp:
+            for line in fp:
+                if " : Accumulator : " in line:
+                    name, values = line.split(" : Accumulator : ", 1)
+                    stats[name.strip().split(".")[-1]] = dict(field.strip().split(" = ") for field in values.split(";") if " = " in field)
+
+        iterations = 4
+        arrayBytes = 256 * 8
+        expected = {
+            "memset_cmds"   : iterations,
+            "memcpy_cmds"   : iterations,
+            "gather_cmds"   : 0,
+            "scatter_cmds"  : iterations,
+            "reduce_cmds"   : iterations,
+            "bytes_read"    : iterations * 3 * arrayBytes,   # memcpy, scatter and reduce sources
+            "bytes_written" : iterations * 3 * arrayBytes,   # memset, memcpy and scatter destinations
+        }
+        for stat, value in expected.items():
+            self.assertTrue(stat in stats, "miranda test {0}: statistic {1} missing from {2}".format(testDataFileName, stat, outfile))
+            self.assertEqual(int(stats[stat]["Sum.u64"]), value, "miranda test {0}: {1} is {2}, expected {3}".format(testDataFileName, stat, stats[stat]["Sum.u64"], value))
@@ -20,8 +20,10 @@
 #include "sst_config.h"
 #include "FST.h"
 
+#include <cmath>
 #include <vector>
 #include <map>
+#include <set>
 
 #include "AllocInfo.h"
 #include "Job.h"
@@ -35,11 +37,15 @@
 using namespace SST::Scheduler;
 using namespace std;
 
-FST::FST(int inrelaxed)
+FST::FST(int inrelaxed, bool inincremental)
 {
     //keeps track of job copies so we have a pointer when they actually start
     running = new vector<Job*>;
     toRun = new vector<Job*>;
+    jobFST = NULL;
+    incremental = inincremental;
+    nextSeq = 0;
+    simMach = NULL; //created when we first see the real machine
     schedout.init("", 8, 0, Output::STDOUT);
 
     if (inrelaxed == 1) {
@@ -51,6 +57,20 @@ FST::FST(int inrelaxed)
     }
 }
 
+FST::~FST()
+{
+    for (unsigned int x = 0; x < running -> size(); x++) {
+        delete running -> at(x);
+    }
+    for (unsigned int x = 0; x < toRun -> size(); x++) {
+        delete toRun -> at(x);
+    }
+    delete running;
+    delete toRun;
+    delete [] jobFST;
+    delete simMach;
+}
+
 //This would normally be a part of the constructor but we need the number of
 //jobs, so schedComponent calls it later.
 void FST::setup(int innumjobs)
@@ -71,6 +91,33 @@ bool compevents(Job* j1, Job* j2) {
     return j1 -> getStartTime() + j1 -> getActualTime() < j2 -> getStartTime() + j2 -> getActualTime();
 }
 
+//nodes a job occupies; matches AllocInfo
+static int nodesNeeded(Job* j, const Machine* mach)
+{
+    return ceil((float) j -> getProcsNeeded() / mach -> coresPerNode);
+}
+
+FST::TimelineEntry::TimelineEntry(Job* injob, unsigned long inseq)
+{
+    job = injob;
+    start = job -> getStartTime();
+    end = start + job -> getActualTime();
+    seq = inseq;
+}
+
+//same order as compevents; the clone engine's multimap keeps equal jobs in
+//the order they were inserted, which is the order they started
+bool FST::TimelineEntry::operator<(const TimelineEntry& other) const
+{
+    if (end != other.end) {
+        return end < other.end;
+    }
+    if (start != other.start) {
+        return start < other.start;
+    }
+    return seq < other.seq;
+}
+
 //When a job arrives, we need to calculate its FST value
 void FST::jobArrives(Job *inj, Scheduler* insched, Machine* inmach)
 {
@@ -78,9 +125,9 @@ void FST::jobArrives(Job *inj, Scheduler* insched, Machine* inmach)
 
     Job *j = new Job(*inj); //must copy the job because they keep track of when they each start
 
-    //if the schedule is not relaxed the job has already been added; otherwise
-    //we want to add it later (but only once)
-    bool alreadyadded = !relaxed;
+    if (incremental && NULL == simMach) {
+        simMach = new SimpleMachine(inmach -> numNodes, true, inmach -> coresPerNode, NULL);
+    }
 
     if (!relaxed) {
         toRun -> push_back(j); //keep the pointer for the future so we can add it to running
@@ -98,6 +145,20 @@ void FST::jobArrives(Job *inj, Scheduler* insched, Machine* inmach)
         return;
     }
 
+    if (incremental) {
+        incrementalArrives(j, insched);
+    } else {
+        cloneArrives(j, insched, inmach);
+    }
+}
+
+//Simulates the schedule on copies of the scheduler, machine, and allocator
+void FST::cloneArrives(Job* j, Scheduler* insched, Machine* inmach)
+{
+    //if the schedule is not relaxed the job has already been added; otherwise
+    //we want to add it later (but only once)
+    bool alreadyadded = !relaxed;
+
     //create copies of the scheduler, machine, and allocator for our simulation
     Scheduler* sched = insched -> copy(running, toRun);
     Machine* mach = new SimpleMachine(inmach->numNodes, true, inmach->coresPerNode, NULL);
@@ -115,7 +176,6 @@ void FST::jobArrives(Job *inj, Scheduler* insched, Machine* inmach)
         TaskMapInfo* tmi = taskMap->mapTasks(ai);
         mach -> allocate(tmi);
         jobToAi -> insert(pair<Job*, TaskMapInfo*>(running -> at(x), tmi));
-        delete tmi;
     }
 
     Statistics* stats = new Statistics(mach, sched, alloc, taskMap, nullstr.c_str(), nullcstr, true, this);
@@ -199,7 +259,7 @@ void FST::jobArrives(Job *inj, Scheduler* insched, Machine* inmach)
 
         //this check is because we don't want to start until all jobs that have completed at the same time to finish
         //(may cause a larger job to be able to start as more processors become available)
-        if (endtimes -> begin() -> second != time) {
+        if (endtimes -> empty() || endtimes -> begin() -> second != time) {
             success = FSTstart(endtimes, jobToAi, j, sched, alloc, mach, stats, time);
 
             //now that a new job is started, see if we can add ours
@@ -235,13 +295,13 @@ void FST::jobArrives(Job *inj, Scheduler* insched, Machine* inmach)
     }
     jobToAi -> clear();
     delete jobToAi;
-    while (!readdtorunning -> empty()) {
-        running -> push_back(readdtorunning -> back());
-        readdtorunning -> pop_back();
+    //readd in the order the jobs were found so jobs that end together stay
+    //in the order they started
+    for (unsigned int x = 0; x < readdtorunning -> size(); x++) {
+        running -> push_back(readdtorunning -> at(x));
     }
-    while (!readdtorun-> empty()) {
-        toRun -> push_back(readdtorun -> back());
-        readdtorun -> pop_back();
+    for (unsigned int x = 0; x < readdtorun -> size(); x++) {
+        toRun -> push_back(readdtorun -> at(x));
     }
     //some of these jobs may have been started during our simulation; reset them
     for (unsigned int x = 0; x < toRun -> size(); x++) {
@@ -262,19 +322,25 @@ bool FST::FSTstart(std::multimap<Job*, unsigned long, bool(*)(Job*, Job*)>* endt
     TaskMapInfo* tmi;
     do {
         newJob = sched->tryToStart(time, *mach);
+        if (NULL == newJob) {
+            return false;
+        }
         sched->startNext(time, *mach);
         ai = alloc->allocate(newJob);
         if (ai != NULL) {
-            tmi = taskMapper.mapTasks(ai);
             if (ai -> job == j) {
                 //our job has been scheduled!  record the time
                 jobFST[j -> getJobNum()] = time;
                 schedout.debug(CALL_INFO, 7, 0, "Assigning FST of %lu to Job %ld\n", jobFST[j -> getJobNum()], j -> getJobNum());
                 j -> reset();
+                delete ai;
                 return true;
             }
             else {
                 schedout.debug(CALL_INFO, 7, 0, "%lu: FST starting %s\n", time, ai -> job -> toString().c_str());
+                newJob -> start(time);
+                tmi = taskMapper.mapTasks(ai);
+                mach -> allocate(tmi);
                 endtimes -> insert(pair<Job*, unsigned long>(ai -> job, time + ai -> job -> getActualTime()));
                 jobToAi -> insert(pair<Job*, TaskMapInfo*>(ai -> job, tmi));
             }
@@ -284,10 +350,129 @@ bool FST::FSTstart(std::multimap<Job*, unsigned long, bool(*)(Job*, Job*)>* endt
     return false;
 }
 
+//Simulates the schedule on a copy of the scheduler only.  The running jobs'
+//completions come from the persistent timeline, which we walk without
+//changing, merged with the completions of jobs started in this simulation.
+//The schedulers only look at the machine's free node count, so that is all
+//simMach tracks; it is put back afterwards.
+void FST::incrementalArrives(Job* j, Scheduler* insched)
+{
+    //if the schedule is not relaxed the job has already been added; otherwise
+    //we want to add it later (but only once)
+    bool alreadyadded = !relaxed;
+
+    Scheduler* sched = insched -> copy(running, toRun);
+    int freeBefore = simMach -> getNumFreeNodes();
+
+    SimState sim;
+    sim.nextSeq = nextSeq; //after every running job, as in the clone engine
+    sim.waiting = toRun -> size();
+
+    unsigned long time = j -> getArrivalTime();
+    bool success = false;
+    //see if we can start now
+    if (toRun -> empty() && !alreadyadded) {
+        toRun -> push_back(j);
+        sched -> jobArrives(j, time, *simMach);
+        alreadyadded = true;
+    }
+    success = incrementalStart(j, sched, &sim, time);
+
+    if (!alreadyadded && 0 == sim.waiting) {
+        toRun -> push_back(j);
+        sched -> jobArrives(j, time, *simMach);
+        alreadyadded = true;
+        //try to start again in case we can start the job right away
+        success = incrementalStart(j, sched, &sim, time);
+    }
+
+    set<TimelineEntry>::iterator nextRunning = timeline.begin();
+    while (!success && (nextRunning != timeline.end() || !sim.ends.empty())) {
+        //take the earliest completion from either list
+        bool fromTimeline = sim.ends.empty() ||
+            (nextRunning != timeline.end() && *nextRunning < *(sim.ends.begin()));
+        Job* finished;
+        if (fromTimeline) {
+            finished = nextRunning -> job;
+            time = nextRunning -> end;
+            nextRunning++;
+        } else {
+            finished = sim.ends.begin() -> job;
+            time = sim.ends.begin() -> end;
+            sim.ends.erase(sim.ends.begin());
+        }
+
+        simMach -> deallocateNodes(nodesNeeded(finished, simMach));
+        sched -> jobFinishes(finished, time, *simMach);
+
+        //don't start until all jobs that complete at the same time finish
+        bool moreNow = (nextRunning != timeline.end() && nextRunning -> end == time) ||
+            (!sim.ends.empty() && sim.ends.begin() -> end == time);
+        if (!moreNow) {
+            success = incrementalStart(j, sched, &sim, time);
+
+            //now that a new job is started, see if we can add ours
+            if (relaxed && !alreadyadded && 0 == sim.waiting) {
+                toRun -> push_back(j);
+                sched -> jobArrives(j, time, *simMach);
+                alreadyadded = true;
+                //try to start again in case we can start the job right away
+                success = incrementalStart(j, sched, &sim, time);
+            }
+        }
+    }
+    if (!success) schedout.fatal(CALL_INFO, 1, "Could not find time for %s in FST\n", j -> toString().c_str());
+
+    //clean up
+    delete sched;
+    for (unsigned int x = 0; x < sim.started.size(); x++) {
+        sim.started[x] -> reset();
+    }
+    int freeAfter = simMach -> getNumFreeNodes();
+    if (freeAfter > freeBefore) {
+        simMach -> allocateNodes(freeAfter - freeBefore);
+    } else if (freeAfter < freeBefore) {
+        simMach -> deallocateNodes(freeBefore - freeAfter);
+    }
+}
+
+//helper function; starts jobs on the simulated machine until the scheduler
+//has none ready or starts j
+bool FST::incrementalStart(Job* j, Scheduler* sched, SimState* sim, unsigned long time)
+{
+    Job* newJob;
+    while (NULL != (newJob = sched -> tryToStart(time, *simMach))) {
+        sched -> startNext(time, *simMach);
+        if (newJob == j) {
+            //our job has been scheduled!  record the time
+            jobFST[j -> getJobNum()] = time;
+            schedout.debug(CALL_INFO, 7, 0, "Assigning FST of %lu to Job %ld\n", jobFST[j -> getJobNum()], j -> getJobNum());
+            j -> reset();
+            return true;
+        }
+        schedout.debug(CALL_INFO, 7, 0, "%lu: FST starting %s\n", time, newJob -> toString().c_str());
+        newJob -> start(time);
+        simMach -> allocateNodes(nodesNeeded(newJob, simMach));
+        sim -> ends.insert(TimelineEntry(newJob, sim -> nextSeq++));
+        sim -> started.push_back(newJob);
+        sim -> waiting--;
+    }
+    return false;
+}
+
 //when a job finishes, we just remove it from running
 void FST::jobCompletes(Job* j)
 {
     schedout.debug(CALL_INFO, 7, 0, "%s completing in FST\n", j -> toString().c_str());
+    if (incremental) {
+        map<long, set<TimelineEntry>::iterator>::iterator entry = jobToTimeline.find(j -> getJobNum());
+        if (entry == jobToTimeline.end()) {
+            schedout.fatal(CALL_INFO, 1, "FST could not find completing job in its timeline\n");
+        }
+        simMach -> deallocateNodes(nodesNeeded(entry -> second -> job, simMach));
+        timeline.erase(entry -> second);
+        jobToTimeline.erase(entry);
+    }
     for(vector<Job*>::iterator it = running -> begin(); it != running -> end(); it++) {
         if ((*it) -> getJobNum() == j -> getJobNum()) {
             delete *it;
@@ -309,6 +494,10 @@ void FST::jobStarts(Job* j, unsigned long time)
             Job* startingjob = toRun -> at(x);
             startingjob -> startsAtTime(time);
             running -> push_back(startingjob);
+            if (incremental) {
+                simMach -> allocateNodes(nodesNeeded(startingjob, simMach));
+                jobToTimeline[startingjob -> getJobNum()] = timeline.insert(TimelineEntry(startingjob, nextSeq++)).first;
+            }
             toRun -> erase (toRun -> begin() + x);
             return;
         }
@@ -15,6 +15,14 @@
 
 /*
  * Computes the FST for each job that comes in
+ *
+ * There are two engines.  The clone engine (the default) rebuilds a machine
+ * and allocator and replays every running job for each arrival.  The
+ * incremental engine keeps the running jobs' completions in a persistent
+ * timeline and a node count that are updated as jobs start and complete, so
+ * each arrival only forks the scheduler and walks the timeline.  It is opt-in
+ * and has only been checked against the clone engine for the pqueue
+ * schedulers.
  */
 
 #ifndef SST_SCHEDULER_FST_H__
@@ -22,6 +30,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 
 namespace SST {
     namespace Scheduler {
@@ -34,17 +43,49 @@ namespace SST {
 
         class FST {
             private:
+                //a job completion; ordered as compevents orders jobs, with
+                //ties (same end and start) broken by the order jobs started
+                struct TimelineEntry {
+                    unsigned long end;
+                    unsigned long start;
+                    unsigned long seq;
+                    Job* job;
+
+                    TimelineEntry(Job* injob, unsigned long inseq);
+                    bool operator<(const TimelineEntry& other) const;
+                };
+
+                //state of one incremental simulation
+                struct SimState {
+                    std::set<TimelineEntry> ends;   //completions of jobs started in the simulation
+                    std::vector<Job*> started;      //jobs started in the simulation
+                    unsigned long nextSeq;
+                    unsigned int waiting;           //toRun jobs not yet started
+                };
+
                 std::vector<Job*>* running;
                 std::vector<Job*>* toRun;
                 int numjobs;
                 unsigned long* jobFST; //array to hold the FST values for jobs 1....numjobs
                 bool relaxed;
+                bool incremental;
+
+                //incremental engine state
+                std::set<TimelineEntry> timeline;   //completions of the real running jobs
+                std::map<long, std::set<TimelineEntry>::iterator> jobToTimeline;
+                unsigned long nextSeq;
+                Machine* simMach;                   //only its free node count is used
+
+                void cloneArrives(Job* j, Scheduler* insched, Machine* inmach);
+                void incrementalArrives(Job* j, Scheduler* insched);
+                bool incrementalStart(Job* j, Scheduler* sched, SimState* sim, unsigned long time);
 
             public:
                 void jobArrives(Job* j, Scheduler* insched, Machine* inmach);
                 void jobCompletes(Job* j);
                 void jobStarts(Job* j, unsigned long time);
-                FST(int inrelaxed);
+                FST(int inrelaxed, bool inincremental = false);
+                ~FST();
                 bool FSTstart(std::multimap<Job*, unsigned long, bool(*)(Job*, Job*)>* endtimes,
                               std::map<Job*, TaskMapInfo*>* jobToAi, Job* j, Scheduler* sched,
                               Allocator* alloc, Machine* mach, Statistics* stats, unsigned long time);
@@ -656,6 +656,23 @@ int Factory::getFST(SST::Params& params)
     return 0;
 }
 
+//FST engine, given as the FST argument: strict[clone] (the default)
+//or strict[incremental]
+bool Factory::getFSTIncremental(SST::Params& params)
+{
+    if(params.find<std::string>("FST").empty()){
+        return false;
+    }
+    vector<string>* FSTparams = parseparams(params.find<std::string>("FST"));
+    if (FSTparams -> size() < 2 || FSTparams -> at(1) == "clone") {
+        return false;
+    } else if (FSTparams -> at(1) == "incremental") {
+        return true;
+    }
+    schedout.fatal(CALL_INFO, 1, "Could not parse FST engine; should be clone or incremental");
+    return false;
+}
+
 vector<double>* Factory::getTimePerDistance(SST::Params& params)
 {
     vector<double>* ret = new vector<double>;
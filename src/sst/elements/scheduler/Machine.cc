@@ -105,6 +105,22 @@ void Machine::deallocate(TaskMapInfo* taskMapInfo)
     }
 }
 
+void Machine::allocateNodes(int nodeCount)
+{
+    if(numAvail < nodeCount){
+        schedout.fatal(CALL_INFO, 1, "Attempted to allocate %d nodes when only %d are available", nodeCount, numAvail);
+    }
+    numAvail -= nodeCount;
+}
+
+void Machine::deallocateNodes(int nodeCount)
+{
+    if(nodeCount > (numNodes - numAvail)) {
+        schedout.fatal(CALL_INFO, 1, "Attempted to deallocate %d nodes when only %d are busy", nodeCount, (numNodes-numAvail));
+    }
+    numAvail += nodeCount;
+}
+
 std::vector<int>* Machine::getFreeNodes() const
 {
     std::vector<int>* freeList = new std::vector<int>(numAvail);
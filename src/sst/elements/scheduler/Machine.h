@@ -38,6 +38,10 @@ namespace SST {
                 void reset();
                 void allocate(TaskMapInfo* taskMapInfo);
                 void deallocate(TaskMapInfo* taskMapInfo);
+                //change only the free node count, for simulations that never
+                //look at which nodes are free (FST)
+                void allocateNodes(int nodeCount);
+                void deallocateNodes(int nodeCount);
 
                 inline int getNumFreeNodes() const { return numAvail; }
                 inline bool isFree(int nodeNum) const { return freeNodes[nodeNum]; }
@@ -155,7 +155,7 @@ schedComponent::schedComponent(ComponentId_t id, Params& params) :
 
     string trace = params.find<std::string>("traceName");
     if (FSTtype > 0) {
-        calcFST = new FST(FSTtype);  //must call calcFST -> setup() once we know the number of jobs (in other words, in setup())
+        calcFST = new FST(FSTtype, factory.getFSTIncremental(params));  //must call calcFST -> setup() once we know the number of jobs (in other words, in setup())
     } else {
         calcFST = NULL;
     }
@@ -87,7 +87,7 @@ namespace SST {
                         "Simple task mapper"
                     },
                     { "FST",
-                      "Metric to analyze scheduler in terms of social justice",
+                      "Metric to analyze scheduler in terms of social justice: none, strict or relaxed. An optional engine argument, e.g. strict[incremental], selects the clone (default) or incremental calculation; incremental has only been checked for pqueue",
                       "None"
                     },
                     { "timeperdistance",
@@ -25,6 +25,7 @@
 #include <queue>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cstdio>
 #include <cmath>
@@ -332,16 +333,15 @@ EASYScheduler* EASYScheduler::copy(std::vector<Job*>* inrunning, std::vector<Job
         newrunning -> insert(new RunningInfo(*it));
     }
 
-    //replace pointers in toRun
+    //replace pointers in toRun, looking the copies up by job number
+    unordered_map<long, Job*> copies;
+    for (vector<Job*>::iterator it2 = intoRun -> begin(); it2 != intoRun -> end(); it2++) {
+        copies.insert(pair<long, Job*>((*it2) -> getJobNum(), *it2));
+    }
     for (set<Job*, JobComparator, std::allocator<Job*> >::iterator it = toRun -> begin(); it != toRun -> end(); it++) {
-        bool found = false;
-        for (vector<Job*>::iterator it2 = intoRun -> begin(); !found && it2 != intoRun -> end(); it2++) {
-            if ((*it2) -> getJobNum() == (*it) -> getJobNum()) {
-                newtoRun -> insert(*it2);
-                found = true;
-            }
-        }
-        if (!found) schedout.fatal(CALL_INFO, 1, "Could not find deep copy for %s\nwhen copying EASYScheduler for FST\n", (*it) -> toString().c_str());
+        unordered_map<long, Job*>::iterator copy = copies.find((*it) -> getJobNum());
+        if (copy == copies.end()) schedout.fatal(CALL_INFO, 1, "Could not find deep copy for %s\nwhen copying EASYScheduler for FST\n", (*it) -> toString().c_str());
+        newtoRun -> insert(copy -> second);
     }
 
     //call the constructor and return
@@ -23,6 +23,7 @@
 
 #include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
 
@@ -80,19 +81,21 @@ PQScheduler* PQScheduler::copy(std::vector<Job*>* inrunning, std::vector<Job*>*
         toRun -> pop();
     }
 
+    //index the copies by job number so each lookup is constant time
+    unordered_map<long, Job*> copies;
+    for (vector<Job*>::iterator it2 = intoRun -> begin(); it2 != intoRun -> end(); it2++) {
+        copies.insert(pair<long, Job*>((*it2) -> getJobNum(), *it2));
+    }
+
     int notfound = 0;
     while (!copyToRun -> empty()) {
-        bool found = false;
         Job* it = copyToRun -> top();
         toRun -> push(it); //add the element back to toRun
         copyToRun -> pop();
-        for (vector<Job*>::iterator it2 = intoRun -> begin(); !found && it2 != intoRun -> end(); it2++) {
-            if ((*it2) -> getJobNum() == it -> getJobNum()) {
-                newtoRun -> push(*it2);
-                found = true;
-            }
-        }
-        if (!found) {
+        unordered_map<long, Job*>::iterator copy = copies.find(it -> getJobNum());
+        if (copy != copies.end()) {
+            newtoRun -> push(copy -> second);
+        } else {
             schedout.debug(CALL_INFO, 7, 0, "Cannot find %s in toRun\n", it -> toString().c_str());
             notfound++;
         }
@@ -0,0 +1,166 @@
+#!/usr/bin/env python
+'''
+Regression harness for the FST (fair start time) engines.
+Runs each bundled trace through sst twice, once with the incremental FST
+engine and once with the clone engine, and checks that every job gets the
+same FST value in the time log.  Exits with 1 on any difference.
+
+usage: python compareFST.py [options]
+       python compareFST.py --schedulers easy --fst relaxed
+'''
+
+import os, sys, time, subprocess, shutil, tempfile
+
+from optparse import OptionParser
+
+# Bundled traces: (trace, machine nodes, cores per node).  The Atlas machine
+# matches sstInput.py; the NASA iPSC/860 had 128 single core nodes.
+traces = [
+    ('test_scheduler_Atlas.sim', 80, 4),
+    ('NASA-iPSC-1993-3.1-cln.swf', 128, 1),
+]
+
+engines = ['incremental', 'clone']
+
+
+# Converts a standard workload format trace as convertTrace.py does
+# ([Arrival time | Number of processors | Runtime | Requested Time]), but
+# without numpy and keeping only the first maxJobs usable jobs
+def convertSWF(inFile, outFile, maxJobs):
+    count = 0
+    out = open(outFile, 'w')
+    for line in open(inFile):
+        fields = line.split()
+        if len(fields) < 9 or line.startswith(';'):
+            continue
+        arrival, runtime, procs, requested = [int(float(fields[x])) for x in (1, 3, 4, 8)]
+        if procs <= 0 or runtime < 0:
+            continue
+        # the scheduler rejects jobs that run longer than requested
+        requested = max(requested, runtime)
+        out.write('%d %d %d %d\n' % (arrival, procs, runtime, requested))
+        count += 1
+        if maxJobs > 0 and count >= maxJobs:
+            break
+    out.close()
+
+
+def writeConfig(configFile, traceName, nodes, cores, scheduler, FST):
+    f = open(configFile, 'w')
+    f.write('# scheduler simulation input file\n')
+    f.write('import sst\n')
+    f.write('\n')
+    f.write('scheduler = sst.Component("myScheduler", "scheduler.schedComponent")\n')
+    f.write('scheduler.addParams({\n')
+    f.write('      "traceName" : "' + traceName + '",\n')
+    f.write('      "coresPerNode" : "' + str(cores) + '",\n')
+    f.write('      "scheduler" : "' + scheduler + '",\n')
+    f.write('      "FST" : "' + FST + '"\n')
+    f.write('})\n')
+    f.write('\n')
+    for i in range(0, nodes):
+        f.write('n' + str(i) + ' = sst.Component("n' + str(i) + '", "scheduler.nodeComponent")\n')
+        f.write('n' + str(i) + '.addParams({ "nodeNum" : "' + str(i) + '" })\n')
+        f.write('l' + str(i) + ' = sst.Link("l' + str(i) + '")\n')
+        f.write('l' + str(i) + '.connect( (scheduler, "nodeLink' + str(i) + \
+                '", "0 ns"), (n' + str(i) + ', "Scheduler", "0 ns") )\n')
+    f.close()
+
+
+# Returns {job number: FST} from a time log, or None if the run failed
+def runEngine(options, workDir, runDir, traceName, nodes, cores, scheduler, FST):
+    configFile = os.path.join(runDir, 'config.py')
+    writeConfig(configFile, traceName, nodes, cores, scheduler, FST)
+
+    env = dict(os.environ)
+    env['SIMOUTPUT'] = runDir + '/'
+    log = open(os.path.join(runDir, 'sst.out'), 'w')
+    start = time.time()
+    ret = subprocess.call([options.sst, configFile], cwd = workDir, env = env,
+                          stdout = log, stderr = subprocess.STDOUT)
+    elapsed = time.time() - start
+    log.close()
+    if ret != 0:
+        print('    sst failed (%d), see %s' % (ret, os.path.join(runDir, 'sst.out')))
+        return None, elapsed
+
+    timeLog = os.path.join(runDir, os.path.basename(traceName) + '.time')
+    values = {}
+    for line in open(timeLog):
+        fields = line.split()
+        if len(fields) < 9 or line.startswith('#'):
+            continue
+        values[int(fields[0])] = int(fields[8])
+    return values, elapsed
+
+
+if __name__ == '__main__':
+    parser = OptionParser()
+    parser.add_option('--sst', dest = 'sst', default = 'sst',
+                      help = 'sst executable (default: sst)')
+    parser.add_option('--schedulers', dest = 'schedulers',
+                      default = 'pqueue[fifo],pqueue[largefirst],pqueue[shortfirst]',
+                      help = 'comma separated schedulers (default: the pqueue orderings)')
+    parser.add_option('--fst', dest = 'fst', default = 'strict,relaxed',
+                      help = 'comma separated FST types (default: strict,relaxed)')
+    parser.add_option('--jobs', dest = 'jobs', type = 'int', default = 2000,
+                      help = 'jobs taken from SWF traces, 0 for all (default: 2000)')
+    parser.add_option('--keep', dest = 'keep', default = None,
+                      help = 'directory to keep the runs in (default: temporary)')
+    (options, args) = parser.parse_args()
+
+    simDir = os.path.dirname(os.path.abspath(__file__))
+    if options.keep:
+        workDir = os.path.abspath(options.keep)
+        if not os.path.exists(workDir):
+            os.makedirs(workDir)
+    else:
+        workDir = tempfile.mkdtemp(prefix = 'compareFST')
+
+    # communication matrices named in the traces are opened from the
+    # working directory
+    for traceFile in os.listdir(simDir):
+        if traceFile.endswith('.mtx'):
+            shutil.copy(os.path.join(simDir, traceFile), workDir)
+
+    failures = 0
+    for (traceFile, nodes, cores) in traces:
+        traceName = os.path.join(workDir, traceFile)
+        if traceFile.endswith('.swf'):
+            traceName = traceName + '.sim'
+            convertSWF(os.path.join(simDir, traceFile), traceName, options.jobs)
+        else:
+            shutil.copy(os.path.join(simDir, traceFile), traceName)
+
+        for scheduler in options.schedulers.split(','):
+            for FST in options.fst.split(','):
+                print('%s %s %s' % (traceFile, scheduler, FST))
+                results = {}
+                for engine in engines:
+                    runDir = os.path.join(workDir, '_'.join([traceFile, scheduler, FST, engine]).replace('[', '_').replace(']', ''))
+                    if not os.path.exists(runDir):
+                        os.makedirs(runDir)
+                    results[engine], elapsed = runEngine(options, workDir, runDir, traceName, nodes, cores,
+                                                         scheduler, FST + '[' + engine + ']')
+                    print('    %-12s %.1fs' % (engine, elapsed))
+
+                if None in results.values():
+                    failures += 1
+                    continue
+                reference = results['clone']
+                mismatches = [job for job in sorted(reference) if results['incremental'].get(job) != reference[job]]
+                if len(results['incremental']) != len(reference) or mismatches:
+                    failures += 1
+                    print('    MISMATCH: %d jobs differ' % len(mismatches))
+                    for job in mismatches[:10]:
+                        print('      job %d: clone %d incremental %s' % (job, reference[job], results['incremental'].get(job)))
+                else:
+                    print('    %d jobs match' % len(reference))
+
+    if not options.keep:
+        shutil.rmtree(workDir)
+
+    if failures:
+        print('%d comparisons failed' % failures)
+        sys.exit(1)
+    print('All comparisons match')
@@ -2,14 +2,18 @@
 #ifndef _H_VANADIS_CACHE
 #define _H_VANADIS_CACHE
 
-#include <list>
+#include <vector>
 #include <unordered_map>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
 namespace SST {
 namespace Vanadis {
 
+// Fixed-capacity LRU table. Entries live in preallocated slots threaded on an
+// intrusive doubly-linked recency list (by slot index), and the key map holds
+// slot indices, so lookups, touches and evictions are all O(1).
 template< typename I, typename T >
 class VanadisCache {
 public:
@@ -18,49 +22,86 @@ public:
 	}
 
 	~VanadisCache() {
-		ordering_q.clear();
-		data_values.clear();
+		clear();
 	}
 
 	void clear() {
-		ordering_q.clear();
-		data_values.clear();
+		key_slots.clear();
+		lru_head = NO_SLOT;
+		lru_tail = NO_SLOT;
+		free_head = NO_SLOT;
+
+		for( size_t i = slots.size(); i > 0; --i ) {
+			slots[i-1].next = free_head;
+			free_head = (uint32_t) (i-1);
+		}
 	}
 
 	void reset( const size_t cache_entries ) {
-		clear();
-
 		max_entries = cache_entries;
-                data_values.reserve( cache_entries );
+		slots.assign( cache_entries, Slot() );
+		key_slots.reserve( cache_entries );
+
+		clear();
 	}
 
 	bool contains( const I& value ) const {
-		return (data_values.find( value ) != data_values.end());
+		return (key_slots.find( value ) != key_slots.end());
 	}
 
 	T find( const I& key ) {
-		send_key_to_front( key );
-		return data_values.find( key )->second;
+		const uint32_t slot = key_slots.find( key )->second;
+		send_slot_to_front( slot );
+		return slots[slot].value;
+	}
+
+	// Returns the value slot for key (marking it most recently used), or
+	// nullptr when the key is not cached, so callers can update in place
+	T* lookup( const I& key ) {
+		auto find_key = key_slots.find( key );
+
+		if( find_key == key_slots.end() ) {
+			return nullptr;
+		}
+
+		send_slot_to_front( find_key->second );
+		return &(slots[find_key->second].value);
 	}
 
 	void store( const I& key, T value ) {
-		if( contains( key ) ) {
-			send_key_to_front( key );
+		auto find_key = key_slots.find( key );
+
+		if( find_key != key_slots.end() ) {
+			send_slot_to_front( find_key->second );
 		} else {
+			if( 0 == max_entries ) {
+				release( value );
+				return;
+			}
+
 			kill_lru_key();
-			data_values.insert( std::pair<I, T>( key, value ) );
-			ordering_q.push_front( key );
+
+			const uint32_t slot = free_head;
+			free_head = slots[slot].next;
+
+			slots[slot].key   = key;
+			slots[slot].value = value;
+			link_front( slot );
+
+			key_slots.insert( std::pair<I, uint32_t>( key, slot ) );
 		}
 	}
 
 	void touch( const I& key ) {
-		if( contains(key) ) {
-			send_key_to_front( key );
+		auto find_key = key_slots.find( key );
+
+		if( find_key != key_slots.end() ) {
+			send_slot_to_front( find_key->second );
 		}
 	}
 
 	size_t size() {
-		return data_values.size();
+		return key_slots.size();
 	}
 
 	size_t capacity() {
@@ -68,42 +109,81 @@ public:
 	}
 
 private:
+	static const uint32_t NO_SLOT = UINT32_MAX;
+
+	struct Slot {
+		Slot() : value(), prev(NO_SLOT), next(NO_SLOT) {}
+
+		I key;
+		T value;
+		uint32_t prev;
+		uint32_t next;
+	};
+
+	// Evicted pointer values are owned by the cache, plain values need no cleanup
+	template< typename V > static void release( V*& value ) { delete value; }
+	template< typename V > static void release( V& ) {}
+
 	void kill_lru_key() {
 		// if we aren't full yet, then keep entries otherwise we will
 		// throw away
-		if( ordering_q.size() < max_entries ) {
+		if( key_slots.size() < max_entries ) {
 			return;
 		}
 
-		I remove_key = ordering_q.back();
-		ordering_q.pop_back();
+		const uint32_t victim = lru_tail;
+		unlink( victim );
+
+		key_slots.erase( slots[victim].key );
+		release( slots[victim].value );
+		slots[victim].value = T();
+
+		slots[victim].next = free_head;
+		free_head = victim;
+	}
+
+	void unlink( const uint32_t slot ) {
+		Slot& s = slots[slot];
+
+		if( NO_SLOT == s.prev ) {
+			lru_head = s.next;
+		} else {
+			slots[s.prev].next = s.next;
+		}
+
+		if( NO_SLOT == s.next ) {
+			lru_tail = s.prev;
+		} else {
+			slots[s.next].prev = s.prev;
+		}
+	}
+
+	void link_front( const uint32_t slot ) {
+		slots[slot].prev = NO_SLOT;
+		slots[slot].next = lru_head;
 
-		auto find_key = data_values.find( remove_key );
-		delete find_key->second;
-		data_values.erase( find_key );
+		if( NO_SLOT == lru_head ) {
+			lru_tail = slot;
+		} else {
+			slots[lru_head].prev = slot;
+		}
+
+		lru_head = slot;
 	}
 
-	void send_key_to_front( const I& key ) {
-		bool found_key = false;
-
-                for( auto order_itr = ordering_q.begin(); order_itr != ordering_q.end(); ) {
-                        if( key == (*order_itr) ) {
-                                ordering_q.erase( order_itr );
-                                found_key = true;
-				break;
-                        } else {
-                                order_itr++;
-                        }
-                }
-
-                if( found_key ) {
-                        ordering_q.push_front( key );
-                }
+	void send_slot_to_front( const uint32_t slot ) {
+		if( slot != lru_head ) {
+			unlink( slot );
+			link_front( slot );
+		}
 	}
 
 	size_t max_entries;
-	std::list< I > ordering_q;
-	std::unordered_map<I, T> data_values;
+	std::vector< Slot > slots;
+	std::unordered_map<I, uint32_t> key_slots;
+	uint32_t lru_head;
+	uint32_t lru_tail;
+	uint32_t free_head;
 
 };
 
@@ -0,0 +1,118 @@
+// Microbenchmark for the Vanadis uop/predecode/branch-predictor LRU table.
+//
+// Build and run standalone from the vanadis directory:
+//   g++ -O2 -std=c++11 -I. tests/vcache_bench.cc -o vcache_bench && ./vcache_bench
+//
+// Reports nanoseconds per operation for VanadisCache against the previous
+// list-ordered implementation as the number of entries grows. Each run
+// replays the same address stream: mostly hits with a stride pattern that
+// touches the whole table, plus a fraction of misses that cause evictions.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "datastruct/vcache.h"
+
+using namespace SST::Vanadis;
+
+// The recency handling VanadisCache used before it became an intrusive LRU
+template< typename I, typename T >
+class ListOrderedCache {
+public:
+	ListOrderedCache( const size_t entries ) : max_entries(entries) {}
+
+	bool contains( const I& key ) const { return data_values.find( key ) != data_values.end(); }
+
+	T find( const I& key ) {
+		send_key_to_front( key );
+		return data_values.find( key )->second;
+	}
+
+	void store( const I& key, T value ) {
+		if( contains( key ) ) {
+			send_key_to_front( key );
+		} else {
+			if( ordering_q.size() >= max_entries ) {
+				data_values.erase( ordering_q.back() );
+				ordering_q.pop_back();
+			}
+			data_values.insert( std::pair<I, T>( key, value ) );
+			ordering_q.push_front( key );
+		}
+	}
+
+private:
+	void send_key_to_front( const I& key ) {
+		for( auto itr = ordering_q.begin(); itr != ordering_q.end(); itr++ ) {
+			if( key == (*itr) ) {
+				ordering_q.erase( itr );
+				ordering_q.push_front( key );
+				return;
+			}
+		}
+	}
+
+	size_t max_entries;
+	std::list< I > ordering_q;
+	std::unordered_map< I, T > data_values;
+};
+
+template< typename C >
+double runStream( C& cache, const std::vector<uint64_t>& stream, uint64_t& checksum ) {
+	const auto start = std::chrono::steady_clock::now();
+
+	for( size_t i = 0; i < stream.size(); ++i ) {
+		const uint64_t addr = stream[i];
+
+		if( cache.contains( addr ) ) {
+			checksum += cache.find( addr );
+		} else {
+			cache.store( addr, addr >> 2 );
+		}
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>( end - start ).count() / (double) stream.size();
+}
+
+int main( int argc, char* argv[] ) {
+	const size_t ops = (argc > 1) ? (size_t) atol( argv[1] ) : 200000;
+
+	printf( "%10s %16s %16s %10s\n", "entries", "list (ns/op)", "intrusive (ns/op)", "speedup" );
+
+	for( size_t entries = 16; entries <= 8192; entries *= 2 ) {
+		// Working set slightly larger than the table so ~10% of accesses miss
+		std::vector<uint64_t> stream;
+		stream.reserve( ops );
+		srand( 1 );
+
+		const size_t working_set = entries + (entries / 10) + 1;
+		for( size_t i = 0; i < ops; ++i ) {
+			const size_t idx = (rand() % 4 == 0) ? (size_t) rand() % working_set : (i * 7) % entries;
+			stream.push_back( 0x400000 + (idx * 4) );
+		}
+
+		uint64_t check_list = 0;
+		uint64_t check_lru  = 0;
+
+		ListOrderedCache<uint64_t, uint64_t> list_cache( entries );
+		VanadisCache<uint64_t, uint64_t> lru_cache( entries );
+
+		const double list_ns = runStream( list_cache, stream, check_list );
+		const double lru_ns  = runStream( lru_cache, stream, check_lru );
+
+		if( check_list != check_lru ) {
+			fprintf( stderr, "Error: caches disagree at %" PRIu64 " entries\n", (uint64_t) entries );
+			return 1;
+		}
+
+		printf( "%10" PRIu64 " %16.1f %16.1f %9.1fx\n", (uint64_t) entries, list_ns, lru_ns, list_ns / lru_ns );
+	}
+
+	return 0;
+}